@@ -102,6 +102,21 @@
 #define CPSR_UNDEF_MODE          0x1B  /* 未定义指令模式（十进制27） */
 #define CPSR_MASK_MODE           0x1F  /* 模式位掩码（取低5位，十进制31） */
 
+/**
+ * @brief FPU上下文相关定义
+ * @note FPEXC.EN清零时执行VFP/NEON指令会触发未定义指令异常，懒惰切换据此在首次使用时才装入浮点状态：
+ *       各CPU记录寄存器中留存的是哪个任务的用户态浮点状态，只有其他上下文要用FPU时才写回
+ */
+#define FPEXC_EN                 0x40000000  /* FPEXC使能位bit[30] */
+#if defined(LOSCFG_ARCH_FPU_VFP_D32)
+#define FPU_REGS_SIZE            (32 * 8)    /* D0-D31占用的字节数 */
+#else
+#define FPU_REGS_SIZE            (16 * 8)    /* D0-D15占用的字节数 */
+#endif
+#if !defined(LOSCFG_ARCH_FPU_DISABLE) && !defined(LOSCFG_GDB)
+#define ARCH_FPU_LAZY                        /* 用户态浮点状态懒惰切换（GDB接管未定义指令异常时不支持） */
+#endif
+
 /**
  * @brief 异常类型ID定义
  * @note 用于标识不同类型的处理器异常
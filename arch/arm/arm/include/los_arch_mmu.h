@@ -102,6 +102,7 @@ STATUS_T LOS_ArchMmuUnmap(LosArchMmu *archMmu, VADDR_T vaddr, size_t count);
 STATUS_T LOS_ArchMmuMap(LosArchMmu *archMmu, VADDR_T vaddr, PADDR_T paddr, size_t count, UINT32 flags);
 STATUS_T LOS_ArchMmuChangeProt(LosArchMmu *archMmu, VADDR_T vaddr, size_t count, UINT32 flags);
 STATUS_T LOS_ArchMmuMove(LosArchMmu *archMmu, VADDR_T oldVaddr, VADDR_T newVaddr, size_t count, UINT32 flags);
+INT32 LOS_ArchMmuCopy(LosArchMmu *srcMmu, LosArchMmu *dstMmu, VADDR_T vaddr, size_t count);
 VOID LOS_ArchMmuContextSwitch(LosArchMmu *archMmu);
 STATUS_T LOS_ArchMmuDestroy(LosArchMmu *archMmu);
 VOID OsArchMmuInitPerCPU(VOID);
@@ -110,9 +110,16 @@ typedef struct {
  * Return      : pointer to the task context
  */
 extern VOID *OsTaskStackInit(UINT32 taskID, UINT32 stackSize, VOID *topStack, BOOL initFlag);
-extern VOID OsUserCloneParentStack(VOID *childStack, UINTPTR sp, UINTPTR parentTopOfStask, UINT32 parentStackSize);
+extern VOID OsUserCloneParentStack(UINT32 childTaskID, VOID *childStack, UINTPTR sp,
+                                   UINTPTR parentTopOfStask, UINT32 parentStackSize);
 extern VOID OsUserTaskStackInit(TaskContext *context, UINTPTR taskEntry, UINTPTR stack);
 extern VOID OsInitSignalContext(const VOID *sp, VOID *signalContext, UINTPTR sigHandler, UINT32 signo, UINT32 param);
+extern VOID OsFpuTrap(UINT32 cpsr);
+extern VOID OsFpuOwnerRelease(VOID);
+#ifdef ARCH_FPU_LAZY
+extern VOID OsFpuSignalSave(UINT32 taskID);
+extern VOID OsFpuSignalRestore(UINT32 taskID);
+#endif
 extern void arm_clean_cache_range(UINTPTR start, UINTPTR end);
 extern void arm_inv_cache_range(UINTPTR start, UINTPTR end);
 
@@ -91,6 +91,13 @@ typedef struct {  // MMU映射信息结构体
     UINT32 *flags;        // 映射标志位
 } MmuMapInfo;
 
+typedef struct {  // 映射批量复制进度
+    vaddr_t vaddr;        // 当前虚拟地址
+    UINT32 count;         // 剩余页数
+    UINT32 copied;        // 已复制的页数
+    BOOL protect;         // 是否有源页表项被改为只读
+} MmuCopyInfo;
+
 #define TRY_MAX_TIMES 10  // 最大尝试次数定义
 
 // 定义一级页表，按L1页表项数量对齐，并放置在.bss.prebss.translation_table段
@@ -1059,6 +1066,246 @@ STATUS_T LOS_ArchMmuMove(LosArchMmu *archMmu, VADDR_T oldVaddr, VADDR_T newVaddr
     return LOS_OK;  // 全部完成，返回成功
 }
 
+/**
+ * @brief 为目标地址空间准备与源L1页表项对应的L2页表
+ * @param dstMmu 目标MMU架构信息结构体指针
+ * @param srcPte1 源L1页表项(页表类型)
+ * @param vaddr 虚拟地址
+ * @param dstPte1 输出目标L1页表项
+ * @return 成功返回LOS_OK，失败返回错误码
+ */
+STATIC STATUS_T OsCopyL1PTE(LosArchMmu *dstMmu, PTE_T srcPte1, VADDR_T vaddr, PTE_T *dstPte1)
+{
+    PTE_T *l1Entry = OsGetPte1Ptr(dstMmu->virtTtb, vaddr);  // 目标L1页表项指针
+    PADDR_T pte2Base = 0;  // L2页表物理基地址
+    SPIN_LOCK_S *lock = NULL;  // L1页表自旋锁
+    STATUS_T ret = LOS_OK;  // 返回值
+    UINT32 intSave;  // 中断状态
+
+    lock = OsGetPte1Lock(dstMmu, OsGetPte1Paddr(dstMmu->physTtb, vaddr), &intSave);
+    if (OsIsPte1Invalid(*l1Entry)) {  // 目标尚无L2页表，分配一个
+        ret = OsGetL2Table(dstMmu, OsGetPte1Index(vaddr), &pte2Base);
+        if (ret == LOS_OK) {
+            // 与OsMapL1PTE相同的L1页表项格式，非安全位沿用源页表项
+            PTE_T entry = pte2Base | MMU_DESCRIPTOR_L1_TYPE_PAGE_TABLE |
+                (srcPte1 & MMU_DESCRIPTOR_L1_PAGETABLE_NON_SECURE);
+            entry &= MMU_DESCRIPTOR_L1_SMALL_DOMAIN_MASK;
+            entry |= MMU_DESCRIPTOR_L1_SMALL_DOMAIN_CLIENT;
+            OsSavePte1(l1Entry, entry);
+        }
+    } else if (!OsIsPte1PageTable(*l1Entry)) {  // 目标已是段映射，不能再挂L2页表
+        ret = LOS_ERRNO_VM_ALREADY_EXISTS;
+    }
+    *dstPte1 = *l1Entry;
+    OsUnlockPte1(lock, intSave);
+    return ret;
+}
+
+/**
+ * @brief 在一个L2页表范围内批量复制页表项，并就地去除源页表项的写权限
+ * @param srcMmu 源MMU架构信息结构体指针
+ * @param dstMmu 目标MMU架构信息结构体指针
+ * @param srcPte1 源L1页表项(页表类型)
+ * @param mmuCopyInfo 复制进度：虚拟地址、剩余页数、已复制页数、是否修改过源页表项
+ * @return 本次处理的页数，失败返回负数错误码
+ * @note 相同属性的页表项只做一次属性转换；源、目标L2页表锁各加锁一次
+ */
+STATIC INT32 OsCopyL2PTE(LosArchMmu *srcMmu, LosArchMmu *dstMmu, PTE_T srcPte1, MmuCopyInfo *mmuCopyInfo)
+{
+    PTE_T *srcBasePtr = NULL;  // 源L2页表基地址
+    PTE_T *dstBasePtr = NULL;  // 目标L2页表基地址
+    PTE_T dstPte1 = 0;  // 目标L1页表项
+    PTE_T srcPte2;  // 源L2页表项
+    PTE_T lastAttrs = MMU_DESCRIPTOR_L2_SMALL_MASK + 1;  // 上一次转换的源属性，初值不可能与任何属性相等
+    PTE_T newAttrs = 0;  // 去写权限后的属性
+    SPIN_LOCK_S *srcLock = NULL;  // 源L2页表锁
+    SPIN_LOCK_S *dstLock = NULL;  // 目标L2页表锁
+    UINT32 srcIntSave, dstIntSave, flags, index, copyCount, pte2Index;
+    STATUS_T ret;
+
+    pte2Index = OsGetPte2Index(mmuCopyInfo->vaddr);  // 起始L2页表索引
+    copyCount = MIN2(MMU_DESCRIPTOR_L2_NUMBERS_PER_L1 - pte2Index, mmuCopyInfo->count);  // 本L2页表内的页数
+
+    ret = OsCopyL1PTE(dstMmu, srcPte1, mmuCopyInfo->vaddr, &dstPte1);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    srcLock = OsGetPte2Lock(srcMmu, srcPte1, &srcIntSave);  // 源L2页表锁
+    if (srcLock == NULL) {
+        return LOS_ERRNO_VM_FAULT;
+    }
+    dstLock = OsGetPte2Lock(dstMmu, dstPte1, &dstIntSave);  // 目标L2页表锁
+    if (dstLock == NULL) {
+        OsUnlockPte2(srcLock, srcIntSave);
+        return LOS_ERRNO_VM_FAULT;
+    }
+    srcBasePtr = OsGetPte2BasePtr(srcPte1);
+    dstBasePtr = OsGetPte2BasePtr(dstPte1);
+
+    DMB;
+    for (index = pte2Index; index < (pte2Index + copyCount); index++) {
+        srcPte2 = srcBasePtr[index];
+        if (!OsIsPte2SmallPage(srcPte2) && !OsIsPte2SmallPageXN(srcPte2)) {  // 未映射的页跳过
+            continue;
+        }
+        if ((srcPte2 & MMU_DESCRIPTOR_L2_SMALL_MASK) != lastAttrs) {  // 属性变化时重新计算只读属性
+            lastAttrs = srcPte2 & MMU_DESCRIPTOR_L2_SMALL_MASK;
+            OsCvtPte2AttsToFlags(srcPte1, srcPte2, &flags);
+            newAttrs = OsCvtPte2FlagsToAttrs(flags & ~VM_MAP_REGION_FLAG_PERM_WRITE);
+        }
+        srcPte2 = MMU_DESCRIPTOR_L2_SMALL_PAGE_ADDR(srcPte2) | newAttrs;
+        if (srcBasePtr[index] != srcPte2) {  // 可写页就地改为只读，稍后统一刷新TLB
+            srcBasePtr[index] = srcPte2;
+            mmuCopyInfo->protect = TRUE;
+        }
+        dstBasePtr[index] = srcPte2;
+        mmuCopyInfo->copied++;
+    }
+    DSB;
+
+    OsUnlockPte2(dstLock, dstIntSave);
+    OsUnlockPte2(srcLock, srcIntSave);
+
+    mmuCopyInfo->vaddr += copyCount << MMU_DESCRIPTOR_L2_SMALL_SHIFT;
+    mmuCopyInfo->count -= copyCount;
+    return (INT32)copyCount;
+}
+
+/**
+ * @brief 复制一个段映射，源、目标均去除写权限
+ * @param srcMmu 源MMU架构信息结构体指针
+ * @param dstMmu 目标MMU架构信息结构体指针
+ * @param mmuCopyInfo 复制进度
+ * @return 本次处理的页数，失败返回负数错误码
+ */
+STATIC INT32 OsCopySection(LosArchMmu *srcMmu, LosArchMmu *dstMmu, MmuCopyInfo *mmuCopyInfo)
+{
+    PTE_T *srcEntry = OsGetPte1Ptr(srcMmu->virtTtb, mmuCopyInfo->vaddr);  // 源L1页表项指针
+    PTE_T *dstEntry = OsGetPte1Ptr(dstMmu->virtTtb, mmuCopyInfo->vaddr);  // 目标L1页表项指针
+    SPIN_LOCK_S *lock = NULL;  // 源L1页表锁
+    PTE_T entry;  // 去写权限后的段页表项
+    UINT32 intSave, flags;
+
+    if (!OsIsPte1Invalid(*dstEntry)) {
+        return LOS_ERRNO_VM_ALREADY_EXISTS;
+    }
+    lock = OsGetPte1Lock(srcMmu, OsGetPte1Paddr(srcMmu->physTtb, mmuCopyInfo->vaddr), &intSave);
+    OsCvtSecAttsToFlags(*srcEntry, &flags);
+    entry = OsTruncPte1(MMU_DESCRIPTOR_L1_SECTION_ADDR(*srcEntry)) |
+        OsCvtSecFlagsToAttrs(flags & ~VM_MAP_REGION_FLAG_PERM_WRITE) | MMU_DESCRIPTOR_L1_TYPE_SECTION;
+    if (*srcEntry != entry) {
+        OsSavePte1(srcEntry, entry);
+        mmuCopyInfo->protect = TRUE;
+    }
+    OsUnlockPte1(lock, intSave);
+    OsSavePte1(dstEntry, entry);
+
+    mmuCopyInfo->vaddr += MMU_DESCRIPTOR_L1_SMALL_SIZE;
+    mmuCopyInfo->count -= MMU_DESCRIPTOR_L2_NUMBERS_PER_L1;
+    mmuCopyInfo->copied += MMU_DESCRIPTOR_L2_NUMBERS_PER_L1;
+    return MMU_DESCRIPTOR_L2_NUMBERS_PER_L1;
+}
+
+/**
+ * @brief 将源地址空间中的一个段映射就地拆分为256个属性相同的小页映射
+ * @param archMmu 源MMU架构信息结构体指针
+ * @param mmuCopyInfo 复制进度，拆分后需要刷新源TLB
+ * @return 成功返回LOS_OK，失败返回错误码
+ * @note 用于只复制段的一部分时，拆分后按L2页表路径逐页去除写权限
+ */
+STATIC STATUS_T OsSplitSection(LosArchMmu *archMmu, MmuCopyInfo *mmuCopyInfo)
+{
+    PTE_T *l1Entry = OsGetPte1Ptr(archMmu->virtTtb, mmuCopyInfo->vaddr);  // L1页表项指针
+    PADDR_T pte2Base = 0;  // 新L2页表物理地址
+    SPIN_LOCK_S *lock = NULL;  // L1页表锁
+    STATUS_T ret = LOS_OK;
+    PTE_T entry;  // 新的页表类型L1页表项
+    UINT32 intSave, flags;
+
+    lock = OsGetPte1Lock(archMmu, OsGetPte1Paddr(archMmu->physTtb, mmuCopyInfo->vaddr), &intSave);
+    if (!OsIsPte1Section(*l1Entry)) {  // 加锁前已被其他路径修改，交给调用者重新判断
+        OsUnlockPte1(lock, intSave);
+        return LOS_OK;
+    }
+    ret = OsGetL2Table(archMmu, OsGetPte1Index(mmuCopyInfo->vaddr), &pte2Base);
+    if (ret != LOS_OK) {
+        OsUnlockPte1(lock, intSave);
+        return ret;
+    }
+    OsCvtSecAttsToFlags(*l1Entry, &flags);
+    (VOID)OsSavePte2Continuous((PTE_T *)LOS_PaddrToKVaddr(pte2Base), 0,
+        MMU_DESCRIPTOR_L1_SECTION_ADDR(*l1Entry) | OsCvtPte2FlagsToAttrs(flags), MMU_DESCRIPTOR_L2_NUMBERS_PER_L1);
+
+    entry = pte2Base | MMU_DESCRIPTOR_L1_TYPE_PAGE_TABLE;  // 与OsMapL1PTE相同的L1页表项格式
+    if (flags & VM_MAP_REGION_FLAG_NS) {
+        entry |= MMU_DESCRIPTOR_L1_PAGETABLE_NON_SECURE;
+    }
+    entry &= MMU_DESCRIPTOR_L1_SMALL_DOMAIN_MASK;
+    entry |= MMU_DESCRIPTOR_L1_SMALL_DOMAIN_CLIENT;
+    OsSavePte1(l1Entry, entry);
+    OsUnlockPte1(lock, intSave);
+
+    mmuCopyInfo->protect = TRUE;  // 旧的段TLB项映射相同的物理地址和属性，随复制结束统一刷新
+    return LOS_OK;
+}
+
+/**
+ * @brief 写时复制方式批量复制一段虚拟地址的映射(fork使用)
+ * @param srcMmu 源MMU架构信息结构体指针
+ * @param dstMmu 目标MMU架构信息结构体指针
+ * @param vaddr 虚拟地址起始
+ * @param count 页数(4KB为单位)
+ * @return 复制的页数，失败返回负数错误码
+ * @note 以L2页表为单位直接复制页表项，源映射中的可写页就地改为只读，目标映射与之相同。
+ *       源页表有修改时，按ASID整体刷新一次TLB，而不是逐页解除映射再重新映射。
+ *       只复制段的一部分时先把源段拆分为L2页表；无法识别的L1页表项类型返回LOS_ERRNO_VM_NOT_VALID
+ */
+INT32 LOS_ArchMmuCopy(LosArchMmu *srcMmu, LosArchMmu *dstMmu, VADDR_T vaddr, size_t count)
+{
+    PTE_T l1Entry;  // 源L1页表项
+    INT32 ret = 0;  // 单次处理结果
+    MmuCopyInfo mmuCopyInfo = {  // 复制进度
+        .vaddr = vaddr,
+        .count = (UINT32)count,
+        .copied = 0,
+        .protect = FALSE,
+    };
+
+    if ((srcMmu == NULL) || (dstMmu == NULL) || (srcMmu == dstMmu) || !MMU_DESCRIPTOR_IS_L2_SIZE_ALIGNED(vaddr)) {
+        return LOS_ERRNO_VM_INVALID_ARGS;
+    }
+
+    while (mmuCopyInfo.count > 0) {
+        l1Entry = OsGetPte1(srcMmu->virtTtb, mmuCopyInfo.vaddr);
+        if (OsIsPte1Invalid(l1Entry)) {  // 整个L1项未映射，直接跳过
+            (VOID)OsUnmapL1Invalid(&mmuCopyInfo.vaddr, &mmuCopyInfo.count);
+            continue;
+        } else if (OsIsPte1Section(l1Entry)) {  // 段映射
+            if (MMU_DESCRIPTOR_IS_L1_SIZE_ALIGNED(mmuCopyInfo.vaddr) &&
+                (mmuCopyInfo.count >= MMU_DESCRIPTOR_L2_NUMBERS_PER_L1)) {
+                ret = OsCopySection(srcMmu, dstMmu, &mmuCopyInfo);
+            } else {  // 只复制段的一部分：拆分为L2页表后下一轮按小页复制
+                ret = OsSplitSection(srcMmu, &mmuCopyInfo);
+            }
+        } else if (OsIsPte1PageTable(l1Entry)) {  // L2页表映射
+            ret = OsCopyL2PTE(srcMmu, dstMmu, l1Entry, &mmuCopyInfo);
+        } else {
+            VM_ERR("unsupported l1 entry %#x at %#x", l1Entry, mmuCopyInfo.vaddr);
+            ret = LOS_ERRNO_VM_NOT_VALID;
+        }
+        if (ret < 0) {
+            break;
+        }
+    }
+
+    if (mmuCopyInfo.protect) {  // 源映射有页被改为只读，整体刷新一次TLB
+        OsArmWriteTlbiasidis(srcMmu->asid);
+        OsArmInvalidateTlbBarrier();
+    }
+    return (ret < 0) ? ret : (INT32)mmuCopyInfo.copied;
+}
+
 /**
  * @brief 切换MMU上下文(地址空间)
  * @param archMmu 目标MMU架构信息结构体指针，NULL表示禁用用户空间
@@ -31,6 +31,7 @@
 
 #include "los_hw_pri.h"
 #include "los_task_pri.h"
+#include "arch_config.h"
 
 /* CPU厂商支持表，定义ARM架构下支持的处理器型号 */
 CpuVendor g_cpuTable[] = {
@@ -48,6 +49,174 @@ UINT64 g_cpuMap[LOSCFG_KERNEL_CORE_NUM] = {
 /* FPU使能宏定义，bit[30]为FPU使能控制位 */
 #define FP_EN (1U << 30)  // FPU使能标志位 (二进制1000000000000000000000000000000，十进制1073741824)
 
+#ifdef ARCH_FPU_LAZY
+/**
+ * @brief 任务的用户态浮点上下文
+ * @details 懒惰切换下用户态浮点状态不随任务切换保存，而是留在寄存器中归g_fpuOwner所有，
+ *          只有其他上下文要使用FPU时才写回这里，任务再次使用时从这里装入
+ */
+typedef struct {
+    UINT64 D[FP_REGS_NUM];  /* D0-D31 */
+    UINT32 regFPSCR;        /* FPSCR */
+    UINT32 reserved;        /* 保持8字节对齐 */
+} FpuContext;
+
+STATIC FpuContext g_fpuContext[LOSCFG_BASE_CORE_TSK_LIMIT];  // 按任务ID索引
+STATIC FpuContext g_fpuSigContext[LOSCFG_BASE_CORE_TSK_LIMIT];  // 进入信号处理函数时被打断代码的浮点状态
+
+/* 各CPU浮点寄存器中留存的是哪个任务的用户态浮点状态，NULL表示没有，汇编按CPU号访问 */
+LosTaskCB *g_fpuOwner[LOSCFG_KERNEL_CORE_NUM];
+
+/* 以下函数在关中断且FPU可能关闭时调用，只能通过内联汇编访问浮点寄存器 */
+STATIC INLINE VOID OsFpuEnable(VOID)
+{
+    __asm__ __volatile__("vmsr fpexc, %0" : : "r"(FPEXC_EN) : "memory");
+}
+
+STATIC INLINE VOID OsFpuDisable(VOID)
+{
+    __asm__ __volatile__("vmsr fpexc, %0" : : "r"(0) : "memory");
+}
+
+STATIC INLINE VOID OsFpuRegsSave(FpuContext *context)
+{
+    UINT64 *regs = context->D;
+    UINT32 fpscr;
+
+    __asm__ __volatile__(
+        "vstmia %0!, {d0-d15}\n"
+#ifdef LOSCFG_ARCH_FPU_VFP_D32
+        "vstmia %0!, {d16-d31}\n"
+#endif
+        "vmrs %1, fpscr\n"
+        : "+r"(regs), "=r"(fpscr) : : "memory");
+    context->regFPSCR = fpscr;
+}
+
+STATIC INLINE VOID OsFpuRegsLoad(const FpuContext *context)
+{
+    const UINT64 *regs = context->D;
+
+    __asm__ __volatile__(
+        "vldmia %0!, {d0-d15}\n"
+#ifdef LOSCFG_ARCH_FPU_VFP_D32
+        "vldmia %0!, {d16-d31}\n"
+#endif
+        "vmsr fpscr, %1\n"
+        : "+r"(regs) : "r"(context->regFPSCR) : "memory");
+}
+
+/**
+ * @brief 解除本核浮点寄存器的归属
+ * @details 寄存器中留存有某个任务的用户态浮点状态时写回该任务的上下文，返回时FPU已使能，
+ *          寄存器可以交给其他上下文使用。由汇编在关中断时调用
+ */
+VOID OsFpuOwnerRelease(VOID)
+{
+    UINT32 cpuid = ArchCurrCpuid();
+    LosTaskCB *owner = g_fpuOwner[cpuid];
+
+    OsFpuEnable();
+    if (owner != NULL) {
+        OsFpuRegsSave(&g_fpuContext[owner->taskID]);
+        g_fpuOwner[cpuid] = NULL;
+    }
+}
+
+/**
+ * @brief FPU关闭时执行浮点指令的处理
+ * @param cpsr 被打断上下文的CPSR
+ * @details 内核态使用FPU时写回寄存器中留存的用户态浮点状态后直接使能；
+ *          用户态使用时，寄存器中仍是本任务的状态则直接使能，否则写回原归属任务的状态并装入本任务的
+ */
+VOID OsFpuTrap(UINT32 cpsr)
+{
+    UINT32 cpuid = ArchCurrCpuid();
+    LosTaskCB *runTask = OsCurrTaskGet();
+
+    if ((cpsr & CPSR_MASK_MODE) != CPSR_USER_MODE) {
+        OsFpuOwnerRelease();
+        return;
+    }
+
+    if (g_fpuOwner[cpuid] == runTask) {
+        OsFpuEnable();
+        return;
+    }
+
+    OsFpuOwnerRelease();
+    OsFpuRegsLoad(&g_fpuContext[runTask->taskID]);
+    g_fpuOwner[cpuid] = runTask;
+}
+
+/**
+ * @brief 进入信号处理函数前保存被打断代码的用户态浮点状态
+ * @param taskID 当前任务ID
+ * @details 信号栈帧中没有浮点寄存器，寄存器中留存的状态先写回任务的浮点上下文再整体快照，
+ *          之后关闭FPU，处理函数首次使用浮点时经OsFpuTrap重新装入。在关中断时调用
+ */
+VOID OsFpuSignalSave(UINT32 taskID)
+{
+    if (g_fpuOwner[ArchCurrCpuid()] == OS_TCB_FROM_RTID(taskID)) {
+        OsFpuOwnerRelease();
+    }
+    OsFpuDisable();  // 返回用户态时FPU_USER_RESUME只在寄存器归当前任务时使能
+    g_fpuSigContext[taskID] = g_fpuContext[taskID];
+}
+
+/**
+ * @brief 信号处理函数返回时恢复被打断代码的用户态浮点状态
+ * @param taskID 当前任务ID
+ * @details 寄存器中处理函数的浮点状态直接丢弃，不再写回，被打断的代码再次使用浮点时装入快照。
+ *          在关中断时调用
+ */
+VOID OsFpuSignalRestore(UINT32 taskID)
+{
+    UINT32 cpuid = ArchCurrCpuid();
+
+    if (g_fpuOwner[cpuid] == OS_TCB_FROM_RTID(taskID)) {
+        g_fpuOwner[cpuid] = NULL;
+        OsFpuDisable();
+    }
+    g_fpuContext[taskID] = g_fpuSigContext[taskID];
+}
+
+/**
+ * @brief 复位任务的用户态浮点上下文
+ * @details 任务创建和exec时调用，之后首次使用FPU装入的是干净的寄存器
+ */
+STATIC VOID OsFpuContextReset(UINT32 taskID)
+{
+    LosTaskCB *taskCB = OS_TCB_FROM_RTID(taskID);
+    UINT32 intSave = LOS_IntLock();
+
+    for (UINT32 cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+        if (g_fpuOwner[cpuid] == taskCB) {
+            g_fpuOwner[cpuid] = NULL;  // 寄存器中是同一任务控制块上一个任务或exec之前的状态
+        }
+    }
+    LOS_IntRestore(intSave);
+    (VOID)memset_s(&g_fpuContext[taskID], sizeof(FpuContext), 0, sizeof(FpuContext));
+}
+
+/**
+ * @brief fork时子任务继承父任务的用户态浮点上下文
+ */
+STATIC VOID OsFpuContextClone(UINT32 childTaskID, const LosTaskCB *parent)
+{
+    UINT32 intSave = LOS_IntLock();
+
+    if (g_fpuOwner[ArchCurrCpuid()] == parent) {
+        OsFpuOwnerRelease();  // 父任务的最新状态还在寄存器中
+    }
+    LOS_IntRestore(intSave);
+    (VOID)memcpy_s(&g_fpuContext[childTaskID], sizeof(FpuContext),
+                   &g_fpuContext[parent->taskID], sizeof(FpuContext));
+    (VOID)memcpy_s(&g_fpuSigContext[childTaskID], sizeof(FpuContext),  // 在信号处理函数中fork
+                   &g_fpuSigContext[parent->taskID], sizeof(FpuContext));
+}
+#endif
+
 /**
  * @brief 任务退出函数
  * @details 通过软件中断(SWI)触发系统调用，实现任务的正常退出
@@ -122,7 +291,13 @@ LITE_OS_SEC_TEXT_INIT VOID *OsTaskStackInit(UINT32 taskID, UINT32 stackSize, VOI
         taskContext->D[index] = 0xAAA0000000000000LL + index;  /* 初始化D0-D31浮点寄存器 */
     }
     taskContext->regFPSCR = 0;  // 浮点状态控制寄存器初始化为0
+#ifdef ARCH_FPU_LAZY
+    /* 任务以关闭的FPU启动，首次执行浮点指令时由未定义指令异常装入其用户态浮点上下文 */
+    taskContext->regFPEXC = 0;
+    OsFpuContextReset(taskID);
+#else
     taskContext->regFPEXC = FP_EN;  // 启用FPU (设置FPEXC寄存器的EN位)
+#endif
 #endif
 
     return (VOID *)taskContext;  // 返回初始化好的任务上下文指针
@@ -130,13 +305,15 @@ LITE_OS_SEC_TEXT_INIT VOID *OsTaskStackInit(UINT32 taskID, UINT32 stackSize, VOI
 
 /**
  * @brief 用户任务克隆父进程栈
+ * @param childTaskID 子任务ID
  * @param childStack 子进程栈指针
  * @param sp 用户栈指针 (0表示使用父进程栈顶)
  * @param parentTopOfStack 父进程栈顶
  * @param parentStackSize 父进程栈大小
  * @details 复制父进程的任务上下文到子进程栈，用于实现fork系统调用
  */
-VOID OsUserCloneParentStack(VOID *childStack, UINTPTR sp, UINTPTR parentTopOfStack, UINT32 parentStackSize)
+VOID OsUserCloneParentStack(UINT32 childTaskID, VOID *childStack, UINTPTR sp,
+                            UINTPTR parentTopOfStack, UINT32 parentStackSize)
 {
     LosTaskCB *task = OsCurrTaskGet();  // 获取当前任务控制块
     sig_cb *sigcb = &task->sig;         // 获取信号控制块
@@ -153,6 +330,11 @@ VOID OsUserCloneParentStack(VOID *childStack, UINTPTR sp, UINTPTR parentTopOfSta
     // 复制父进程上下文到子进程栈 (大小为TaskContext结构体大小)
     (VOID)memcpy_s(childStack, sizeof(TaskContext), cloneStack, sizeof(TaskContext));
     ((TaskContext *)childStack)->R0 = 0;  // 子进程fork返回值为0
+#ifdef ARCH_FPU_LAZY
+    OsFpuContextClone(childTaskID, task);  // 用户态浮点状态不在上下文帧中，单独复制
+#else
+    (VOID)childTaskID;
+#endif
     if (sp != 0) {  // 如果指定了用户栈指针
         // 设置用户栈指针并按栈对齐要求截断 (通常为8字节或16字节对齐)
         ((TaskContext *)childStack)->USP = TRUNCATE(sp, LOSCFG_STACK_POINT_ALIGN_SIZE);
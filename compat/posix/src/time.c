@@ -1095,6 +1095,7 @@ int timer_settime(timer_t timerID, int flags,
     SWTMR_CTRL_S *swtmr = NULL;  // 软件定时器控制块
     UINT32 interval, expiry, ret;  // 间隔、超时时间（ ticks ）和返回值
     UINT32 intSave;  // 中断保存标志
+    SPIN_LOCK_S *lock = NULL;  // 定时器所在时间轮的锁
 
     if (flags != 0) {  // 标志位不为0（未支持）
         /* flags not supported currently */
@@ -1132,13 +1133,13 @@ int timer_settime(timer_t timerID, int flags,
     expiry = OsTimeSpec2Tick(&value->it_value);    // 将超时时间转换为ticks
     interval = OsTimeSpec2Tick(&value->it_interval);  // 将间隔转换为ticks
 
-    LOS_SpinLockSave(&g_swtmrSpin, &intSave);  // 加自旋锁
+    lock = OsSwtmrLock(swtmr, &intSave);  // 锁住定时器所在CPU的时间轮
     // 设置定时器模式：有间隔则为周期模式，否则为单次不自动删除模式
     swtmr->ucMode = interval ? LOS_SWTMR_MODE_OPP : LOS_SWTMR_MODE_NO_SELFDELETE;
     swtmr->uwExpiry = expiry + !!expiry; // PS: skip the first tick because it is NOT a full tick.
     swtmr->uwInterval = interval;  // 设置间隔
     swtmr->uwOverrun = 0;          // 重置溢出计数
-    LOS_SpinUnlockRestore(&g_swtmrSpin, intSave);  // 解锁
+    LOS_SpinUnlockRestore(lock, intSave);  // 解锁
 
     // 若超时时间为0（停止定时器）
     if ((value->it_value.tv_sec == 0) && (value->it_value.tv_nsec == 0)) {
@@ -1234,7 +1235,12 @@ STATIC INT32 DoNanoSleep(UINT64 nanoseconds)
 {
     UINT32 ret;  // 返回值
 
+#ifdef LOSCFG_KERNEL_HRTIMER
+    // 向上取整到微秒，由单次定时器直接按到期时间唤醒，不对齐到tick
+    ret = LOS_TaskDelayUs((nanoseconds + OS_SYS_NS_PER_US - 1) / OS_SYS_NS_PER_US);
+#else
     ret = LOS_TaskDelay(OsNS2Tick(nanoseconds));  // 转换为ticks并延迟
+#endif
     // 若成功或因任务不足无法切换（仍视为成功）
     if (ret == LOS_OK || ret == LOS_ERRNO_TSK_YIELD_NOT_ENOUGH_TASK) {
         return 0;  // 返回成功
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MTD_RAMNOR_H__
+#define __MTD_RAMNOR_H__
+
+#include "mtd_dev.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#ifdef LOSCFG_DRIVERS_MTD_RAM_NOR
+/**
+ * @brief 创建RAM模拟的NOR闪存设备
+ * @details 在内核虚拟内存中分配size字节作为闪存介质，并以"spinor"类型登记到MTD设备链表，
+ *          之后即可用add_mtd_partition("spinor", ...)划分分区并挂载JFFS2，无需真实闪存硬件。
+ *          介质遵循NOR语义：擦除把整块置为0xFF，写入只能把位从1清为0。
+ * @param[in] size         设备总大小(字节)，必须是eraseSize的整数倍
+ * @param[in] eraseSize    擦除块大小(字节)，必须是页大小的整数倍
+ * @param[in] eraseDelayMs 每次块擦除模拟的耗时(毫秒)，0表示不模拟；擦除期间调用者睡眠而非忙等
+ * @return 成功返回MTD设备指针；参数非法、内存不足或系统中已登记了"spinor"设备时返回NULL
+ * @attention 同一时刻只能存在一个RAM NOR设备，它占用"spinor"类型，不能与真实SPI NOR闪存共存
+ */
+extern struct MtdDev *RamNorCreate(UINT32 size, UINT32 eraseSize, UINT32 eraseDelayMs);
+
+/**
+ * @brief 销毁RAM模拟的NOR闪存设备
+ * @details 从MTD设备链表中注销设备并释放介质内存，调用前必须先删除该设备上的全部分区
+ * @param[in] mtd RamNorCreate返回的设备指针
+ * @return 0表示成功，-EINVAL表示mtd不是RAM NOR设备
+ */
+extern INT32 RamNorDestroy(struct MtdDev *mtd);
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#endif /* __MTD_RAMNOR_H__ */
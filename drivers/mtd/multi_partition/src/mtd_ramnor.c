@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mtd_ramnor.h"
+#include "errno.h"
+#include "pthread.h"
+#include "securec.h"
+#include "los_base.h"
+#include "los_vm_common.h"
+#include "los_vm_map.h"
+#include "mtd_list.h"
+
+/*
+ * RAM模拟的NOR闪存，用于在没有闪存硬件的配置上挂载和压测JFFS2。
+ * 偏移量为设备内的绝对地址，与JFFS2移植层访问真实SPI NOR的方式一致。
+ */
+#define RAM_NOR_ERASED_BYTE    0xFF    /* 擦除后的字节值 */
+
+typedef struct {
+    struct MtdDev mtd;                 /* 登记到MTD设备链表的设备，priv指向本结构 */
+    UINT8 *media;                      /* 闪存介质，LOS_VMalloc分配 */
+    UINT32 eraseDelayMs;               /* 每块擦除模拟的耗时(毫秒) */
+} RamNorDev;
+
+STATIC RamNorDev g_ramNorDev;
+STATIC pthread_mutex_t g_ramNorLock = PTHREAD_MUTEX_INITIALIZER;
+
+STATIC BOOL RamNorRangeValid(const struct MtdDev *mtd, UINT64 start, UINT64 len)
+{
+    return (start <= mtd->size) && (len <= (mtd->size - start));
+}
+
+STATIC int RamNorErase(struct MtdDev *mtd, UINT64 start, UINT64 len, UINT64 *failAddr)
+{
+    RamNorDev *dev = (RamNorDev *)mtd->priv;
+
+    if (!RamNorRangeValid(mtd, start, len) || ((start % mtd->eraseSize) != 0) || ((len % mtd->eraseSize) != 0)) {
+        if (failAddr != NULL) {
+            *failAddr = start;
+        }
+        return -EINVAL;
+    }
+
+    (VOID)memset_s(dev->media + start, (size_t)len, RAM_NOR_ERASED_BYTE, (size_t)len);
+    if (dev->eraseDelayMs != 0) {
+        LOS_Msleep(dev->eraseDelayMs * (UINT32)(len / mtd->eraseSize));  // 擦除耗时按块累加，期间让出CPU
+    }
+    return 0;
+}
+
+STATIC int RamNorRead(struct MtdDev *mtd, UINT64 start, UINT64 len, const char *buf)
+{
+    RamNorDev *dev = (RamNorDev *)mtd->priv;
+
+    if ((buf == NULL) || !RamNorRangeValid(mtd, start, len)) {
+        return -EINVAL;
+    }
+    (VOID)memcpy_s((VOID *)buf, (size_t)len, dev->media + start, (size_t)len);
+    return (int)len;
+}
+
+STATIC int RamNorWrite(struct MtdDev *mtd, UINT64 start, UINT64 len, const char *buf)
+{
+    RamNorDev *dev = (RamNorDev *)mtd->priv;
+    UINT8 *dst = NULL;
+    UINT64 i;
+
+    if ((buf == NULL) || !RamNorRangeValid(mtd, start, len)) {
+        return -EINVAL;
+    }
+    dst = dev->media + start;
+    for (i = 0; i < len; i++) {
+        dst[i] &= (UINT8)buf[i];  // NOR编程只能把位从1清为0
+    }
+    return (int)len;
+}
+
+struct MtdDev *RamNorCreate(UINT32 size, UINT32 eraseSize, UINT32 eraseDelayMs)
+{
+    struct MtdDev *exist = NULL;
+    struct MtdDev *mtd = NULL;
+
+    if ((size == 0) || (eraseSize == 0) || ((eraseSize % PAGE_SIZE) != 0) || ((size % eraseSize) != 0)) {
+        return NULL;
+    }
+
+    (VOID)pthread_mutex_lock(&g_ramNorLock);
+    if (g_ramNorDev.media != NULL) {
+        goto ERROR_OUT;
+    }
+    exist = (struct MtdDev *)GetMtd("spinor");
+    if (exist != NULL) {
+        (VOID)FreeMtd(exist);
+        PRINT_ERR("%s, a spinor mtd device is already registered\n", __FUNCTION__);
+        goto ERROR_OUT;
+    }
+
+    g_ramNorDev.media = (UINT8 *)LOS_VMalloc(size);
+    if (g_ramNorDev.media == NULL) {
+        PRINT_ERR("%s, media malloc failed\n", __FUNCTION__);
+        goto ERROR_OUT;
+    }
+    (VOID)memset_s(g_ramNorDev.media, size, RAM_NOR_ERASED_BYTE, size);
+    g_ramNorDev.eraseDelayMs = eraseDelayMs;
+
+    mtd = &g_ramNorDev.mtd;
+    mtd->priv = &g_ramNorDev;
+    mtd->type = MTD_NORFLASH;
+    mtd->size = size;
+    mtd->eraseSize = eraseSize;
+    mtd->erase = RamNorErase;
+    mtd->read = RamNorRead;
+    mtd->write = RamNorWrite;
+    AddMtdList("spinor", mtd);
+    (VOID)pthread_mutex_unlock(&g_ramNorLock);
+    return mtd;
+
+ERROR_OUT:
+    (VOID)pthread_mutex_unlock(&g_ramNorLock);
+    return NULL;
+}
+
+INT32 RamNorDestroy(struct MtdDev *mtd)
+{
+    (VOID)pthread_mutex_lock(&g_ramNorLock);
+    if ((mtd == NULL) || (mtd != &g_ramNorDev.mtd) || (g_ramNorDev.media == NULL)) {
+        (VOID)pthread_mutex_unlock(&g_ramNorLock);
+        return -EINVAL;
+    }
+    (VOID)DelMtdList(mtd);
+    LOS_VFree(g_ramNorDev.media);
+    (VOID)memset_s(&g_ramNorDev, sizeof(RamNorDev), 0, sizeof(RamNorDev));
+    (VOID)pthread_mutex_unlock(&g_ramNorLock);
+    return 0;
+}
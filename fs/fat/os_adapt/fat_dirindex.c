@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fatfs.h"
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+#include "los_hash.h"
+#include "los_list.h"
+#include "securec.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/*
+ * 目录名称索引
+ * FatFs的dir_find逐项扫描目录，包含数千个文件的目录每次打开都是O(n)。这里为目录建立
+ * "名称哈希 -> 目录项组偏移"的内存索引：第一次在目录中查找时扫描一遍建立索引，之后的
+ * 查找只需校验哈希命中的目录项。新建的目录项直接插入索引，删除、重命名时整个索引作废。
+ * 索引按(卷, 目录起始簇号)散列，查找目录的索引不随索引数量增长。
+ * 所有索引占用的槽数受LOSCFG_FS_FAT_DIR_INDEX_SLOTS限制，超出时按LRU淘汰整个目录的索引。
+ */
+
+#define FAT_DIRINDEX_SLOT_FREE  0xFFFFFFFF  // 空槽标记(目录项偏移不会取此值)
+#define FAT_DIRINDEX_MIN_SLOTS  16          // 单个索引最少槽数
+#define FAT_DIRINDEX_MAX_CAND   8           // 一次查找最多校验的候选目录项数
+#define FAT_DIRINDEX_NO_LFN     0xFFFFFFFF  // dir_read对无长文件名目录项设置的blk_ofs
+#define FAT_DIRINDEX_BUCKETS    64          // 目录索引散列桶数，须为2的幂
+
+typedef struct {
+    DWORD hash;                 // 名称哈希(ASCII字母不区分大小写)
+    DWORD ofs;                  // 目录项组起始偏移(长文件名首项，无长文件名时为短文件名项)
+} FAT_DIRINDEX_SLOT;
+
+typedef struct {
+    LOS_DL_LIST lru;            // LRU链表节点，表头为最近使用
+    LOS_DL_LIST bucket;         // 散列桶链表节点
+    const FATFS *fs;            // 所属卷
+    DWORD sclust;               // 目录起始簇号
+    UINT32 used;                // 已用槽数
+    UINT32 mask;                // 槽数 - 1，槽数为2的幂
+    FAT_DIRINDEX_SLOT slot[];   // 开放定址哈希表
+} FAT_DIRINDEX;
+
+static LOS_DL_LIST_HEAD(g_fatDirIndexLru);  // 所有目录索引的LRU链表
+static LOS_DL_LIST g_fatDirIndexBucket[FAT_DIRINDEX_BUCKETS];  // 按(卷, 起始簇号)散列的目录索引
+static UINT32 g_fatDirIndexSlots;           // 所有目录索引占用的槽数
+static pthread_mutex_t g_fatDirIndexLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief 计算名称哈希
+ * @details ASCII字母统一折叠为大写后做FNV-1a，与FAT名称不区分大小写的比较规则一致
+ */
+static DWORD fatfs_dirindex_hash(const char *name, size_t len)
+{
+    DWORD hash = FNV1_32A_INIT;  // FNV哈希初始值
+    size_t i;
+    char c;
+
+    for (i = 0; i < len; i++) {
+        c = name[i];
+        if ((c >= 'a') && (c <= 'z')) {
+            c = c - 'a' + 'A';  // 折叠为大写
+        }
+        hash = LOS_HashFNV32aBuf(&c, sizeof(char), hash);
+    }
+    return hash;
+}
+
+/**
+ * @brief 判断名称能否由索引给出结论
+ * @details FatFs会去掉长文件名末尾的空格和点，这类名称与目录项中的名称字节不同，交给dir_find处理
+ * @param ascii 输出参数，名称是否只含ASCII字符
+ */
+static BOOL fatfs_dirindex_name_ok(const char *name, size_t len, BOOL *ascii)
+{
+    size_t i;
+
+    if ((len == 0) || (name[0] == ' ') || (name[len - 1] == ' ') || (name[len - 1] == '.')) {
+        return FALSE;
+    }
+    *ascii = TRUE;
+    for (i = 0; i < len; i++) {
+        if ((unsigned char)name[i] >= 0x80) {  // 非ASCII字符的大小写折叠由FatFs按代码页处理
+            *ascii = FALSE;
+            break;
+        }
+    }
+    return TRUE;
+}
+
+static BOOL fatfs_dirindex_name_eq(const TCHAR *fname, const char *name, size_t len)
+{
+    return (strlen(fname) == len) && (strncasecmp(fname, name, len) == 0);
+}
+
+static void fatfs_dirindex_slot_add(FAT_DIRINDEX *idx, DWORD hash, DWORD ofs)
+{
+    UINT32 i = hash & idx->mask;
+
+    while (idx->slot[i].ofs != FAT_DIRINDEX_SLOT_FREE) {
+        i = (i + 1) & idx->mask;  // 线性探测
+    }
+    idx->slot[i].hash = hash;
+    idx->slot[i].ofs = ofs;
+}
+
+/**
+ * @brief 扫描目录，收集所有名称的哈希与目录项组偏移
+ * @return FR_OK - 扫描完成，其他 - 失败或超出索引容量
+ */
+static FRESULT fatfs_dirindex_scan(DIR *dp, FILINFO *fno, FAT_DIRINDEX_SLOT **names, UINT32 *count)
+{
+    FAT_DIRINDEX_SLOT *buf = NULL;  // 名称数组
+    FAT_DIRINDEX_SLOT *tmp = NULL;
+    UINT32 cap = FAT_DIRINDEX_MIN_SLOTS;
+    UINT32 cnt = 0;
+    FRESULT result;
+    DWORD ofs;
+
+    buf = (FAT_DIRINDEX_SLOT *)malloc(cap * sizeof(FAT_DIRINDEX_SLOT));
+    if (buf == NULL) {
+        return FR_NOT_ENOUGH_CORE;
+    }
+    result = dir_sdi(dp, 0);  // 从目录开头扫描
+    while (result == FR_OK) {
+        result = dir_read(dp, 0);  // 读取下一个文件或目录，跳过卷标、已删除项和点目录
+        if (result != FR_OK) {
+            break;
+        }
+        if ((cnt + 2) > cap) {  // 每个目录项最多两个名称(长文件名与短文件名)
+            if ((cap * 2) > (UINT32)LOSCFG_FS_FAT_DIR_INDEX_SLOTS) {
+                result = FR_NOT_ENOUGH_CORE;  // 目录过大，不建立索引
+                break;
+            }
+            tmp = (FAT_DIRINDEX_SLOT *)malloc(cap * 2 * sizeof(FAT_DIRINDEX_SLOT));
+            if (tmp == NULL) {
+                result = FR_NOT_ENOUGH_CORE;
+                break;
+            }
+            (void)memcpy_s(tmp, cap * 2 * sizeof(FAT_DIRINDEX_SLOT), buf, cnt * sizeof(FAT_DIRINDEX_SLOT));
+            free(buf);
+            buf = tmp;
+            cap *= 2;
+        }
+        get_fileinfo(dp, fno);
+        ofs = (dp->blk_ofs != FAT_DIRINDEX_NO_LFN) ? dp->blk_ofs : dp->dptr;
+        buf[cnt].hash = fatfs_dirindex_hash(fno->fname, strlen(fno->fname));
+        buf[cnt++].ofs = ofs;
+#if FF_USE_LFN
+        if ((fno->altname[0] != '\0') && (strcasecmp(fno->altname, fno->fname) != 0)) {
+            buf[cnt].hash = fatfs_dirindex_hash(fno->altname, strlen(fno->altname));
+            buf[cnt++].ofs = ofs;
+        }
+#endif
+        result = dir_next(dp, 0);
+    }
+    if (result != FR_NO_FILE) {  // 只有读到目录末尾才算扫描完整
+        free(buf);
+        return (result == FR_OK) ? FR_INT_ERR : result;
+    }
+    *names = buf;
+    *count = cnt;
+    return FR_OK;
+}
+
+/**
+ * @brief 为目录建立名称索引
+ * @details 调用者持有该卷的lock_fs，期间目录内容不会改变；扫描涉及磁盘读，不持有索引全局锁
+ */
+static FAT_DIRINDEX *fatfs_dirindex_build(DIR *dp, FILINFO *fno)
+{
+    FAT_DIRINDEX_SLOT *names = NULL;
+    FAT_DIRINDEX *idx = NULL;
+    UINT32 count = 0;
+    UINT32 slots = FAT_DIRINDEX_MIN_SLOTS;
+    UINT32 i;
+
+    if (fatfs_dirindex_scan(dp, fno, &names, &count) != FR_OK) {
+        return NULL;
+    }
+    while (slots < (count * 2)) {  // 装载因子不超过1/2
+        slots <<= 1;
+    }
+    if (slots > (UINT32)LOSCFG_FS_FAT_DIR_INDEX_SLOTS) {
+        free(names);
+        return NULL;
+    }
+    idx = (FAT_DIRINDEX *)malloc(sizeof(FAT_DIRINDEX) + slots * sizeof(FAT_DIRINDEX_SLOT));
+    if (idx == NULL) {
+        free(names);
+        return NULL;
+    }
+    idx->fs = dp->obj.fs;
+    idx->sclust = dp->obj.sclust;
+    idx->used = count;
+    idx->mask = slots - 1;
+    for (i = 0; i < slots; i++) {
+        idx->slot[i].ofs = FAT_DIRINDEX_SLOT_FREE;
+    }
+    for (i = 0; i < count; i++) {
+        fatfs_dirindex_slot_add(idx, names[i].hash, names[i].ofs);
+    }
+    free(names);
+    return idx;
+}
+
+/* 以下函数的调用者须持有g_fatDirIndexLock */
+static LOS_DL_LIST *fatfs_dirindex_bucket(const FATFS *fs, DWORD sclust)
+{
+    LOS_DL_LIST *bucket = &g_fatDirIndexBucket[(((UINTPTR)fs / sizeof(FATFS)) ^ sclust) & (FAT_DIRINDEX_BUCKETS - 1)];
+
+    if (bucket->pstNext == NULL) {  // 静态数组首次使用时初始化
+        LOS_ListInit(bucket);
+    }
+    return bucket;
+}
+
+static FAT_DIRINDEX *fatfs_dirindex_get(const FATFS *fs, DWORD sclust)
+{
+    FAT_DIRINDEX *idx = NULL;
+
+    LOS_DL_LIST_FOR_EACH_ENTRY(idx, fatfs_dirindex_bucket(fs, sclust), FAT_DIRINDEX, bucket) {
+        if ((idx->fs == fs) && (idx->sclust == sclust)) {
+            LOS_ListDelete(&idx->lru);
+            LOS_ListAdd(&g_fatDirIndexLru, &idx->lru);  // 移到LRU表头
+            return idx;
+        }
+    }
+    return NULL;
+}
+
+static void fatfs_dirindex_free(FAT_DIRINDEX *idx)
+{
+    LOS_ListDelete(&idx->lru);
+    LOS_ListDelete(&idx->bucket);
+    g_fatDirIndexSlots -= idx->mask + 1;
+    free(idx);
+}
+
+static void fatfs_dirindex_add(FAT_DIRINDEX *idx)
+{
+    UINT32 slots = idx->mask + 1;
+
+    while ((g_fatDirIndexSlots + slots) > (UINT32)LOSCFG_FS_FAT_DIR_INDEX_SLOTS) {
+        fatfs_dirindex_free(LOS_DL_LIST_ENTRY(g_fatDirIndexLru.pstPrev, FAT_DIRINDEX, lru));  // 淘汰最久未用的索引
+    }
+    LOS_ListAdd(&g_fatDirIndexLru, &idx->lru);
+    LOS_ListAdd(fatfs_dirindex_bucket(idx->fs, idx->sclust), &idx->bucket);
+    g_fatDirIndexSlots += slots;
+}
+
+static UINT32 fatfs_dirindex_cand(const FAT_DIRINDEX *idx, DWORD hash, DWORD *cand)
+{
+    UINT32 i = hash & idx->mask;
+    UINT32 n = 0;
+
+    while (idx->slot[i].ofs != FAT_DIRINDEX_SLOT_FREE) {
+        if (idx->slot[i].hash == hash) {
+            if (n == FAT_DIRINDEX_MAX_CAND) {
+                return FAT_DIRINDEX_MAX_CAND + 1;  // 冲突过多，交给dir_find
+            }
+            cand[n++] = idx->slot[i].ofs;
+        }
+        i = (i + 1) & idx->mask;
+    }
+    return n;
+}
+
+/**
+ * @brief 通过目录名称索引查找目录项
+ * @details 目录尚无索引时先扫描建立。哈希命中的目录项逐个读回校验名称，
+ *          校验时目录项组位置不符说明索引已过期，作废后交给dir_find
+ * @param dp   目录对象，obj.fs与obj.sclust指定被查找的目录
+ * @param name 要查找的名称(不要求以'\0'结尾)
+ * @param len  名称长度
+ * @param fno  临时文件信息结构体
+ * @return FR_OK - 找到，dp已定位到该目录项(与dir_find返回时一致)；
+ *         FR_NO_FILE - 确定不存在；
+ *         其他 - 索引无法给出结论。索引会覆盖fs->lfnbuf，调用者须重新create_name后调用dir_find
+ */
+FRESULT fatfs_dirindex_find(DIR *dp, const char *name, size_t len, FILINFO *fno)
+{
+    DWORD cand[FAT_DIRINDEX_MAX_CAND];  // 候选目录项组偏移
+    FAT_DIRINDEX *idx = NULL;
+    FAT_DIRINDEX *newIdx = NULL;
+    DWORD hash;
+    UINT32 n;
+    UINT32 i;
+    BOOL ascii = FALSE;
+
+    if (!fatfs_dirindex_name_ok(name, len, &ascii)) {
+        return FR_INVALID_NAME;
+    }
+    hash = fatfs_dirindex_hash(name, len);
+
+    (void)pthread_mutex_lock(&g_fatDirIndexLock);
+    idx = fatfs_dirindex_get(dp->obj.fs, dp->obj.sclust);
+    if (idx == NULL) {
+        (void)pthread_mutex_unlock(&g_fatDirIndexLock);
+        newIdx = fatfs_dirindex_build(dp, fno);
+        if (newIdx == NULL) {
+            return FR_INT_ERR;
+        }
+        (void)pthread_mutex_lock(&g_fatDirIndexLock);
+        fatfs_dirindex_add(newIdx);
+        idx = newIdx;
+    }
+    n = fatfs_dirindex_cand(idx, hash, cand);  // 拷贝候选后即可释放全局锁，索引可能随后被其他卷淘汰
+    (void)pthread_mutex_unlock(&g_fatDirIndexLock);
+    if (n > FAT_DIRINDEX_MAX_CAND) {
+        return FR_INT_ERR;
+    }
+
+    for (i = 0; i < n; i++) {
+        if ((dir_sdi(dp, cand[i]) != FR_OK) || (dir_read(dp, 0) != FR_OK) ||
+            (((dp->blk_ofs != FAT_DIRINDEX_NO_LFN) ? dp->blk_ofs : dp->dptr) != cand[i])) {
+            fatfs_dirindex_invalidate(dp->obj.fs, dp->obj.sclust);  // 索引与磁盘不一致
+            return FR_INT_ERR;
+        }
+        get_fileinfo(dp, fno);
+        if (fatfs_dirindex_name_eq(fno->fname, name, len)) {
+            return FR_OK;
+        }
+#if FF_USE_LFN
+        if (fatfs_dirindex_name_eq(fno->altname, name, len)) {
+            return FR_OK;
+        }
+#endif
+    }
+    /* 非ASCII名称可能与目录项只差代码页内的大小写，未命中时不能断定不存在 */
+    return ascii ? FR_NO_FILE : FR_INT_ERR;
+}
+
+/**
+ * @brief 把新建的目录项加入所在目录的名称索引
+ * @details 目录项已写入且已读回到fno之后调用，调用者持有该卷的lock_fs。目录尚无索引时不做处理，
+ *          第一次查找时再建立；插入后装载因子会超过1/2时作废索引，下次查找时按新大小重建
+ * @param fs     卷
+ * @param sclust 所在目录的起始簇号
+ * @param ofs    目录项组起始偏移，即dir_ofs()的结果
+ * @param fno    读回的文件信息，提供长文件名与短文件名
+ */
+void fatfs_dirindex_insert(const FATFS *fs, DWORD sclust, DWORD ofs, const FILINFO *fno)
+{
+    FAT_DIRINDEX *idx = NULL;
+    UINT32 need = 1;
+
+#if FF_USE_LFN
+    if ((fno->altname[0] != '\0') && (strcasecmp(fno->altname, fno->fname) != 0)) {
+        need++;
+    }
+#endif
+    (void)pthread_mutex_lock(&g_fatDirIndexLock);
+    idx = fatfs_dirindex_get(fs, sclust);
+    if (idx != NULL) {
+        if (((idx->used + need) * 2) > (idx->mask + 1)) {
+            fatfs_dirindex_free(idx);
+        } else {
+            fatfs_dirindex_slot_add(idx, fatfs_dirindex_hash(fno->fname, strlen(fno->fname)), ofs);
+#if FF_USE_LFN
+            if (need > 1) {
+                fatfs_dirindex_slot_add(idx, fatfs_dirindex_hash(fno->altname, strlen(fno->altname)), ofs);
+            }
+#endif
+            idx->used += need;
+        }
+    }
+    (void)pthread_mutex_unlock(&g_fatDirIndexLock);
+}
+
+/**
+ * @brief 作废一个目录的名称索引
+ * @details 在目录中删除或重命名目录项，以及删除目录本身时调用，调用者持有该卷的lock_fs
+ */
+void fatfs_dirindex_invalidate(const FATFS *fs, DWORD sclust)
+{
+    FAT_DIRINDEX *idx = NULL;
+
+    (void)pthread_mutex_lock(&g_fatDirIndexLock);
+    idx = fatfs_dirindex_get(fs, sclust);
+    if (idx != NULL) {
+        fatfs_dirindex_free(idx);
+    }
+    (void)pthread_mutex_unlock(&g_fatDirIndexLock);
+}
+
+/**
+ * @brief 作废一个卷的全部名称索引，卸载卷时调用
+ */
+void fatfs_dirindex_drop(const FATFS *fs)
+{
+    FAT_DIRINDEX *idx = NULL;
+    FAT_DIRINDEX *next = NULL;
+
+    (void)pthread_mutex_lock(&g_fatDirIndexLock);
+    LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(idx, next, &g_fatDirIndexLru, FAT_DIRINDEX, lru) {
+        if (idx->fs == fs) {
+            fatfs_dirindex_free(idx);
+        }
+    }
+    (void)pthread_mutex_unlock(&g_fatDirIndexLock);
+}
+#endif /* LOSCFG_FS_FAT_DIR_INDEX */
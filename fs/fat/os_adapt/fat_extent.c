@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fatfs.h"
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+#include "diskio.h"
+#include "securec.h"
+
+/*
+ * 文件簇链区段缓存
+ * FatFs的f_read/f_write/f_lseek每跨过一个簇都要通过get_fat查一次FAT表，且一次磁盘请求最多
+ * 传输一个簇。这里为每个打开的文件缓存簇链中连续的簇区段(文件内簇序号 -> 簇号，连续簇数)，
+ * 读写中扇区对齐的部分按区段直接下发多扇区请求，定位时直接由区段算出目标簇。
+ * 区段缓存覆盖文件中连续的一段簇序号，顺序访问时向后扩展，已满时丢弃较早的一半区段；
+ * 访问位置早于缓存覆盖范围时从起始簇重新建立。调用者均持有该卷的lock_fs。
+ * 直接读写不改动FatFs私有的文件状态标志：读取时以扇区缓冲区fp->buf中的内容为准，写入时同步更新
+ * 缓冲区，需要写回缓冲区时调用f_sync；直接写入后的目录项由调用者写回。
+ */
+
+/**
+ * @brief 清空文件的区段缓存
+ */
+void fatfs_extent_reset(FIL *fp)
+{
+    FAT_FIL_EXTENT(fp)->num = 0;
+}
+
+/**
+ * @brief 清空一个文件所有打开实例的区段缓存
+ * @details 簇链被截断或重新分配后调用。各实例的当前簇与缓冲区扇区可能已被释放，
+ *          标记为失效，下次读写或定位前按读写位置重新定位
+ */
+void fatfs_extent_invalidate(FILINFO *finfo)
+{
+    FIL *entry = NULL;
+
+    LOS_DL_LIST_FOR_EACH_ENTRY(entry, &finfo->fp_list, FIL, fp_entry) {
+        fatfs_extent_reset(entry);
+        FAT_FIL_EXTENT(entry)->stale = TRUE;
+    }
+}
+
+static FAT_EXTENT *fatfs_extent_push(FAT_EXTENT_CACHE *cache, DWORD fclust, DWORD clust)
+{
+    FAT_EXTENT *ext = NULL;
+    UINT32 keep;
+
+    if (cache->num == LOSCFG_FS_FAT_EXTENT_NUM) {  // 缓存已满，丢弃较早的一半区段
+        keep = cache->num / 2;
+        (void)memmove_s(&cache->ext[0], sizeof(cache->ext), &cache->ext[cache->num - keep],
+                        keep * sizeof(FAT_EXTENT));
+        cache->num = keep;
+    }
+    ext = &cache->ext[cache->num++];
+    ext->fclust = fclust;
+    ext->clust = clust;
+    ext->count = 1;
+    return ext;
+}
+
+/**
+ * @brief 读取簇链中的下一簇
+ * @return FR_OK - 成功，FR_NO_FILE - 簇链结束，其他 - 错误
+ */
+static FRESULT fatfs_extent_next(FIL *fp, DWORD clust, DWORD *next)
+{
+    DWORD nclust = get_fat(&fp->obj, clust);
+
+    if ((nclust == BAD_CLUSTER) || (nclust == DISK_ERROR)) {
+        return FR_DISK_ERR;
+    }
+    if (nclust < 2) {  // 0为空闲簇、1为内部错误，都不应出现在簇链中
+        return FR_INT_ERR;
+    }
+    if (nclust >= fp->obj.fs->n_fatent) {  // 簇链结束标记
+        return FR_NO_FILE;
+    }
+    *next = nclust;
+    return FR_OK;
+}
+
+/**
+ * @brief 由文件内簇序号查找簇号
+ * @details 缓存未覆盖时沿簇链向后扩展缓存，至少解析到fclust + want - 1或目标簇所在区段结束
+ * @param fp     文件对象
+ * @param fclust 文件内簇序号
+ * @param want   调用者需要的簇数，用于向后预读连续簇
+ * @param clust  输出参数，目标簇号
+ * @param run    输出参数，从目标簇开始的连续簇数
+ * @return FR_OK - 成功，FR_NO_FILE - 簇链在目标簇之前结束，其他 - 错误
+ */
+static FRESULT fatfs_extent_map(FIL *fp, DWORD fclust, DWORD want, DWORD *clust, DWORD *run)
+{
+    FAT_EXTENT_CACHE *cache = FAT_FIL_EXTENT(fp);
+    FAT_EXTENT *ext = NULL;
+    DWORD cur;      // 已解析的最后一簇
+    DWORD pos;      // 已解析的最后一簇的文件内簇序号
+    DWORD next;
+    UINT32 i;
+    FRESULT result;
+
+    if ((cache->num == 0) || (cache->sclust != fp->obj.sclust) || (fclust < cache->ext[0].fclust)) {
+        if (fp->obj.sclust == 0) {
+            return FR_NO_FILE;
+        }
+        cache->sclust = fp->obj.sclust;  // 从起始簇重新建立
+        cache->num = 0;
+        (void)fatfs_extent_push(cache, 0, fp->obj.sclust);
+    }
+
+    ext = &cache->ext[cache->num - 1];
+    cur = ext->clust + ext->count - 1;
+    pos = ext->fclust + ext->count - 1;
+    while (pos < (fclust + want - 1)) {
+        result = fatfs_extent_next(fp, cur, &next);
+        if ((result == FR_NO_FILE) && (pos >= fclust)) {
+            break;  // 簇链在目标簇之后结束
+        }
+        if (result != FR_OK) {
+            return result;
+        }
+        if ((next != (cur + 1)) && (pos >= fclust)) {
+            break;  // 目标簇所在区段已完整，目标簇之后的区段不必记录，避免挤出目标区段
+        }
+        pos++;
+        if (next == (cur + 1)) {
+            ext->count++;  // 与上一簇连续，扩展当前区段
+        } else {
+            ext = fatfs_extent_push(cache, pos, next);
+        }
+        cur = next;
+    }
+
+    for (i = cache->num; i > 0; i--) {  // 区段按文件内簇序号递增排列，从后向前查找
+        ext = &cache->ext[i - 1];
+        if (fclust >= ext->fclust) {
+            *clust = ext->clust + (fclust - ext->fclust);
+            *run = ext->count - (fclust - ext->fclust);
+            return FR_OK;
+        }
+    }
+    return FR_INT_ERR;
+}
+
+/**
+ * @brief 为文件分配簇，使簇链至少包含文件内簇序号fclust
+ */
+static FRESULT fatfs_extent_alloc(FIL *fp, DWORD fclust)
+{
+    FAT_EXTENT_CACHE *cache = FAT_FIL_EXTENT(fp);
+    FAT_EXTENT *ext = NULL;
+    DWORD clust;
+    DWORD run;
+    DWORD cur;
+    DWORD pos;
+    FRESULT result;
+
+    if (fp->obj.sclust == 0) {  // 空文件，先创建簇链
+        clust = create_chain(&fp->obj, 0);
+        if (clust == 0) {
+            return FR_NO_SPACE_LEFT;
+        }
+        if ((clust == 1) || (clust == DISK_ERROR)) {
+            return FR_DISK_ERR;
+        }
+        fp->obj.sclust = clust;  // 起始簇变化，由调用者写回目录项
+    }
+    result = fatfs_extent_map(fp, fclust, 1, &clust, &run);
+    if (result != FR_NO_FILE) {
+        return result;
+    }
+
+    ext = &cache->ext[cache->num - 1];  // 簇链已解析到结尾，从最后一簇向后扩展
+    cur = ext->clust + ext->count - 1;
+    pos = ext->fclust + ext->count - 1;
+    while (pos < fclust) {
+        clust = create_chain(&fp->obj, cur);
+        if (clust == 0) {
+            return FR_NO_SPACE_LEFT;
+        }
+        if ((clust == 1) || (clust == DISK_ERROR)) {
+            return FR_DISK_ERR;
+        }
+        pos++;
+        if (clust == (cur + 1)) {
+            ext->count++;
+        } else {
+            ext = fatfs_extent_push(cache, pos, clust);
+        }
+        cur = clust;
+    }
+    return FR_OK;
+}
+
+/**
+ * @brief 读取文件数据
+ * @details 与f_read语义一致。扇区对齐的部分按簇区段一次读取多个扇区，首尾不足一个扇区的部分交给f_read
+ * @param fp   文件对象
+ * @param buff 数据缓冲区
+ * @param btr  要读取的字节数
+ * @param br   输出参数，实际读取的字节数
+ * @return FR_OK - 成功，其他 - 错误码
+ */
+FRESULT fatfs_extent_read(FIL *fp, void *buff, UINT btr, UINT *br)
+{
+    FATFS *fs = fp->obj.fs;
+    BYTE *rbuff = (BYTE *)buff;
+    DWORD bcs = (DWORD)SS(fs) * fs->csize;  // 每簇字节数
+    DWORD fclust;
+    DWORD csect;
+    DWORD clust;
+    DWORD run;
+    QWORD sect;
+    UINT cc;
+    UINT rcnt;
+    FRESULT result;
+
+    *br = 0;
+    if (fp->err != FR_OK) {
+        return (FRESULT)fp->err;
+    }
+    if (fp->fptr >= fp->obj.objsize) {
+        return FR_OK;
+    }
+    if (FAT_FIL_EXTENT(fp)->stale) {  // 簇链已改变，先按读写位置重新定位
+        result = fatfs_extent_seek(fp, fp->fptr);
+        if (result != FR_OK) {
+            return result;
+        }
+    }
+    if (btr > (fp->obj.objsize - fp->fptr)) {
+        btr = (UINT)(fp->obj.objsize - fp->fptr);  // 不超过文件末尾
+    }
+
+    if ((fp->fptr % SS(fs)) != 0) {  // 首部补齐到扇区边界
+        rcnt = SS(fs) - (UINT)(fp->fptr % SS(fs));
+        rcnt = (rcnt > btr) ? btr : rcnt;
+        result = f_read(fp, rbuff, rcnt, br);
+        if ((result != FR_OK) || (*br < rcnt)) {
+            return result;
+        }
+    }
+
+    while ((btr - *br) >= SS(fs)) {
+        fclust = (DWORD)(fp->fptr / bcs);
+        csect = (DWORD)(fp->fptr / SS(fs)) & (fs->csize - 1);
+        cc = (btr - *br) / SS(fs);
+        result = fatfs_extent_map(fp, fclust, (csect + cc + fs->csize - 1) / fs->csize, &clust, &run);
+        if (result != FR_OK) {
+            return (result == FR_NO_FILE) ? FR_INT_ERR : result;  // 簇链短于文件大小
+        }
+        if (cc > ((run * fs->csize) - csect)) {
+            cc = (run * fs->csize) - csect;  // 一次读取一个连续区段
+        }
+        sect = clst2sect(fs, clust) + csect;
+        if (disk_read(fs->pdrv, rbuff, sect, cc) != RES_OK) {
+            return FR_DISK_ERR;
+        }
+        if ((fp->sect - sect) < cc) {  // 缓冲区中的扇区可能尚未写回，以缓冲区为准
+            (void)memcpy_s(rbuff + ((fp->sect - sect) * SS(fs)), SS(fs), fp->buf, SS(fs));
+        }
+        rcnt = cc * SS(fs);
+        fp->fptr += rcnt;
+        fp->clust = clust + (DWORD)((fp->fptr - 1) / bcs) - fclust;  // 与f_read一致，指向最后读取字节所在簇
+        rbuff += rcnt;
+        *br += rcnt;
+    }
+
+    if (btr > *br) {  // 尾部不足一个扇区
+        result = f_read(fp, rbuff, btr - *br, &rcnt);
+        *br += rcnt;
+        return result;
+    }
+    return FR_OK;
+}
+
+/**
+ * @brief 写入文件数据
+ * @details 与f_write语义一致。扇区对齐的部分先分配所需的簇，再按簇区段一次写入多个扇区；
+ *          分配失败时剩余部分交给f_write，由其按FatFs的规则处理部分写入
+ * @param fp     文件对象
+ * @param buff   数据缓冲区
+ * @param btw    要写入的字节数
+ * @param bw     输出参数，实际写入的字节数
+ * @param direct 输出参数，是否绕过f_write修改了簇链或数据。为TRUE时f_sync不会写回目录项，
+ *               调用者须自行写回文件大小与起始簇
+ * @return FR_OK - 成功，其他 - 错误码
+ */
+FRESULT fatfs_extent_write(FIL *fp, const void *buff, UINT btw, UINT *bw, BOOL *direct)
+{
+    FATFS *fs = fp->obj.fs;
+    const BYTE *wbuff = (const BYTE *)buff;
+    DWORD bcs = (DWORD)SS(fs) * fs->csize;  // 每簇字节数
+    DWORD fclust;
+    DWORD csect;
+    DWORD want;
+    DWORD clust;
+    DWORD run;
+    QWORD sect;
+    UINT cc;
+    UINT wcnt;
+    FRESULT result;
+
+    *bw = 0;
+    *direct = FALSE;
+    if (fp->err != FR_OK) {
+        return (FRESULT)fp->err;
+    }
+    if (FAT_FIL_EXTENT(fp)->stale) {  // 簇链已改变，先按读写位置重新定位，位置超出文件大小时扩展文件
+        result = fatfs_extent_seek(fp, fp->fptr);
+        if (result != FR_OK) {
+            return result;
+        }
+    }
+    if ((DWORD)(fp->fptr + btw) < (DWORD)fp->fptr) {
+        return f_write(fp, buff, btw, bw);  // 超出FAT32文件大小上限，由f_write截断
+    }
+
+    if ((fp->fptr % SS(fs)) != 0) {  // 首部补齐到扇区边界
+        wcnt = SS(fs) - (UINT)(fp->fptr % SS(fs));
+        wcnt = (wcnt > btw) ? btw : wcnt;
+        result = f_write(fp, wbuff, wcnt, bw);
+        if ((result != FR_OK) || (*bw < wcnt)) {
+            return result;
+        }
+    }
+
+    while ((btw - *bw) >= SS(fs)) {
+        fclust = (DWORD)(fp->fptr / bcs);
+        csect = (DWORD)(fp->fptr / SS(fs)) & (fs->csize - 1);
+        cc = (btw - *bw) / SS(fs);
+        want = (csect + cc + fs->csize - 1) / fs->csize;
+        *direct = TRUE;
+        if (fatfs_extent_alloc(fp, fclust + want - 1) != FR_OK) {
+            break;  // 空间不足等情况交给f_write处理
+        }
+        result = fatfs_extent_map(fp, fclust, want, &clust, &run);
+        if (result != FR_OK) {
+            return (result == FR_NO_FILE) ? FR_INT_ERR : result;
+        }
+        if (cc > ((run * fs->csize) - csect)) {
+            cc = (run * fs->csize) - csect;  // 一次写入一个连续区段
+        }
+        sect = clst2sect(fs, clust) + csect;
+        if (disk_write(fs->pdrv, wbuff, sect, cc) != RES_OK) {
+            return FR_DISK_ERR;
+        }
+        if ((fp->sect - sect) < cc) {  // 缓冲区中的扇区已被覆盖，以新数据为准；缓冲区为脏时之后写回的也是新数据
+            (void)memcpy_s(fp->buf, SS(fs), wbuff + ((fp->sect - sect) * SS(fs)), SS(fs));
+        }
+        wcnt = cc * SS(fs);
+        fp->fptr += wcnt;
+        fp->clust = clust + (DWORD)((fp->fptr - 1) / bcs) - fclust;  // 与f_write一致，指向最后写入字节所在簇
+        if (fp->fptr > fp->obj.objsize) {
+            fp->obj.objsize = fp->fptr;
+        }
+        wbuff += wcnt;
+        *bw += wcnt;
+    }
+
+    if (btw > *bw) {  // 尾部不足一个扇区，或分配失败后的剩余部分
+        result = f_write(fp, wbuff, btw - *bw, &wcnt);
+        *bw += wcnt;
+        return result;
+    }
+    return FR_OK;
+}
+
+/**
+ * @brief 移动文件读写位置
+ * @details 与f_lseek语义一致。文件范围内的定位由区段缓存直接得到目标簇，超出文件大小的扩展交给f_lseek。
+ *          簇链被截断后，实例原来的当前簇与缓冲区扇区不再可信，从文件开头重新定位
+ * @param fp  文件对象
+ * @param ofs 新的读写位置
+ * @return FR_OK - 成功，其他 - 错误码
+ */
+FRESULT fatfs_extent_seek(FIL *fp, FSIZE_t ofs)
+{
+    FATFS *fs = fp->obj.fs;
+    DWORD bcs = (DWORD)SS(fs) * fs->csize;  // 每簇字节数
+    DWORD fclust;
+    DWORD clust;
+    DWORD run;
+    QWORD sect;
+    FRESULT result;
+
+    if (fp->err != FR_OK) {
+        return (FRESULT)fp->err;
+    }
+    if (FAT_FIL_EXTENT(fp)->stale) {  // 每次文件操作结束时都已f_sync，缓冲区不为脏，可直接丢弃
+        FAT_FIL_EXTENT(fp)->stale = FALSE;
+        fp->fptr = 0;
+        fp->sect = 0;
+    }
+    if ((ofs == 0) || (ofs > fp->obj.objsize)) {
+        return f_lseek(fp, ofs);
+    }
+
+    fclust = (DWORD)((ofs - 1) / bcs);  // 簇边界上的位置对应前一簇，与f_lseek一致
+    result = fatfs_extent_map(fp, fclust, 1, &clust, &run);
+    if (result != FR_OK) {
+        return (result == FR_NO_FILE) ? FR_INT_ERR : result;
+    }
+    fp->fptr = ofs;
+    fp->clust = clust;
+    if ((ofs % SS(fs)) != 0) {  // 位置不在扇区边界时缓冲区须为该扇区
+        sect = clst2sect(fs, clust) + ((DWORD)(ofs / SS(fs)) & (fs->csize - 1));
+        if (sect != fp->sect) {
+            result = f_sync(fp);  // 换入新扇区前写回缓冲区
+            if (result != FR_OK) {
+                return result;
+            }
+            if (disk_read(fs->pdrv, fp->buf, sect, 1) != RES_OK) {
+                return FR_DISK_ERR;
+            }
+            fp->sect = sect;
+        }
+    }
+    return FR_OK;
+}
+#endif /* LOSCFG_FS_FAT_EXTENT_CACHE */
@@ -564,6 +564,9 @@ static int fatfs_create_obj(struct Vnode *parent, const char *name, int mode, st
     }
     dp_new->blk_ofs = dir_ofs(dp_new);  // 设置块偏移
     get_fileinfo(dp_new, finfo_new);  // 获取文件信息
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_insert(fs, finfo->sclst, dp_new->blk_ofs, finfo_new);  // 新目录项加入父目录索引
+#endif
     if (type == AM_ARC) {  // 普通文件
         dp_new->obj.objsize = 0;  // 对象大小设为0
     } else if (type == AM_LNK) {  // 符号链接
@@ -604,6 +607,9 @@ static int fatfs_create_obj(struct Vnode *parent, const char *name, int mode, st
 
 ERROR_REMOVE_CHAIN:
     remove_chain(&(dp_new->obj), clust, 0);  // 移除已分配的簇链
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_invalidate(fs, finfo->sclst);  // 目录项可能已部分写入但未加入索引
+#endif
 ERROR_UNLOCK:
     unlock_fs(fs, result);  // 解锁文件系统
     FREE_NAMBUF();  // 释放文件名缓冲区
@@ -632,6 +638,9 @@ int fatfs_lookup(struct Vnode *parent, const char *path, int len, struct Vnode *
     DWORD hash;                       // 哈希值
     FRESULT result;                   // FatFs操作结果
     int ret;                          // 返回值
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    const char *name = path;          // 文件名起始位置，索引无法给出结论时重新解析
+#endif
 
     /* 分配目录文件结构体 */
     dfp = (DIR_FILE *)zalloc(sizeof(DIR_FILE));
@@ -659,7 +668,18 @@ int fatfs_lookup(struct Vnode *parent, const char *path, int len, struct Vnode *
         goto ERROR_UNLOCK;  // 跳转到解锁
     }
 
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    result = fatfs_dirindex_find(dp, name, len, finfo);  // 先通过目录名称索引查找
+    if ((result != FR_OK) && (result != FR_NO_FILE)) {  // 索引无法给出结论
+        path = name;
+        result = create_name(dp, &path);  // 索引覆盖了文件名缓冲区，重新解析
+        if (result == FR_OK) {
+            result = dir_find(dp);  // 线性查找目录项
+        }
+    }
+#else
     result = dir_find(dp);  // 查找目录项
+#endif
     if (result != FR_OK) {  // 查找失败
         ret = fatfs_2_vfs(result);  // 转换错误码
         goto ERROR_UNLOCK;  // 跳转到解锁
@@ -757,7 +777,7 @@ int fatfs_open(struct file *filep)
     int ret;  // 返回值
 
     /* 分配文件结构体(包含扇区大小的缓冲区) */
-    fp = (FIL *)zalloc(sizeof(FIL) + SS(fs));
+    fp = (FIL *)zalloc(sizeof(FIL) + FAT_FIL_PRIV_SIZE + SS(fs));
     if (fp == NULL) {  // 分配失败
         ret = ENOMEM;  // 内存不足
         goto ERROR_EXIT;  // 跳转到错误处理
@@ -782,7 +802,7 @@ int fatfs_open(struct file *filep)
     fp->err = 0;  // 错误码
     fp->sect = 0;  // 当前扇区
     fp->fptr = 0;  // 文件指针
-    fp->buf = (BYTE *)fp + sizeof(FIL);  // 数据缓冲区
+    fp->buf = (BYTE *)fp + sizeof(FIL) + FAT_FIL_PRIV_SIZE;  // 数据缓冲区
     LOS_ListAdd(&finfo->fp_list, &fp->fp_entry);  // 添加到文件指针列表
     unlock_fs(fs, FR_OK);  // 解锁文件系统
 
@@ -856,7 +876,11 @@ int fatfs_read(struct file *filep, char *buff, size_t count)
     }
     fp->obj.objsize = finfo->fsize;  // 更新对象大小
     fp->obj.sclust = finfo->sclst;  // 更新起始簇号
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+    result = fatfs_extent_read(fp, buff, count, &rcount);  // 按簇区段读取数据
+#else
     result = f_read(fp, buff, count, &rcount);  // 读取数据
+#endif
     if (result != FR_OK) {  // 读取失败
         goto EXIT;  // 跳转到解锁
     }
@@ -969,7 +993,11 @@ off64_t fatfs_lseek64(struct file *filep, off64_t offset, int whence)
     fp->obj.sclust = finfo->sclst;       // 更新文件对象起始簇
     fp->obj.objsize = finfo->fsize;      // 更新文件对象大小
 
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+    result = fatfs_extent_seek(fp, fpos); // 由簇区段缓存定位文件指针
+#else
     result = f_lseek(fp, fpos);          // 调用FatFs库函数定位文件指针
+#endif
     finfo->fsize = fp->obj.objsize;      // 更新文件大小信息
     finfo->sclst = fp->obj.sclust;       // 更新文件起始簇信息
     if (result != FR_OK) {               // 检查定位是否成功
@@ -1050,6 +1078,10 @@ int fatfs_write(struct file *filep, const char *buff, size_t count)
     size_t wcount;                       // 实际写入字节数
     FRESULT result;                      // 函数返回结果
     int ret;                             // 临时返回值
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+    BOOL direct = FALSE;                 // 是否绕过f_write直接修改了簇链或数据
+    FRESULT dirResult;                   // 目录项写回结果
+#endif
 
     ret = lock_fs(fs);                   // 锁定文件系统
     if (ret == FALSE) {                  // 检查锁定是否成功
@@ -1057,7 +1089,17 @@ int fatfs_write(struct file *filep, const char *buff, size_t count)
     }
     fp->obj.objsize = finfo->fsize;      // 更新文件对象大小
     fp->obj.sclust = finfo->sclst;       // 更新文件对象起始簇
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+    result = fatfs_extent_write(fp, buff, count, &wcount, &direct); // 按簇区段写入数据
+    if (direct) {                        // 直接写入未经f_write，f_sync不会写回目录项
+        finfo->fsize = fp->obj.objsize;  // 写入失败时也记录已分配的簇链
+        finfo->sclst = fp->obj.sclust;
+        dirResult = update_dir(&(((DIR_FILE *)vp->data)->f_dir), finfo);
+        result = (result == FR_OK) ? dirResult : result;
+    }
+#else
     result = f_write(fp, buff, count, &wcount); // 调用FatFs库函数写入数据
+#endif
     if (result != FR_OK) {               // 检查写入是否成功
         goto ERROR_EXIT;                 // 失败则跳转到错误处理
     }
@@ -1268,6 +1310,9 @@ int fatfs_truncate64(struct Vnode *vp, off64_t len)
     object.fs = fs;                             // 设置文件系统对象
     // 重新分配簇链以匹配目标大小
     result = realloc_cluster(finfo, &object, (FSIZE_t)len);
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+    fatfs_extent_invalidate(finfo);             // 簇链已改变，清空打开实例的区段缓存
+#endif
     if (result != FR_OK) {                      // 检查重新分配是否成功
         goto ERROR_UNLOCK;                      // 失败则跳转到错误处理
     }
@@ -1572,6 +1617,9 @@ int fatfs_umount(struct Mount *mnt, struct Vnode **blkdriver)
     if (ret == FALSE) {                 // 检查删除是否成功
         return -EINVAL;                 // 返回参数错误
     }
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_drop(fs);            // 释放该卷的目录名称索引
+#endif
     free(fs);                           // 释放文件系统对象
 
     *blkdriver = device;                // 设置输出块设备指针
@@ -2130,12 +2178,21 @@ int fatfs_rename(struct Vnode *old_vnode, struct Vnode *new_parent, const char *
         goto ERROR_FREE;  // 跳转到释放内存
     }
     result = dir_find(dp_new);  // 查找目录
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_invalidate(fs, dp_old->obj.sclust);  // 新旧父目录内容即将改变
+    fatfs_dirindex_invalidate(fs, dp_new->obj.sclust);
+#endif
     if (result == FR_OK) {  // 新路径已存在
         get_fileinfo(dp_new, finfo_new);  // 获取新路径文件信息
         result = rename_check(dp_new, finfo_new, dp_old, finfo_old);  // 重命名检查
         if (result != FR_OK) {
             goto ERROR_FREE;  // 跳转到释放内存
         }
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+        if (finfo_new->fattrib & AM_DIR) {
+            fatfs_dirindex_invalidate(fs, finfo_new->sclst);  // 被覆盖的空目录即将删除
+        }
+#endif
         result = dir_remove(dp_old);  // 删除旧路径目录项
         if (result != FR_OK) {
             goto ERROR_FREE;  // 跳转到释放内存
@@ -2427,6 +2484,10 @@ int fatfs_rmdir(struct Vnode *parent, struct Vnode *vp, const char *name)
         result = FR_NO_EMPTY_DIR;  // 设置目录非空错误
         goto ERROR_UNLOCK;  // 跳转到解锁
     }
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_invalidate(fs, dp->obj.sclust);  // 父目录内容即将改变
+    fatfs_dirindex_invalidate(fs, finfo->sclst);  // 被删除目录自身的索引
+#endif
     result = dir_remove(dp);  // 删除目录项
     if (result != FR_OK) {
         goto ERROR_UNLOCK;  // 跳转到解锁
@@ -2484,6 +2545,9 @@ int fatfs_unlink(struct Vnode *parent, struct Vnode *vp, const char *name)
         result = FR_TIMEOUT;  // 设置超时错误
         goto ERROR_OUT;  // 跳转到错误处理
     }
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    fatfs_dirindex_invalidate(fs, dp->obj.sclust);  // 父目录内容即将改变
+#endif
     result = dir_remove(dp);  // 删除目录项
     if (result != FR_OK) {  // 目录项删除失败
         goto ERROR_UNLOCK;  // 跳转到解锁处理
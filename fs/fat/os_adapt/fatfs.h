@@ -115,6 +115,28 @@ extern "C" {
 #define FMT_ANY      0x07  // 自动选择FAT类型标志
 #define FMT_ERASE    0x08  // 格式化时擦除介质标志
 
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+/* 簇链区段：一段在磁盘上连续的簇 */
+typedef struct {
+    DWORD fclust;  // 区段首簇在文件内的簇序号
+    DWORD clust;   // 区段首簇的簇号
+    DWORD count;   // 区段包含的连续簇数
+} FAT_EXTENT;
+
+/* 打开文件的簇链区段缓存，分配在FIL结构体之后 */
+typedef struct {
+    DWORD sclust;  // 建立缓存时文件的起始簇号
+    UINT32 num;    // 有效区段数
+    BOOL stale;    // 簇链已被截断或重新分配，当前簇与缓冲区扇区须重新定位
+    FAT_EXTENT ext[LOSCFG_FS_FAT_EXTENT_NUM];
+} FAT_EXTENT_CACHE;
+
+#define FAT_FIL_EXTENT(fp)  ((FAT_EXTENT_CACHE *)((FIL *)(fp) + 1))
+#define FAT_FIL_PRIV_SIZE   sizeof(FAT_EXTENT_CACHE)  // FIL之后、数据缓冲区之前的私有数据大小
+#else
+#define FAT_FIL_PRIV_SIZE   0
+#endif
+
 extern char FatLabel[LABEL_LEN];
 
 int fatfs_2_vfs(int result);
@@ -143,6 +165,19 @@ int fatfs_mkfs(struct Vnode *device, int sectors, int option);
 int fatfs_mkdir(struct Vnode *parent, const char *name, mode_t mode, struct Vnode **vpp);
 int fatfs_rmdir(struct Vnode *parent, struct Vnode *vp, const char *name);
 int fatfs_unlink(struct Vnode *parent, struct Vnode *vp, const char *name);
+#ifdef LOSCFG_FS_FAT_EXTENT_CACHE
+FRESULT fatfs_extent_read(FIL *fp, void *buff, UINT btr, UINT *br);
+FRESULT fatfs_extent_write(FIL *fp, const void *buff, UINT btw, UINT *bw, BOOL *direct);
+FRESULT fatfs_extent_seek(FIL *fp, FSIZE_t ofs);
+void fatfs_extent_reset(FIL *fp);
+void fatfs_extent_invalidate(FILINFO *finfo);
+#endif
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+FRESULT fatfs_dirindex_find(DIR *dp, const char *name, size_t len, FILINFO *fno);
+void fatfs_dirindex_insert(const FATFS *fs, DWORD sclust, DWORD ofs, const FILINFO *fno);
+void fatfs_dirindex_invalidate(const FATFS *fs, DWORD sclust);
+void fatfs_dirindex_drop(const FATFS *fs);
+#endif
 int fatfs_ioctl(struct file *filep, int req, unsigned long arg);
 int fatfs_fscheck(struct Vnode* vnode, struct fs_dirent_s *dir);
 
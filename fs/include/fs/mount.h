@@ -78,6 +78,7 @@ struct Mount {
     void *data;                        /*! private data | 私有数据,可使用这个成员作为一个指向它们自己内部数据的指针*/	
     uint32_t hashseed;                 /*! Random seed for vfs hash | vfs 哈希随机种子*/ 
     unsigned long mountFlags;          /*! Flags for mount | 挂载标签*/	
+    Atomic unmounting;                 /*! set while unmounting, blocks lockless pins | 卸载中标志，置位后无锁路径查找不再钉住该挂载下的vnode*/
     char pathName[PATH_MAX];           /*! path name of mount point | 挂载点路径名称  /bin1/vs/sd*/	
     char devName[PATH_MAX];            /*! path name of dev point | 设备名称 /dev/mmcblk0p0*/		
 };
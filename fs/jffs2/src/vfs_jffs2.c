@@ -79,6 +79,7 @@
 #include "los_config.h"
 #include "los_typedef.h"
 #include "los_mux.h"
+#include "los_rwlock.h"
 #include "los_tables.h"
 #include "los_vm_filemap.h"
 #include "los_crc32.h"
@@ -104,8 +105,24 @@ struct VnodeOps g_jffs2Vops;
 // JFFS2文件系统的文件操作结构体
 struct file_operations_vfs g_jffs2Fops;
 
-// JFFS2文件系统操作互斥锁 (保护所有JFFS2操作的线程安全)
-static LosMux g_jffs2FsLock;  /* lock for all jffs2 ops */
+/*
+ * Locking order: g_jffs2FsLock -> partition lock -> inode lock -> jffs2 core locks
+ * (f->sem, c->alloc_sem). The jffs2 core protects its own node lists, so the locks
+ * below only guard the namespace and the VFS side inode fields (i_size, times, f_pos).
+ */
+#define JFFS2_INODE_LOCK_NUM    64      /* 条带化inode锁数量，须为2的幂 */
+#define JFFS2_INODE_LOCK_MASK   (JFFS2_INODE_LOCK_NUM - 1)
+
+#define JFFS2_LOCK_READ         0       /* 分区读锁 + inode读锁：读文件、stat、lookup、readdir */
+#define JFFS2_LOCK_WRITE        1       /* 分区读锁 + inode写锁：写文件、截断、修改属性 */
+#define JFFS2_LOCK_NAMESPACE    2       /* 分区写锁：创建、删除、重命名、链接 */
+
+// JFFS2挂载互斥锁 (串行化挂载与卸载)
+static LosMux g_jffs2FsLock;  /* lock for mount and unmount */
+// JFFS2分区锁 (每个MTD分区一把，目录树变更独占，其余操作共享)
+static LosRwlock g_jffs2PartLock[CONFIG_MTD_PATTITION_NUM];
+// JFFS2 inode锁 (按inode地址散列的条带锁，不同文件的读写互不阻塞)
+static LosRwlock g_jffs2InodeLock[JFFS2_INODE_LOCK_NUM];
 
 // JFFS2节点操作递归互斥锁 (支持递归加锁的节点操作保护)
 static pthread_mutex_t g_jffs2NodeLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
@@ -171,6 +188,63 @@ void Jffs2NodeUnlock(void)
     (void)pthread_mutex_unlock(&g_jffs2NodeLock);  // 解锁节点互斥锁
 }
 
+/**
+ * @brief   获取挂载点所在分区的分区锁
+ * @param   mnt [in] 挂载点结构体指针
+ * @return  LosRwlock* 分区读写锁
+ */
+static LosRwlock *Jffs2PartLockGet(const struct Mount *mnt)
+{
+    return &g_jffs2PartLock[((mtd_partition *)mnt->data)->patitionnum];
+}
+
+/**
+ * @brief   获取inode对应的条带锁
+ * @param   node [in] JFFS2 inode结构体指针
+ * @return  LosRwlock* inode读写锁
+ * @details 硬链接共享同一个jffs2_inode，因此按inode地址散列即可覆盖所有别名
+ */
+static LosRwlock *Jffs2InodeLockGet(const struct jffs2_inode *node)
+{
+    return &g_jffs2InodeLock[((UINTPTR)node / sizeof(struct jffs2_inode)) & JFFS2_INODE_LOCK_MASK];
+}
+
+/**
+ * @brief   按操作类型为Vnode加锁
+ * @param   vnode [in] 被操作的Vnode(命名空间操作时为父目录)
+ * @param   mode  [in] JFFS2_LOCK_READ / JFFS2_LOCK_WRITE / JFFS2_LOCK_NAMESPACE
+ * @details 命名空间操作独占分区锁，排除该分区上的所有其他操作；文件读写只共享分区锁，
+ *          再按inode加读锁或写锁，因此慢速写入和GC不会阻塞其他文件的读取
+ */
+static void Jffs2VnodeLock(struct Vnode *vnode, int mode)
+{
+    LosRwlock *partLock = Jffs2PartLockGet(vnode->originMount);
+
+    if (mode == JFFS2_LOCK_NAMESPACE) {
+        (void)LOS_RwlockWrLock(partLock, LOS_WAIT_FOREVER);
+        return;
+    }
+    (void)LOS_RwlockRdLock(partLock, LOS_WAIT_FOREVER);
+    if (mode == JFFS2_LOCK_WRITE) {
+        (void)LOS_RwlockWrLock(Jffs2InodeLockGet(vnode->data), LOS_WAIT_FOREVER);
+    } else {
+        (void)LOS_RwlockRdLock(Jffs2InodeLockGet(vnode->data), LOS_WAIT_FOREVER);
+    }
+}
+
+/**
+ * @brief   释放Jffs2VnodeLock获取的锁
+ * @param   vnode [in] 加锁时使用的Vnode
+ * @param   mode  [in] 加锁时使用的模式
+ */
+static void Jffs2VnodeUnlock(struct Vnode *vnode, int mode)
+{
+    if (mode != JFFS2_LOCK_NAMESPACE) {
+        (void)LOS_RwlockUnLock(Jffs2InodeLockGet(vnode->data));
+    }
+    (void)LOS_RwlockUnLock(Jffs2PartLockGet(vnode->originMount));
+}
+
 /**
  * @brief   绑定并挂载JFFS2文件系统
  * @param   mnt        [in/out] 挂载点结构体指针
@@ -257,8 +331,10 @@ int VfsJffs2Unbind(struct Mount *mnt, struct Vnode **blkDriver)
     }
 
     partNo = p->patitionnum;            // 获取分区号
-    // 卸载JFFS2文件系统
+    // 卸载JFFS2文件系统，独占分区锁以等待该分区上的操作结束
+    (void)LOS_RwlockWrLock(&g_jffs2PartLock[partNo], LOS_WAIT_FOREVER);
     ret = jffs2_umount((struct jffs2_inode *)mnt->vnodeCovered->data);
+    (void)LOS_RwlockUnLock(&g_jffs2PartLock[partNo]);
     if (ret) {                          // 卸载失败
         LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
         return ret;                     // 返回卸载错误码
@@ -280,21 +356,19 @@ int VfsJffs2Unbind(struct Mount *mnt, struct Vnode **blkDriver)
  * @param   ppVnode     [out] 查找到的Vnode指针的指针
  * @return  int 成功返回0，失败返回错误码
  * @details 在指定父目录下查找文件，若找到则创建或复用Vnode并返回
+ * @note    调用者须持有分区锁
  */
-int VfsJffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct Vnode **ppVnode)
+static int Jffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct Vnode **ppVnode)
 {
     int ret;                           // 函数返回值
     struct Vnode *newVnode = NULL;     // 新Vnode指针
     struct jffs2_inode *node = NULL;   // JFFS2 inode指针
     struct jffs2_inode *parentNode = NULL;  // 父目录inode指针
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
-
     parentNode = (struct jffs2_inode *)parentVnode->data;  // 获取父目录inode
     // 在父目录中查找指定路径的文件
     node = jffs2_lookup(parentNode, (const unsigned char *)path, len);
     if (!node) {                        // 未找到文件
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
         return -ENOENT;                 // 返回文件不存在错误
     }
 
@@ -306,7 +380,6 @@ int VfsJffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct
         }
         newVnode->parent = parentVnode;  // 设置父Vnode
         *ppVnode = newVnode;            // 返回找到的Vnode
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
         return 0;                       // 查找成功
     }
     // 分配新的Vnode
@@ -314,7 +387,6 @@ int VfsJffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct
     if (ret != 0) {                     // 分配失败
         PRINT_ERR("%s-%d, ret: %x\n", __FUNCTION__, __LINE__, ret);  // 打印错误
         (void)jffs2_iput(node);         // 减少inode引用计数
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
         return ret;                     // 返回错误码
     }
 
@@ -331,10 +403,29 @@ int VfsJffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct
 
     *ppVnode = newVnode;                // 返回新创建的Vnode
 
-    LOS_MuxUnlock(&g_jffs2FsLock);      // 释放文件系统锁
     return 0;                           // 查找成功
 }
 
+/**
+ * @brief   VFS接口：在JFFS2文件系统中查找文件/目录
+ * @param   parentVnode [in]  父目录Vnode指针
+ * @param   path        [in]  要查找的路径名
+ * @param   len         [in]  路径名长度
+ * @param   ppVnode     [out] 查找到的Vnode指针的指针
+ * @return  int 成功返回0，失败返回错误码
+ * @details 查找只持有分区读锁，可与其他文件的读写并发；同名Vnode的查找与插入
+ *          由VFS层的VnodeHold串行化
+ */
+int VfsJffs2Lookup(struct Vnode *parentVnode, const char *path, int len, struct Vnode **ppVnode)
+{
+    int ret;                           // 函数返回值
+
+    Jffs2VnodeLock(parentVnode, JFFS2_LOCK_READ);  // 加锁
+    ret = Jffs2Lookup(parentVnode, path, len, ppVnode);
+    Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_READ);  // 解锁
+    return ret;
+}
+
 /**
  * @brief   在JFFS2文件系统中创建文件
  * @param   parentVnode [in]  父目录Vnode指针
@@ -356,12 +447,12 @@ int VfsJffs2Create(struct Vnode *parentVnode, const char *path, int mode, struct
         return -ENOMEM;                 // 返回内存不足错误
     }
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
     // 在JFFS2中创建新文件
     ret = jffs2_create((struct jffs2_inode *)parentVnode->data, (const unsigned char *)path, mode, &newNode);
     if (ret != 0) {                     // 创建失败
         VnodeFree(newVnode);            // 释放已分配的Vnode
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+        Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
         return ret;                     // 返回创建错误码
     }
 
@@ -378,7 +469,7 @@ int VfsJffs2Create(struct Vnode *parentVnode, const char *path, int mode, struct
 
     *ppVnode = newVnode;                // 返回新创建的Vnode
 
-    LOS_MuxUnlock(&g_jffs2FsLock);      // 释放文件系统锁
+    Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
     return 0;                           // 创建成功
 }
 
@@ -408,7 +499,7 @@ ssize_t VfsJffs2ReadPage(struct Vnode *vnode, char *buffer, off_t off)
     struct jffs2_sb_info *c = NULL;     // JFFS2超级块信息指针
     int ret;                           // 函数返回值
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(vnode, JFFS2_LOCK_READ);  // 加锁
 
     node = (struct jffs2_inode *)vnode->data;  // 获取JFFS2 inode
     f = JFFS2_INODE_INFO(node);         // 获取inode信息
@@ -416,15 +507,17 @@ ssize_t VfsJffs2ReadPage(struct Vnode *vnode, char *buffer, off_t off)
 
     off_t pos = min(node->i_size, off);  // 计算实际读取起始位置(不超过文件大小)
     ssize_t len = min(PAGE_SIZE, (node->i_size - pos));  // 计算读取长度(不超过一页)
-    // 读取inode数据
+    // 读取inode数据，f->sem与GC线程搬移该inode的节点互斥
+    mutex_lock(&f->sem);
     ret = jffs2_read_inode_range(c, f, (unsigned char *)buffer, off, len);
+    mutex_unlock(&f->sem);
     if (ret) {                          // 读取失败
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+        Jffs2VnodeUnlock(vnode, JFFS2_LOCK_READ);  // 解锁
         return ret;                     // 返回错误码
     }
     node->i_atime = Jffs2CurSec();      // 更新访问时间
 
-    LOS_MuxUnlock(&g_jffs2FsLock);      // 释放文件系统锁
+    Jffs2VnodeUnlock(vnode, JFFS2_LOCK_READ);  // 解锁
 
     return len;                         // 返回读取字节数
 }
@@ -444,23 +537,25 @@ ssize_t VfsJffs2Read(struct file *filep, char *buffer, size_t bufLen)
     struct jffs2_sb_info *c = NULL;     // JFFS2超级块信息指针
     int ret;                           // 函数返回值
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(filep->f_vnode, JFFS2_LOCK_READ);  // 加锁
     node = (struct jffs2_inode *)filep->f_vnode->data;  // 获取JFFS2 inode
     f = JFFS2_INODE_INFO(node);         // 获取inode信息
     c = JFFS2_SB_INFO(node->i_sb);      // 获取超级块信息
 
     off_t pos = min(node->i_size, filep->f_pos);  // 计算实际读取起始位置
     off_t len = min(bufLen, (node->i_size - pos));  // 计算实际可读取长度
-    // 读取inode数据
+    // 读取inode数据，f->sem与GC线程搬移该inode的节点互斥
+    mutex_lock(&f->sem);
     ret = jffs2_read_inode_range(c, f, (unsigned char *)buffer, filep->f_pos, len);
+    mutex_unlock(&f->sem);
     if (ret) {                          // 读取失败
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+        Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_READ);  // 解锁
         return ret;                     // 返回错误码
     }
     node->i_atime = Jffs2CurSec();      // 更新访问时间
     filep->f_pos += len;                // 更新文件指针
 
-    LOS_MuxUnlock(&g_jffs2FsLock);      // 释放文件系统锁
+    Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_READ);  // 解锁
 
     return len;                         // 返回读取字节数
 }
@@ -484,14 +579,14 @@ ssize_t VfsJffs2WritePage(struct Vnode *vnode, char *buffer, off_t pos, size_t b
     int ret;                           // 函数返回值
     uint32_t writtenLen;                // 实际写入长度
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(vnode, JFFS2_LOCK_WRITE);  // 加锁
 
     node = (struct jffs2_inode *)vnode->data;  // 获取JFFS2 inode
     f = JFFS2_INODE_INFO(node);         // 获取inode信息
     c = JFFS2_SB_INFO(node->i_sb);      // 获取超级块信息
 
     if (pos < 0) {                      // 检查偏移量是否有效
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+        Jffs2VnodeUnlock(vnode, JFFS2_LOCK_WRITE);  // 解锁
         return -EINVAL;                 // 返回无效参数错误
     }
 
@@ -509,7 +604,7 @@ ssize_t VfsJffs2WritePage(struct Vnode *vnode, char *buffer, off_t pos, size_t b
         attr.attr_chg_size = pos;        // 设置新大小
         err = jffs2_setattr(node, &attr);  // 更新inode属性
         if (err) {                       // 更新失败
-            LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+            Jffs2VnodeUnlock(vnode, JFFS2_LOCK_WRITE);  // 解锁
             return err;                  // 返回错误码
         }
     }
@@ -519,13 +614,13 @@ ssize_t VfsJffs2WritePage(struct Vnode *vnode, char *buffer, off_t pos, size_t b
     ret = jffs2_write_inode_range(c, f, &ri, (unsigned char *)buffer, pos, buflen, &writtenLen);
     if (ret) {                          // 写入失败
         node->i_mtime = node->i_ctime = je32_to_cpu(ri.mtime);  // 更新时间
-        LOS_MuxUnlock(&g_jffs2FsLock);  // 释放文件系统锁
+        Jffs2VnodeUnlock(vnode, JFFS2_LOCK_WRITE);  // 解锁
         return ret;                     // 返回错误码
     }
 
     node->i_mtime = node->i_ctime = je32_to_cpu(ri.mtime);  // 更新修改和创建时间
 
-    LOS_MuxUnlock(&g_jffs2FsLock);      // 释放文件系统锁
+    Jffs2VnodeUnlock(vnode, JFFS2_LOCK_WRITE);  // 解锁
 
     return (ssize_t)writtenLen;         // 返回实际写入字节数
 }
@@ -547,7 +642,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
     off_t pos;                                // 文件当前写入位置
     uint32_t writtenLen;                      // 实际写入长度
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统全局互斥锁，确保线程安全
+    Jffs2VnodeLock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 加锁
 
     node = (struct jffs2_inode *)filep->f_vnode->data;  // 从vnode中获取JFFS2 inode
     f = JFFS2_INODE_INFO(node);                         // 获取inode信息
@@ -568,7 +663,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
     }
 #endif
     if (pos < 0) {                               // 检查写入位置是否合法
-        LOS_MuxUnlock(&g_jffs2FsLock);           // 释放文件系统锁
+        Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 解锁
         return -EINVAL;                          // 返回无效参数错误
     }
 
@@ -584,7 +679,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
         attr.attr_chg_size = pos;               // 设置新文件大小为当前写入位置
         err = jffs2_setattr(node, &attr);       // 调用JFFS2设置属性函数扩展文件
         if (err) {                              // 扩展失败
-            LOS_MuxUnlock(&g_jffs2FsLock);       // 释放锁
+            Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 解锁
             return err;                         // 返回错误码
         }
     }
@@ -601,7 +696,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
 
         filep->f_pos = pos;                      // 更新文件指针
 
-        LOS_MuxUnlock(&g_jffs2FsLock);           // 释放锁
+        Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 解锁
 
         return ret;                              // 返回错误码（非致命错误）
     }
@@ -615,7 +710,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
 
         filep->f_pos = pos;                      // 更新文件指针
 
-        LOS_MuxUnlock(&g_jffs2FsLock);           // 释放锁
+        Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 解锁
 
         return -ENOSPC;                          // 返回空间不足错误
     }
@@ -628,7 +723,7 @@ ssize_t VfsJffs2Write(struct file *filep, const char *buffer, size_t bufLen)
 
     filep->f_pos = pos;                          // 更新文件指针
 
-    LOS_MuxUnlock(&g_jffs2FsLock);               // 释放文件系统锁
+    Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_WRITE);  // 解锁
 
     return writtenLen;                           // 返回成功写入的字节数
 }
@@ -645,7 +740,7 @@ off_t VfsJffs2Seek(struct file *filep, off_t offset, int whence)
     struct jffs2_inode *node = NULL;          // JFFS2 inode结构体指针
     loff_t filePos;                           // 计算后的文件位置
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(filep->f_vnode, JFFS2_LOCK_READ);  // 加锁
 
     node = (struct jffs2_inode *)filep->f_vnode->data;  // 获取inode
     filePos = filep->f_pos;                             // 获取当前文件位置
@@ -664,11 +759,11 @@ off_t VfsJffs2Seek(struct file *filep, off_t offset, int whence)
             break;
 
         default:                              // 无效的定位基准
-            LOS_MuxUnlock(&g_jffs2FsLock);   // 释放锁
+            Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_READ);  // 解锁
             return -EINVAL;                  // 返回错误
     }
 
-    LOS_MuxUnlock(&g_jffs2FsLock);           // 释放锁
+    Jffs2VnodeUnlock(filep->f_vnode, JFFS2_LOCK_READ);  // 解锁
 
     if (filePos < 0)                         // 检查位置是否合法
         return -EINVAL;
@@ -737,7 +832,7 @@ int VfsJffs2Readdir(struct Vnode *pVnode, struct fs_dirent_s *dir)
     int ret;                                  // 函数返回值
     int i = 0;                                // 目录项计数
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(pVnode, JFFS2_LOCK_READ);  // 加锁
 
     /* set jffs2_d */
     while (i < dir->read_cnt) {               // 循环读取，直到达到请求的目录项数量
@@ -751,7 +846,7 @@ int VfsJffs2Readdir(struct Vnode *pVnode, struct fs_dirent_s *dir)
         i++;                                  // 增加目录项计数
     }
 
-    LOS_MuxUnlock(&g_jffs2FsLock);           // 释放锁
+    Jffs2VnodeUnlock(pVnode, JFFS2_LOCK_READ);  // 解锁
 
     return i;                                 // 返回实际读取到的目录项数量
 }
@@ -811,12 +906,12 @@ int VfsJffs2Mkdir(struct Vnode *parentNode, const char *dirName, mode_t mode, st
         return -ENOMEM;                        // 返回内存不足错误
     }
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(parentNode, JFFS2_LOCK_NAMESPACE);  // 加锁
 
     // 调用JFFS2创建目录函数
     ret = jffs2_mkdir((struct jffs2_inode *)parentNode->data, (const unsigned char *)dirName, mode, &node);
     if (ret != 0) {                            // 创建失败
-        LOS_MuxUnlock(&g_jffs2FsLock);         // 释放锁
+        Jffs2VnodeUnlock(parentNode, JFFS2_LOCK_NAMESPACE);  // 解锁
         VnodeFree(newVnode);                   // 释放已分配的vnode
         return ret;                            // 返回错误码
     }
@@ -834,7 +929,7 @@ int VfsJffs2Mkdir(struct Vnode *parentNode, const char *dirName, mode_t mode, st
 
     (void)VfsHashInsert(newVnode, node->i_ino);  // 将新vnode插入VFS哈希表
 
-    LOS_MuxUnlock(&g_jffs2FsLock);             // 释放锁
+    Jffs2VnodeUnlock(parentNode, JFFS2_LOCK_NAMESPACE);  // 解锁
 
     return 0;                                  // 返回成功
 }
@@ -853,9 +948,9 @@ static int Jffs2Truncate(struct Vnode *pVnode, unsigned int len)
     attr.attr_chg_size = len;                 // 设置目标大小
     attr.attr_chg_valid = CHG_SIZE;           // 标记需要修改文件大小属性
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(pVnode, JFFS2_LOCK_WRITE);  // 加锁
     ret = jffs2_setattr((struct jffs2_inode *)pVnode->data, &attr);  // 调用JFFS2设置属性函数执行截断
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放文件系统锁
+    Jffs2VnodeUnlock(pVnode, JFFS2_LOCK_WRITE);  // 解锁
     return ret;                               // 返回操作结果
 }
 
@@ -901,7 +996,7 @@ int VfsJffs2Chattr(struct Vnode *pVnode, struct IATTR *attr)
         return -EINVAL;                       // 返回无效参数错误
     }
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(pVnode, JFFS2_LOCK_WRITE);  // 加锁
 
     node = pVnode->data;                      // 获取Vnode关联的JFFS2 inode
     ret = jffs2_setattr(node, attr);          // 调用JFFS2设置属性函数
@@ -910,18 +1005,18 @@ int VfsJffs2Chattr(struct Vnode *pVnode, struct IATTR *attr)
         pVnode->gid = node->i_gid;            // 更新Vnode的组ID
         pVnode->mode = node->i_mode;          // 更新Vnode的权限模式
     }
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放文件系统锁
+    Jffs2VnodeUnlock(pVnode, JFFS2_LOCK_WRITE);  // 解锁
     return ret;                               // 返回操作结果
 }
 
 /**
- * @brief   VFS接口：删除目录
+ * @brief   删除目录（调用者须持有分区写锁）
  * @param   parentVnode 父目录Vnode指针
  * @param   targetVnode 目标目录Vnode指针
  * @param   path        目标目录路径名
  * @return  成功返回0，失败返回负错误码
  */
-int VfsJffs2Rmdir(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
+static int Jffs2Rmdir(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
 {
     int ret;                                  // 函数返回值
     struct jffs2_inode *parentInode = NULL;   // 父目录inode指针
@@ -934,15 +1029,33 @@ int VfsJffs2Rmdir(struct Vnode *parentVnode, struct Vnode *targetVnode, const ch
     parentInode = (struct jffs2_inode *)parentVnode->data;  // 获取父目录inode
     targetInode = (struct jffs2_inode *)targetVnode->data;  // 获取目标目录inode
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
-
     // 调用JFFS2删除目录函数
     ret = jffs2_rmdir(parentInode, targetInode, (const unsigned char *)path);
     if (ret == 0) {                           // 删除成功
         (void)jffs2_iput(targetInode);        // 减少目标inode引用计数（释放inode）
     }
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放文件系统锁
+    return ret;                               // 返回操作结果
+}
+
+/**
+ * @brief   VFS接口：删除目录
+ * @param   parentVnode 父目录Vnode指针
+ * @param   targetVnode 目标目录Vnode指针
+ * @param   path        目标目录路径名
+ * @return  成功返回0，失败返回负错误码
+ */
+int VfsJffs2Rmdir(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
+{
+    int ret;                                  // 函数返回值
+
+    if (parentVnode == NULL) {                // 无父目录时无法确定分区锁
+        return -EINVAL;                       // 返回无效参数错误
+    }
+
+    Jffs2VnodeLock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
+    ret = Jffs2Rmdir(parentVnode, targetVnode, path);
+    Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
     return ret;                               // 返回操作结果
 }
 
@@ -966,11 +1079,11 @@ int VfsJffs2Link(struct Vnode *oldVnode, struct Vnode *newParentVnode, struct Vn
         return -ENOMEM;                       // 返回内存不足错误
     }
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(newParentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
     // 调用JFFS2创建硬链接函数
     ret = jffs2_link(oldInode, newParentInode, (const unsigned char *)newName);
     if (ret != 0) {                           // 创建链接失败
-        LOS_MuxUnlock(&g_jffs2FsLock);        // 释放锁
+        Jffs2VnodeUnlock(newParentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
         VnodeFree(pVnode);                    // 释放已分配的Vnode
         return ret;                           // 返回错误码
     }
@@ -987,7 +1100,7 @@ int VfsJffs2Link(struct Vnode *oldVnode, struct Vnode *newParentVnode, struct Vn
     *newVnode = pVnode;                       // 输出新Vnode
     (void)VfsHashInsert(*newVnode, oldInode->i_ino);  // 将新Vnode插入VFS哈希表
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    Jffs2VnodeUnlock(newParentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
     return ret;                               // 返回成功
 }
 
@@ -1010,11 +1123,11 @@ int VfsJffs2Symlink(struct Vnode *parentVnode, struct Vnode **newVnode, const ch
         return -ENOMEM;                       // 返回内存不足错误
     }
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
     // 调用JFFS2创建符号链接函数
     ret = jffs2_symlink((struct jffs2_inode *)parentVnode->data, &inode, (const unsigned char *)path, target);
     if (ret != 0) {                           // 创建失败
-        LOS_MuxUnlock(&g_jffs2FsLock);        // 释放锁
+        Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
         VnodeFree(pVnode);                    // 释放Vnode
         return ret;                           // 返回错误码
     }
@@ -1031,7 +1144,7 @@ int VfsJffs2Symlink(struct Vnode *parentVnode, struct Vnode **newVnode, const ch
     *newVnode = pVnode;                       // 输出新Vnode
     (void)VfsHashInsert(*newVnode, inode->i_ino);  // 插入VFS哈希表
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
     return ret;                               // 返回成功
 }
 
@@ -1049,13 +1162,13 @@ ssize_t VfsJffs2Readlink(struct Vnode *vnode, char *buffer, size_t bufLen)
     ssize_t targetLen;                        // 目标路径长度
     ssize_t cnt;                              // 实际读取长度
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(vnode, JFFS2_LOCK_READ);  // 加锁
 
     inode = (struct jffs2_inode *)vnode->data;  // 获取inode
     f = JFFS2_INODE_INFO(inode);               // 获取inode信息
     targetLen = strlen((const char *)f->target);  // 计算目标路径长度
     if (bufLen == 0) {                        // 缓冲区长度为0（仅获取长度）
-        LOS_MuxUnlock(&g_jffs2FsLock);        // 释放锁
+        Jffs2VnodeUnlock(vnode, JFFS2_LOCK_READ);  // 解锁
         return 0;                             // 返回0（不读取数据）
     }
 
@@ -1063,24 +1176,24 @@ ssize_t VfsJffs2Readlink(struct Vnode *vnode, char *buffer, size_t bufLen)
     cnt = (bufLen - 1) < targetLen ? (bufLen - 1) : targetLen;
     // 将目标路径从内核空间复制到用户空间
     if (LOS_CopyFromKernel(buffer, bufLen, (const char *)f->target, cnt) != 0) {
-        LOS_MuxUnlock(&g_jffs2FsLock);        // 复制失败，释放锁
+        Jffs2VnodeUnlock(vnode, JFFS2_LOCK_READ);  // 解锁
         return -EFAULT;                       // 返回内存访问错误
     }
     buffer[cnt] = '\0';                       // 添加字符串终止符
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    Jffs2VnodeUnlock(vnode, JFFS2_LOCK_READ);  // 解锁
 
     return cnt;                               // 返回实际读取的字节数
 }
 
 /**
- * @brief   VFS接口：删除文件（非目录）
+ * @brief   删除文件（非目录）（调用者须持有分区写锁）
  * @param   parentVnode 父目录Vnode指针
  * @param   targetVnode 目标文件Vnode指针
  * @param   path        目标文件路径名
  * @return  成功返回0，失败返回负错误码
  */
-int VfsJffs2Unlink(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
+static int Jffs2Unlink(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
 {
     int ret;                                  // 函数返回值
     struct jffs2_inode *parentInode = NULL;   // 父目录inode指针
@@ -1094,15 +1207,33 @@ int VfsJffs2Unlink(struct Vnode *parentVnode, struct Vnode *targetVnode, const c
     parentInode = (struct jffs2_inode *)parentVnode->data;  // 获取父目录inode
     targetInode = (struct jffs2_inode *)targetVnode->data;  // 获取目标文件inode
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
-
     // 调用JFFS2删除文件函数
     ret = jffs2_unlink(parentInode, targetInode, (const unsigned char *)path);
     if (ret == 0) {                           // 删除成功
         (void)jffs2_iput(targetInode);        // 减少inode引用计数
     }
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    return ret;                               // 返回操作结果
+}
+
+/**
+ * @brief   VFS接口：删除文件（非目录）
+ * @param   parentVnode 父目录Vnode指针
+ * @param   targetVnode 目标文件Vnode指针
+ * @param   path        目标文件路径名
+ * @return  成功返回0，失败返回负错误码
+ */
+int VfsJffs2Unlink(struct Vnode *parentVnode, struct Vnode *targetVnode, const char *path)
+{
+    int ret;                                  // 函数返回值
+
+    if (parentVnode == NULL) {                // 无父目录时无法确定分区锁
+        return -EINVAL;                       // 返回无效参数错误
+    }
+
+    Jffs2VnodeLock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
+    ret = Jffs2Unlink(parentVnode, targetVnode, path);
+    Jffs2VnodeUnlock(parentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
     return ret;                               // 返回操作结果
 }
 
@@ -1121,20 +1252,20 @@ int VfsJffs2Rename(struct Vnode *fromVnode, struct Vnode *toParentVnode, const c
     struct Vnode *toVnode = NULL;             // 目标路径已存在的Vnode
     struct jffs2_inode *fromNode = NULL;      // 源文件inode
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(toParentVnode, JFFS2_LOCK_NAMESPACE);  // 加锁
     fromParentVnode = fromVnode->parent;      // 获取源文件的父目录
 
     // 检查目标路径是否已存在
-    ret = VfsJffs2Lookup(toParentVnode, toName, strlen(toName), &toVnode);
+    ret = Jffs2Lookup(toParentVnode, toName, strlen(toName), &toVnode);
     if (ret == 0) {                           // 目标路径已存在
         if (toVnode->type == VNODE_TYPE_DIR) {  // 目标是目录
-            ret = VfsJffs2Rmdir(toParentVnode, toVnode, (char *)toName);  // 删除目标目录
+            ret = Jffs2Rmdir(toParentVnode, toVnode, (char *)toName);  // 删除目标目录
         } else {
-            ret = VfsJffs2Unlink(toParentVnode, toVnode, (char *)toName);  // 删除目标文件
+            ret = Jffs2Unlink(toParentVnode, toVnode, (char *)toName);  // 删除目标文件
         }
         if (ret) {                            // 删除目标失败
             PRINTK("%s-%d remove newname(%s) failed ret=%d\n", __FUNCTION__, __LINE__, toName, ret);  // 打印错误信息
-            LOS_MuxUnlock(&g_jffs2FsLock);    // 释放锁
+            Jffs2VnodeUnlock(toParentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
             return ret;                       // 返回错误码
         }
     }
@@ -1143,7 +1274,7 @@ int VfsJffs2Rename(struct Vnode *fromVnode, struct Vnode *toParentVnode, const c
     ret = jffs2_rename((struct jffs2_inode *)fromParentVnode->data, fromNode,
         (const unsigned char *)fromName, (struct jffs2_inode *)toParentVnode->data, (const unsigned char *)toName);
     fromVnode->parent = toParentVnode;        // 更新源文件Vnode的父目录
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    Jffs2VnodeUnlock(toParentVnode, JFFS2_LOCK_NAMESPACE);  // 解锁
 
     if (ret) {                                // 重命名失败
         return ret;                           // 返回错误码
@@ -1162,7 +1293,7 @@ int VfsJffs2Stat(struct Vnode *pVnode, struct stat *buf)
 {
     struct jffs2_inode *node = NULL;          // JFFS2 inode结构体指针
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    Jffs2VnodeLock(pVnode, JFFS2_LOCK_READ);  // 加锁
 
     node = (struct jffs2_inode *)pVnode->data;  // 获取inode
     // 根据inode模式设置文件类型
@@ -1196,7 +1327,7 @@ int VfsJffs2Stat(struct Vnode *pVnode, struct stat *buf)
     buf->__st_mtim32.tv_sec = (long)node->i_mtime;
     buf->__st_ctim32.tv_sec = (long)node->i_ctime;
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放锁
+    Jffs2VnodeUnlock(pVnode, JFFS2_LOCK_READ);  // 解锁
 
     return 0;                                 // 返回成功
 }
@@ -1224,7 +1355,7 @@ int VfsJffs2Statfs(struct Mount *mnt, struct statfs *buf)
     struct jffs2_sb_info *c = NULL;           // JFFS2超级块信息结构体指针
     struct jffs2_inode *rootNode = NULL;      // 根目录inode指针
 
-    LOS_MuxLock(&g_jffs2FsLock, (uint32_t)JFFS2_WAITING_FOREVER);  // 获取文件系统锁
+    (void)LOS_RwlockRdLock(Jffs2PartLockGet(mnt), LOS_WAIT_FOREVER);  // 获取分区读锁
 
     rootNode = (struct jffs2_inode *)mnt->vnodeCovered->data;  // 从挂载点获取根目录inode
     c = JFFS2_SB_INFO(rootNode->i_sb);        // 获取JFFS2超级块信息
@@ -1244,31 +1375,47 @@ int VfsJffs2Statfs(struct Mount *mnt, struct statfs *buf)
     buf->f_ffree = 0;                         // 空闲文件节点数（未实现）
     buf->f_flags = mnt->mountFlags;           // 挂载标志
 
-    LOS_MuxUnlock(&g_jffs2FsLock);            // 释放文件系统锁
+    (void)LOS_RwlockUnLock(Jffs2PartLockGet(mnt));  // 释放分区读锁
     return 0;                                 // 返回成功
 }
 
 /**
- * @brief   初始化JFFS2文件系统互斥锁
+ * @brief   初始化JFFS2文件系统锁(挂载锁、分区锁与inode条带锁)
  * @return  成功返回0，失败返回-1
  */
 int Jffs2MutexCreate(void)
 {
-    // 初始化全局文件系统互斥锁
+    int i;
+
+    // 初始化挂载互斥锁
     if (LOS_MuxInit(&g_jffs2FsLock, NULL) != LOS_OK) {
         PRINT_ERR("%s, LOS_MuxCreate failed\n", __FUNCTION__);  // 打印初始化失败信息
         return -1;                                               // 返回错误
-    } else {
-        return 0;                                                // 返回成功
     }
+    // 初始化分区锁与inode条带锁
+    for (i = 0; i < CONFIG_MTD_PATTITION_NUM; i++) {
+        (void)LOS_RwlockInit(&g_jffs2PartLock[i]);
+    }
+    for (i = 0; i < JFFS2_INODE_LOCK_NUM; i++) {
+        (void)LOS_RwlockInit(&g_jffs2InodeLock[i]);
+    }
+    return 0;                                                    // 返回成功
 }
 
 /**
- * @brief   销毁JFFS2文件系统互斥锁
+ * @brief   销毁JFFS2文件系统锁
  */
 void Jffs2MutexDelete(void)
 {
-    (void)LOS_MuxDestroy(&g_jffs2FsLock);     // 销毁全局文件系统互斥锁
+    int i;
+
+    for (i = 0; i < JFFS2_INODE_LOCK_NUM; i++) {
+        (void)LOS_RwlockDestroy(&g_jffs2InodeLock[i]);
+    }
+    for (i = 0; i < CONFIG_MTD_PATTITION_NUM; i++) {
+        (void)LOS_RwlockDestroy(&g_jffs2PartLock[i]);
+    }
+    (void)LOS_MuxDestroy(&g_jffs2FsLock);     // 销毁挂载互斥锁
 }
 
 /**
@@ -52,6 +52,8 @@ void ProcFreeProcessDir(struct ProcDirEntry *processDir);
 
 void ProcSysMemInfoInit(void);
 
+void ProcSlabInfoInit(void);
+
 void ProcFileSysInit(void);
 #endif
 
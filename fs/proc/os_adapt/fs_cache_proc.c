@@ -102,20 +102,14 @@ static int VnodeListProcess(struct SeqBuf *buf, LIST_HEAD* list)
 static int PathCacheListProcess(struct SeqBuf *buf)
 {
     int count = 0;                          // 路径缓存计数
-    LIST_HEAD* bucketList = GetPathCacheList();  // 获取路径缓存哈希桶列表
+    struct PathCache *pc = NULL;            // 当前路径缓存条目
 
-    // 遍历所有路径缓存哈希桶（LOSCFG_MAX_PATH_CACHE_SIZE为哈希桶数量）
-    for (int i = 0; i < LOSCFG_MAX_PATH_CACHE_SIZE; i++) {
-        struct PathCache *pc = NULL;        // 当前路径缓存条目
-        LIST_HEAD *list = &bucketList[i];   // 当前哈希桶链表头
-
-        // 遍历当前哈希桶中的所有路径缓存条目
-        LOS_DL_LIST_FOR_EACH_ENTRY(pc, list, struct PathCache, hashEntry) {
-            // 格式化输出路径缓存信息：桶编号、缓存地址、父Vnode、子Vnode、命中次数和路径名
-            LosBufPrintf(buf, "%-3d    %-10p    %-11p    %-10p    %-9d    %s\n", i, pc,
-                pc->parentVnode, pc->childVnode, pc->hit, pc->name);
-            count++;  // 计数递增
-        }
+    // 按最近使用从旧到新遍历所有路径缓存条目
+    LOS_DL_LIST_FOR_EACH_ENTRY(pc, GetPathCacheLruList(), struct PathCache, lruEntry) {
+        // 格式化输出路径缓存信息：哈希值、缓存地址、父Vnode、子Vnode、命中次数和路径名
+        LosBufPrintf(buf, "0x%08x    %-10p    %-11p    %-10p    %-9d    %s\n", pc->hash, pc,
+            pc->parentVnode, pc->childVnode, pc->hit, pc->name);
+        count++;  // 计数递增
     }
 
     return count;  // 返回处理的路径缓存总数
@@ -186,16 +180,19 @@ static int FsCacheInfoFill(struct SeqBuf *buf, void *arg)
     int vnodeTotal;         // Vnode总数
 
     int pathCacheTotal;     // 路径缓存总数
+    struct PathCacheStat pathCacheStat; // 路径缓存容量与链长统计
+    struct VnodeHashStat vnodeHashStat; // vnode哈希表链长统计
     int pathCacheTotalTry = 0;  // 路径缓存尝试访问次数
     int pathCacheTotalHit = 0;  // 路径缓存命中次数
 
     int pageCacheTotal;     // 页缓存总数
     int pageCacheTotalTry = 0;  // 页缓存尝试访问次数
     int pageCacheTotalHit = 0;  // 页缓存命中次数
+    PageCacheRaInfo pageCacheRa = {0}; // 预读与周边映射统计
 
     // 重置路径缓存和页缓存的命中统计信息
     ResetPathCacheHitInfo(&pathCacheTotalHit, &pathCacheTotalTry);
-    ResetPageCacheHitInfo(&pageCacheTotalTry, &pageCacheTotalHit);
+    ResetPageCacheHitInfo(&pageCacheTotalTry, &pageCacheTotalHit, &pageCacheRa);
 
     VnodeHold();  // 持有Vnode锁，确保数据一致性
     // 输出Vnode信息表头
@@ -210,7 +207,7 @@ static int FsCacheInfoFill(struct SeqBuf *buf, void *arg)
 
     // 输出路径缓存信息表头
     LosBufPrintf(buf, "\n=================================================================\n");
-    LosBufPrintf(buf, "No.    CacheAddr     ParentAddr     ChildAddr     HitCount     Name\n");
+    LosBufPrintf(buf, "Hash          CacheAddr     ParentAddr     ChildAddr     HitCount     Name\n");
     pathCacheTotal = PathCacheListProcess(buf);  // 处理路径缓存并统计数量
 
     // 输出页缓存信息表头
@@ -219,11 +216,21 @@ static int FsCacheInfoFill(struct SeqBuf *buf, void *arg)
 
     // 输出缓存统计汇总信息
     LosBufPrintf(buf, "\n=================================================================\n");
-    LosBufPrintf(buf, "PathCache Total:%d Try:%d Hit:%d\n",
-        pathCacheTotal, pathCacheTotalTry, pathCacheTotalHit);
+    LosBufPrintf(buf, "PathCache Total:%d Try:%d Hit:%d HitRatio:%d%%\n",
+        pathCacheTotal, pathCacheTotalTry, pathCacheTotalHit,
+        (pathCacheTotalTry != 0) ? (pathCacheTotalHit * 100 / pathCacheTotalTry) : 0); /* 100: percent */
+    PathCacheStatGet(&pathCacheStat);
+    LosBufPrintf(buf, "PathCache Memory:%u/%u Evicted:%u Buckets:%u Used:%u MaxChain:%u\n",
+        pathCacheStat.memSize, pathCacheStat.memLimit, pathCacheStat.evicted,
+        pathCacheStat.buckets, pathCacheStat.usedBuckets, pathCacheStat.maxChain);
+    VnodeHashStatGet(&vnodeHashStat);
+    LosBufPrintf(buf, "VnodeHash Total:%u Buckets:%u Used:%u MaxChain:%u\n",
+        vnodeHashStat.entries, vnodeHashStat.buckets, vnodeHashStat.usedBuckets, vnodeHashStat.maxChain);
     LosBufPrintf(buf, "Vnode Total:%d Free:%d Virtual:%d Active:%d\n",
         vnodeTotal, vnodeFree, vnodeVirtual, vnodeActive);
     LosBufPrintf(buf, "PageCache total:%d Try:%d Hit:%d\n", pageCacheTotal, pageCacheTotalTry, pageCacheTotalHit);
+    LosBufPrintf(buf, "PageCache ReadAhead:%d RaHit:%d FaultAround:%d MaxWindow:%d\n", pageCacheRa.readAheadPages,
+        pageCacheRa.readAheadHit, pageCacheRa.faultAroundPages, pageCacheRa.maxWindow);
     VnodeDrop();  // 释放Vnode锁
     return 0;      // 成功完成信息填充
 }
@@ -34,6 +34,9 @@
 #include "los_memory.h"
 #include "los_vm_filemap.h"
 #include "los_memory_pri.h"
+#include "los_slab.h"
+
+#define SLAB_INFO_MAX 32  // /proc/slabinfo最多展示的对象缓存个数
 /**
  * @brief 填充系统内存信息到序列缓冲区
  * @param seqBuf 序列缓冲区指针，用于存储格式化的内存信息
@@ -87,4 +90,51 @@ void ProcSysMemInfoInit(void)
     }
 
     pde->procFileOps = &SYS_MEMINFO_PROC_FOPS;  // 关联meminfo节点的文件操作函数
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 填充对象缓存统计信息到序列缓冲区
+ * @param seqBuf 序列缓冲区指针
+ * @param arg 未使用的参数
+ * @return 成功返回0，失败返回-ENOMEM
+ */
+static int SlabInfoFill(struct SeqBuf *seqBuf, void *arg)
+{
+    (void)arg;
+    LosSlabInfo *info = (LosSlabInfo *)malloc(sizeof(LosSlabInfo) * SLAB_INFO_MAX);
+    if (info == NULL) {
+        return -ENOMEM;
+    }
+
+    UINT32 num = LOS_SlabInfoGet(info, SLAB_INFO_MAX);  // 快照后再输出，输出时不持有缓存锁
+    (void)LosBufPrintf(seqBuf, "%-16s %8s %8s %8s %8s %8s %10s %10s %10s\n", "Name", "ObjSize", "SlabSize",
+                       "Slabs", "Total", "Active", "Alloc", "Free", "MagHit");
+    for (UINT32 i = 0; i < num; i++) {
+        (void)LosBufPrintf(seqBuf, "%-16s %8u %8u %8u %8u %8u %10u %10u %10u\n", info[i].name, info[i].objSize,
+                           info[i].slabSize, info[i].slabNum, info[i].objTotal, info[i].objActive,
+                           info[i].allocCount, info[i].freeCount, info[i].magazineHit);
+    }
+    free(info);
+    return 0;
+}
+
+/**
+ * @brief /proc/slabinfo文件的操作函数结构体
+ */
+static const struct ProcFileOperations SLAB_INFO_PROC_FOPS = {
+    .read = SlabInfoFill,                       // 读取操作：填充对象缓存统计
+};
+
+/**
+ * @brief 初始化/proc/slabinfo节点
+ */
+void ProcSlabInfoInit(void)
+{
+    struct ProcDirEntry *pde = CreateProcEntry("slabinfo", 0, NULL);
+    if (pde == NULL) {
+        PRINT_ERR("create slab_info error!\n");
+        return;
+    }
+
+    pde->procFileOps = &SLAB_INFO_PROC_FOPS;
+}
@@ -79,6 +79,7 @@ void ProcFsInit(void)
 #endif  
 #ifdef LOSCFG_PROC_PROCESS_DIR  
     ProcSysMemInfoInit();  // 当启用进程目录时，初始化内存信息节点(/proc/meminfo)  
+    ProcSlabInfoInit();  // 当启用进程目录时，初始化对象缓存信息节点(/proc/slabinfo)  
     ProcFileSysInit();  // 当启用进程目录时，初始化文件系统信息节点(/proc/filesystems)  
 #endif  
 #ifdef LOSCFG_KERNEL_PLIMITS  
@@ -35,12 +35,14 @@
 #include "linux/delay.h"
 #include "disk_pri.h"
 #include "user_copy.h"
+#include "los_vm_map.h"
 #undef HALARC_ALIGNMENT
 #define DMA_ALLGN          64  // DMA对齐大小，64字节
 #define HALARC_ALIGNMENT   DMA_ALLGN  // HALARC对齐方式，使用DMA对齐
 #define BCACHE_MAGIC_NUM   20132016  // 块缓存魔数，用于标识有效缓存块
 #define BCACHE_STATCK_SIZE 0x3000  // 块缓存栈大小
 #define ASYNC_EVENT_BIT    0x01  // 异步事件标志位
+#define BCACHE_MERGE_MAX   (CONFIG_FS_FAT_READ_NUMS / 2)  // 连续未命中块合并读取的最大块数，不超过读缓冲区的一半以免挤掉本次读入的块
 
 #ifdef DEBUG
 #define D(args) printf args  // 调试模式下启用打印输出
@@ -817,6 +819,32 @@ static VOID BlockInit(OsBcache *bc, OsBcacheBlock *block, UINT64 num)
     block->allDirty = FALSE;  // 清除全脏标志（表示整个块都被修改）
 }
 
+/**
+ * @brief 为未命中的块分配缓存块并初始化，不读取数据
+ * @param bc 块缓存控制结构体指针
+ * @param num 物理块编号
+ * @param read TRUE表示使用读缓冲区，FALSE表示使用写缓冲区
+ * @return 成功返回缓存块指针，失败返回NULL
+ */
+static OsBcacheBlock *BcacheNewBlock(OsBcache *bc, UINT64 num, BOOL read)
+{
+    OsBcacheBlock *block = AllocNewBlock(bc, read, num);  // 分配新的缓存块
+    if (block == NULL) {  // 如果分配失败
+        block = GetSlowBlock(bc, read);  // 获取慢路径块（可能需要同步脏块）
+    }
+
+    if (block == NULL) {
+        return NULL;
+    }
+#ifdef BCACHE_ANALYSE
+    UINT32 index = ((UINT32)(block->data - g_memStart)) / g_dataSize;  // 计算缓存块索引
+    PRINTK(", [MISS], %llu, %u\n", num, index);  // 打印缓存未命中信息
+    g_switchTimes[index]++;  // 增加切换计数
+#endif
+    BlockInit(bc, block, num);  // 初始化新分配的缓存块
+    return block;
+}
+
 /**
  * @brief 从缓存中获取指定编号的块，如果不存在则分配新块
  * @param bc 块缓存控制结构体指针
@@ -863,20 +891,10 @@ static INT32 BcacheGetBlock(OsBcache *bc, UINT64 num, BOOL readData, OsBcacheBlo
 
     D(("bcache block = %llu NOT found in cache\n", num));  // 调试日志：缓存未命中
 
-    block = AllocNewBlock(bc, readData, num);  // 分配新的缓存块
-    if (block == NULL) {  // 如果分配失败
-        block = GetSlowBlock(bc, readData);  // 获取慢路径块（可能需要同步脏块）
-    }
-
-    if (block == NULL) {  // 如果仍然无法获取块
+    block = BcacheNewBlock(bc, num, readData);  // 分配并初始化新的缓存块
+    if (block == NULL) {  // 如果无法获取块
         return -ENOMEM;  // 返回内存不足错误
     }
-#ifdef BCACHE_ANALYSE
-    UINT32 index = ((UINT32)(block->data - g_memStart)) / g_dataSize;  // 计算缓存块索引
-    PRINTK(", [MISS], %llu, %u\n", num, index);  // 打印缓存未命中信息
-    g_switchTimes[index]++;  // 增加切换计数
-#endif
-    BlockInit(bc, block, num);  // 初始化新分配的缓存块
 
     if (readData == TRUE) {  // 如果需要从物理设备读取数据
         D(("bcache reading block = %llu\n", block->num));  // 调试日志：开始读取块
@@ -896,6 +914,113 @@ static INT32 BcacheGetBlock(OsBcache *bc, UINT64 num, BOOL readData, OsBcacheBlo
     return ENOERR;  // 返回成功
 }
 
+/**
+ * @brief 统计从num开始连续未缓存的块数
+ * @param bc 块缓存控制结构体指针
+ * @param num 起始块编号
+ * @param maxBlocks 最多统计的块数
+ * @return 连续未缓存的块数
+ */
+static UINT32 BcacheMissRun(const OsBcache *bc, UINT64 num, UINT32 maxBlocks)
+{
+    UINT32 n = 0;
+
+    while ((n < maxBlocks) && ((num + n) < bc->blockCount) && (RbFindBlock(bc, num + n) == NULL)) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief 为连续未命中的块分配缓存块，并按内存连续的分组合并为一次设备读
+ * @param bc 块缓存控制结构体指针
+ * @param num 起始块编号
+ * @param count 块数量，不超过BCACHE_MERGE_MAX
+ * @param useRead TRUE表示使用读缓冲区，FALSE表示使用写缓冲区
+ * @return 成功返回ENOERR，失败返回错误码
+ */
+static INT32 BcacheFillRun(OsBcache *bc, UINT64 num, UINT32 count, BOOL useRead)
+{
+    OsBcacheBlock *run[BCACHE_MERGE_MAX];  // 本次读入的缓存块
+    UINT32 i, j, k;
+    INT32 ret;
+
+    for (i = 0; i < count; i++) {
+        run[i] = BcacheNewBlock(bc, num + i, useRead);
+        if (run[i] == NULL) {
+            break;
+        }
+        AddBlock(bc, run[i]);  // 先加入缓存，写缓冲区按前一块编号选择相邻的缓存块
+    }
+    if (i == 0) {
+        return -ENOMEM;
+    }
+    count = i;
+
+    for (i = 0; i < count; i = j) {
+        /* 缓存块数据区在内存中相邻时合并为一次读 */
+        for (j = i + 1; (j < count) && (run[j]->data == (run[j - 1]->data + bc->blockSize)); j++) {
+        }
+        ret = bc->breadFun(bc->priv, run[i]->data, (j - i) * bc->sectorPerBlock,
+                           run[i]->num << GetValLog2(bc->sectorPerBlock));
+        if (ret != ENOERR) {
+            PRINT_ERR("BcacheFillRun, breadFun error, ret = %d\n", ret);
+            for (k = i; k < count; k++) {
+                DelBlock(bc, run[k]);  // 未读入数据的块移出缓存
+            }
+            return ret;
+        }
+        for (k = i; k < j; k++) {
+            run[k]->readFlag = TRUE;
+        }
+    }
+
+    if ((useRead == TRUE) && (bc->prereadFun != NULL)) {
+        bc->prereadFun(bc, run[count - 1]);  // 从最后一块开始预读
+    }
+    return ENOERR;
+}
+
+/**
+ * @brief 处理从num开始的未命中块：整块且为内核缓冲区时直接读入调用者缓冲区，否则合并读入缓存
+ * @param bc 块缓存控制结构体指针
+ * @param buf 调用者缓冲区
+ * @param num 起始块编号
+ * @param pos 起始块内偏移
+ * @param size 剩余读取字节数
+ * @param useRead 是否使用读缓冲区
+ * @param direct 输出参数，直接读入调用者缓冲区的块数
+ * @return 成功返回ENOERR，失败返回错误码
+ */
+static INT32 BcacheReadMiss(OsBcache *bc, UINT8 *buf, UINT64 num, UINT64 pos, UINT32 size,
+                            BOOL useRead, UINT32 *direct)
+{
+    UINT32 blocks = (UINT32)((pos + size + bc->blockSize - 1) >> bc->blockSizeLog2);  // 本次请求涉及的块数
+    UINT32 run;
+    INT32 ret;
+
+    *direct = 0;
+    /* 大块连续读且整块未缓存时绕过缓存，一次读入调用者缓冲区 */
+    if ((useRead == FALSE) && (pos == 0) && (size >= bc->blockSize)) {
+        run = BcacheMissRun(bc, num, size >> bc->blockSizeLog2);
+        if ((run > 0) && !LOS_IsUserAddressRange((VADDR_T)(UINTPTR)buf, run << bc->blockSizeLog2)) {
+            ret = bc->breadFun(bc->priv, buf, run * bc->sectorPerBlock, num << GetValLog2(bc->sectorPerBlock));
+            if (ret != ENOERR) {
+                PRINT_ERR("BcacheReadMiss, breadFun error, ret = %d\n", ret);
+                return ret;
+            }
+            *direct = run;
+            return ENOERR;
+        }
+    }
+
+    run = BcacheMissRun(bc, num, MIN2(blocks, BCACHE_MERGE_MAX));
+    if (run <= 1) {
+        return ENOERR;  // 命中或只有一块未命中，按单块路径处理
+    }
+    return BcacheFillRun(bc, num, run, useRead);
+}
+
 /**
  * @brief 清除缓存中的所有块
  * @param bc 块缓存控制结构体指针
@@ -1073,6 +1198,7 @@ INT32 BlockCacheRead(OsBcache *bc, UINT8 *buf, UINT32 *len, UINT64 sector, BOOL
     INT32 ret = ENOERR;  // 返回值
     UINT64 pos;  // 块内偏移
     UINT64 num;  // 块编号
+    UINT32 direct;  // 直接读入调用者缓冲区的块数
 #ifdef BCACHE_ANALYSE
     PRINTK("bcache read:\n");  // 调试信息打印
 #endif
@@ -1095,6 +1221,19 @@ INT32 BlockCacheRead(OsBcache *bc, UINT8 *buf, UINT32 *len, UINT64 sector, BOOL
 
         (VOID)pthread_mutex_lock(&bc->bcacheMutex);  // 加锁保护缓存操作
 
+        ret = BcacheReadMiss(bc, tempBuf, num, pos, size, useRead, &direct);  // 连续未命中块合并读取
+        if (ret != ENOERR) {
+            (VOID)pthread_mutex_unlock(&bc->bcacheMutex);  // 解锁
+            break;  // 退出循环
+        }
+        if (direct > 0) {  // 整块已直接读入调用者缓冲区
+            (VOID)pthread_mutex_unlock(&bc->bcacheMutex);  // 解锁
+            tempBuf += direct << bc->blockSizeLog2;
+            size -= direct << bc->blockSizeLog2;
+            num += direct;
+            continue;
+        }
+
         /* 读取大连续数据时useRead应设为FALSE */
         ret = BcacheGetBlock(bc, num, useRead, &block);  // 获取缓存块
         if (ret != ENOERR) {  // 检查获取结果
@@ -27,26 +27,79 @@
  * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
  * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
-
 #include "epoll.h"
 #include <stdint.h>
 #include <poll.h>
 #include <errno.h>
 #include <string.h>
 #include "pthread.h"
-/* 100，表示一个epoll文件描述符可控制的文件描述符数量 */
+#include "los_event.h"
+#include "los_list.h"
+#include "los_spinlock.h"
+#include "los_sys.h"
+#include "los_task.h"
+#include "los_slab.h"
+/* 100，epoll实例初始的容量，注册的文件描述符超过后按倍数扩容 */
 #define EPOLL_DEFAULT_SIZE 100
 
+/* 用户可见的就绪事件位，EPOLLET/EPOLLONESHOT等控制位不参与poll */
+#define EPOLL_EVENTS_MASK (EPOLLIN | EPOLLPRI | EPOLLOUT | EPOLLERR | EPOLLHUP | EPOLLRDNORM | EPOLLRDBAND | \
+                           EPOLLWRNORM | EPOLLWRBAND | EPOLLMSG)
+
+/* 就绪链表非空时写入epoll实例事件控制块的事件位 */
+#define EPOLL_EVENT_READY 0x1U
+
+/* 被监听fd到监听项的哈希表，通知路径据此找到关注该fd的所有epoll实例 */
+#define EPOLL_WATCH_HASH_SIZE 64
+#define EPOLL_WATCH_HASH(fd) ((UINT32)(fd) & (EPOLL_WATCH_HASH_SIZE - 1))
+
+/* 一次通知在释放g_epollWatchSpin后最多唤醒的实例数，超过时分批处理 */
+#define EPOLL_NOTIFY_BATCH 8
+
+struct epoll_head;
+
+/* 一个epoll实例中的一个被监听fd */
+struct epoll_item {
+    LOS_DL_LIST watchNode;   // 挂在g_epollWatch哈希桶上，由g_epollWatchSpin保护
+    LOS_DL_LIST readyNode;   // 挂在所属实例的就绪链表上，由实例的readyLock保护
+    LOS_DL_LIST itemNode;    // 挂在所属实例的监听项链表上，由实例的lock保护
+    struct epoll_head *head; // 所属epoll实例
+    int fd;                  // 被监听的系统文件描述符
+    UINT32 events;           // 关注的事件，含EPOLLET/EPOLLONESHOT控制位
+    epoll_data_t data;       // 用户数据，就绪时原样返回
+    BOOL ready;              // 是否在就绪链表上
+};
+
 /* 内部数据结构，用于管理每个epoll文件描述符 */
 struct epoll_head {
-    int size;               // epoll实例可管理的最大文件描述符数量
-    int nodeCount;          // 当前已注册的文件描述符数量
-    struct epoll_event *evs; // 存储已注册事件的数组
+    pthread_mutex_t lock;          // 实例锁，串行化本实例的epoll_ctl与事件收集
+    SPIN_LOCK_S readyLock;         // 保护就绪链表，通知路径可能运行在协议栈线程
+    LOS_DL_LIST itemList;          // 全部监听项
+    LOS_DL_LIST readyList;         // 可能就绪的监听项
+    EVENT_CB_S event;              // 等待就绪的事件控制块
+    int nodeCount;                 // 当前已注册的文件描述符数量
+    int pollCount;                 // 不会主动通知就绪的fd数量，非0时epoll_wait退回全量poll
+    int capacity;                  // pollFds/batch的容量
+    struct pollfd *pollFds;        // 预分配的pollfd数组，等待路径不再分配内存
+    struct epoll_item **batch;     // 与pollFds一一对应的监听项
+    int refCount;                  // 引用计数，由g_epollMutex保护
+    int notifying;                 // 已在通知路径中摘出、尚未完成唤醒的次数，由g_epollWatchSpin保护
+    BOOL closing;                  // epoll文件描述符已关闭
 };
 
-/* 静态互斥锁，用于保护epoll相关全局数据的线程安全访问 */
+/* 静态互斥锁，保护epoll文件描述符表与实例引用计数 */
 STATIC pthread_mutex_t g_epollMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
 
+/* 保护被监听fd哈希表 */
+STATIC SPIN_LOCK_INIT(g_epollWatchSpin);
+
+/* 被监听fd哈希表 */
+STATIC LOS_DL_LIST g_epollWatch[EPOLL_WATCH_HASH_SIZE];
+STATIC BOOL g_epollWatchInited = FALSE;
+
+/* 监听项对象缓存，epoll_ctl增删监听fd时频繁分配释放 */
+STATIC LosSlabCache *g_epollItemCache = NULL;
+
 #ifndef MAX_EPOLL_FD
 #define MAX_EPOLL_FD CONFIG_EPOLL_DESCRIPTORS  // 定义epoll文件描述符的最大数量，由配置项决定
 #endif
@@ -126,22 +179,298 @@ static struct epoll_head *EpollGetDataBuff(int fd)
 }
 
 /**
- * @brief 执行EPOLL_CTL_ADD操作时，检查文件描述符是否已存在
+ * @brief 判断被监听的fd在就绪时是否会调用EpollNotify
  *
- * @param epHead epoll控制头结构指针，通过epoll ID查找得到
- * @param fd 需要添加的文件描述符
- * @return 成功返回0（不存在）；失败返回-1（已存在）
+ * 目前只有套接字在协议栈事件回调中通知，其余fd只能靠poll轮询
+ * @param fd 系统文件描述符
+ * @return TRUE表示会主动通知
  */
-static int CheckFdExist(struct epoll_head *epHead, int fd)
+static BOOL EpollFdNotifiable(int fd)
 {
+#ifdef LOSCFG_NET_LWIP_SACK
+    return (fd >= CONFIG_NFILE_DESCRIPTORS) && (fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS));
+#else
+    (void)fd;
+    return FALSE;
+#endif
+}
+
+/**
+ * @brief 初始化被监听fd哈希表和监听项对象缓存，调用者持有g_epollMutex
+ */
+static VOID EpollWatchInit(VOID)
+{
+    UINT32 intSave;
     int i;
-    for (i = 0; i < epHead->nodeCount; i++) {  // 遍历已注册的文件描述符
-        if (epHead->evs[i].data.fd == fd) {  // 检查是否已存在相同文件描述符
-            return -1;  // 已存在返回-1
+
+    if (g_epollItemCache == NULL) {  // 创建失败时下次再试，期间添加监听项返回ENOMEM
+        g_epollItemCache = LOS_SlabCacheCreate("epoll_item", sizeof(struct epoll_item), NULL);
+    }
+    if (g_epollWatchInited) {
+        return;
+    }
+    LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+    for (i = 0; i < EPOLL_WATCH_HASH_SIZE; i++) {
+        LOS_ListInit(&g_epollWatch[i]);
+    }
+    g_epollWatchInited = TRUE;
+    LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+}
+
+/**
+ * @brief 在epoll实例中查找监听fd的监听项
+ *
+ * @param epHead epoll控制头结构指针
+ * @param fd 被监听的文件描述符
+ * @return 找到的监听项；不存在返回NULL
+ */
+static struct epoll_item *EpollItemFind(struct epoll_head *epHead, int fd)
+{
+    struct epoll_item *item = NULL;
+    struct epoll_item *found = NULL;
+    UINT32 intSave;
+
+    LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+    LOS_DL_LIST_FOR_EACH_ENTRY(item, &g_epollWatch[EPOLL_WATCH_HASH(fd)], struct epoll_item, watchNode) {
+        if ((item->head == epHead) && (item->fd == fd)) {
+            found = item;
+            break;
         }
     }
+    LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+    return found;
+}
+
+/**
+ * @brief 将监听项放入所属实例的就绪链表，不唤醒等待者
+ *
+ * @param item 监听项
+ * @return 监听项由不在就绪链表变为在就绪链表时返回TRUE，此时调用者需唤醒等待者
+ */
+static BOOL EpollReadyMark(struct epoll_item *item)
+{
+    struct epoll_head *epHead = item->head;
+    BOOL added = FALSE;
+    UINT32 intSave;
+
+    LOS_SpinLockSave(&epHead->readyLock, &intSave);
+    if (!item->ready) {
+        LOS_ListTailInsert(&epHead->readyList, &item->readyNode);
+        item->ready = TRUE;
+        added = TRUE;
+    }
+    LOS_SpinUnlockRestore(&epHead->readyLock, intSave);
+    return added;
+}
+
+/**
+ * @brief 将监听项放入所属实例的就绪链表并唤醒等待者，调用者不能持有自旋锁
+ *
+ * @param item 监听项
+ * @return 无
+ */
+static VOID EpollReadyAdd(struct epoll_item *item)
+{
+    (VOID)EpollReadyMark(item);
+    (VOID)LOS_EventWrite(&item->head->event, EPOLL_EVENT_READY);
+}
 
-    return 0;  // 不存在返回0
+/**
+ * @brief 将监听项移出就绪链表
+ *
+ * @param item 监听项
+ * @return 无
+ */
+static VOID EpollReadyDel(struct epoll_item *item)
+{
+    struct epoll_head *epHead = item->head;
+    UINT32 intSave;
+
+    LOS_SpinLockSave(&epHead->readyLock, &intSave);
+    if (item->ready) {
+        LOS_ListDelete(&item->readyNode);
+        item->ready = FALSE;
+    }
+    LOS_SpinUnlockRestore(&epHead->readyLock, intSave);
+}
+
+/**
+ * @brief 被监听fd就绪通知
+ *
+ * 由fd的事件源调用（目前为套接字的协议栈事件回调），把关注这些事件的监听项放入各自实例的就绪链表，
+ * 使epoll_wait只需检查就绪链表，代价与空闲fd数量无关。
+ * 持锁期间只标记就绪并记下需要唤醒的实例，释放g_epollWatchSpin后再写事件；
+ * 实例的notifying计数保证唤醒完成前实例不会被DoEpollClose释放
+ * @param fd 系统文件描述符
+ * @param events 当前就绪的事件
+ * @return 无
+ */
+VOID EpollNotify(int fd, UINT32 events)
+{
+    struct epoll_head *wake[EPOLL_NOTIFY_BATCH];
+    struct epoll_item *item = NULL;
+    UINT32 intSave;
+    BOOL more;
+    int count;
+    int i;
+
+    do {
+        count = 0;
+        more = FALSE;
+        LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+        if (!g_epollWatchInited) {  // 尚未创建过epoll实例
+            LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+            return;
+        }
+        LOS_DL_LIST_FOR_EACH_ENTRY(item, &g_epollWatch[EPOLL_WATCH_HASH(fd)], struct epoll_item, watchNode) {
+            if ((item->fd != fd) || !(item->events & events & EPOLL_EVENTS_MASK)) {
+                continue;
+            }
+            if (count == EPOLL_NOTIFY_BATCH) {  // 已标记的监听项仍在就绪链表上，重新扫描时会跳过
+                more = TRUE;
+                break;
+            }
+            if (EpollReadyMark(item)) {  // 已在就绪链表上的监听项此前已唤醒过等待者
+                item->head->notifying++;
+                wake[count++] = item->head;
+            }
+        }
+        LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+
+        if (count == 0) {
+            continue;
+        }
+        for (i = 0; i < count; i++) {
+            (VOID)LOS_EventWrite(&wake[i]->event, EPOLL_EVENT_READY);
+        }
+        LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+        for (i = 0; i < count; i++) {
+            wake[i]->notifying--;
+        }
+        LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+    } while (more);
+}
+
+/**
+ * @brief 等待通知路径完成对实例的唤醒
+ *
+ * 调用前实例的监听项已全部移出g_epollWatch，不会再有新的通知引用该实例
+ * @param epHead epoll控制头结构指针
+ * @return 无
+ */
+static VOID EpollNotifyDrain(struct epoll_head *epHead)
+{
+    UINT32 intSave;
+    int notifying;
+
+    do {
+        LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+        notifying = epHead->notifying;
+        LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+        if (notifying != 0) {
+            (VOID)LOS_TaskDelay(1);
+        }
+    } while (notifying != 0);
+}
+
+/**
+ * @brief 扩大实例预分配的pollfd数组，保证能容纳全部监听项
+ *
+ * @param epHead epoll控制头结构指针
+ * @return 成功返回0；内存不足返回-1
+ */
+static int EpollCapacityGrow(struct epoll_head *epHead)
+{
+    int capacity = epHead->capacity << 1;
+    struct pollfd *pollFds = NULL;
+    struct epoll_item **batch = NULL;
+
+    pollFds = malloc(sizeof(struct pollfd) * capacity);
+    batch = malloc(sizeof(struct epoll_item *) * capacity);
+    if ((pollFds == NULL) || (batch == NULL)) {
+        free(pollFds);
+        free(batch);
+        return -1;
+    }
+
+    free(epHead->pollFds);
+    free(epHead->batch);
+    epHead->pollFds = pollFds;
+    epHead->batch = batch;
+    epHead->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief EPOLL_CTL_ADD：创建监听项并登记到被监听fd哈希表
+ *
+ * @param epHead epoll控制头结构指针
+ * @param fd 被监听的文件描述符
+ * @param ev 关注的事件与用户数据
+ * @return 成功返回0；失败返回-1
+ */
+static int EpollItemAdd(struct epoll_head *epHead, int fd, const struct epoll_event *ev)
+{
+    struct epoll_item *item = NULL;
+    UINT32 intSave;
+
+    if (EpollItemFind(epHead, fd) != NULL) {  // 检查文件描述符是否已存在
+        set_errno(EEXIST);  // 设置错误号为"文件已存在"
+        return -1;
+    }
+
+    if ((epHead->nodeCount == epHead->capacity) && (EpollCapacityGrow(epHead) != 0)) {
+        set_errno(ENOMEM);  // 设置错误号为"内存不足"
+        return -1;
+    }
+
+    item = (struct epoll_item *)LOS_SlabAlloc(g_epollItemCache);
+    if (item == NULL) {
+        set_errno(ENOMEM);  // 设置错误号为"内存不足"
+        return -1;
+    }
+    (VOID)memset_s(item, sizeof(struct epoll_item), 0, sizeof(struct epoll_item));
+    item->head = epHead;
+    item->fd = fd;
+    item->events = ev->events | POLLERR | POLLHUP;  // 总是关注错误与挂起事件
+    item->data = ev->data;
+
+    LOS_ListTailInsert(&epHead->itemList, &item->itemNode);
+    epHead->nodeCount++;
+    if (!EpollFdNotifiable(fd)) {
+        epHead->pollCount++;
+    }
+
+    LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+    LOS_ListTailInsert(&g_epollWatch[EPOLL_WATCH_HASH(fd)], &item->watchNode);
+    LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+
+    EpollReadyAdd(item);  // 注册前可能已经就绪，先检查一次
+    return 0;
+}
+
+/**
+ * @brief 注销并释放监听项
+ *
+ * @param epHead epoll控制头结构指针
+ * @param item 监听项
+ * @return 无
+ */
+static VOID EpollItemDel(struct epoll_head *epHead, struct epoll_item *item)
+{
+    UINT32 intSave;
+
+    LOS_SpinLockSave(&g_epollWatchSpin, &intSave);
+    LOS_ListDelete(&item->watchNode);
+    LOS_SpinUnlockRestore(&g_epollWatchSpin, intSave);
+    EpollReadyDel(item);
+
+    LOS_ListDelete(&item->itemNode);
+    epHead->nodeCount--;
+    if (!EpollFdNotifiable(item->fd)) {
+        epHead->pollCount--;
+    }
+    LOS_SlabFree(g_epollItemCache, item);
 }
 
 /**
@@ -152,11 +481,18 @@ static int CheckFdExist(struct epoll_head *epHead, int fd)
  */
 static VOID DoEpollClose(struct epoll_head *epHead)
 {
+    struct epoll_item *item = NULL;
+    struct epoll_item *next = NULL;
+
     if (epHead != NULL) {  // 检查epoll头指针是否有效
-        if (epHead->evs != NULL) {  // 检查事件数组指针是否有效
-            free(epHead->evs);  // 释放事件数组内存
+        LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(item, next, &epHead->itemList, struct epoll_item, itemNode) {
+            EpollItemDel(epHead, item);
         }
-
+        EpollNotifyDrain(epHead);
+        (VOID)LOS_EventDestroy(&epHead->event);
+        (VOID)pthread_mutex_destroy(&epHead->lock);
+        free(epHead->pollFds);  // 释放预分配的pollfd数组
+        free(epHead->batch);
         free(epHead);  // 释放epoll头结构内存
     }
 
@@ -164,11 +500,47 @@ static VOID DoEpollClose(struct epoll_head *epHead)
 }
 
 /**
- * @brief 创建epoll实例（不支持的API）
+ * @brief 通过epoll文件描述符获取实例并增加引用计数
+ *
+ * @param fd epoll文件描述符
+ * @return 指向epoll_head结构的指针；失败返回NULL
+ */
+static struct epoll_head *EpollHeadGet(int fd)
+{
+    struct epoll_head *epHead = NULL;
+
+    (VOID)pthread_mutex_lock(&g_epollMutex);
+    epHead = EpollGetDataBuff(fd);
+    if (epHead != NULL) {
+        epHead->refCount++;
+    }
+    (VOID)pthread_mutex_unlock(&g_epollMutex);
+    return epHead;
+}
+
+/**
+ * @brief 释放实例引用，最后一个引用释放时销毁实例
+ *
+ * @param epHead epoll控制头结构指针
+ * @return 无
+ */
+static VOID EpollHeadPut(struct epoll_head *epHead)
+{
+    int refCount;
+
+    (VOID)pthread_mutex_lock(&g_epollMutex);
+    refCount = --epHead->refCount;
+    (VOID)pthread_mutex_unlock(&g_epollMutex);
+    if (refCount == 0) {
+        DoEpollClose(epHead);
+    }
+}
+
+/**
+ * @brief 创建epoll实例
  *
- * 注：epoll_create通过调用epoll_create1实现，其参数'size'无用
- * epoll_create1的简单版本不使用红黑树，因此当fd为正常值（大于0）时，
- * 实际分配的epoll可管理EPOLL_DEFAULT_SIZE数量的文件描述符
+ * 注：epoll_create通过调用epoll_create1实现，其参数'size'无用。
+ * 实例初始可容纳EPOLL_DEFAULT_SIZE个文件描述符，之后在epoll_ctl中按需扩容
  *
  * @param flags 未实际使用的标志位
  * @return 创建成功返回epoll文件描述符；失败返回-1
@@ -183,19 +555,27 @@ int epoll_create1(int flags)
         set_errno(ENOMEM);  // 设置错误号为"内存不足"
         return fd;  // 返回-1表示失败
     }
-
-    /* 实际分配的epoll可管理数量为EPOLL_DEFAULT_SIZE */
-    epHead->size = EPOLL_DEFAULT_SIZE;  // 设置最大可管理文件描述符数量
-    epHead->nodeCount = 0;  // 初始化已注册文件描述符数量为0
-    epHead->evs = malloc(sizeof(struct epoll_event) * EPOLL_DEFAULT_SIZE);  // 分配事件数组内存
-    if (epHead->evs == NULL) {  // 检查事件数组内存分配是否成功
+    (VOID)memset_s(epHead, sizeof(struct epoll_head), 0, sizeof(struct epoll_head));
+
+    epHead->capacity = EPOLL_DEFAULT_SIZE;  // 设置初始容量
+    epHead->pollFds = malloc(sizeof(struct pollfd) * EPOLL_DEFAULT_SIZE);
+    epHead->batch = malloc(sizeof(struct epoll_item *) * EPOLL_DEFAULT_SIZE);
+    if ((epHead->pollFds == NULL) || (epHead->batch == NULL) || (LOS_EventInit(&epHead->event) != LOS_OK)) {
+        free(epHead->pollFds);
+        free(epHead->batch);
         free(epHead);  // 释放已分配的epoll头结构
         set_errno(ENOMEM);  // 设置错误号为"内存不足"
         return fd;  // 返回-1表示失败
     }
+    (VOID)pthread_mutex_init(&epHead->lock, NULL);
+    LOS_SpinInit(&epHead->readyLock);
+    LOS_ListInit(&epHead->itemList);
+    LOS_ListInit(&epHead->readyList);
+    epHead->refCount = 1;  // 文件描述符持有的引用
 
     /* 文件描述符设置，获取系统文件描述符，用于关闭操作 */
     (VOID)pthread_mutex_lock(&g_epollMutex);  // 加锁保护全局数据访问
+    EpollWatchInit();
     fd = EpollAllocSysFd(MAX_EPOLL_FD, epHead);  // 分配系统文件描述符
     if (fd == -1) {  // 检查文件描述符分配是否成功
         (VOID)pthread_mutex_unlock(&g_epollMutex);  // 解锁
@@ -210,7 +590,7 @@ int epoll_create1(int flags)
 /**
  * @brief 关闭epoll文件描述符
  *
- * 由close系统调用触发
+ * 由close系统调用触发。正在epoll_wait的任务持有实例引用，实例在其返回后才释放
  * @param epfd 需要关闭的epoll文件描述符
  * @return 成功返回0；失败返回-1
  */
@@ -226,9 +606,12 @@ int epoll_close(int epfd)
         return -1;  // 返回-1表示失败
     }
 
-    DoEpollClose(epHead);  // 关闭epoll实例并释放资源
     int ret = EpollFreeSysFd(epfd);  // 释放系统文件描述符
     (VOID)pthread_mutex_unlock(&g_epollMutex);  // 解锁
+
+    epHead->closing = TRUE;
+    (VOID)LOS_EventWrite(&epHead->event, EPOLL_EVENT_READY);  // 唤醒等待者
+    EpollHeadPut(epHead);
     return ret;  // 返回操作结果
 }
 
@@ -244,81 +627,172 @@ int epoll_close(int epfd)
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
     struct epoll_head *epHead = NULL;  // 声明epoll头结构指针
-    int i;  // 循环索引变量
+    struct epoll_item *item = NULL;  // 监听项
     int ret = -1;  // 初始化返回值为-1（表示失败）
 
-    (VOID)pthread_mutex_lock(&g_epollMutex);  // 加锁保护全局数据访问
-    epHead = EpollGetDataBuff(epfd);  // 通过文件描述符获取私有数据
+    epHead = EpollHeadGet(epfd);  // 通过文件描述符获取私有数据
     if (epHead == NULL) {  // 检查私有数据是否存在
         set_errno(EBADF);  // 设置错误号为"错误的文件描述符"
-        goto OUT_RELEASE;  // 跳转到解锁并返回
+        return ret;
     }
 
     if (ev == NULL) {  // 检查事件结构指针是否为空
         set_errno(EINVAL);  // 设置错误号为"无效的参数"
-        goto OUT_RELEASE;  // 跳转到解锁并返回
+        EpollHeadPut(epHead);
+        return ret;
     }
 
+    (VOID)pthread_mutex_lock(&epHead->lock);  // 只锁本实例
     switch (op) {  // 根据操作类型执行相应处理
         case EPOLL_CTL_ADD:  // 添加文件描述符事件监听
-            ret = CheckFdExist(epHead, fd);  // 检查文件描述符是否已存在
-            if (ret == -1) {  // 已存在
-                set_errno(EEXIST);  // 设置错误号为"文件已存在"
-                goto OUT_RELEASE;  // 跳转到解锁并返回
-            }
-
-            if (epHead->nodeCount == EPOLL_DEFAULT_SIZE) {  // 检查是否达到最大容量
-                set_errno(ENOMEM);  // 设置错误号为"内存不足"
-                goto OUT_RELEASE;  // 跳转到解锁并返回
-            }
-
-            // 设置事件（添加POLLERR和POLLHUP事件）
-            epHead->evs[epHead->nodeCount].events = ev->events | POLLERR | POLLHUP;
-            epHead->evs[epHead->nodeCount].data.fd = fd;  // 存储文件描述符
-            epHead->nodeCount++;  // 增加已注册文件描述符计数
-            ret = 0;  // 设置返回值为成功
+            ret = EpollItemAdd(epHead, fd, ev);
             break;
         case EPOLL_CTL_DEL:  // 删除文件描述符事件监听
-            for (i = 0; i < epHead->nodeCount; i++) {  // 遍历已注册的文件描述符
-                if (epHead->evs[i].data.fd != fd) {  // 找到匹配的文件描述符
-                    continue;
-                }
-
-                if (i != epHead->nodeCount - 1) {  // 如果不是最后一个元素
-                    // 移动数组元素覆盖当前位置
-                    memmove_s(&epHead->evs[i], epHead->nodeCount - i, &epHead->evs[i + 1],
-                              epHead->nodeCount - i);
-                }
-                epHead->nodeCount--;  // 减少已注册文件描述符计数
-                ret = 0;  // 设置返回值为成功
-                goto OUT_RELEASE;  // 跳转到解锁并返回
+            item = EpollItemFind(epHead, fd);
+            if (item == NULL) {
+                set_errno(ENOENT);  // 设置错误号为"文件不存在"
+                break;
             }
-            set_errno(ENOENT);  // 设置错误号为"文件不存在"
+            EpollItemDel(epHead, item);
+            ret = 0;  // 设置返回值为成功
             break;
         case EPOLL_CTL_MOD:  // 修改文件描述符事件监听
-            for (i = 0; i < epHead->nodeCount; i++) {  // 遍历已注册的文件描述符
-                if (epHead->evs[i].data.fd == fd) {  // 找到匹配的文件描述符
-                    // 更新事件（添加POLLERR和POLLHUP事件）
-                    epHead->evs[i].events = ev->events | POLLERR | POLLHUP;
-                    ret = 0;  // 设置返回值为成功
-                    goto OUT_RELEASE;  // 跳转到解锁并返回
-                }
+            item = EpollItemFind(epHead, fd);
+            if (item == NULL) {
+                set_errno(ENOENT);  // 设置错误号为"文件不存在"
+                break;
             }
-            set_errno(ENOENT);  // 设置错误号为"文件不存在"
+            // 更新事件（添加POLLERR和POLLHUP事件），EPOLLONESHOT触发后也由此重新使能
+            item->events = ev->events | POLLERR | POLLHUP;
+            item->data = ev->data;
+            EpollReadyAdd(item);  // 按新的事件重新检查一次
+            ret = 0;  // 设置返回值为成功
             break;
         default:  // 无效的操作类型
             set_errno(EINVAL);  // 设置错误号为"无效的参数"
             break;
     }
+    (VOID)pthread_mutex_unlock(&epHead->lock);
 
-OUT_RELEASE:
-    (VOID)pthread_mutex_unlock(&g_epollMutex);  // 解锁
+    EpollHeadPut(epHead);
     return ret;  // 返回操作结果
 }
 
+/**
+ * @brief 上报一个就绪的监听项，并按触发方式更新其状态
+ *
+ * 水平触发的监听项重新放回就绪链表，下次等待时再次检查；边沿触发的等待下一次通知；
+ * EPOLLONESHOT的监听项上报后停用，直到EPOLL_CTL_MOD重新使能
+ * @param item 监听项
+ * @param revents 就绪的事件
+ * @param ev 输出的事件
+ * @return 无
+ */
+static VOID EpollItemReport(struct epoll_item *item, UINT32 revents, struct epoll_event *ev)
+{
+    ev->events = revents;  // 存储就绪事件类型
+    ev->data = item->data;  // 返回注册时的用户数据
+
+    if (item->events & EPOLLONESHOT) {
+        item->events &= ~EPOLL_EVENTS_MASK;
+    } else if (!(item->events & EPOLLET)) {
+        EpollReadyAdd(item);
+    }
+}
+
+/**
+ * @brief 检查就绪链表上的监听项，收集就绪事件
+ *
+ * 只检查被通知过的监听项，代价与空闲fd数量无关
+ * @param epHead epoll控制头结构指针，调用者持有epHead->lock
+ * @param evs 输出的就绪事件数组
+ * @param maxevents 最多可返回的事件数量
+ * @return 就绪事件数量
+ */
+static int EpollReadyCollect(struct epoll_head *epHead, struct epoll_event *evs, int maxevents)
+{
+    struct epoll_item *item = NULL;
+    UINT32 intSave;
+    int count = 0;
+    int ready = 0;
+    int i;
+
+    LOS_SpinLockSave(&epHead->readyLock, &intSave);
+    while (!LOS_ListEmpty(&epHead->readyList) && (count < maxevents)) {
+        item = LOS_DL_LIST_ENTRY(epHead->readyList.pstNext, struct epoll_item, readyNode);
+        LOS_ListDelete(&item->readyNode);
+        item->ready = FALSE;  // 检查期间的新通知会把它重新放回就绪链表
+        if ((item->events & EPOLL_EVENTS_MASK) == 0) {  // EPOLLONESHOT已停用
+            continue;
+        }
+        epHead->batch[count] = item;
+        epHead->pollFds[count].fd = item->fd;
+        epHead->pollFds[count].events = (short)(item->events & EPOLL_EVENTS_MASK);
+        epHead->pollFds[count].revents = 0;
+        count++;
+    }
+    LOS_SpinUnlockRestore(&epHead->readyLock, intSave);
+
+    if ((count == 0) || (poll(epHead->pollFds, count, 0) <= 0)) {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (epHead->pollFds[i].revents != 0) {
+            EpollItemReport(epHead->batch[i], (UINT32)(UINT16)epHead->pollFds[i].revents, &evs[ready]);
+            ready++;
+        }
+    }
+    return ready;
+}
+
+/**
+ * @brief 对全部监听项执行poll，用于监听了不会主动通知就绪的fd的实例
+ *
+ * @param epHead epoll控制头结构指针，调用者持有epHead->lock
+ * @param evs 输出的就绪事件数组
+ * @param maxevents 最多可返回的事件数量
+ * @param timeout 超时时间（毫秒），-1表示无限等待
+ * @return 就绪事件数量
+ */
+static int EpollPollAll(struct epoll_head *epHead, struct epoll_event *evs, int maxevents, int timeout)
+{
+    struct epoll_item *item = NULL;
+    int count = 0;
+    int ready = 0;
+    int i;
+
+    // 初始化pollfd数组，使用预分配的内存
+    LOS_DL_LIST_FOR_EACH_ENTRY(item, &epHead->itemList, struct epoll_item, itemNode) {
+        if ((item->events & EPOLL_EVENTS_MASK) == 0) {  // EPOLLONESHOT已停用
+            continue;
+        }
+        epHead->batch[count] = item;
+        epHead->pollFds[count].fd = item->fd;  // 设置文件描述符
+        epHead->pollFds[count].events = (short)(item->events & EPOLL_EVENTS_MASK);  // 设置关注的事件
+        epHead->pollFds[count].revents = 0;
+        count++;
+    }
+
+    if (poll(epHead->pollFds, count, timeout) <= 0) {  // poll返回0（超时）或-1（错误）
+        return 0;
+    }
+
+    // 收集就绪事件
+    for (i = 0; (i < count) && (ready < maxevents); i++) {
+        if (epHead->pollFds[i].revents != 0) {  // 检查是否有就绪事件
+            EpollItemReport(epHead->batch[i], (UINT32)(UINT16)epHead->pollFds[i].revents, &evs[ready]);
+            ready++;
+        }
+    }
+    return ready;
+}
+
 /**
  * @brief 等待epoll实例中的文件描述符上的事件
  *
+ * 监听的fd都会主动通知时，只检查就绪链表，链表为空时在实例事件上睡眠，睡眠期间不持有实例锁；
+ * 否则退回对全部监听项poll。等待路径不分配内存
  * @param epfd epoll实例的文件描述符
  * @param evs 指向epoll_event数组的指针，用于存储就绪事件
  * @param maxevents 最多可返回的事件数量
@@ -328,64 +802,47 @@ OUT_RELEASE:
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents, int timeout)
 {
     struct epoll_head *epHead = NULL;  // 声明epoll头结构指针
-    int ret = -1;  // 初始化返回值为-1（表示失败）
-    int counter;  // 循环计数变量
-    int i;  // 循环索引变量
-    struct pollfd *pFd = NULL;  // 声明pollfd结构指针，用于调用poll
-    int pollSize;  // poll操作的文件描述符数量
+    UINT64 start = LOS_TickCountGet();  // 开始等待的时刻
+    UINT64 elapsed;  // 已等待的tick数
+    UINT32 ticks = (timeout > 0) ? LOS_MS2Tick((UINT32)timeout) : 0;  // 超时时间对应的tick数
+    int ret = 0;  // 就绪事件数量
 
-    (VOID)pthread_mutex_lock(&g_epollMutex);  // 加锁保护全局数据访问
-    epHead = EpollGetDataBuff(epfd);  // 通过文件描述符获取私有数据
+    epHead = EpollHeadGet(epfd);  // 通过文件描述符获取私有数据
     if (epHead == NULL) {  // 检查私有数据是否存在
         set_errno(EBADF);  // 设置错误号为"错误的文件描述符"
-        goto OUT_RELEASE;  // 跳转到解锁并返回
+        return -1;
     }
 
     if ((maxevents <= 0) || (evs == NULL)) {  // 检查参数有效性
         set_errno(EINVAL);  // 设置错误号为"无效的参数"
-        goto OUT_RELEASE;  // 跳转到解锁并返回
-    }
-
-    // 确定poll操作的文件描述符数量（不超过已注册数量和maxevents）
-    if (maxevents > epHead->nodeCount) {
-        pollSize = epHead->nodeCount;
-    } else {
-        pollSize = maxevents;
-    }
-
-    pFd = malloc(sizeof(struct pollfd) * pollSize);  // 分配pollfd数组内存
-    if (pFd == NULL) {  // 检查内存分配是否成功
-        set_errno(EINVAL);  // 设置错误号为"无效的参数"
-        goto OUT_RELEASE;  // 跳转到解锁并返回
+        EpollHeadPut(epHead);
+        return -1;
     }
 
-    // 初始化pollfd数组
-    for (i = 0; i < pollSize; i++) {
-        pFd[i].fd = epHead->evs[i].data.fd;  // 设置文件描述符
-        pFd[i].events = (short)epHead->evs[i].events;  // 设置关注的事件
-    }
-
-
-    ret = poll(pFd, pollSize, timeout);  // 调用poll等待事件
-    if (ret <= 0) {  // poll返回0（超时）或-1（错误）
-        free(pFd);  // 释放pollfd数组内存
-        ret = 0;  // 设置返回值为0
-        goto OUT_RELEASE;  // 跳转到解锁并返回
-    }
+    (VOID)pthread_mutex_lock(&epHead->lock);
+    while (!epHead->closing) {
+        elapsed = LOS_TickCountGet() - start;
+        if (epHead->pollCount > 0) {
+            if (timeout > 0) {  // 扣除已等待的时间
+                timeout -= (int)LOS_Tick2MS((UINT32)elapsed);
+                timeout = (timeout < 0) ? 0 : timeout;
+            }
+            ret = EpollPollAll(epHead, evs, maxevents, timeout);
+            break;
+        }
 
-    // 收集就绪事件
-    for (i = 0, counter = 0; i < ret && counter < pollSize; counter++) {
-        if (pFd[counter].revents != 0) {  // 检查是否有就绪事件
-            evs[i].data.fd = pFd[counter].fd;  // 存储就绪文件描述符
-            evs[i].events  = pFd[counter].revents;  // 存储就绪事件类型
-            i++;  // 增加就绪事件计数
+        ret = EpollReadyCollect(epHead, evs, maxevents);
+        if ((ret != 0) || (timeout == 0) || ((timeout > 0) && (elapsed >= ticks))) {
+            break;
         }
-    }
 
-    free(pFd);  // 释放pollfd数组内存
-    ret = i;  // 设置返回值为就绪事件数量
+        (VOID)pthread_mutex_unlock(&epHead->lock);  // 睡眠期间允许epoll_ctl
+        (VOID)LOS_EventRead(&epHead->event, EPOLL_EVENT_READY, LOS_WAITMODE_OR | LOS_WAITMODE_CLR,
+                            (timeout < 0) ? LOS_WAIT_FOREVER : (UINT32)(ticks - elapsed));
+        (VOID)pthread_mutex_lock(&epHead->lock);
+    }
+    (VOID)pthread_mutex_unlock(&epHead->lock);
 
-OUT_RELEASE:
-    (VOID)pthread_mutex_unlock(&g_epollMutex);  // 解锁
+    EpollHeadPut(epHead);
     return ret;  // 返回就绪事件数量
-}
\ No newline at end of file
+}
@@ -108,7 +108,16 @@ typedef struct tagOsBcache {  // 块缓存实例结构体，管理整个块缓
     BcacheWriteFun bwriteFun;     /* block write function */  // 块写入函数
     BcachePrereadFun prereadFun;  /* block preread function */  // 块预读函数
     UINT8 *rwBuffer;              /* buffer for bcache block */  // 块缓存读写缓冲区
-    pthread_mutex_t bcacheMutex;  /* mutex for bcache */  // 块缓存互斥锁
+    /*
+     * mutex for bcache, one lock for the whole cache. Per-block or per-bucket locking is not
+     * implemented: los_disk_read/los_disk_write and los_part_read/los_part_write hold disk_mutex
+     * around their bcache calls, and block misses do device I/O with this lock held, so readers
+     * of different blocks still run one at a time. Letting them overlap needs disk_mutex dropped
+     * across device I/O, a reference on the disk against los_disk_deinit, and blocks that stay
+     * pinned while being filled without this lock. Only the async preread thread comes in
+     * without disk_mutex, and it takes this lock per block.
+     */
+    pthread_mutex_t bcacheMutex;  // 块缓存互斥锁，整个缓存共用一把，读写路径上调用者已持有disk_mutex
     EVENT_CB_S bcacheEvent;       /* event for bcache */  // 块缓存事件
     UINT32 modifiedBlock;         /* number of modified blocks */  // 修改过的块数量
 #ifdef LOSCFG_FS_FAT_CACHE_SYNC_THREAD
@@ -136,6 +145,8 @@ typedef struct tagOsBcache {  // 块缓存实例结构体，管理整个块缓
  * @attention
  * <ul>
  * <li>The block number is automatically adjusted if position is greater than block size.</li>
+ * <li>Contiguous blocks missing from the cache are read from the device in one request. When useRead is FALSE,
+ * whole uncached blocks are read straight into a kernel buffer without passing through the cache.</li>
  * </ul>
  *
  * @retval #0           read succeded
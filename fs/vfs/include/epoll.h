@@ -65,6 +65,8 @@ extern "C" {
 #define EPOLLMSG        0x400  // 消息可用（未实现）
 #define EPOLLERR        0x008  // 错误事件
 #define EPOLLHUP        0x010  // 挂起事件（连接关闭）
+#define EPOLLONESHOT    (1U << 30)  // 上报一次后停用，需EPOLL_CTL_MOD重新使能
+#define EPOLLET         (1U << 31)  // 边沿触发，只在fd通知新事件后上报
 /** @} */
 
 /** @name epoll控制操作类型 */
@@ -98,6 +100,7 @@ int epoll_create1(int flags);
 int epoll_close(int epfd);
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev);
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents, int timeout);
+VOID EpollNotify(int fd, UINT32 events);
 
 #ifdef __cplusplus
 }
@@ -45,21 +45,39 @@ struct PathCache {
     LIST_ENTRY parentEntry;       /* 父vnode中缓存列表的链表项 */
     LIST_ENTRY childEntry;        /* 子vnode中缓存列表的链表项 */
     LIST_ENTRY hashEntry;         /* 哈希表桶中的链表项，用于快速查找 */
+    LIST_ENTRY lruEntry;          /* 全局LRU链表项，内存超限时按此淘汰 */
+    uint32_t hash;                /* 名称与父vnode的哈希值，决定所在分段和桶 */
     uint8_t nameLen;              /* 路径组件名称的长度 */
+    uint8_t referenced;           /* 最近被查找命中过，淘汰扫描时给一次机会 */
 #ifdef LOSCFG_DEBUG_VERSION
     int hit;                      /* 缓存命中计数器，调试版本有效 */
 #endif
     char name[0];                 /* 路径组件名称，柔性数组存储实际字符串 */
 };
 
+/**
+ * @brief 路径缓存统计信息，供procfs展示
+ */
+struct PathCacheStat {
+    uint32_t entries;             /* 缓存项数 */
+    uint32_t buckets;             /* 哈希桶总数 */
+    uint32_t usedBuckets;         /* 非空哈希桶数 */
+    uint32_t maxChain;            /* 最长链长 */
+    uint32_t memSize;             /* 缓存项占用内存（字节） */
+    uint32_t memLimit;            /* 内存上限（字节） */
+    uint32_t evicted;             /* 因内存上限淘汰的缓存项数 */
+};
+
 int PathCacheInit(void);
 int PathCacheFree(struct PathCache *cache);
 struct PathCache *PathCacheAlloc(struct Vnode *parent, struct Vnode *vnode, const char *name, uint8_t len);
 int PathCacheLookup(struct Vnode *parent, const char *name, int len, struct Vnode **vnode);
+int PathCacheLookupPinned(struct Vnode *parent, const char *name, int len, struct Vnode **vnode);
 void VnodePathCacheFree(struct Vnode *vnode);
 void PathCacheMemoryDump(void);
 void PathCacheDump(void);
-LIST_HEAD* GetPathCacheList(void);
+void PathCacheStatGet(struct PathCacheStat *stat);
+LIST_HEAD* GetPathCacheLruList(void);
 #ifdef LOSCFG_DEBUG_VERSION
 void ResetPathCacheHitInfo(int *hit, int *try);
 #endif
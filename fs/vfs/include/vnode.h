@@ -35,6 +35,7 @@
 #include "fs/fs_operation.h"
 #include "fs/file.h"
 #include "los_list.h"
+#include "los_atomic.h"
 
 typedef LOS_DL_LIST LIST_HEAD;  // 定义双向链表头类型
 typedef LOS_DL_LIST LIST_ENTRY; // 定义双向链表节点类型
@@ -109,10 +110,12 @@ enum VnodeType {  // vnode类型枚举
 struct fs_dirent_s;  // 前向声明目录项结构体
 struct VnodeOps;     // 前向声明vnode操作结构体
 struct IATTR;        // 前向声明属性变更结构体
+struct VmPageIndexNode; // 前向声明页缓存索引节点
 
 struct Vnode {  // vnode结构体，代表虚拟文件系统中的一个节点
     enum VnodeType type;                /* vnode type */               // vnode类型
     int useCount;                       /* ref count of users */       // 用户引用计数
+    Atomic pinCount;                    /* pins of lockless lookups */ // 无锁路径查找持有的引用，不受g_vnodeMux保护
     uint32_t hash;                      /* vnode hash */               // vnode哈希值
     uint uid;                           /* uid for dac */              // DAC权限的用户ID
     uint gid;                           /* gid for dac */              // DAC权限的组ID
@@ -130,6 +133,7 @@ struct Vnode {  // vnode结构体，代表虚拟文件系统中的一个节点
     struct Mount *newMount;             /* fs info about who mount on this vnode */ // 挂载在该vnode上的文件系统信息
     char *filePath;                     /* file path of the vnode */   // vnode的文件路径
     struct page_mapping mapping;        /* page mapping of the vnode */ // vnode的页面映射
+    struct VmPageIndexNode *pageIndex;  /* pgoff index of mapping, protected by mapping.list_lock */ // 页缓存基数树根
 #ifdef LOSCFG_MNT_CONTAINER
     int mntCount;                       /* ref count of mounts */      // 挂载引用计数
 #endif
@@ -164,6 +168,13 @@ struct VnodeOps {  // vnode操作函数集结构体
 
 typedef int VfsHashCmp(struct Vnode *vnode, void *arg);  // vnode哈希比较函数指针类型
 
+struct VnodeHashStat {      // vnode哈希表统计信息，供procfs展示
+    uint32_t entries;       // 表中vnode数
+    uint32_t buckets;       // 哈希桶总数
+    uint32_t usedBuckets;   // 非空哈希桶数
+    uint32_t maxChain;      // 最长链长
+};
+
 int VnodesInit(void);
 int VnodeDevInit(void);
 int VnodeAlloc(struct VnodeOps *vop, struct Vnode **newVnode);
@@ -171,22 +182,30 @@ int VnodeFree(struct Vnode *vnode);
 int VnodeLookup(const char *path, struct Vnode **vnode, uint32_t flags);
 int VnodeLookupFullpath(const char *fullpath, struct Vnode **vnode, uint32_t flags);
 int VnodeLookupAt(const char *path, struct Vnode **vnode, uint32_t flags, struct Vnode *orgVnode);
+int VnodeLookupPinned(const char *path, struct Vnode **vnode);
+void VnodePin(struct Vnode *vnode);
+BOOL VnodePinLive(struct Vnode *vnode);
+void VnodeUnpin(struct Vnode *vnode);
+void VnodePinDrain(struct Mount *mount);
 int VnodeHold(void);
 int VnodeDrop(void);
 void VnodeRefDec(struct Vnode *vnode);
-int VnodeFreeAll(const struct Mount *mnt);
+int VnodeFreeAll(struct Mount *mnt);
 int VnodeHashInit(void);
 uint32_t VfsHashIndex(struct Vnode *vnode);
 int VfsHashGet(const struct Mount *mount, uint32_t hash, struct Vnode **vnode, VfsHashCmp *fun, void *arg);
 void VfsHashRemove(struct Vnode *vnode);
+void VnodeHashStatGet(struct VnodeHashStat *stat);
 int VfsHashInsert(struct Vnode *vnode, uint32_t hash);
 void ChangeRoot(struct Vnode *newRoot);
 BOOL VnodeInUseIter(const struct Mount *mount);
 struct Vnode *VnodeGetRoot(void);
+BOOL VnodeIsVirtual(const struct Vnode *vnode);
 void VnodeMemoryDump(void);
 mode_t GetUmask(void);
 int VfsPermissionCheck(uint fuid, uint fgid, mode_t fileMode, int accMode);
 int VfsVnodePermissionCheck(const struct Vnode *node, int accMode);
+int VfsIovDirectCapable(int fd, int isWrite);
 LIST_HEAD* GetVnodeFreeList(void);
 LIST_HEAD* GetVnodeActiveList(void);
 LIST_HEAD* GetVnodeVirtualList(void);
@@ -693,7 +693,7 @@ static void VnodeTryFree(struct Vnode *vnode)
     }
 
     VnodePathCacheFree(vnode);  // 释放vnode路径缓存
-    LOS_ListDelete(&(vnode->hashEntry));  // 从哈希表中删除
+    VfsHashRemove(vnode);  // 从哈希表中删除
     LOS_ListDelete(&vnode->actFreeEntry);  // 从活动列表中删除
 
     if (vnode->vop->Reclaim) { // 检查是否有Reclaim操作
@@ -747,6 +747,7 @@ int ForceUmountDev(struct Vnode *dev)
     }
     origin = mnt->vnodeBeCovered;  // 获取被覆盖的原始vnode
 
+    VnodePinDrain(mnt);  // 阻止并排空无锁查找的钉住，之后才能回收vnode和挂载结构
     FileDisableAndClean(mnt);  // 禁用并清理文件
     VnodeTryFreeAll(mnt);  // 尝试释放所有vnode
     ret = mnt->ops->Unmount(mnt, &dev);  // 调用文件系统卸载操作
@@ -46,6 +46,8 @@
 #include "los_task_pri.h"
 #include "capability_api.h"
 #include "vnode.h"
+#include "vfs_config.h"
+#include "fs/mount.h"
 #define MAX_DIR_ENT 1024  // 最大目录项数量
 
 /**
@@ -161,6 +163,31 @@ int VfsPermissionCheck(uint fuid, uint fgid, uint fileMode, int accMode)
     return 1;  // 权限不满足，返回1
 }
 
+/**
+ * @brief 判断readv/writev能否对fd逐段直接读写，免去中转缓冲区
+ * @param fd 文件描述符
+ * @param isWrite 非0表示写入
+ * @return 可以逐段直接读写返回1，否则返回0
+ * @note 只有普通文件和块设备可以逐段读写：管道、socket和终端一次read可能阻塞或按报文截断，
+ *       一次write的数据须整体到达对端。O_APPEND的写入逐段进行时，段之间可能插入其他写者的数据，
+ *       也要合并成一次write以保证整体追加
+ */
+int VfsIovDirectCapable(int fd, int isWrite)
+{
+    struct file *filep = NULL;  // 文件结构体指针
+
+    if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS) {  // socket等非文件描述符
+        return 0;
+    }
+    if ((fs_getfilep(fd, &filep) < 0) || (filep->f_vnode == NULL)) {  // 交给中转路径报告错误
+        return 0;
+    }
+    if (isWrite && ((unsigned int)filep->f_oflags & O_APPEND)) {  // 追加写须保持整体原子
+        return 0;
+    }
+    return (filep->f_vnode->type == VNODE_TYPE_REG) || (filep->f_vnode->type == VNODE_TYPE_BLK);
+}
+
 #ifdef VFS_USING_WORKDIR
 /**
  * @brief 设置当前工作目录
@@ -354,6 +381,7 @@ int chown(const char *pathname, uid_t owner, gid_t group)
 
 /**
  * @brief 检查文件访问权限
+ * @details 路径在路径缓存中时走无锁查找，只读取vnode上的权限与挂载标志，不经过g_vnodeMux
  * @param path 文件路径
  * @param amode 访问模式
  * @return 成功返回0，失败返回VFS_ERROR
@@ -361,32 +389,26 @@ int chown(const char *pathname, uid_t owner, gid_t group)
 int access(const char *path, int amode)
 {
     int ret;  // 错误码
-    struct stat buf;  // 文件状态结构体
-    struct statfs fsBuf;  // 文件系统状态结构体
+    struct Vnode *vnode = NULL;  // 目标vnode
 
-    ret = statfs(path, &fsBuf);  // 获取文件系统状态
-    if (ret != 0) {  // 检查获取是否成功
-        if (get_errno() != ENOSYS) {  // 如果错误不是ENOSYS
-            return VFS_ERROR;  // 返回错误
-        }
-        /* 设备没有statfs操作，需要devfs在后续处理 */
-    }
-
-    if ((fsBuf.f_flags & MS_RDONLY) && ((unsigned int)amode & W_OK)) {  // 如果文件系统只读且请求写权限
-        set_errno(EROFS);  // 设置错误码为EROFS
+    ret = VnodeLookupPinned(path, &vnode);  // 查找并钉住vnode
+    if (ret != LOS_OK) {  // 检查查找是否成功
+        set_errno(-ret);  // 设置错误码
         return VFS_ERROR;  // 返回错误
     }
 
-    ret = stat(path, &buf);  // 获取文件状态
-    if (ret != 0) {  // 检查获取是否成功
-        return VFS_ERROR;  // 返回错误
+    if (((unsigned int)amode & W_OK) && (vnode->originMount != NULL) &&
+        (vnode->originMount->mountFlags & MS_RDONLY)) {  // 如果文件系统只读且请求写权限
+        ret = -EROFS;
+    } else if (VfsVnodePermissionCheck(vnode, amode)) {  // 检查访问权限
+        ret = -EACCES;
     }
+    VnodeUnpin(vnode);  // 释放vnode
 
-    if (VfsPermissionCheck(buf.st_uid, buf.st_gid, buf.st_mode, amode)) {  // 检查访问权限
-        set_errno(EACCES);  // 设置错误码为EACCES
+    if (ret != OK) {
+        set_errno(-ret);  // 设置错误码
         return VFS_ERROR;  // 返回错误
     }
-
     return OK;  // 成功返回0
 }
 
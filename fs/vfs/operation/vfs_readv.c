@@ -38,6 +38,50 @@
 #include "user_copy.h"
 #include "stdio.h"
 #include "limits.h"
+#include "vnode.h"
+
+/**
+ * @brief 逐段直接读入各iovec缓冲区（分散读取快速路径）
+ * @param fd 文件描述符
+ * @param iov iovec结构体数组，包含多个缓冲区的地址和长度
+ * @param iovcnt iovec结构体数组元素个数
+ * @param offset 读取偏移量指针（NULL表示使用当前文件指针）
+ * @return 成功返回读取的总字节数，首段即失败返回VFS_ERROR
+ * @note 遇到短读（文件末尾）立即停止，中途出错时返回已读字节数
+ */
+static ssize_t iov_read_direct(int fd, const struct iovec *iov, int iovcnt, off_t *offset)
+{
+    ssize_t totalbytesread = 0;  // 总读取字节数
+    ssize_t ret;                 // 单段读取结果
+    size_t buflen = 0;           // 缓冲区总长度
+    int i;                       // 循环计数器
+
+    for (i = 0; i < iovcnt; ++i) {  // 先整体校验长度，与中转路径保持一致
+        if (SSIZE_MAX - buflen < iov[i].iov_len) {  // 检查是否溢出
+            set_errno(EINVAL);  // 设置无效参数错误
+            return VFS_ERROR;
+        }
+        buflen += iov[i].iov_len;  // 累加缓冲区长度
+    }
+
+    for (i = 0; i < iovcnt; ++i) {  // 逐段直接读入用户缓冲区
+        if (iov[i].iov_len == 0) {  // 跳过空缓冲区
+            continue;
+        }
+        ret = (offset == NULL) ? read(fd, iov[i].iov_base, iov[i].iov_len)
+                               : pread(fd, iov[i].iov_base, iov[i].iov_len, *offset + totalbytesread);
+        if (ret < 0) {  // 读取失败：已有数据则返回部分结果
+            return (totalbytesread > 0) ? totalbytesread : VFS_ERROR;
+        }
+        totalbytesread += ret;  // 累加已读字节数
+        if ((size_t)ret < iov[i].iov_len) {  // 短读表示已到文件末尾
+            break;
+        }
+    }
+
+    return totalbytesread;
+}
+
 /**
  * @brief 预读缓冲区并进行合法性检查
  * @param fd 文件描述符
@@ -114,6 +158,10 @@ ssize_t vfs_readv(int fd, const struct iovec *iov, int iovcnt, off_t *offset)
     ssize_t totalbytesread = 0; // 总读取字节数
     ssize_t bytesleft;          // 剩余未复制的字节数
 
+    if ((iov != NULL) && (iovcnt <= IOV_MAX) && VfsIovDirectCapable(fd, 0)) {  // 普通文件直接逐段读取
+        return iov_read_direct(fd, iov, iovcnt, offset);
+    }
+
     // 调用辅助函数预读数据并检查
     buf = pread_buf_and_check(fd, iov, iovcnt, &totalbytesread, offset);
     if (buf == NULL) {  // 检查缓冲区是否有效
@@ -37,6 +37,41 @@
 #include "fs/file.h"
 #include "user_copy.h"
 #include "limits.h"
+#include "vnode.h"
+
+/**
+ * @brief 逐段直接写出各iovec缓冲区（集中写入快速路径）
+ * @param fd 文件描述符
+ * @param iov iovec结构体数组，包含要写入的数据
+ * @param iovcnt iovec结构体数量
+ * @param offset 文件偏移量指针，为NULL时使用当前文件偏移
+ * @return 成功写入的总字节数，首段即失败返回VFS_ERROR
+ * @note 遇到短写（如空间不足）立即停止，中途出错时返回已写字节数
+ */
+static ssize_t iov_write_direct(int fd, const struct iovec *iov, int iovcnt, off_t *offset)
+{
+    ssize_t totalbyteswritten = 0;          // 成功写入的总字节数
+    ssize_t ret;                            // 单段写入结果
+    int i;                                  // 循环计数器
+
+    for (i = 0; i < iovcnt; ++i) {
+        if (iov[i].iov_len == 0) {          // 跳过空的iovec元素
+            continue;
+        }
+        ret = (offset == NULL) ? write(fd, iov[i].iov_base, iov[i].iov_len)
+                               : pwrite(fd, iov[i].iov_base, iov[i].iov_len, *offset + totalbyteswritten);
+        if (ret < 0) {                      // 写入失败：已有数据则返回部分结果
+            return (totalbyteswritten > 0) ? totalbyteswritten : VFS_ERROR;
+        }
+        totalbyteswritten += ret;           // 累加已写字节数
+        if ((size_t)ret < iov[i].iov_len) { // 短写，不再继续
+            break;
+        }
+    }
+
+    return totalbyteswritten;
+}
+
 /**
  * @brief 将分散的iovec数据复制到连续缓冲区
  * @param buf 目标连续缓冲区
@@ -123,6 +158,10 @@ ssize_t vfs_writev(int fd, const struct iovec *iov, int iovcnt, off_t *offset)
         return 0;                           // 返回0，表示成功写入0字节
     }
 
+    if (VfsIovDirectCapable(fd, 1)) {           // 普通文件直接逐段写入，无需中转缓冲区
+        return iov_write_direct(fd, iov, iovcnt, offset);
+    }
+
     totallen = buflen * sizeof(char);       // 计算缓冲区总大小
 #ifdef LOSCFG_KERNEL_VM                     // 如果启用了内核虚拟内存
     buf = (char *)LOS_VMalloc(totallen);    // 使用内核虚拟内存分配
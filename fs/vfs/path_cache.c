@@ -28,16 +28,48 @@
  * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+
 #include "path_cache.h"
 #include "los_config.h"
 #include "los_hash.h"
+#include "los_spinlock.h"
+#include "los_slab.h"
 #include "stdlib.h"
 #include "limits.h"
 #include "vnode.h"
-// 路径缓存哈希掩码，用于计算哈希表索引（哈希表大小-1）
-#define PATH_CACHE_HASH_MASK (LOSCFG_MAX_PATH_CACHE_SIZE - 1)
-// 路径缓存哈希表，数组元素为链表头
-LIST_HEAD g_pathCacheHashEntrys[LOSCFG_MAX_PATH_CACHE_SIZE];
+#ifdef LOSCFG_DRIVERS_RANDOM
+#include "hisoc/random.h"
+#endif
+
+/*
+ * 路径缓存哈希表分成PATH_CACHE_STRIPES个分段，哈希值低位选分段，其余位在分段内选桶。
+ * 每个分段有自己的锁和桶数组，按负载各自在线扩容：重新散列只发生在同一分段内，
+ * 持有分段锁的无锁路径查找(PathCacheLookupPinned)看到的总是完整的一张表。
+ * 增删缓存项、扩容和淘汰都在g_vnodeMux下进行，分段锁只用于与无锁查找互斥
+ */
+#define PATH_CACHE_STRIPE_BITS      6
+#define PATH_CACHE_STRIPES          (1U << PATH_CACHE_STRIPE_BITS)
+#define PATH_CACHE_STRIPE_MASK      (PATH_CACHE_STRIPES - 1)
+#define PATH_CACHE_STRIPE_MAX_SIZE  256     /* 每个分段最多的桶数，全表最多16384个桶 */
+#define PATH_CACHE_LOAD_FACTOR      2       /* 平均链长超过该值时分段扩容一倍 */
+#define PATH_CACHE_MEM_LIMIT        ((size_t)LOSCFG_PATH_CACHE_MEM_LIMIT * 1024) /* 1024: KB to bytes */
+#define PATH_CACHE_ITEM_SIZE(pc)    (sizeof(struct PathCache) + (pc)->nameLen + 1)
+#define PATH_CACHE_SHORT_NAME       31      /* 不超过该长度的名称从对象缓存分配，更长的走malloc */
+
+struct PathCacheStripe {
+    SPIN_LOCK_S lock;       /* 保护本分段的桶数组与链表 */
+    LIST_HEAD *buckets;     /* 桶数组 */
+    uint32_t mask;          /* 桶数-1 */
+    uint32_t count;         /* 缓存项数 */
+};
+
+static struct PathCacheStripe g_pathCacheStripes[PATH_CACHE_STRIPES];
+static LIST_HEAD g_pathCacheLruList;    /* 所有缓存项，表头最久未用，二次机会（CLOCK）近似LRU */
+static uint32_t g_pathCacheNum = 0;     /* 缓存项总数 */
+static size_t g_pathCacheMemSize = 0;   /* 缓存项占用的内存 */
+static uint32_t g_pathCacheEvicted = 0; /* 因内存上限淘汰的缓存项数 */
+static uint32_t g_pathCacheSeed = 0;    /* 哈希种子 */
+static LosSlabCache *g_pathCacheSlab = NULL; /* 短名称缓存项的对象缓存 */
 
 #ifdef LOSCFG_DEBUG_VERSION                          // 如果启用调试版本
 // 路径缓存命中总数
@@ -68,15 +100,66 @@ void ResetPathCacheHitInfo(int *hit, int *try)
 #define TRACE_HIT_CACHE(pc)
 #endif
 
+/**
+ * @brief 分配并初始化一个桶数组
+ * @param size 桶数
+ * @return 成功返回桶数组，失败返回NULL
+ */
+static LIST_HEAD *PathCacheBucketsAlloc(uint32_t size)
+{
+    LIST_HEAD *buckets = (LIST_HEAD *)malloc(sizeof(LIST_HEAD) * size);
+    if (buckets == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        LOS_ListInit(&buckets[i]);
+    }
+    return buckets;
+}
+
 /**
  * @brief 初始化路径缓存哈希表
+ * @details 初始总桶数为LOSCFG_MAX_PATH_CACHE_SIZE（向下取2的幂），平均分到各分段
  * @return 成功返回LOS_OK，否则返回错误码
  */
 int PathCacheInit(void)
 {
-    for (int i = 0; i < LOSCFG_MAX_PATH_CACHE_SIZE; i++) {  // 遍历哈希表所有桶
-        LOS_ListInit(&g_pathCacheHashEntrys[i]);            // 初始化每个桶的链表头
+    uint32_t size = LOSCFG_MAX_PATH_CACHE_SIZE / PATH_CACHE_STRIPES;
+
+    if (size == 0) {
+        size = 1;
+    }
+    while ((size & (size - 1)) != 0) {                      // 向下取2的幂
+        size &= size - 1;
+    }
+    if (size > PATH_CACHE_STRIPE_MAX_SIZE) {
+        size = PATH_CACHE_STRIPE_MAX_SIZE;
     }
+
+    for (uint32_t i = 0; i < PATH_CACHE_STRIPES; i++) {  // 遍历所有分段
+        struct PathCacheStripe *stripe = &g_pathCacheStripes[i];
+        stripe->buckets = PathCacheBucketsAlloc(size);
+        if (stripe->buckets == NULL) {
+            PRINT_ERR("pathCache init failed, no memory!\n");
+            return -ENOMEM;
+        }
+        LOS_SpinInit(&stripe->lock);
+        stripe->mask = size - 1;
+        stripe->count = 0;
+    }
+    g_pathCacheSlab = LOS_SlabCacheCreate("path_cache", sizeof(struct PathCache) + PATH_CACHE_SHORT_NAME + 1, NULL);
+    if (g_pathCacheSlab == NULL) {
+        PRINT_ERR("pathCache init failed, no memory!\n");
+        return -ENOMEM;
+    }
+    LOS_ListInit(&g_pathCacheLruList);
+#ifdef LOSCFG_DRIVERS_RANDOM
+    /* 硬件随机数作种子，构造的文件名无法预知会落到哪条链 */
+    HiRandomHwInit();
+    (VOID)HiRandomHwGetInteger(&g_pathCacheSeed);
+    HiRandomHwDeinit();
+#endif
+    /* 没有硬件随机数时种子固定为0，链长只靠扩容控制 */
     return LOS_OK;                                          // 返回初始化成功
 }
 
@@ -85,41 +168,64 @@ int PathCacheInit(void)
  */
 void PathCacheDump(void)
 {
+    struct PathCache *pc = NULL;                            // 路径缓存项指针
+
     PRINTK("-------->pathCache dump in\n");              // 打印 dump 开始标记
-    for (int i = 0; i < LOSCFG_MAX_PATH_CACHE_SIZE; i++) {  // 遍历哈希表所有桶
-        struct PathCache *pc = NULL;                        // 路径缓存项指针
-        LIST_HEAD *nhead = &g_pathCacheHashEntrys[i];       // 当前桶的链表头
-
-        // 遍历当前桶中的所有缓存项
-        LOS_DL_LIST_FOR_EACH_ENTRY(pc, nhead, struct PathCache, hashEntry) {
-            // 打印缓存项信息：哈希桶索引、路径名、父/子虚拟节点指针、路径长度
-            PRINTK("    pathCache dump hash %d item %s %p %p %d\n", i,
-                pc->name, pc->parentVnode, pc->childVnode, pc->nameLen);
-        }
+    LOS_DL_LIST_FOR_EACH_ENTRY(pc, &g_pathCacheLruList, struct PathCache, lruEntry) {
+        // 打印缓存项信息：哈希值、路径名、父/子虚拟节点指针、路径长度
+        PRINTK("    pathCache dump hash 0x%08x item %s %p %p %d\n", pc->hash,
+            pc->name, pc->parentVnode, pc->childVnode, pc->nameLen);
     }
     PRINTK("-------->pathCache dump out\n");             // 打印 dump 结束标记
 }
 
 /**
- * @brief 打印路径缓存内存使用情况（调试用）
+ * @brief 统计路径缓存的容量、内存与链长分布
+ * @param stat [输出] 统计信息
  */
-void PathCacheMemoryDump(void)
+void PathCacheStatGet(struct PathCacheStat *stat)
 {
-    int pathCacheNum = 0;                                 // 缓存项总数
-    int nameSum = 0;                                      // 路径名总长度
-    for (int i = 0; i < LOSCFG_MAX_PATH_CACHE_SIZE; i++) { // 遍历哈希表所有桶
-        LIST_HEAD *dhead = &g_pathCacheHashEntrys[i];      // 当前桶的链表头
-        struct PathCache *dent = NULL;                     // 路径缓存项指针
-
-        // 遍历当前桶中的所有缓存项
-        LOS_DL_LIST_FOR_EACH_ENTRY(dent, dhead, struct PathCache, hashEntry) {
-            pathCacheNum++;                                // 增加缓存项计数
-            nameSum += dent->nameLen;                      // 累加路径名长度
+    uint32_t intSave;
+
+    (void)memset_s(stat, sizeof(struct PathCacheStat), 0, sizeof(struct PathCacheStat));
+    for (uint32_t i = 0; i < PATH_CACHE_STRIPES; i++) {
+        struct PathCacheStripe *stripe = &g_pathCacheStripes[i];
+        LOS_SpinLockSave(&stripe->lock, &intSave);
+        for (uint32_t j = 0; j <= stripe->mask; j++) {
+            uint32_t len = 0;
+            LIST_HEAD *node = NULL;
+            LOS_DL_LIST_FOR_EACH(node, &stripe->buckets[j]) {
+                len++;
+            }
+            if (len != 0) {
+                stat->usedBuckets++;
+            }
+            if (len > stat->maxChain) {
+                stat->maxChain = len;
+            }
         }
+        stat->buckets += stripe->mask + 1;
+        stat->entries += stripe->count;
+        LOS_SpinUnlockRestore(&stripe->lock, intSave);
     }
-    PRINTK("pathCache number = %d\n", pathCacheNum);       // 打印缓存项总数
+    stat->memSize = (uint32_t)g_pathCacheMemSize;
+    stat->memLimit = (uint32_t)PATH_CACHE_MEM_LIMIT;
+    stat->evicted = g_pathCacheEvicted;
+}
+
+/**
+ * @brief 打印路径缓存内存使用情况（调试用）
+ */
+void PathCacheMemoryDump(void)
+{
+    struct PathCacheStat stat;
+
+    PathCacheStatGet(&stat);
+    PRINTK("pathCache number = %u\n", stat.entries);        // 打印缓存项总数
     // 打印总内存使用量：缓存项结构体大小 + 路径名字符串大小
-    PRINTK("pathCache memory size = %d(B)\n", pathCacheNum * sizeof(struct PathCache) + nameSum);
+    PRINTK("pathCache memory size = %u(B), limit = %u(B)\n", stat.memSize, stat.memLimit);
+    PRINTK("pathCache buckets = %u, used = %u, max chain = %u, evicted = %u\n",
+        stat.buckets, stat.usedBuckets, stat.maxChain, stat.evicted);
 }
 
 /**
@@ -133,10 +239,50 @@ static uint32_t NameHash(const char *name, int len, struct Vnode *dvp)
 {
     uint32_t hash;
     // 使用FNV-1a算法计算路径名字符串的哈希
-    hash = LOS_HashFNV32aBuf(name, len, FNV1_32A_INIT);
-    // 结合父目录虚拟节点指针计算最终哈希值
+    hash = LOS_HashFNV32aBuf(name, len, FNV1_32A_INIT ^ g_pathCacheSeed);
+    // 结合父目录虚拟节点指针计算哈希值
     hash = LOS_HashFNV32aBuf(&dvp, sizeof(struct Vnode *), hash);
-    return hash;
+    // 终结混合，使低位（分段号和桶号）与每个输入位都相关
+    return LOS_HashMix32(hash);
+}
+
+/**
+ * @brief 取哈希值对应的桶，调用者持有分段锁或g_vnodeMux
+ */
+static inline LIST_HEAD *PathCacheBucket(const struct PathCacheStripe *stripe, uint32_t hash)
+{
+    return &stripe->buckets[(hash >> PATH_CACHE_STRIPE_BITS) & stripe->mask];
+}
+
+/**
+ * @brief 分段负载过高时扩容一倍，调用者持有g_vnodeMux
+ * @details 新桶数组在分段锁外分配，只有重新散列与切换桶数组在锁内；分配失败时保持原表继续使用
+ * @param stripe 分段
+ */
+static void PathCacheStripeGrow(struct PathCacheStripe *stripe)
+{
+    uint32_t intSave;
+    uint32_t size = (stripe->mask + 1) << 1;
+    LIST_HEAD *oldBuckets = stripe->buckets;
+    LIST_HEAD *newBuckets = PathCacheBucketsAlloc(size);
+
+    if (newBuckets == NULL) {
+        return;
+    }
+
+    LOS_SpinLockSave(&stripe->lock, &intSave);
+    for (uint32_t i = 0; i <= stripe->mask; i++) {
+        while (!LOS_ListEmpty(&oldBuckets[i])) {
+            struct PathCache *pc = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&oldBuckets[i]), struct PathCache, hashEntry);
+            LOS_ListDelete(&pc->hashEntry);
+            LOS_ListAdd(&newBuckets[(pc->hash >> PATH_CACHE_STRIPE_BITS) & (size - 1)], &pc->hashEntry);
+        }
+    }
+    stripe->buckets = newBuckets;
+    stripe->mask = size - 1;
+    LOS_SpinUnlockRestore(&stripe->lock, intSave);
+
+    free(oldBuckets);
 }
 
 /**
@@ -148,9 +294,78 @@ static uint32_t NameHash(const char *name, int len, struct Vnode *dvp)
  */
 static void PathCacheInsert(struct Vnode *parent, struct PathCache *cache, const char* name, int len)
 {
-    // 计算哈希索引并插入哈希表对应桶中
-    int hash = NameHash(name, len, parent) & PATH_CACHE_HASH_MASK;
-    LOS_ListAdd(&g_pathCacheHashEntrys[hash], &cache->hashEntry);
+    uint32_t intSave;
+    uint32_t hash = NameHash(name, len, parent);
+    struct PathCacheStripe *stripe = &g_pathCacheStripes[hash & PATH_CACHE_STRIPE_MASK];
+
+    if ((stripe->count >= (stripe->mask + 1) * PATH_CACHE_LOAD_FACTOR) &&
+        (stripe->mask + 1 < PATH_CACHE_STRIPE_MAX_SIZE)) {
+        PathCacheStripeGrow(stripe);
+    }
+
+    cache->hash = hash;                                   // 记录哈希值，释放和扩容时无需重新计算
+    LOS_SpinLockSave(&stripe->lock, &intSave);
+    LOS_ListAdd(PathCacheBucket(stripe, hash), &cache->hashEntry);
+    stripe->count++;
+    LOS_SpinUnlockRestore(&stripe->lock, intSave);
+}
+
+/**
+ * @brief 判断缓存项能否被淘汰
+ * @details 设备节点只存在于路径缓存中，挂载点的穿越也依赖缓存项，二者都不淘汰。
+ *          子节点不在vnode哈希表中的文件系统（如procfs）每次Lookup都新建vnode，
+ *          淘汰后旧vnode无法再被找到也不会被释放，同样不淘汰
+ */
+static BOOL PathCacheEvictable(const struct PathCache *pc)
+{
+    if (VnodeIsVirtual(pc->parentVnode) || VnodeIsVirtual(pc->childVnode)) {
+        return FALSE;
+    }
+    if (LOS_ListEmpty(&pc->childVnode->hashEntry)) {
+        return FALSE;
+    }
+    if (pc->childVnode->flag & (VNODE_FLAG_MOUNT_ORIGIN | VNODE_FLAG_MOUNT_NEW)) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 超出内存上限时按二次机会算法淘汰缓存项，调用者持有g_vnodeMux
+ * @details 从最久未用的一端扫描：最近命中过的清除标记后移到队尾，其余可淘汰的直接释放。
+ *          只淘汰缓存项本身，vnode仍在，下次查找经文件系统Lookup重新建立缓存
+ * @param keep 刚插入的缓存项，不参与淘汰
+ */
+static void PathCacheShrink(const struct PathCache *keep)
+{
+    uint32_t scan = 0;
+    uint32_t scanMax = g_pathCacheNum * 2; /* 2: every entry gets a second chance once */
+
+    while ((g_pathCacheMemSize > PATH_CACHE_MEM_LIMIT) && (scan++ < scanMax)) {
+        struct PathCache *pc = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&g_pathCacheLruList), struct PathCache, lruEntry);
+        if ((pc != keep) && !pc->referenced && PathCacheEvictable(pc)) {
+            (void)PathCacheFree(pc);
+            g_pathCacheEvicted++;
+            continue;
+        }
+        pc->referenced = 0;
+        LOS_ListDelete(&pc->lruEntry);
+        LOS_ListTailInsert(&g_pathCacheLruList, &pc->lruEntry);
+    }
+}
+
+/**
+ * @brief 按名称长度将缓存项内存还给对象缓存或堆
+ * @param pc 缓存项
+ * @param len 路径名长度
+ */
+static void PathCacheItemFree(struct PathCache *pc, uint8_t len)
+{
+    if (len <= PATH_CACHE_SHORT_NAME) {
+        LOS_SlabFree(g_pathCacheSlab, pc);
+    } else {
+        free(pc);
+    }
 }
 
 /**
@@ -173,16 +388,21 @@ struct PathCache *PathCacheAlloc(struct Vnode *parent, struct Vnode *vnode, cons
     }
     pathCacheSize = sizeof(struct PathCache) + len + 1;   // 计算缓存项总大小（结构体+路径名+结束符）
 
-    pc = (struct PathCache*)zalloc(pathCacheSize);        // 分配缓存项内存
+    if (len <= PATH_CACHE_SHORT_NAME) {                   // 短名称占绝大多数，从对象缓存分配
+        pc = (struct PathCache*)LOS_SlabAlloc(g_pathCacheSlab);
+    } else {
+        pc = (struct PathCache*)malloc(pathCacheSize);
+    }
     if (pc == NULL) {                                     // 检查内存分配是否失败
         PRINT_ERR("pathCache alloc failed, no memory!\n");  // 输出内存分配失败错误信息
         return NULL;
     }
+    (void)memset_s(pc, pathCacheSize, 0, pathCacheSize);
 
     // 安全拷贝路径名字符串
     ret = strncpy_s(pc->name, len + 1, name, len);
     if (ret != LOS_OK) {                                  // 检查字符串拷贝是否失败
-        free(pc);                                         // 释放已分配的内存
+        PathCacheItemFree(pc, len);                       // 释放已分配的内存
         return NULL;
     }
 
@@ -196,6 +416,12 @@ struct PathCache *PathCacheAlloc(struct Vnode *parent, struct Vnode *vnode, cons
     LOS_ListAdd((&(vnode->parentPathCaches)), (&(pc->parentEntry)));
 
     PathCacheInsert(parent, pc, name, len);               // 将缓存项插入哈希表
+    LOS_ListTailInsert(&g_pathCacheLruList, &pc->lruEntry);
+    g_pathCacheNum++;
+    g_pathCacheMemSize += pathCacheSize;
+    if (g_pathCacheMemSize > PATH_CACHE_MEM_LIMIT) {      // 超出内存上限，淘汰冷缓存项
+        PathCacheShrink(pc);
+    }
 
     return pc;                                            // 返回初始化后的缓存项
 }
@@ -207,21 +433,31 @@ struct PathCache *PathCacheAlloc(struct Vnode *parent, struct Vnode *vnode, cons
  */
 int PathCacheFree(struct PathCache *pc)
 {
+    uint32_t intSave;
+    struct PathCacheStripe *stripe = NULL;
+
     if (pc == NULL) {                                     // 检查缓存项指针是否有效
         PRINT_ERR("pathCache free: invalid pathCache\n"); // 输出无效缓存项错误信息
         return -ENOENT;
     }
 
+    stripe = &g_pathCacheStripes[pc->hash & PATH_CACHE_STRIPE_MASK];
+    LOS_SpinLockSave(&stripe->lock, &intSave);
     LOS_ListDelete(&pc->hashEntry);                       // 从哈希表中删除缓存项
+    stripe->count--;
+    LOS_SpinUnlockRestore(&stripe->lock, intSave);
+    LOS_ListDelete(&pc->lruEntry);                        // 从LRU链表中删除缓存项
+    g_pathCacheNum--;
+    g_pathCacheMemSize -= PATH_CACHE_ITEM_SIZE(pc);
     LOS_ListDelete(&pc->parentEntry);                     // 从父节点链表中删除缓存项
     LOS_ListDelete(&pc->childEntry);                      // 从子节点链表中删除缓存项
-    free(pc);                                             // 释放缓存项内存
+    PathCacheItemFree(pc, pc->nameLen);                   // 释放缓存项内存
 
     return LOS_OK;                                        // 返回释放成功
 }
 
 /**
- * @brief 查找路径缓存项
+ * @brief 查找路径缓存项，调用者持有g_vnodeMux
  * @param parent 父目录虚拟节点
  * @param name 路径名字符串
  * @param len 路径名长度
@@ -231,16 +467,17 @@ int PathCacheFree(struct PathCache *pc)
 int PathCacheLookup(struct Vnode *parent, const char *name, int len, struct Vnode **vnode)
 {
     struct PathCache *pc = NULL;                          // 路径缓存项指针
+    uint32_t hash = NameHash(name, len, parent);
     // 计算哈希索引并获取对应哈希桶
-    int hash = NameHash(name, len, parent) & PATH_CACHE_HASH_MASK;
-    LIST_HEAD *dhead = &g_pathCacheHashEntrys[hash];      // 哈希桶链表头
+    LIST_HEAD *dhead = PathCacheBucket(&g_pathCacheStripes[hash & PATH_CACHE_STRIPE_MASK], hash);
 
     TRACE_TRY_CACHE();                                    // 增加缓存尝试查找计数
     // 遍历哈希桶中的所有缓存项
     LOS_DL_LIST_FOR_EACH_ENTRY(pc, dhead, struct PathCache, hashEntry) {
-        // 匹配条件：父节点相同、路径长度相同、路径名相同
-        if (pc->parentVnode == parent && pc->nameLen == len && !strncmp(pc->name, name, len)) {
+        // 匹配条件：哈希值相同、父节点相同、路径长度相同、路径名相同
+        if (pc->hash == hash && pc->parentVnode == parent && pc->nameLen == len && !strncmp(pc->name, name, len)) {
             *vnode = pc->childVnode;                      // 设置输出的子虚拟节点
+            pc->referenced = 1;                           // 标记最近使用
             TRACE_HIT_CACHE(pc);                          // 增加缓存命中计数
             return LOS_OK;                                // 返回查找成功
         }
@@ -248,6 +485,41 @@ int PathCacheLookup(struct Vnode *parent, const char *name, int len, struct Vnod
     return -ENOENT;                                       // 未找到缓存项
 }
 
+/**
+ * @brief 不持有g_vnodeMux查找路径缓存项，命中时钉住子虚拟节点
+ * @details 调用者须已钉住parent。在分段锁内比较并钉住子节点，缓存项被释放前必须先拿到分段锁摘链，
+ *          所以返回的子节点在VnodeUnpin之前不会被VnodeFree回收
+ * @param parent 父目录虚拟节点
+ * @param name 路径名字符串
+ * @param len 路径名长度
+ * @param vnode [输出] 已钉住的子虚拟节点
+ * @return 成功返回LOS_OK，未找到或所属挂载正在卸载返回-ENOENT
+ */
+int PathCacheLookupPinned(struct Vnode *parent, const char *name, int len, struct Vnode **vnode)
+{
+    struct PathCache *pc = NULL;
+    uint32_t intSave;
+    int ret = -ENOENT;
+    uint32_t hash = NameHash(name, len, parent);
+    struct PathCacheStripe *stripe = &g_pathCacheStripes[hash & PATH_CACHE_STRIPE_MASK];
+
+    TRACE_TRY_CACHE();
+    LOS_SpinLockSave(&stripe->lock, &intSave);
+    LOS_DL_LIST_FOR_EACH_ENTRY(pc, PathCacheBucket(stripe, hash), struct PathCache, hashEntry) {
+        if (pc->hash == hash && pc->parentVnode == parent && pc->nameLen == len && !strncmp(pc->name, name, len)) {
+            if (VnodePinLive(pc->childVnode)) {           // 出分段锁前钉住，防止子节点被回收；所属挂载正在卸载时不钉住
+                *vnode = pc->childVnode;
+                pc->referenced = 1;
+                TRACE_HIT_CACHE(pc);
+                ret = LOS_OK;
+            }
+            break;
+        }
+    }
+    LOS_SpinUnlockRestore(&stripe->lock, intSave);
+    return ret;
+}
+
 /**
  * @brief 释放虚拟节点的子路径缓存项
  * @param vnode 虚拟节点
@@ -292,10 +564,10 @@ void VnodePathCacheFree(struct Vnode *vnode)
 }
 
 /**
- * @brief 获取路径缓存哈希表
- * @return 哈希表数组首地址
+ * @brief 获取路径缓存LRU链表，遍历时调用者持有g_vnodeMux
+ * @return 链表头，按最近使用从旧到新排列所有缓存项
  */
-LIST_HEAD* GetPathCacheList()
+LIST_HEAD* GetPathCacheLruList(void)
 {
-    return g_pathCacheHashEntrys;                         // 返回全局哈希表数组
-}
\ No newline at end of file
+    return &g_pathCacheLruList;                           // 返回全局LRU链表
+}
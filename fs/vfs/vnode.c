@@ -34,12 +34,14 @@
 #include "vnode.h"
 #include "los_process.h"
 #include "los_process_pri.h"
+#include "los_slab.h"
 
 LIST_HEAD g_vnodeFreeList;              /* free vnodes list | 空闲节点链表*/
 LIST_HEAD g_vnodeVirtualList;           /* dev vnodes list | 虚拟设备节点链表,暂无实际的文件系统*/
 LIST_HEAD g_vnodeActiveList;            /* inuse vnodes list | 正在使用的虚拟节点链表*/
 static int g_freeVnodeSize = 0;         /* system free vnodes size | 剩余节点数量*/
 static int g_totalVnodeSize = 0;        /* total vnode size | 已分配的总节点数量*/
+static LosSlabCache *g_vnodeCache = NULL; /* vnode object cache | vnode对象缓存*/
 
 static LosMux g_vnodeMux;	            ///< 操作链表互斥量			
 static struct Vnode *g_rootVnode = NULL;///< 根节点
@@ -93,6 +95,12 @@ int VnodesInit(void)
         return retval;
     }
 
+    g_vnodeCache = LOS_SlabCacheCreate("vnode", sizeof(struct Vnode), NULL);
+    if (g_vnodeCache == NULL) {
+        PRINT_ERR("Create object cache for vnode fail\n");
+        return -ENOMEM;
+    }
+
     LOS_ListInit(&g_vnodeFreeList);
     LOS_ListInit(&g_vnodeVirtualList);
     LOS_ListInit(&g_vnodeActiveList);
@@ -174,8 +182,11 @@ int VnodeAlloc(struct VnodeOps *vop, struct Vnode **newVnode)
     VnodeHold();
     vnode = GetFromFreeList();
     if ((vnode == NULL) && g_totalVnodeSize < LOSCFG_MAX_VNODE_SIZE) {
-        vnode = (struct Vnode *)zalloc(sizeof(struct Vnode));
-        g_totalVnodeSize++;
+        vnode = (struct Vnode *)LOS_SlabAlloc(g_vnodeCache);
+        if (vnode != NULL) {
+            (void)memset_s(vnode, sizeof(struct Vnode), 0, sizeof(struct Vnode));
+            g_totalVnodeSize++;
+        }
     }
 
     if (vnode == NULL) {
@@ -220,13 +231,18 @@ int VnodeFree(struct Vnode *vnode)
     }
 
     VnodeHold();
-    if (vnode->useCount > 0) {
+    if ((vnode->useCount > 0) || (LOS_AtomicRead(&vnode->pinCount) > 0)) {
         VnodeDrop();
         return -EBUSY;
     }
 
     VnodePathCacheFree(vnode);
-    LOS_ListDelete(&(vnode->hashEntry));
+    /* 摘除路径缓存之前可能已被无锁查找钉住 */
+    if (LOS_AtomicRead(&vnode->pinCount) > 0) {
+        VnodeDrop();
+        return -EBUSY;
+    }
+    VfsHashRemove(vnode);
     LOS_ListDelete(&vnode->actFreeEntry);
 
     if (vnode->vop->Reclaim) {
@@ -239,7 +255,7 @@ int VnodeFree(struct Vnode *vnode)
     if (vnode->vop == &g_devfsOps) {
         /* for dev vnode, just free it */
         free(vnode->data);
-        free(vnode);
+        LOS_SlabFree(g_vnodeCache, vnode);
         g_totalVnodeSize--;
     } else {
         /* for normal vnode, reclaim it to g_VnodeFreeList */
@@ -252,16 +268,18 @@ int VnodeFree(struct Vnode *vnode)
     return LOS_OK;
 }
 
-int VnodeFreeAll(const struct Mount *mount)
+int VnodeFreeAll(struct Mount *mount)
 {
     struct Vnode *vnode = NULL;
     struct Vnode *nextVnode = NULL;
     int ret;
 
+    VnodePinDrain(mount);
     LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(vnode, nextVnode, &g_vnodeActiveList, struct Vnode, actFreeEntry) {
         if ((vnode->originMount == mount) && !(vnode->flag & VNODE_FLAG_MOUNT_NEW)) {
             ret = VnodeFree(vnode);
             if (ret != LOS_OK) {
+                LOS_AtomicSet(&mount->unmounting, 0); /* 卸载失败，挂载继续可用 */
                 return ret;
             }
         }
@@ -270,6 +288,7 @@ int VnodeFreeAll(const struct Mount *mount)
     return LOS_OK;
 }
 
+/* 钉住只在无锁查找期间短暂持有，由VnodeFreeAll排空，不视为占用 */
 BOOL VnodeInUseIter(const struct Mount *mount)
 {
     struct Vnode *vnode = NULL;
@@ -284,6 +303,31 @@ BOOL VnodeInUseIter(const struct Mount *mount)
     return FALSE;
 }
 
+static BOOL VnodePinnedIter(const struct Mount *mount)
+{
+    struct Vnode *vnode = NULL;
+
+    LOS_DL_LIST_FOR_EACH_ENTRY(vnode, &g_vnodeActiveList, struct Vnode, actFreeEntry) {
+        if ((vnode->originMount == mount) && (LOS_AtomicRead(&vnode->pinCount) > 0)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * 卸载前调用，调用者持有g_vnodeMux。先置卸载标志阻止新的钉住，再等待已有的钉住释放。
+ * 无锁查找在等待g_vnodeMux之前已放开全部钉住，所以这里可以持锁等待
+ */
+void VnodePinDrain(struct Mount *mount)
+{
+    LOS_AtomicSet(&mount->unmounting, 1);
+    DMB; /* 与VnodePinLive配对：先写自己的计数再读对方的，至少一方能看到对方 */
+    while (VnodePinnedIter(mount)) {
+        LOS_TaskDelay(1);
+    }
+}
+
 int VnodeHold(void)
 {
     int ret = LOS_MuxLock(&g_vnodeMux, LOS_WAIT_FOREVER);
@@ -516,6 +560,103 @@ int VnodeLookupFullpath(const char *fullpath, struct Vnode **vnode, uint32_t fla
     return VnodeLookupAt(fullpath, vnode, flags, GetCurrRootVnode());
 }
 
+void VnodePin(struct Vnode *vnode)
+{
+    LOS_AtomicInc(&vnode->pinCount);
+}
+
+/*
+ * 钉住vnode并确认其所属挂载不在卸载中，失败时不持有钉住。vnode须仍可经路径缓存到达
+ * （调用者持有哈希桶锁）或已被钉住的父节点引用，此时挂载结构尚未释放
+ */
+BOOL VnodePinLive(struct Vnode *vnode)
+{
+    VnodePin(vnode);
+    DMB; /* 与VnodePinDrain配对 */
+    if ((vnode->originMount != NULL) && (LOS_AtomicRead(&vnode->originMount->unmounting) != 0)) {
+        VnodeUnpin(vnode);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void VnodeUnpin(struct Vnode *vnode)
+{
+    LOS_AtomicDec(&vnode->pinCount);
+}
+
+/*
+ * 只走路径缓存、不持有g_vnodeMux的路径查找。每一级在哈希桶锁内钉住子节点后才放开父节点，
+ * 途经的vnode都不会被回收。缓存无法独立给出结果时（未命中、挂载点、权限或类型错误、
+ * filePath未记录）返回-EAGAIN，由调用者在持锁的慢路径上重新查找
+ */
+static int VnodeLookupCached(char *path, struct Vnode *startVnode, struct Vnode **result)
+{
+    uint8_t len = 0;
+    char *currentDir = path;
+    struct Vnode *currentVnode = startVnode;
+    struct Vnode *nextVnode = NULL;
+    char *nextDir = NextName(currentDir, &len);
+
+    if (!VnodePinLive(currentVnode)) {
+        return -EAGAIN;
+    }
+    while (nextDir != NULL) {
+        if (currentVnode->type != VNODE_TYPE_DIR) {
+            break;
+        }
+        if (PathCacheLookupPinned(currentVnode, nextDir, len, &nextVnode) != LOS_OK) {
+            break;
+        }
+        VnodeUnpin(currentVnode);
+        currentVnode = nextVnode;
+        if ((currentVnode->flag & VNODE_FLAG_MOUNT_ORIGIN) || (currentVnode->filePath == NULL)) {
+            break;
+        }
+        currentDir = nextDir + len;
+        nextDir = NextName(currentDir, &len);
+        if ((nextDir != NULL) && VfsVnodePermissionCheck(currentVnode, EXEC_OP)) {
+            break;
+        }
+    }
+
+    if (nextDir != NULL) {
+        VnodeUnpin(currentVnode);
+        return -EAGAIN;
+    }
+    *result = currentVnode;
+    return LOS_OK;
+}
+
+/*
+ * 查找已存在的vnode并返回钉住的节点，调用者用VnodeUnpin释放。整条路径都在路径缓存中时
+ * 不获取g_vnodeMux，多核上并发的stat类查询互不串行；其余情况退回VnodeLookupAt
+ */
+int VnodeLookupPinned(const char *path, struct Vnode **vnode)
+{
+    int ret;
+    char *normalizedPath = NULL;
+    struct Vnode *startVnode = NULL;
+
+    ret = PreProcess(path, &startVnode, &normalizedPath);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    ret = VnodeLookupCached(normalizedPath, startVnode, vnode);
+    if (ret == -EAGAIN) {
+        VnodeHold();
+        ret = VnodeLookupAt(normalizedPath, vnode, 0, startVnode);
+        if (ret == LOS_OK) {
+            VnodePin(*vnode);
+        }
+        VnodeDrop();
+    }
+
+    free(normalizedPath);
+    return ret;
+}
+
 static void ChangeRootInternal(struct Vnode *rootOld, char *dirname)
 {
     int ret;
@@ -691,6 +832,12 @@ struct Vnode *VnodeGetRoot(void)
     return g_rootVnode;
 }
 
+/* devfs vnodes only live in the path cache, their Lookup can't find them again */
+BOOL VnodeIsVirtual(const struct Vnode *vnode)
+{
+    return vnode->vop == &g_devfsOps;
+}
+
 static int VnodeChattr(struct Vnode *vnode, struct IATTR *attr)
 {
     mode_t tmpMode;
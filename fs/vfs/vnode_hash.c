@@ -29,18 +29,28 @@
  */
 
 #include "los_mux.h"
+#include "los_hash.h"
+#include "stdlib.h"
 #include "vnode.h"
 #include "fs/mount.h"
 
-// 虚拟节点哈希表桶数量
+// 虚拟节点哈希表初始桶数量
 #define VNODE_HASH_BUCKETS 128
+// 虚拟节点哈希表最大桶数量
+#define VNODE_HASH_MAX_BUCKETS 8192
+// 平均链长超过该值时哈希表扩容一倍
+#define VNODE_HASH_LOAD_FACTOR 2
 
+// 初始哈希桶数组，扩容前使用，避免初始化阶段分配内存
+static LIST_HEAD g_vnodeHashInitEntrys[VNODE_HASH_BUCKETS];
 // 虚拟节点哈希表数组，每个元素为链表头
-LIST_HEAD g_vnodeHashEntrys[VNODE_HASH_BUCKETS];
+LIST_HEAD *g_vnodeHashEntrys = g_vnodeHashInitEntrys;
 // 哈希掩码，用于计算哈希表索引（桶数量-1）
 uint32_t g_vnodeHashMask = VNODE_HASH_BUCKETS - 1;
 // 哈希表大小（桶数量）
 uint32_t g_vnodeHashSize = VNODE_HASH_BUCKETS;
+// 哈希表中的vnode数量
+static uint32_t g_vnodeHashCount = 0;
 
 // 虚拟节点哈希表互斥锁，用于线程安全访问
 static LosMux g_vnodeHashMux;
@@ -111,8 +121,69 @@ uint32_t VfsHashIndex(struct Vnode *vnode)
  */
 static LOS_DL_LIST *VfsHashBucket(const struct Mount *mp, uint32_t hash)
 {
-    // 计算桶索引并返回对应桶的链表头
-    return (&g_vnodeHashEntrys[(hash + mp->hashseed) & g_vnodeHashMask]);
+    // 文件系统给出的哈希多为连续的inode号，混合后再取低位作桶号
+    return (&g_vnodeHashEntrys[LOS_HashMix32(hash + mp->hashseed) & g_vnodeHashMask]);
+}
+
+/**
+ * @brief 负载过高时哈希表扩容一倍，调用者持有g_vnodeHashMux
+ * @details 分配失败时保持原表继续使用
+ */
+static void VfsHashGrow(void)
+{
+    uint32_t size = g_vnodeHashSize << 1;
+    uint32_t oldSize = g_vnodeHashSize;
+    LIST_HEAD *oldEntrys = g_vnodeHashEntrys;
+    LIST_HEAD *newEntrys = (LIST_HEAD *)malloc(sizeof(LIST_HEAD) * size);
+
+    if (newEntrys == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        LOS_ListInit(&newEntrys[i]);
+    }
+
+    g_vnodeHashEntrys = newEntrys;
+    g_vnodeHashSize = size;
+    g_vnodeHashMask = size - 1;
+    for (uint32_t i = 0; i < oldSize; i++) {  // 按新掩码重新散列
+        while (!LOS_ListEmpty(&oldEntrys[i])) {
+            struct Vnode *vnode = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&oldEntrys[i]), struct Vnode, hashEntry);
+            LOS_ListDelete(&vnode->hashEntry);
+            LOS_ListHeadInsert(VfsHashBucket(vnode->originMount, vnode->hash), &vnode->hashEntry);
+        }
+    }
+
+    if (oldEntrys != g_vnodeHashInitEntrys) {
+        free(oldEntrys);
+    }
+}
+
+/**
+ * @brief 统计vnode哈希表的链长分布
+ * @param stat [输出] 统计信息
+ */
+void VnodeHashStatGet(struct VnodeHashStat *stat)
+{
+    stat->usedBuckets = 0;
+    stat->maxChain = 0;
+    (void)LOS_MuxLock(&g_vnodeHashMux, LOS_WAIT_FOREVER);
+    for (uint32_t i = 0; i < g_vnodeHashSize; i++) {
+        uint32_t len = 0;
+        LIST_HEAD *node = NULL;
+        LOS_DL_LIST_FOR_EACH(node, &g_vnodeHashEntrys[i]) {
+            len++;
+        }
+        if (len != 0) {
+            stat->usedBuckets++;
+        }
+        if (len > stat->maxChain) {
+            stat->maxChain = len;
+        }
+    }
+    stat->buckets = g_vnodeHashSize;
+    stat->entries = g_vnodeHashCount;
+    (void)LOS_MuxUnlock(&g_vnodeHashMux);
 }
 
 /**
@@ -165,7 +236,11 @@ void VfsHashRemove(struct Vnode *vnode)
         return;
     }
     (void)LOS_MuxLock(&g_vnodeHashMux, LOS_WAIT_FOREVER);  // 加锁保护哈希表访问
-    LOS_ListDelete(&vnode->hashEntry);                      // 从哈希链表中删除节点
+    if (!LOS_ListEmpty(&vnode->hashEntry)) {                // 未插入过哈希表的节点链表项指向自身
+        LOS_ListDelete(&vnode->hashEntry);                  // 从哈希链表中删除节点
+        LOS_ListInit(&vnode->hashEntry);                    // 重新指向自身，重复移除无副作用
+        g_vnodeHashCount--;
+    }
     (void)LOS_MuxUnlock(&g_vnodeHashMux);                   // 解锁哈希表
 }
 
@@ -181,6 +256,11 @@ int VfsHashInsert(struct Vnode *vnode, uint32_t hash)
         return -EINVAL;   // 返回参数无效错误码
     }
     (void)LOS_MuxLock(&g_vnodeHashMux, LOS_WAIT_FOREVER);  // 加锁保护哈希表访问
+    if ((g_vnodeHashCount >= g_vnodeHashSize * VNODE_HASH_LOAD_FACTOR) &&
+        (g_vnodeHashSize < VNODE_HASH_MAX_BUCKETS)) {
+        VfsHashGrow();                                     // 链过长，扩容一倍
+    }
+    g_vnodeHashCount++;
     vnode->hash = hash;                                    // 设置虚拟节点的哈希值
     // 将虚拟节点插入到对应哈希桶的头部
     LOS_ListHeadInsert(VfsHashBucket(vnode->originMount, hash), &vnode->hashEntry);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "los_hrtimer.h"
+#include "los_sched_pri.h"
+#include "los_sys_pri.h"
+#include "los_hwi.h"
+
+#ifdef LOSCFG_KERNEL_HRTIMER
+/**
+ * @brief 将定时器从所在CPU的队列上摘下
+ * @details 与目标CPU滴答中断中的到期处理竞争，在队列锁内确认定时器仍在队列上才摘除
+ * @param timer 定时器控制块
+ * @return TRUE表示定时器此前处于启动状态并已摘除
+ */
+STATIC BOOL HrtimerDequeue(LosHrtimer *timer)
+{
+    SortLinkList *node = &timer->sortList;
+    SchedRunqueue *rq = OsSchedRunqueueByID(OsGetSortLinkNodeCpuid(node));
+    SortLinkAttribute *hrtimerQueue = &rq->hrtimerQueue;
+
+    LOS_SpinLock(&hrtimerQueue->spinLock);
+    if (GET_SORTLIST_VALUE(node) == OS_SORT_LINK_INVALID_TIME) {  // 未启动或已到期
+        LOS_SpinUnlock(&hrtimerQueue->spinLock);
+        return FALSE;
+    }
+
+    UINT64 oldResponseTime = GET_SORTLIST_VALUE(node);
+    OsDeleteNodeSortLink(hrtimerQueue, node);
+    if (oldResponseTime <= rq->responseTime) {  // 摘掉的是当前比较值对应的定时器，下次更新时重新计算
+        rq->responseTime = OS_SCHED_MAX_RESPONSE_TIME;
+    }
+    LOS_SpinUnlock(&hrtimerQueue->spinLock);
+    return TRUE;
+}
+
+LITE_OS_SEC_TEXT_INIT UINT32 LOS_HrtimerCreate(LosHrtimer *timer, HRTIMER_PROC_FUNC handler, UINTPTR arg)
+{
+    if ((timer == NULL) || (handler == NULL)) {
+        return LOS_ERRNO_HRTIMER_PTR_NULL;
+    }
+
+    LOS_ListInit(&timer->sortList.sortLinkNode);
+    SET_SORTLIST_VALUE(&timer->sortList, OS_SORT_LINK_INVALID_TIME);  // 未启动
+#ifdef LOSCFG_KERNEL_SMP
+    timer->sortList.cpuid = 0;
+#endif
+    timer->handler = handler;
+    timer->arg = arg;
+    return LOS_OK;
+}
+
+LITE_OS_SEC_TEXT UINT32 LOS_HrtimerStart(LosHrtimer *timer, UINT64 us)
+{
+    UINT32 intSave;
+
+    if ((timer == NULL) || (timer->handler == NULL)) {
+        return LOS_ERRNO_HRTIMER_PTR_NULL;
+    }
+
+    if (us == 0) {
+        return LOS_ERRNO_HRTIMER_INTERVAL_INVALID;
+    }
+
+    (VOID)HrtimerDequeue(timer);  // 已启动的定时器按新时长重新启动
+
+    /* 关中断固定在当前CPU上，保证入队的队列与下面更新比较值的CPU一致 */
+    intSave = LOS_IntLock();
+    UINT16 cpuid = ArchCurrCpuid();
+    SchedRunqueue *rq = OsSchedRunqueueByID(cpuid);
+    UINT64 responseTime = OsGetCurrSchedTimeCycle() + OS_SYS_US_TO_CYCLE(us);
+    OsAdd2SortLink(&rq->hrtimerQueue, &timer->sortList, responseTime, cpuid);
+    if (responseTime < rq->responseTime) {  // 早于当前比较值，按新的到期时间设置滴答定时器
+        if (OS_INT_ACTIVE || !OS_SCHEDULER_ACTIVE) {
+            rq->schedFlag |= INT_PEND_TICK;  // 中断退出或调度器启动时统一设置
+        } else {
+            OsSchedExpireTimeUpdate();
+        }
+    }
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+LITE_OS_SEC_TEXT UINT32 LOS_HrtimerCancel(LosHrtimer *timer)
+{
+    if (timer == NULL) {
+        return LOS_ERRNO_HRTIMER_PTR_NULL;
+    }
+
+    if (!HrtimerDequeue(timer)) {
+        return LOS_ERRNO_HRTIMER_NOT_STARTED;
+    }
+    return LOS_OK;
+}
+#endif
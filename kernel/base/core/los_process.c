@@ -419,9 +419,6 @@ VOID OsWaitWakeTask(LosTaskCB *taskCB, UINTPTR wakePID)
 {
     taskCB->waitID = wakePID;  // 设置任务的等待ID为唤醒源进程ID
     taskCB->ops->wake(taskCB);  // 调用任务操作接口唤醒任务
-#ifdef LOSCFG_KERNEL_SMP  // 如果启用了SMP（对称多处理）
-    LOS_MpSchedule(OS_MP_CPU_ALL);  // 触发所有CPU的调度
-#endif
 }
 
 /**
@@ -2542,7 +2539,8 @@ STATIC UINT32 OsCopyTask(UINT32 flags, LosProcessCB *childProcessCB, const CHAR
 
     if (OsProcessIsUserMode(childProcessCB)) {//是否是用户进程
         SCHEDULER_LOCK(intSave);  // 关闭调度器
-        OsUserCloneParentStack(childTaskCB->stackPointer, entry, runTask->topOfStack, runTask->stackSize);  // 克隆父进程堆栈
+        OsUserCloneParentStack(childTaskCB->taskID, childTaskCB->stackPointer, entry,
+                               runTask->topOfStack, runTask->stackSize);  // 克隆父进程堆栈
         SCHEDULER_UNLOCK(intSave);  // 恢复调度器
     }
     return LOS_OK;  // 返回成功
@@ -2802,7 +2800,6 @@ STATIC INT32 OsCopyProcess(UINT32 flags, const CHAR *name, UINTPTR sp, UINT32 si
         goto ERROR_TASK;  // 跳转到任务错误处理标签
     }
 
-    LOS_MpSchedule(OS_MP_CPU_ALL);  // 通知所有CPU核心调度
     if (OS_SCHEDULER_ACTIVE) {  // 检查调度器是否激活
         LOS_Schedule();  // 触发调度
     }
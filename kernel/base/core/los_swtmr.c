@@ -101,15 +101,84 @@
 #include "los_sortlink_pri.h"
 #include "los_task_pri.h"
 #include "los_hook.h"
+#include "los_bitmap.h"
 
 #ifdef LOSCFG_BASE_CORE_SWTMR_ENABLE
 #if (LOSCFG_BASE_CORE_SWTMR_LIMIT <= 0)
 #error "swtmr maxnum cannot be zero"
 #endif /* LOSCFG_BASE_CORE_SWTMR_LIMIT <= 0 */
 
+/*
+ * 每个CPU一个分级时间轮：每级SWTMR_WHEEL_SIZE个槽，第0级每槽1个tick，逐级粒度扩大SWTMR_WHEEL_SIZE倍，
+ * 共SWTMR_WHEEL_LEVEL级，覆盖2^30个tick，更远的定时器先挂在最高级，级联时再按真实到期时间重新散列。
+ * 定时器固定归属创建时选定的CPU（记录在stSortList.cpuid），其控制块与所在时间轮都由该CPU的时间轮锁保护，
+ * 启动/停止为O(1)链表操作，不再经过全局锁。
+ */
+#define SWTMR_WHEEL_BITS        5
+#define SWTMR_WHEEL_SIZE        (1U << SWTMR_WHEEL_BITS)
+#define SWTMR_WHEEL_MASK        (SWTMR_WHEEL_SIZE - 1)
+#define SWTMR_WHEEL_LEVEL       6
+#define SWTMR_WHEEL_MAX_DELTA   ((1ULL << (SWTMR_WHEEL_BITS * SWTMR_WHEEL_LEVEL)) - 1)
+#define SWTMR_BATCH_NUM         16  /* 每次出锁后批量执行的回调数 */
+#ifndef MIN
+#define MIN(x, y)               ((x) < (y) ? (x) : (y))
+#endif
+
+typedef struct {
+    SPIN_LOCK_S       lock;          // 时间轮锁，保护本时间轮及归属本CPU的定时器控制块
+    UINT64            currTick;      // 时间轮已推进到的tick，小于该值的槽均已处理
+    UINT32            pending[SWTMR_WHEEL_LEVEL];  // 各级非空槽位图
+    LOS_DL_LIST       wheel[SWTMR_WHEEL_LEVEL][SWTMR_WHEEL_SIZE];  // 各级槽链表
+    LOS_DL_LIST       expiredList;   // 已到期、等待执行回调的定时器
+    UINT32            nodeNum;       // 计时中的定时器数（含已到期未执行回调的）
+    Atomic            timerNum;      // 归属本CPU的已创建定时器数，用于创建时选择CPU
+    LosTaskCB         *swtmrTask;    // 软件定时器任务控制块指针
+} SwtmrRunqueue;
+
+LITE_OS_SEC_BSS SWTMR_CTRL_S    *g_swtmrCBArray = NULL;     /* 定时器内存空间首地址 */
+LITE_OS_SEC_BSS LOS_DL_LIST     g_swtmrFreeList;            /* 软件定时器空闲链表 */
+LITE_OS_SEC_BSS SPIN_LOCK_INIT(g_swtmrFreeSpin);            /* 仅保护空闲链表 */
+
+STATIC SwtmrRunqueue g_swtmrRunqueue[LOSCFG_KERNEL_CORE_NUM];  // 每个CPU核心的软件定时器运行队列
+
+/**
+ * @brief 锁住定时器归属CPU的时间轮
+ * @details 归属CPU只在持有原时间轮锁时修改，加锁后需复核，变化则重试
+ * @param swtmr 软件定时器控制块指针
+ * @param intSave 输出参数，中断状态
+ * @return 已加锁的运行队列
+ */
+STATIC INLINE SwtmrRunqueue *SwtmrRunqueueLock(const SWTMR_CTRL_S *swtmr, UINT32 *intSave)
+{
+    for (;;) {
+        UINT16 cpuid = OsGetSortLinkNodeCpuid(&swtmr->stSortList);
+        SwtmrRunqueue *srq = &g_swtmrRunqueue[cpuid];
+        LOS_SpinLockSave(&srq->lock, intSave);
+        if (OsGetSortLinkNodeCpuid(&swtmr->stSortList) == cpuid) {
+            return srq;
+        }
+        LOS_SpinUnlockRestore(&srq->lock, *intSave);
+    }
+}
+
+#define SWTMR_LOCK(swtmr, srq, state)   ((srq) = SwtmrRunqueueLock((swtmr), &(state)))  // 获取定时器所在时间轮锁
+#define SWTMR_UNLOCK(srq, state)        LOS_SpinUnlockRestore(&(srq)->lock, (state))    // 释放时间轮锁
+#define SWTMR_RUNQUEUE_CPUID(srq)       ((UINT16)((srq) - g_swtmrRunqueue))
+
+/**
+ * @brief 锁住定时器控制块（供其他模块修改定时器参数）
+ * @param swtmr 软件定时器控制块指针
+ * @param intSave 输出参数，中断状态
+ * @return 已持有的锁，调用者用LOS_SpinUnlockRestore释放
+ */
+SPIN_LOCK_S *OsSwtmrLock(const SWTMR_CTRL_S *swtmr, UINT32 *intSave)
+{
+    return &SwtmrRunqueueLock(swtmr, intSave)->lock;
+}
+
 /**
  * @brief 删除软件定时器
- * @details 将指定的软件定时器从计时链表中移除并置为未使用状态
+ * @details 将指定的软件定时器置为未使用状态并放回空闲链表，调用者持有其时间轮锁
  * @param swtmr 软件定时器控制块指针
  * @return 无
  */
@@ -117,29 +186,12 @@ STATIC INLINE VOID SwtmrDelete(SWTMR_CTRL_S *swtmr);
 
 /**
  * @brief 启动软件定时器并计算到期时间
- * @details 根据定时器模式和当前时间计算下一次到期时间，并添加到计时链表
+ * @details 根据定时器模式和开始时间计算下一次到期时间，并挂入时间轮
+ * @param srq 定时器归属的运行队列（已加锁）
  * @param swtmr 软件定时器控制块指针
- * @param cpuid CPU核心ID
  * @return 定时器到期时间（周期数）
  */
-STATIC INLINE UINT64 SwtmrToStart(SWTMR_CTRL_S *swtmr, UINT16 cpuid);
-
-LITE_OS_SEC_BSS SWTMR_CTRL_S    *g_swtmrCBArray = NULL;     /* 定时器内存空间首地址 */
-LITE_OS_SEC_BSS UINT8           *g_swtmrHandlerPool = NULL; /* 软件定时器处理函数池 */
-LITE_OS_SEC_BSS LOS_DL_LIST     g_swtmrFreeList;            /* 软件定时器空闲链表 */
-
-/* SMP模式下使用的自旋锁 */
-LITE_OS_SEC_BSS  SPIN_LOCK_INIT(g_swtmrSpin);
-#define SWTMR_LOCK(state)       LOS_SpinLockSave(&g_swtmrSpin, &(state))  // 获取软件定时器自旋锁并保存中断状态
-#define SWTMR_UNLOCK(state)     LOS_SpinUnlockRestore(&g_swtmrSpin, (state))  // 恢复中断状态并释放软件定时器自旋锁
-
-typedef struct {
-    SortLinkAttribute swtmrSortLink;  // 软件定时器排序链表属性
-    LosTaskCB         *swtmrTask;     // 软件定时器任务控制块指针
-    LOS_DL_LIST       swtmrHandlerQueue;  // 软件定时器超时处理队列
-} SwtmrRunqueue;
-
-STATIC SwtmrRunqueue g_swtmrRunqueue[LOSCFG_KERNEL_CORE_NUM];  // 每个CPU核心的软件定时器运行队列
+STATIC UINT64 SwtmrToStart(SwtmrRunqueue *srq, SWTMR_CTRL_S *swtmr);
 
 #ifdef LOSCFG_SWTMR_DEBUG
 #define OS_SWTMR_PERIOD_TO_CYCLE(period) (((UINT64)(period) * OS_NS_PER_TICK) / OS_NS_PER_CYCLE)  // 将周期(Tick)转换为周期数
@@ -173,6 +225,7 @@ UINT32 OsSwtmrDebugDataGet(UINT32 swtmrID, SwtmrDebugData *data, UINT32 len, UIN
 {
     UINT32 intSave;
     errno_t ret;
+    SwtmrRunqueue *srq = NULL;
 
     if ((swtmrID > LOSCFG_BASE_CORE_SWTMR_LIMIT) || (data == NULL) ||
         (mode == NULL) || (len < sizeof(SwtmrDebugData))) {
@@ -180,10 +233,10 @@ UINT32 OsSwtmrDebugDataGet(UINT32 swtmrID, SwtmrDebugData *data, UINT32 len, UIN
     }
 
     SWTMR_CTRL_S *swtmr = &g_swtmrCBArray[swtmrID];
-    SWTMR_LOCK(intSave);  // 加锁保护调试数据访问
+    SWTMR_LOCK(swtmr, srq, intSave);  // 加锁保护调试数据访问
     ret = memcpy_s(data, len, &g_swtmrDebugData[swtmrID], sizeof(SwtmrDebugData));
     *mode = swtmr->ucMode;  // 获取定时器模式
-    SWTMR_UNLOCK(intSave);  // 解锁
+    SWTMR_UNLOCK(srq, intSave);  // 解锁
     if (ret != EOK) {
         return LOS_NOK;  // 复制失败，返回错误
     }
@@ -287,20 +340,23 @@ STATIC INLINE VOID SwtmrDebugDataClear(UINT32 swtmrID)
 /**
  * @brief 软件定时器处理函数
  * @details 执行定时器回调函数并记录运行时间调试信息
+ * @param srq 当前CPU的运行队列
  * @param swtmrHandle 定时器处理项指针
  * @return 无
  */
-STATIC INLINE VOID SwtmrHandler(SwtmrHandlerItemPtr swtmrHandle)
+STATIC INLINE VOID SwtmrHandler(SwtmrRunqueue *srq, SwtmrHandlerItemPtr swtmrHandle)
 {
 #ifdef LOSCFG_SWTMR_DEBUG
     UINT32 intSave;
     SwtmrDebugBase *data = &g_swtmrDebugData[swtmrHandle->swtmrID].base;
     UINT64 startTime = OsGetCurrSchedTimeCycle();  // 记录开始执行时间
+#else
+    (VOID)srq;
 #endif
     swtmrHandle->handler(swtmrHandle->arg);  // 执行用户回调函数
 #ifdef LOSCFG_SWTMR_DEBUG
     UINT64 runTime = OsGetCurrSchedTimeCycle() - startTime;  // 计算运行时间
-    SWTMR_LOCK(intSave);  // 加锁保护调试数据
+    LOS_SpinLockSave(&srq->lock, &intSave);  // 加锁保护调试数据
     data->runTime += runTime;  // 累加总运行时间
     if (runTime > data->runTimeMax) {
         data->runTimeMax = runTime;  // 更新最大运行时间
@@ -311,127 +367,295 @@ STATIC INLINE VOID SwtmrHandler(SwtmrHandlerItemPtr swtmrHandle)
         data->readyTimeMax = runTime;  // 更新最大就绪时间
     }
     data->runCount++;  // 累加运行次数
-    SWTMR_UNLOCK(intSave);  // 解锁
+    LOS_SpinUnlockRestore(&srq->lock, intSave);  // 解锁
 #endif
 }
 
 /**
- * @brief 唤醒软件定时器处理
- * @details 将超时的定时器添加到处理队列，并根据模式处理定时器状态
- * @param srq 软件定时器运行队列指针
- * @param startTime 定时器开始时间
- * @param sortList 排序链表节点指针
- * @return 无
+ * @brief 从start槽开始（含）循环查找第一个非空槽
+ * @param pending 槽位图
+ * @param start 起始槽
+ * @return 与start相距的槽数，位图为空时返回SWTMR_WHEEL_SIZE
  */
-STATIC INLINE VOID SwtmrWake(SwtmrRunqueue *srq, UINT64 startTime, SortLinkList *sortList)
+STATIC INLINE UINT32 SwtmrWheelSlotDistance(UINT32 pending, UINT32 start)
 {
-    UINT32 intSave;
-    SWTMR_CTRL_S *swtmr = LOS_DL_LIST_ENTRY(sortList, SWTMR_CTRL_S, stSortList);  // 获取定时器控制块
-    SwtmrHandlerItemPtr swtmrHandler = (SwtmrHandlerItemPtr)LOS_MemboxAlloc(g_swtmrHandlerPool);  // 分配处理项
-    LOS_ASSERT(swtmrHandler != NULL);  // 断言处理项分配成功
+    if (pending == 0) {
+        return SWTMR_WHEEL_SIZE;
+    }
 
-    OsHookCall(LOS_HOOK_TYPE_SWTMR_EXPIRED, swtmr);  // 调用定时器到期钩子函数
+    start &= SWTMR_WHEEL_MASK;
+    if (start != 0) {
+        pending = (pending >> start) | (pending << (SWTMR_WHEEL_SIZE - start));  // 循环右移，使start槽位于bit0
+    }
+    return CTZ(pending);
+}
 
-    SWTMR_LOCK(intSave);  // 加锁保护队列操作
-    swtmrHandler->handler = swtmr->pfnHandler;  // 设置处理函数
-    swtmrHandler->arg = swtmr->uwArg;  // 设置参数
-    LOS_ListTailInsert(&srq->swtmrHandlerQueue, &swtmrHandler->node);  // 添加到处理队列尾部
-    SwtmrDebugWaitTimeCalculate(swtmr->usTimerID, swtmrHandler);  // 计算等待时间
+/**
+ * @brief 将定时器节点挂入时间轮
+ * @details 按到期tick与时间轮当前tick之差选择级别，槽号取到期tick在该级的位段，O(1)
+ * @param srq 运行队列（已加锁）
+ * @param node 定时器排序节点，responseTime为到期时间（周期数）
+ */
+STATIC VOID SwtmrWheelAdd(SwtmrRunqueue *srq, SortLinkList *node)
+{
+    UINT64 expireTick = node->responseTime / OS_CYCLE_PER_TICK;
+    UINT32 level = 0;
 
-    if (swtmr->ucMode == LOS_SWTMR_MODE_ONCE) {  // 单次触发模式
-        SwtmrDelete(swtmr);  // 删除定时器
+    if (expireTick < srq->currTick) {  // 已过期的放在当前槽，下次推进即处理
+        expireTick = srq->currTick;
+    }
+    UINT64 delta = expireTick - srq->currTick;
+    if (delta > SWTMR_WHEEL_MAX_DELTA) {  // 超出时间轮范围，先挂在最高级，级联时重新散列
+        delta = SWTMR_WHEEL_MAX_DELTA;
+        expireTick = srq->currTick + delta;
+    }
+    while (delta >= SWTMR_WHEEL_SIZE) {
+        delta >>= SWTMR_WHEEL_BITS;
+        level++;
+    }
 
-        if (swtmr->usTimerID < (OS_SWTMR_MAX_TIMERID - LOSCFG_BASE_CORE_SWTMR_LIMIT)) {
-            swtmr->usTimerID += LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 调整定时器ID
-        } else {
-            swtmr->usTimerID %= LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 循环使用ID
-        }
-    } else if (swtmr->ucMode == LOS_SWTMR_MODE_NO_SELFDELETE) {  // 单次不自动删除模式
-        swtmr->ucState = OS_SWTMR_STATUS_CREATED;  // 置为已创建状态
-    } else {  // 周期模式
-        swtmr->uwOverrun++;  // 溢出计数加1
-        swtmr->startTime = startTime;  // 更新开始时间
-        (VOID)SwtmrToStart(swtmr, ArchCurrCpuid());  // 重新启动定时器
+    UINT32 slot = (UINT32)(expireTick >> (level * SWTMR_WHEEL_BITS)) & SWTMR_WHEEL_MASK;
+    LOS_ListTailInsert(&srq->wheel[level][slot], &node->sortLinkNode);
+    srq->pending[level] |= BIT(slot);
+    srq->nodeNum++;
+}
+
+/**
+ * @brief 将计时中的定时器节点从时间轮（或到期链表）中摘除，O(1)
+ * @param srq 运行队列（已加锁）
+ * @param node 定时器排序节点
+ */
+STATIC VOID SwtmrWheelDelete(SwtmrRunqueue *srq, SortLinkList *node)
+{
+    LOS_DL_LIST *prev = node->sortLinkNode.pstPrev;
+    LOS_DL_LIST *next = node->sortLinkNode.pstNext;
+    LOS_DL_LIST *base = &srq->wheel[0][0];
+
+    LOS_ListDelete(&node->sortLinkNode);
+    SET_SORTLIST_VALUE(node, OS_SORT_LINK_INVALID_TIME);
+    srq->nodeNum--;
+
+    /* 前驱与后继相同说明链表只剩表头，若表头是时间轮的槽则清除该槽的非空位 */
+    if ((prev == next) && (prev >= base) && (prev < (base + (SWTMR_WHEEL_LEVEL * SWTMR_WHEEL_SIZE)))) {
+        UINT32 index = (UINT32)(prev - base);
+        srq->pending[index / SWTMR_WHEEL_SIZE] &= ~BIT(index % SWTMR_WHEEL_SIZE);
     }
+}
 
-    SWTMR_UNLOCK(intSave);  // 解锁
+/**
+ * @brief 级联：第0级转完一圈时，把上一级当前槽中的定时器按真实到期时间重新散列到低级
+ * @param srq 运行队列（已加锁）
+ */
+STATIC VOID SwtmrWheelCascade(SwtmrRunqueue *srq)
+{
+    for (UINT32 level = 1; level < SWTMR_WHEEL_LEVEL; level++) {
+        UINT32 slot = (UINT32)(srq->currTick >> (level * SWTMR_WHEEL_BITS)) & SWTMR_WHEEL_MASK;
+        if (srq->pending[level] & BIT(slot)) {
+            LOS_DL_LIST *head = &srq->wheel[level][slot];
+            srq->pending[level] &= ~BIT(slot);
+            while (!LOS_ListEmpty(head)) {
+                LOS_DL_LIST *list = LOS_DL_LIST_FIRST(head);
+                LOS_ListDelete(list);
+                srq->nodeNum--;
+                SwtmrWheelAdd(srq, LOS_DL_LIST_ENTRY(list, SortLinkList, sortLinkNode));
+            }
+        }
+        if (slot != 0) {  // 本级未转完一圈，更高级无需级联
+            break;
+        }
+    }
 }
 
 /**
- * @brief 扫描软件定时器计时链表
- * @details 检查并处理所有已超时的软件定时器
- * @param srq 软件定时器运行队列指针
- * @return 无
+ * @brief 获取时间轮当前tick之后下一个需要处理的tick（第0级非空槽或级联点）
+ * @param srq 运行队列（已加锁）
+ * @return tick值，时间轮为空时返回OS_SORT_LINK_INVALID_TIME
  */
-STATIC INLINE VOID ScanSwtmrTimeList(SwtmrRunqueue *srq)
+STATIC UINT64 SwtmrWheelNextTick(const SwtmrRunqueue *srq)
 {
-    UINT32 intSave;
-    SortLinkAttribute *swtmrSortLink = &srq->swtmrSortLink;  // 获取排序链表属性
-    LOS_DL_LIST *listObject = &swtmrSortLink->sortLink;  // 获取链表头
+    UINT64 nextTick = OS_SORT_LINK_INVALID_TIME;
 
-    /* 需要小心处理，因为定时器可能在特定排序链表中，而其他核心仍可能处理它，如停止定时器 */
-    LOS_SpinLockSave(&swtmrSortLink->spinLock, &intSave);  // 加锁保护链表操作
+    if (srq->pending[0] != 0) {
+        nextTick = srq->currTick + 1 + SwtmrWheelSlotDistance(srq->pending[0], (UINT32)srq->currTick + 1);
+    }
+    for (UINT32 level = 1; level < SWTMR_WHEEL_LEVEL; level++) {
+        if (srq->pending[level] == 0) {
+            continue;
+        }
+        UINT32 shift = level * SWTMR_WHEEL_BITS;
+        UINT64 lap = srq->currTick >> shift;
+        UINT64 tick = (lap + 1 + SwtmrWheelSlotDistance(srq->pending[level], (UINT32)lap + 1)) << shift;
+        nextTick = MIN(nextTick, tick);
+    }
+    return nextTick;
+}
 
-    if (LOS_ListEmpty(listObject)) {  // 链表为空
-        LOS_SpinUnlockRestore(&swtmrSortLink->spinLock, intSave);  // 解锁并返回
-        return;
+/**
+ * @brief 把第0级指定槽中已到期的定时器移入到期链表
+ * @param srq 运行队列（已加锁）
+ * @param slot 第0级槽号
+ * @param currTime 当前时间（周期数），当前tick内尚未到期的定时器留在槽中
+ */
+STATIC VOID SwtmrWheelExpire(SwtmrRunqueue *srq, UINT32 slot, UINT64 currTime)
+{
+    LOS_DL_LIST *head = &srq->wheel[0][slot];
+    LOS_DL_LIST *list = head->pstNext;
+
+    while (list != head) {
+        LOS_DL_LIST *next = list->pstNext;
+        if (LOS_DL_LIST_ENTRY(list, SortLinkList, sortLinkNode)->responseTime <= currTime) {
+            LOS_ListDelete(list);
+            LOS_ListTailInsert(&srq->expiredList, list);
+        }
+        list = next;
     }
-    SortLinkList *sortList = LOS_DL_LIST_ENTRY(listObject->pstNext, SortLinkList, sortLinkNode);  // 获取第一个节点
 
-    UINT64 currTime = OsGetCurrSchedTimeCycle();  // 获取当前时间
-    while (sortList->responseTime <= currTime) {  // 处理所有已超时的定时器
-        sortList = LOS_DL_LIST_ENTRY(listObject->pstNext, SortLinkList, sortLinkNode);  // 获取下一个节点
-        UINT64 startTime = GET_SORTLIST_VALUE(sortList);  // 获取开始时间
-        OsDeleteNodeSortLink(swtmrSortLink, sortList);  // 从排序链表中删除节点
-        LOS_SpinUnlockRestore(&swtmrSortLink->spinLock, intSave);  // 解锁
+    if (LOS_ListEmpty(head)) {
+        srq->pending[0] &= ~BIT(slot);
+    }
+}
 
-        SwtmrWake(srq, startTime, sortList);  // 唤醒定时器处理
+/**
+ * @brief 推进时间轮到当前时间，到期定时器移入到期链表
+ * @details 空槽与无需级联的区间整段跳过，长时间空闲后推进的代价只与非空槽数相关
+ * @param srq 运行队列（已加锁）
+ * @param currTime 当前时间（周期数）
+ */
+STATIC VOID SwtmrWheelAdvance(SwtmrRunqueue *srq, UINT64 currTime)
+{
+    UINT64 nowTick = currTime / OS_CYCLE_PER_TICK;
 
-        LOS_SpinLockSave(&swtmrSortLink->spinLock, &intSave);  // 重新加锁
-        if (LOS_ListEmpty(listObject)) {  // 链表为空则退出循环
+    while (srq->currTick <= nowTick) {
+        UINT32 slot = (UINT32)srq->currTick & SWTMR_WHEEL_MASK;
+        if (slot == 0) {
+            SwtmrWheelCascade(srq);
+        }
+        if (srq->pending[0] & BIT(slot)) {
+            SwtmrWheelExpire(srq, slot, currTime);
+        }
+        if (srq->currTick == nowTick) {  // 当前tick可能还有未到期的定时器，停在此处
             break;
         }
+        srq->currTick = MIN(SwtmrWheelNextTick(srq), nowTick);
+    }
+}
+
+/**
+ * @brief 获取时间轮中最早的到期时间
+ * @details 第0级最近的非空槽给出精确到期时间，更高级取其级联点，级联后再重新计算
+ * @param srq 运行队列（已加锁）
+ * @return 到期时间（周期数），无计时中的定时器时返回OS_SORT_LINK_INVALID_TIME
+ */
+STATIC UINT64 SwtmrWheelNextExpireTime(const SwtmrRunqueue *srq)
+{
+    UINT64 expireTime = OS_SORT_LINK_INVALID_TIME;
+
+    if (!LOS_ListEmpty(&srq->expiredList)) {
+        return 0;
+    }
 
-        sortList = LOS_DL_LIST_ENTRY(listObject->pstNext, SortLinkList, sortLinkNode);  // 更新当前节点
+    if (srq->pending[0] != 0) {
+        UINT32 slot = ((UINT32)srq->currTick + SwtmrWheelSlotDistance(srq->pending[0], (UINT32)srq->currTick)) &
+                      SWTMR_WHEEL_MASK;
+        const LOS_DL_LIST *head = &srq->wheel[0][slot];
+        for (LOS_DL_LIST *list = head->pstNext; list != head; list = list->pstNext) {
+            expireTime = MIN(expireTime, LOS_DL_LIST_ENTRY(list, SortLinkList, sortLinkNode)->responseTime);
+        }
     }
 
-    LOS_SpinUnlockRestore(&swtmrSortLink->spinLock, intSave);  // 解锁
-    return;
+    for (UINT32 level = 1; level < SWTMR_WHEEL_LEVEL; level++) {
+        if (srq->pending[level] == 0) {
+            continue;
+        }
+        UINT32 shift = level * SWTMR_WHEEL_BITS;
+        UINT64 lap = srq->currTick >> shift;
+        UINT64 tick = (lap + 1 + SwtmrWheelSlotDistance(srq->pending[level], (UINT32)lap + 1)) << shift;
+        expireTime = MIN(expireTime, tick * OS_CYCLE_PER_TICK);
+    }
+    return expireTime;
+}
+
+/**
+ * @brief 从到期链表取出一批定时器
+ * @details 在时间轮锁内完成状态迁移（单次定时器删除、周期定时器重新挂入），回调参数拷贝到调用者的批处理数组，
+ * 出锁后由调用者统一执行，每次到期不再分配内存
+ * @param srq 当前CPU的运行队列（已加锁）
+ * @param batch 批处理数组，至少SWTMR_BATCH_NUM项
+ * @return 取出的定时器数
+ */
+STATIC UINT32 SwtmrExpiredFetch(SwtmrRunqueue *srq, SwtmrHandlerItem *batch)
+{
+    UINT32 num = 0;
+
+    while (!LOS_ListEmpty(&srq->expiredList) && (num < SWTMR_BATCH_NUM)) {
+        SortLinkList *sortList = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&srq->expiredList), SortLinkList, sortLinkNode);
+        SWTMR_CTRL_S *swtmr = LOS_DL_LIST_ENTRY(sortList, SWTMR_CTRL_S, stSortList);  // 获取定时器控制块
+        UINT64 startTime = GET_SORTLIST_VALUE(sortList);  // 本次到期时间即周期定时器下一轮的开始时间
+        SwtmrHandlerItemPtr swtmrHandler = &batch[num++];
+
+        SwtmrWheelDelete(srq, sortList);
+        OsHookCall(LOS_HOOK_TYPE_SWTMR_EXPIRED, swtmr);  // 调用定时器到期钩子函数
+        swtmrHandler->handler = swtmr->pfnHandler;  // 设置处理函数
+        swtmrHandler->arg = swtmr->uwArg;  // 设置参数
+        SwtmrDebugWaitTimeCalculate(swtmr->usTimerID, swtmrHandler);  // 计算等待时间
+
+        if (swtmr->ucMode == LOS_SWTMR_MODE_ONCE) {  // 单次触发模式
+            if (swtmr->usTimerID < (OS_SWTMR_MAX_TIMERID - LOSCFG_BASE_CORE_SWTMR_LIMIT)) {
+                swtmr->usTimerID += LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 调整定时器ID
+            } else {
+                swtmr->usTimerID %= LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 循环使用ID
+            }
+            SwtmrDelete(swtmr);  // 删除定时器
+        } else if (swtmr->ucMode == LOS_SWTMR_MODE_NO_SELFDELETE) {  // 单次不自动删除模式
+            swtmr->ucState = OS_SWTMR_STATUS_CREATED;  // 置为已创建状态
+        } else {  // 周期模式
+            swtmr->uwOverrun++;  // 溢出计数加1
+            swtmr->startTime = startTime;  // 更新开始时间
+            (VOID)SwtmrToStart(srq, swtmr);  // 重新启动定时器
+        }
+    }
+
+    return num;
 }
 
 /**
  * @brief 软件定时器任务函数
- * @details 循环等待并处理超时的软件定时器回调
+ * @details 推进本CPU时间轮，批量执行到期回调，之后睡眠到下一个到期时间
  * @param 无
  * @return 无
  */
 STATIC VOID SwtmrTask(VOID)
 {
-    SwtmrHandlerItem swtmrHandle;  // 定时器处理项
+    SwtmrHandlerItem batch[SWTMR_BATCH_NUM];  // 本批到期的回调
     UINT32 intSave;
-    UINT64 waitTime;  // 等待时间
+    UINT32 num;
 
     SwtmrRunqueue *srq = &g_swtmrRunqueue[ArchCurrCpuid()];  // 获取当前CPU的运行队列
-    LOS_DL_LIST *head = &srq->swtmrHandlerQueue;  // 获取处理队列头
     for (;;) {  // 无限循环
-        waitTime = OsSortLinkGetNextExpireTime(OsGetCurrSchedTimeCycle(), &srq->swtmrSortLink);  // 获取下一个超时时间
-        if (waitTime != 0) {  // 需要等待
-            SCHEDULER_LOCK(intSave);  // 调度器加锁
-            srq->swtmrTask->ops->delay(srq->swtmrTask, waitTime);  // 延迟等待
-            OsHookCall(LOS_HOOK_TYPE_MOVEDTASKTODELAYEDLIST, srq->swtmrTask);  // 调用任务移至延迟链表钩子
-            SCHEDULER_UNLOCK(intSave);  // 调度器解锁
-        }
-
-        ScanSwtmrTimeList(srq);  // 扫描并处理超时定时器
+        LOS_SpinLockSave(&srq->lock, &intSave);
+        SwtmrWheelAdvance(srq, OsGetCurrSchedTimeCycle());  // 推进时间轮
+        num = SwtmrExpiredFetch(srq, batch);  // 取出一批到期定时器
+        LOS_SpinUnlockRestore(&srq->lock, intSave);
 
-        while (!LOS_ListEmpty(head)) {  // 处理所有就绪的定时器
-            SwtmrHandlerItemPtr swtmrHandlePtr = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(head), SwtmrHandlerItem, node);  // 获取第一个处理项
-            LOS_ListDelete(&swtmrHandlePtr->node);  // 从队列中删除
+        for (UINT32 index = 0; index < num; index++) {
+            SwtmrHandler(srq, &batch[index]);  // 出锁执行回调
+        }
+        if (num != 0) {  // 可能还有到期的定时器，处理完再睡眠
+            continue;
+        }
 
-            (VOID)memcpy_s(&swtmrHandle, sizeof(SwtmrHandlerItem), swtmrHandlePtr, sizeof(SwtmrHandlerItem));  // 复制处理项
-            (VOID)LOS_MemboxFree(g_swtmrHandlerPool, swtmrHandlePtr);  // 释放处理项内存
-            SwtmrHandler(&swtmrHandle);  // 执行处理函数
+        /* 在调度器锁内计算等待时间，与启动定时器时的SwtmrAdjustCheck互斥，避免错过更早的到期时间 */
+        SCHEDULER_LOCK(intSave);  // 调度器加锁
+        LOS_SpinLock(&srq->lock);
+        UINT64 currTime = OsGetCurrSchedTimeCycle();
+        UINT64 expireTime = SwtmrWheelNextExpireTime(srq);
+        LOS_SpinUnlock(&srq->lock);
+        if (expireTime > currTime) {  // 需要等待
+            UINT64 waitTime = (expireTime == OS_SORT_LINK_INVALID_TIME) ? expireTime : (expireTime - currTime);
+            srq->swtmrTask->ops->delay(srq->swtmrTask, waitTime);  // 延迟等待
+            OsHookCall(LOS_HOOK_TYPE_MOVEDTASKTODELAYEDLIST, srq->swtmrTask);  // 调用任务移至延迟链表钩子
         }
+        SCHEDULER_UNLOCK(intSave);  // 调度器解锁
     }
 }
 
@@ -506,20 +730,19 @@ LITE_OS_SEC_TEXT_INIT VOID OsSwtmrRecycle(UINTPTR ownerID)
 
 /**
  * @brief 软件定时器基础初始化
- * @details 分配定时器控制块和处理池内存，初始化链表
+ * @details 分配定时器控制块内存，初始化空闲链表和各CPU的时间轮
  * @param 无
  * @return LOS_OK-成功，其他-失败
  */
 STATIC UINT32 SwtmrBaseInit(VOID)
 {
-    UINT32 ret;
     UINT32 size = sizeof(SWTMR_CTRL_S) * LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 计算控制块内存大小
     SWTMR_CTRL_S *swtmr = (SWTMR_CTRL_S *)LOS_MemAlloc(m_aucSysMem0, size);  // 分配控制块内存
     if (swtmr == NULL) {
         return LOS_ERRNO_SWTMR_NO_MEMORY;  // 内存分配失败
     }
 
-    (VOID)memset_s(swtmr, size, 0, size);  // 初始化控制块内存
+    (VOID)memset_s(swtmr, size, 0, size);  // 初始化控制块内存，归属CPU均为0
     g_swtmrCBArray = swtmr;  // 设置全局控制块数组指针
     LOS_ListInit(&g_swtmrFreeList);  // 初始化空闲链表
     for (UINT16 index = 0; index < LOSCFG_BASE_CORE_SWTMR_LIMIT; index++, swtmr++) {  // 初始化每个控制块
@@ -527,22 +750,18 @@ STATIC UINT32 SwtmrBaseInit(VOID)
         LOS_ListTailInsert(&g_swtmrFreeList, &swtmr->stSortList.sortLinkNode);  // 添加到空闲链表
     }
 
-    size = LOS_MEMBOX_SIZE(sizeof(SwtmrHandlerItem), OS_SWTMR_HANDLE_QUEUE_SIZE);  // 计算处理池大小
-    g_swtmrHandlerPool = (UINT8 *)LOS_MemAlloc(m_aucSysMem1, size);  // 分配处理池内存
-    if (g_swtmrHandlerPool == NULL) {
-        return LOS_ERRNO_SWTMR_NO_MEMORY;  // 内存分配失败
-    }
-
-    ret = LOS_MemboxInit(g_swtmrHandlerPool, size, sizeof(SwtmrHandlerItem));  // 初始化内存池
-    if (ret != LOS_OK) {
-        return LOS_ERRNO_SWTMR_HANDLER_POOL_NO_MEM;  // 内存池初始化失败
-    }
-
-    for (UINT16 index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {  // 初始化每个CPU的运行队列
+    for (UINT16 index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {  // 初始化每个CPU的时间轮
         SwtmrRunqueue *srq = &g_swtmrRunqueue[index];
-        /* 所有核心的链表必须在核心0启动时初始化以实现负载均衡 */
-        OsSortLinkInit(&srq->swtmrSortLink);  // 初始化排序链表
-        LOS_ListInit(&srq->swtmrHandlerQueue);  // 初始化处理队列
+        /* 所有核心的时间轮必须在核心0启动时初始化，其他核心启动前即可接收定时器 */
+        (VOID)memset_s(srq, sizeof(SwtmrRunqueue), 0, sizeof(SwtmrRunqueue));
+        LOS_SpinInit(&srq->lock);
+        LOCKDEP_CLASS_SET(&srq->lock, LOCKDEP_CLASS_SWTMR, index);  // 只在调度器锁之后获取
+        for (UINT32 level = 0; level < SWTMR_WHEEL_LEVEL; level++) {
+            for (UINT32 slot = 0; slot < SWTMR_WHEEL_SIZE; slot++) {
+                LOS_ListInit(&srq->wheel[level][slot]);
+            }
+        }
+        LOS_ListInit(&srq->expiredList);  // 初始化到期链表
         srq->swtmrTask = NULL;  // 任务指针初始化为空
     }
 
@@ -584,70 +803,48 @@ ERROR:
     PRINT_ERR("OsSwtmrInit error! ret = %u\n", ret);  // 打印错误信息
     (VOID)LOS_MemFree(m_aucSysMem0, g_swtmrCBArray);  // 释放控制块内存
     g_swtmrCBArray = NULL;
-    (VOID)LOS_MemFree(m_aucSysMem1, g_swtmrHandlerPool);  // 释放处理池内存
-    g_swtmrHandlerPool = NULL;
     return ret;  // 返回错误码
 }
 
-#ifdef LOSCFG_KERNEL_SMP
 /**
- * @brief 查找空闲的软件定时器运行队列
- * @details 找到定时器数量最少的CPU核心运行队列
- * @param idleCpuid 输出参数，空闲CPU核心ID
- * @return 无
+ * @brief 为新建的定时器选择归属CPU
+ * @details 选择归属定时器最少的CPU，定时器此后一直在该CPU的时间轮上计时和执行回调
+ * @return CPU核心ID
  */
-STATIC INLINE VOID FindIdleSwtmrRunqueue(UINT16 *idleCpuid)
+STATIC INLINE UINT16 SwtmrRunqueueSelect(VOID)
 {
-    SwtmrRunqueue *idleRq = &g_swtmrRunqueue[0];  // 初始化为核心0
-    UINT32 nodeNum = OsGetSortLinkNodeNum(&idleRq->swtmrSortLink);  // 获取节点数量
-    UINT16 cpuid = 1;
-    do {
-        SwtmrRunqueue *srq = &g_swtmrRunqueue[cpuid];
-        UINT32 temp = OsGetSortLinkNodeNum(&srq->swtmrSortLink);  // 获取当前核心节点数量
-        if (nodeNum > temp) {
-            *idleCpuid = cpuid;  // 更新空闲核心ID
-            nodeNum = temp;  // 更新最小节点数量
+    UINT16 idleCpuid = 0;
+#ifdef LOSCFG_KERNEL_SMP
+    INT32 timerNum = LOS_AtomicRead(&g_swtmrRunqueue[0].timerNum);  // 初始化为核心0
+    for (UINT16 cpuid = 1; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+        INT32 temp = LOS_AtomicRead(&g_swtmrRunqueue[cpuid].timerNum);  // 获取当前核心定时器数量
+        if (timerNum > temp) {
+            idleCpuid = cpuid;  // 更新空闲核心ID
+            timerNum = temp;  // 更新最小定时器数量
         }
-        cpuid++;
-    } while (cpuid < LOSCFG_KERNEL_CORE_NUM);  // 遍历所有核心
-}
+    }
 #endif
-
-/**
- * @brief 添加软件定时器到计时链表
- * @details 将定时器节点添加到指定CPU核心的排序计时链表
- * @param node 排序链表节点指针
- * @param responseTime 到期时间
- * @param cpuid CPU核心ID
- * @return 无
- */
-STATIC INLINE VOID AddSwtmr2TimeList(SortLinkList *node, UINT64 responseTime, UINT16 cpuid)
-{
-    SwtmrRunqueue *srq = &g_swtmrRunqueue[cpuid];
-    OsAdd2SortLink(&srq->swtmrSortLink, node, responseTime, cpuid);  // 添加到排序链表
+    return idleCpuid;
 }
 
 /**
- * @brief 从计时链表中移除软件定时器
- * @details 将定时器节点从其所在的计时链表中移除
- * @param node 排序链表节点指针
- * @return 无
+ * @brief 设置定时器的归属CPU，调用者持有原归属CPU的时间轮锁
+ * @param swtmr 软件定时器控制块指针
+ * @param cpuid CPU核心ID
  */
-STATIC INLINE VOID DeSwtmrFromTimeList(SortLinkList *node)
+STATIC INLINE VOID SwtmrCpuidSet(SWTMR_CTRL_S *swtmr, UINT16 cpuid)
 {
 #ifdef LOSCFG_KERNEL_SMP
-    UINT16 cpuid = OsGetSortLinkNodeCpuid(node);  // 获取节点所在CPU核心
+    swtmr->stSortList.cpuid = cpuid;
 #else
-    UINT16 cpuid = 0;  // 单核心模式
+    (VOID)swtmr;
+    (VOID)cpuid;
 #endif
-    SwtmrRunqueue *srq = &g_swtmrRunqueue[cpuid];
-    OsDeleteFromSortLink(&srq->swtmrSortLink, node);  // 从排序链表中删除
-    return;
 }
 
 /**
  * @brief 调整软件定时器任务等待时间
- * @details 如果新的到期时间更早，则调整定时器任务的等待时间
+ * @details 如果新的到期时间更早，则调整定时器任务的等待时间；调用者不得持有时间轮锁
  * @param cpuid CPU核心ID
  * @param responseTime 新的到期时间
  * @return 无
@@ -683,12 +880,12 @@ STATIC VOID SwtmrAdjustCheck(UINT16 cpuid, UINT64 responseTime)
 
 /**
  * @brief 启动软件定时器并计算到期时间
- * @details 根据定时器模式和当前时间计算下一次到期时间，并添加到计时链表
+ * @details 根据定时器模式和开始时间计算下一次到期时间，并挂入时间轮
+ * @param srq 定时器归属的运行队列（已加锁）
  * @param swtmr 软件定时器控制块指针
- * @param cpuid CPU核心ID
  * @return 定时器到期时间（周期数）
  */
-STATIC UINT64 SwtmrToStart(SWTMR_CTRL_S *swtmr, UINT16 cpuid)
+STATIC UINT64 SwtmrToStart(SwtmrRunqueue *srq, SWTMR_CTRL_S *swtmr)
 {
     UINT32 ticks;
     UINT32 times = 0;  // 触发次数
@@ -712,150 +909,117 @@ STATIC UINT64 SwtmrToStart(SWTMR_CTRL_S *swtmr, UINT16 cpuid)
         PRINT_WARN("Swtmr already timeout! SwtmrID: %u\n", swtmr->usTimerID);  // 打印警告
     }
 
-    AddSwtmr2TimeList(&swtmr->stSortList, responseTime, cpuid);  // 添加到计时链表
+    SET_SORTLIST_VALUE(&swtmr->stSortList, responseTime);
+    SwtmrWheelAdd(srq, &swtmr->stSortList);  // 挂入时间轮
     SwtmrDebugDataUpdate(swtmr, ticks, times);  // 更新调试数据
     return responseTime;  // 返回到期时间
 }
 
-/*
- * Description: Start Software Timer
- * Input      : swtmr --- Need to start software timer
- */
-/**
- * @brief 启动软件定时器
- * @details 设置定时器开始时间并添加到计时链表
- * @param swtmr 软件定时器控制块指针
- * @return 无
- */
-STATIC INLINE VOID SwtmrStart(SWTMR_CTRL_S *swtmr)
-{
-    UINT64 responseTime;
-    UINT16 idleCpu = 0;
-#ifdef LOSCFG_KERNEL_SMP
-    FindIdleSwtmrRunqueue(&idleCpu);  // SMP模式下查找空闲CPU
-#endif
-    swtmr->startTime = OsGetCurrSchedTimeCycle();  // 设置开始时间
-    responseTime = SwtmrToStart(swtmr, idleCpu);  // 计算到期时间并添加到链表
-
-    SwtmrDebugDataStart(swtmr, idleCpu);  // 记录启动调试信息
-
-    SwtmrAdjustCheck(idleCpu, responseTime);  // 调整任务等待时间
-}
-
 /*
  * Description: Delete Software Timer
  * Input      : swtmr --- Need to delete software timer, When using, Ensure that it can't be NULL.
  */
 /**
  * @brief 删除软件定时器
- * @details 将指定的软件定时器添加到空闲链表并重置状态
+ * @details 将指定的软件定时器置为未使用状态并放回空闲链表，调用者持有其时间轮锁
  * @param swtmr 软件定时器控制块指针（确保非空）
  * @return 无
  */
 STATIC INLINE VOID SwtmrDelete(SWTMR_CTRL_S *swtmr)
 {
-    /* 插入到空闲链表 */
-    LOS_ListTailInsert(&g_swtmrFreeList, &swtmr->stSortList.sortLinkNode);  // 添加到空闲链表尾部
     swtmr->ucState = OS_SWTMR_STATUS_UNUSED;  // 设置为未使用状态
     swtmr->uwOwnerPid = OS_INVALID_VALUE;  // 重置所有者进程ID
-
     SwtmrDebugDataClear(swtmr->usTimerID);  // 清除调试数据
-}
-
-/**
- * @brief 重启软件定时器
- * @details 重置定时器开始时间并重新添加到计时链表
- * @param startTime 新的开始时间
- * @param sortList 排序链表节点指针
- * @param cpuid CPU核心ID
- * @return 无
- */
-STATIC INLINE VOID SwtmrRestart(UINT64 startTime, SortLinkList *sortList, UINT16 cpuid)
-{
-    UINT32 intSave;
+    LOS_AtomicDec(&g_swtmrRunqueue[OsGetSortLinkNodeCpuid(&swtmr->stSortList)].timerNum);
 
-    SWTMR_CTRL_S *swtmr = LOS_DL_LIST_ENTRY(sortList, SWTMR_CTRL_S, stSortList);  // 获取定时器控制块
-    SWTMR_LOCK(intSave);  // 加锁
-    swtmr->startTime = startTime;  // 更新开始时间
-    (VOID)SwtmrToStart(swtmr, cpuid);  // 重新启动定时器
-    SWTMR_UNLOCK(intSave);  // 解锁
+    /* 插入到空闲链表 */
+    LOS_SpinLock(&g_swtmrFreeSpin);
+    LOS_ListTailInsert(&g_swtmrFreeList, &swtmr->stSortList.sortLinkNode);  // 添加到空闲链表尾部
+    LOS_SpinUnlock(&g_swtmrFreeSpin);
 }
 
 /**
  * @brief 重置软件定时器响应时间
- * @details 重新计算所有定时器的到期时间（用于系统时间调整）
+ * @details 本CPU开始调度时，以调度开始时间为起点重新启动本CPU时间轮上的所有定时器
  * @param startTime 新的开始时间
  * @return 无
  */
 VOID OsSwtmrResponseTimeReset(UINT64 startTime)
 {
-    UINT16 cpuid = ArchCurrCpuid();  // 获取当前CPU核心
-    SortLinkAttribute *swtmrSortLink = &g_swtmrRunqueue[cpuid].swtmrSortLink;  // 获取排序链表属性
-    LOS_DL_LIST *listHead = &swtmrSortLink->sortLink;  // 获取链表头
-    LOS_DL_LIST *listNext = listHead->pstNext;  // 获取第一个节点
-
-    LOS_SpinLock(&swtmrSortLink->spinLock);  // 加锁
-    while (listNext != listHead) {  // 遍历所有节点
-        SortLinkList *sortList = LOS_DL_LIST_ENTRY(listNext, SortLinkList, sortLinkNode);  // 获取当前节点
-        OsDeleteNodeSortLink(swtmrSortLink, sortList);  // 从链表中删除
-        LOS_SpinUnlock(&swtmrSortLink->spinLock);  // 解锁
-
-        SwtmrRestart(startTime, sortList, cpuid);  // 重启定时器
+    SwtmrRunqueue *srq = &g_swtmrRunqueue[ArchCurrCpuid()];  // 获取当前CPU的运行队列
+    LOS_DL_LIST restartList;
+
+    LOS_ListInit(&restartList);
+    LOS_SpinLock(&srq->lock);  // 加锁
+    for (UINT32 level = 0; level < SWTMR_WHEEL_LEVEL; level++) {  // 摘下时间轮上的所有定时器
+        for (UINT32 slot = 0; slot < SWTMR_WHEEL_SIZE; slot++) {
+            while (!LOS_ListEmpty(&srq->wheel[level][slot])) {
+                LOS_DL_LIST *list = LOS_DL_LIST_FIRST(&srq->wheel[level][slot]);
+                LOS_ListDelete(list);
+                LOS_ListTailInsert(&restartList, list);
+            }
+        }
+        srq->pending[level] = 0;
+    }
+    while (!LOS_ListEmpty(&srq->expiredList)) {
+        LOS_DL_LIST *list = LOS_DL_LIST_FIRST(&srq->expiredList);
+        LOS_ListDelete(list);
+        LOS_ListTailInsert(&restartList, list);
+    }
+    srq->nodeNum = 0;
+    srq->currTick = startTime / OS_CYCLE_PER_TICK;  // 时间轮从调度开始时间起计
 
-        LOS_SpinLock(&swtmrSortLink->spinLock);  // 重新加锁
-        listNext = listNext->pstNext;  // 移动到下一个节点
+    while (!LOS_ListEmpty(&restartList)) {  // 逐个重新启动
+        LOS_DL_LIST *list = LOS_DL_LIST_FIRST(&restartList);
+        SWTMR_CTRL_S *swtmr = LOS_DL_LIST_ENTRY(list, SWTMR_CTRL_S, stSortList.sortLinkNode);
+        LOS_ListDelete(list);
+        swtmr->startTime = startTime;  // 更新开始时间
+        (VOID)SwtmrToStart(srq, swtmr);  // 重新启动定时器
     }
-    LOS_SpinUnlock(&swtmrSortLink->spinLock);  // 解锁
+    LOS_SpinUnlock(&srq->lock);  // 解锁
 }
 
 /**
- * @brief 在软件定时器运行队列中查找节点
- * @details 使用指定的检查函数在定时器链表中查找节点
- * @param swtmrSortLink 排序链表属性指针
+ * @brief 在链表中查找满足条件的定时器节点
+ * @param head 链表头
  * @param checkFunc 检查函数指针
  * @param arg 检查函数参数
  * @return TRUE-找到，FALSE-未找到
  */
-STATIC INLINE BOOL SwtmrRunqueueFind(SortLinkAttribute *swtmrSortLink, SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
+STATIC INLINE BOOL SwtmrListFind(const LOS_DL_LIST *head, SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
 {
-    LOS_DL_LIST *listObject = &swtmrSortLink->sortLink;  // 获取链表头
-    LOS_DL_LIST *list = listObject->pstNext;  // 获取第一个节点
-
-    LOS_SpinLock(&swtmrSortLink->spinLock);  // 加锁
-    while (list != listObject) {  // 遍历链表
+    for (LOS_DL_LIST *list = head->pstNext; list != head; list = list->pstNext) {  // 遍历链表
         SortLinkList *listSorted = LOS_DL_LIST_ENTRY(list, SortLinkList, sortLinkNode);  // 获取当前节点
         if (checkFunc((UINTPTR)listSorted, arg)) {  // 调用检查函数
-            LOS_SpinUnlock(&swtmrSortLink->spinLock);  // 解锁
             return TRUE;  // 找到节点
         }
-        list = list->pstNext;  // 移动到下一个节点
     }
-
-    LOS_SpinUnlock(&swtmrSortLink->spinLock);  // 解锁
     return FALSE;  // 未找到
 }
 
 /**
- * @brief 在所有CPU核心的定时器链表中查找节点
- * @details 遍历所有CPU核心的定时器链表，使用检查函数查找节点
+ * @brief 在软件定时器运行队列中查找节点
+ * @details 遍历指定CPU时间轮的所有槽及到期链表，调用者持有其时间轮锁
+ * @param srq 运行队列指针
  * @param checkFunc 检查函数指针
  * @param arg 检查函数参数
  * @return TRUE-找到，FALSE-未找到
  */
-STATIC BOOL SwtmrTimeListFind(SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
+STATIC BOOL SwtmrRunqueueFind(const SwtmrRunqueue *srq, SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
 {
-    for (UINT16 cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {  // 遍历所有CPU核心
-        SortLinkAttribute *swtmrSortLink = &g_swtmrRunqueue[cpuid].swtmrSortLink;
-        if (SwtmrRunqueueFind(swtmrSortLink, checkFunc, arg)) {  // 在当前核心查找
-            return TRUE;  // 找到节点
+    for (UINT32 level = 0; level < SWTMR_WHEEL_LEVEL; level++) {
+        for (UINT32 slot = 0; slot < SWTMR_WHEEL_SIZE; slot++) {
+            if ((srq->pending[level] & BIT(slot)) && SwtmrListFind(&srq->wheel[level][slot], checkFunc, arg)) {
+                return TRUE;
+            }
         }
     }
-    return FALSE;  // 未找到
+    return SwtmrListFind(&srq->expiredList, checkFunc, arg);
 }
 
 /**
  * @brief 在软件定时器工作队列中查找节点
- * @details 加锁保护下在所有定时器链表中查找节点
+ * @details 依次锁住各CPU的时间轮查找节点
  * @param checkFunc 检查函数指针
  * @param arg 检查函数参数
  * @return TRUE-找到，FALSE-未找到
@@ -864,10 +1028,16 @@ BOOL OsSwtmrWorkQueueFind(SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
 {
     UINT32 intSave;
 
-    SWTMR_LOCK(intSave);  // 加锁
-    BOOL find = SwtmrTimeListFind(checkFunc, arg);  // 查找节点
-    SWTMR_UNLOCK(intSave);  // 解锁
-    return find;  // 返回查找结果
+    for (UINT16 cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {  // 遍历所有CPU核心
+        SwtmrRunqueue *srq = &g_swtmrRunqueue[cpuid];
+        LOS_SpinLockSave(&srq->lock, &intSave);  // 加锁
+        BOOL find = SwtmrRunqueueFind(srq, checkFunc, arg);  // 在当前核心查找
+        LOS_SpinUnlockRestore(&srq->lock, intSave);  // 解锁
+        if (find) {
+            return TRUE;  // 找到节点
+        }
+    }
+    return FALSE;  // 未找到
 }
 
 /*
@@ -876,15 +1046,23 @@ BOOL OsSwtmrWorkQueueFind(SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg)
  */
 /**
  * @brief 获取下一个定时器超时时间
- * @details 计算并返回下一个定时器超时的Tick数
+ * @details 计算并返回当前CPU时间轮下一个定时器超时的Tick数
  * @param 无
  * @return 超时Tick数，OS_INVALID_VALUE表示无超时定时器
  */
 LITE_OS_SEC_TEXT UINT32 OsSwtmrGetNextTimeout(VOID)
 {
-    UINT64 currTime = OsGetCurrSchedTimeCycle();  // 获取当前时间
+    UINT32 intSave;
+    UINT64 time = OS_INVALID_VALUE;
     SwtmrRunqueue *srq = &g_swtmrRunqueue[ArchCurrCpuid()];  // 获取当前CPU运行队列
-    UINT64 time = (OsSortLinkGetNextExpireTime(currTime, &srq->swtmrSortLink) / OS_CYCLE_PER_TICK);  // 转换为Tick数
+
+    LOS_SpinLockSave(&srq->lock, &intSave);
+    UINT64 expireTime = SwtmrWheelNextExpireTime(srq);
+    LOS_SpinUnlockRestore(&srq->lock, intSave);
+    if (expireTime != OS_SORT_LINK_INVALID_TIME) {
+        UINT64 currTime = OsGetCurrSchedTimeCycle();  // 获取当前时间
+        time = (expireTime > currTime) ? ((expireTime - currTime) / OS_CYCLE_PER_TICK) : 0;  // 转换为Tick数
+    }
     if (time > OS_INVALID_VALUE) {
         time = OS_INVALID_VALUE;  // 溢出处理
     }
@@ -897,16 +1075,17 @@ LITE_OS_SEC_TEXT UINT32 OsSwtmrGetNextTimeout(VOID)
  */
 /**
  * @brief 停止软件定时器接口
- * @details 将指定定时器从计时链表中移除并重置状态
+ * @details 将指定定时器从时间轮中摘除并重置状态，O(1)
+ * @param srq 定时器归属的运行队列（已加锁）
  * @param swtmr 软件定时器控制块指针
  * @return 无
  */
-STATIC VOID SwtmrStop(SWTMR_CTRL_S *swtmr)
+STATIC VOID SwtmrStop(SwtmrRunqueue *srq, SWTMR_CTRL_S *swtmr)
 {
     swtmr->ucState = OS_SWTMR_STATUS_CREATED;  // 设置为已创建状态
     swtmr->uwOverrun = 0;  // 重置溢出计数
 
-    DeSwtmrFromTimeList(&swtmr->stSortList);  // 从计时链表中移除
+    SwtmrWheelDelete(srq, &swtmr->stSortList);  // 从时间轮中摘除
 }
 
 /*
@@ -946,6 +1125,7 @@ LITE_OS_SEC_TEXT_INIT UINT32 LOS_SwtmrCreate(UINT32 interval,
                                              UINTPTR arg)
 {
     SWTMR_CTRL_S *swtmr = NULL;
+    SwtmrRunqueue *srq = NULL;
     UINT32 intSave;
     SortLinkList *sortList = NULL;
 
@@ -966,16 +1146,22 @@ LITE_OS_SEC_TEXT_INIT UINT32 LOS_SwtmrCreate(UINT32 interval,
         return LOS_ERRNO_SWTMR_RET_PTR_NULL;
     }
 
-    SWTMR_LOCK(intSave);  // 加锁
+    LOS_SpinLockSave(&g_swtmrFreeSpin, &intSave);  // 加锁
     if (LOS_ListEmpty(&g_swtmrFreeList)) {  // 无空闲定时器
-        SWTMR_UNLOCK(intSave);  // 解锁
+        LOS_SpinUnlockRestore(&g_swtmrFreeSpin, intSave);  // 解锁
         return LOS_ERRNO_SWTMR_MAXSIZE;
     }
 
     sortList = LOS_DL_LIST_ENTRY(g_swtmrFreeList.pstNext, SortLinkList, sortLinkNode);  // 获取空闲节点
     swtmr = LOS_DL_LIST_ENTRY(sortList, SWTMR_CTRL_S, stSortList);  // 获取控制块
     LOS_ListDelete(LOS_DL_LIST_FIRST(&g_swtmrFreeList));  // 从空闲链表删除
-    SWTMR_UNLOCK(intSave);  // 解锁
+    LOS_SpinUnlockRestore(&g_swtmrFreeSpin, intSave);  // 解锁
+
+    UINT16 cpuid = SwtmrRunqueueSelect();  // 选择归属CPU
+    LOS_AtomicInc(&g_swtmrRunqueue[cpuid].timerNum);
+    SWTMR_LOCK(swtmr, srq, intSave);  // 在原归属CPU的锁内迁移归属
+    SwtmrCpuidSet(swtmr, cpuid);
+    SWTMR_UNLOCK(srq, intSave);
 
     swtmr->uwOwnerPid = (UINTPTR)OsCurrProcessGet();  // 设置所有者进程ID
     swtmr->pfnHandler = handler;  // 设置回调函数
@@ -1000,9 +1186,11 @@ LITE_OS_SEC_TEXT_INIT UINT32 LOS_SwtmrCreate(UINT32 interval,
 LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStart(UINT16 swtmrID)
 {
     SWTMR_CTRL_S *swtmr = NULL;
+    SwtmrRunqueue *srq = NULL;
     UINT32 intSave;
     UINT32 ret = LOS_OK;
     UINT16 swtmrCBID;
+    UINT64 responseTime = 0;
 
     if (swtmrID >= OS_SWTMR_MAX_TIMERID) {  // ID超出范围
         return LOS_ERRNO_SWTMR_ID_INVALID;
@@ -1011,9 +1199,9 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStart(UINT16 swtmrID)
     swtmrCBID = swtmrID % LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 计算控制块索引
     swtmr = g_swtmrCBArray + swtmrCBID;  // 获取控制块
 
-    SWTMR_LOCK(intSave);  // 加锁
+    SWTMR_LOCK(swtmr, srq, intSave);  // 锁住定时器归属CPU的时间轮
     if (swtmr->usTimerID != swtmrID) {  // ID不匹配
-        SWTMR_UNLOCK(intSave);  // 解锁
+        SWTMR_UNLOCK(srq, intSave);  // 解锁
         return LOS_ERRNO_SWTMR_ID_INVALID;
     }
 
@@ -1026,17 +1214,22 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStart(UINT16 swtmrID)
          * 然后再次启动定时器。
          */
         case OS_SWTMR_STATUS_TICKING:  // 计时中
-            SwtmrStop(swtmr);  // 停止定时器
+            SwtmrStop(srq, swtmr);  // 停止定时器
             /* fall-through */
         case OS_SWTMR_STATUS_CREATED:  // 已创建
-            SwtmrStart(swtmr);  // 启动定时器
+            swtmr->startTime = OsGetCurrSchedTimeCycle();  // 设置开始时间
+            responseTime = SwtmrToStart(srq, swtmr);  // 计算到期时间并挂入时间轮
+            SwtmrDebugDataStart(swtmr, SWTMR_RUNQUEUE_CPUID(srq));  // 记录启动调试信息
             break;
         default:  // 无效状态
             ret = LOS_ERRNO_SWTMR_STATUS_INVALID;
             break;
     }
 
-    SWTMR_UNLOCK(intSave);  // 解锁
+    SWTMR_UNLOCK(srq, intSave);  // 解锁
+    if (ret == LOS_OK) {
+        SwtmrAdjustCheck(SWTMR_RUNQUEUE_CPUID(srq), responseTime);  // 到期时间更早时提前唤醒定时器任务
+    }
     OsHookCall(LOS_HOOK_TYPE_SWTMR_START, swtmr);  // 调用启动钩子函数
     return ret;  // 返回结果
 }
@@ -1050,6 +1243,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStart(UINT16 swtmrID)
 LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStop(UINT16 swtmrID)
 {
     SWTMR_CTRL_S *swtmr = NULL;
+    SwtmrRunqueue *srq = NULL;
     UINT32 intSave;
     UINT32 ret = LOS_OK;
     UINT16 swtmrCBID;
@@ -1060,10 +1254,10 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStop(UINT16 swtmrID)
 
     swtmrCBID = swtmrID % LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 计算控制块索引
     swtmr = g_swtmrCBArray + swtmrCBID;  // 获取控制块
-    SWTMR_LOCK(intSave);  // 加锁
+    SWTMR_LOCK(swtmr, srq, intSave);  // 锁住定时器归属CPU的时间轮
 
     if (swtmr->usTimerID != swtmrID) {  // ID不匹配
-        SWTMR_UNLOCK(intSave);  // 解锁
+        SWTMR_UNLOCK(srq, intSave);  // 解锁
         return LOS_ERRNO_SWTMR_ID_INVALID;
     }
 
@@ -1075,14 +1269,14 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStop(UINT16 swtmrID)
             ret = LOS_ERRNO_SWTMR_NOT_STARTED;  // 未启动
             break;
         case OS_SWTMR_STATUS_TICKING:  // 计时中
-            SwtmrStop(swtmr);  // 停止定时器
+            SwtmrStop(srq, swtmr);  // 停止定时器
             break;
         default:  // 无效状态
             ret = LOS_ERRNO_SWTMR_STATUS_INVALID;
             break;
     }
 
-    SWTMR_UNLOCK(intSave);  // 解锁
+    SWTMR_UNLOCK(srq, intSave);  // 解锁
     OsHookCall(LOS_HOOK_TYPE_SWTMR_STOP, swtmr);  // 调用停止钩子函数
     return ret;  // 返回结果
 }
@@ -1097,6 +1291,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrStop(UINT16 swtmrID)
 LITE_OS_SEC_TEXT UINT32 LOS_SwtmrTimeGet(UINT16 swtmrID, UINT32 *tick)
 {
     SWTMR_CTRL_S *swtmr = NULL;
+    SwtmrRunqueue *srq = NULL;
     UINT32 intSave;
     UINT32 ret = LOS_OK;
     UINT16 swtmrCBID;
@@ -1111,10 +1306,10 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrTimeGet(UINT16 swtmrID, UINT32 *tick)
 
     swtmrCBID = swtmrID % LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 计算控制块索引
     swtmr = g_swtmrCBArray + swtmrCBID;  // 获取控制块
-    SWTMR_LOCK(intSave);  // 加锁
+    SWTMR_LOCK(swtmr, srq, intSave);  // 锁住定时器归属CPU的时间轮
 
     if (swtmr->usTimerID != swtmrID) {  // ID不匹配
-        SWTMR_UNLOCK(intSave);  // 解锁
+        SWTMR_UNLOCK(srq, intSave);  // 解锁
         return LOS_ERRNO_SWTMR_ID_INVALID;
     }
     switch (swtmr->ucState) {  // 根据状态处理
@@ -1131,7 +1326,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrTimeGet(UINT16 swtmrID, UINT32 *tick)
             ret = LOS_ERRNO_SWTMR_STATUS_INVALID;
             break;
     }
-    SWTMR_UNLOCK(intSave);  // 解锁
+    SWTMR_UNLOCK(srq, intSave);  // 解锁
     return ret;  // 返回结果
 }
 
@@ -1144,6 +1339,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrTimeGet(UINT16 swtmrID, UINT32 *tick)
 LITE_OS_SEC_TEXT UINT32 LOS_SwtmrDelete(UINT16 swtmrID)
 {
     SWTMR_CTRL_S *swtmr = NULL;
+    SwtmrRunqueue *srq = NULL;
     UINT32 intSave;
     UINT32 ret = LOS_OK;
     UINT16 swtmrCBID;
@@ -1154,10 +1350,10 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrDelete(UINT16 swtmrID)
 
     swtmrCBID = swtmrID % LOSCFG_BASE_CORE_SWTMR_LIMIT;  // 计算控制块索引
     swtmr = g_swtmrCBArray + swtmrCBID;  // 获取控制块
-    SWTMR_LOCK(intSave);  // 加锁
+    SWTMR_LOCK(swtmr, srq, intSave);  // 锁住定时器归属CPU的时间轮
 
     if (swtmr->usTimerID != swtmrID) {  // ID不匹配
-        SWTMR_UNLOCK(intSave);  // 解锁
+        SWTMR_UNLOCK(srq, intSave);  // 解锁
         return LOS_ERRNO_SWTMR_ID_INVALID;
     }
 
@@ -1166,7 +1362,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrDelete(UINT16 swtmrID)
             ret = LOS_ERRNO_SWTMR_NOT_CREATED;  // 未创建
             break;
         case OS_SWTMR_STATUS_TICKING:  // 计时中
-            SwtmrStop(swtmr);  // 停止定时器
+            SwtmrStop(srq, swtmr);  // 停止定时器
             /* fall-through */
         case OS_SWTMR_STATUS_CREATED:  // 已创建
             SwtmrDelete(swtmr);  // 删除定时器
@@ -1176,7 +1372,7 @@ LITE_OS_SEC_TEXT UINT32 LOS_SwtmrDelete(UINT16 swtmrID)
             break;
     }
 
-    SWTMR_UNLOCK(intSave);  // 解锁
+    SWTMR_UNLOCK(srq, intSave);  // 解锁
     OsHookCall(LOS_HOOK_TYPE_SWTMR_DELETE, swtmr);  // 调用删除钩子函数
     return ret;  // 返回结果
 }
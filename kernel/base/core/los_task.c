@@ -980,8 +980,6 @@ LITE_OS_SEC_TEXT_INIT UINT32 LOS_TaskCreate(UINT32 *taskID, TSK_INIT_PARAM_S *in
     taskCB->ops->enqueue(OsSchedRunqueue(), taskCB);  // 将任务加入调度队列
     SCHEDULER_UNLOCK(intSave);  // 开启调度器
 
-    /* 若创建的任务不在当前核心运行，是否调度取决于其他调度器状态 */
-    LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度
     if (OS_SCHEDULER_ACTIVE) {  // 检查调度器是否激活
         LOS_Schedule();  // 执行调度
     }
@@ -1025,7 +1023,6 @@ LITE_OS_SEC_TEXT_INIT UINT32 LOS_TaskResume(UINT32 taskID)
     errRet = taskCB->ops->resume(taskCB, &needSched);  // 恢复任务
     SCHEDULER_UNLOCK(intSave);  // 开启调度器
 
-    LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度
     if (OS_SCHEDULER_ACTIVE && needSched) {  // 检查调度器是否激活且需要调度
         LOS_Schedule();  // 执行调度
     }
@@ -1314,25 +1311,17 @@ LOS_ERREND:  // 错误处理标签
 }
 
 /**
- * @brief 任务延迟（外部API）
- * @details 使当前任务延迟指定的时钟滴答数，进入阻塞状态
- * @param tick 延迟的时钟滴答数，0表示立即让出CPU
- * @return 操作结果
- * @retval LOS_OK 延迟成功
- * @retval LOS_ERRNO_TSK_DELAY_IN_INT 中断中不允许延迟
- * @retval LOS_ERRNO_TSK_OPERATE_SYSTEM_TASK 不允许延迟系统任务
- * @retval LOS_ERRNO_TSK_DELAY_IN_LOCK 锁定状态下不允许延迟
+ * @brief 检查当前任务是否允许延迟
+ * @param runTask 当前运行任务
+ * @return LOS_OK表示允许，其他值为LOS_TaskDelay对应的错误码
  */
-LITE_OS_SEC_TEXT UINT32 LOS_TaskDelay(UINT32 tick)
+STATIC UINT32 OsTaskDelayCheck(const LosTaskCB *runTask)
 {
-    UINT32 intSave;
-
     if (OS_INT_ACTIVE) {  // 检查是否在中断上下文中
         PRINT_ERR("In interrupt not allow delay task!\n");  // 打印错误信息
         return LOS_ERRNO_TSK_DELAY_IN_INT;  // 返回中断中延迟错误
     }
 
-    LosTaskCB *runTask = OsCurrTaskGet();  // 获取当前运行任务
     if (runTask->taskStatus & OS_TASK_FLAG_SYSTEM_TASK) {  // 检查是否为系统任务
         OsBackTrace();  // 打印调用栈
         return LOS_ERRNO_TSK_OPERATE_SYSTEM_TASK;  // 返回系统任务操作错误
@@ -1341,20 +1330,79 @@ LITE_OS_SEC_TEXT UINT32 LOS_TaskDelay(UINT32 tick)
     if (!OsPreemptable()) {  // 检查是否可抢占
         return LOS_ERRNO_TSK_DELAY_IN_LOCK;  // 返回锁定状态延迟错误
     }
-    OsHookCall(LOS_HOOK_TYPE_TASK_DELAY, tick);  // 调用任务延迟钩子函数
-    if (tick == 0) {  // 延迟为0时，直接让出CPU
-        return LOS_TaskYield();  // 调用任务让出函数
-    }
+    return LOS_OK;
+}
+
+/**
+ * @brief 将当前任务按时钟周期数延迟
+ * @param runTask 当前运行任务
+ * @param cycles 延迟的时钟周期数，到期时间由单次定时器直接编程，不对齐到滴答
+ */
+STATIC UINT32 OsTaskDelayCycle(LosTaskCB *runTask, UINT64 cycles)
+{
+    UINT32 intSave;
 
     SCHEDULER_LOCK(intSave);  // 调度器加锁
-    // 调用具体架构的延迟实现，转换滴答数为周期数
-    UINT32 ret = runTask->ops->delay(runTask, OS_SCHED_TICK_TO_CYCLE(tick));
+    UINT32 ret = runTask->ops->delay(runTask, cycles);
     // 调用任务移至延迟列表钩子函数
     OsHookCall(LOS_HOOK_TYPE_MOVEDTASKTODELAYEDLIST, runTask);
     SCHEDULER_UNLOCK(intSave);  // 调度器解锁
     return ret;  // 返回操作结果
 }
 
+/**
+ * @brief 任务延迟（外部API）
+ * @details 使当前任务延迟指定的时钟滴答数，进入阻塞状态
+ * @param tick 延迟的时钟滴答数，0表示立即让出CPU
+ * @return 操作结果
+ * @retval LOS_OK 延迟成功
+ * @retval LOS_ERRNO_TSK_DELAY_IN_INT 中断中不允许延迟
+ * @retval LOS_ERRNO_TSK_OPERATE_SYSTEM_TASK 不允许延迟系统任务
+ * @retval LOS_ERRNO_TSK_DELAY_IN_LOCK 锁定状态下不允许延迟
+ */
+LITE_OS_SEC_TEXT UINT32 LOS_TaskDelay(UINT32 tick)
+{
+    LosTaskCB *runTask = OsCurrTaskGet();  // 获取当前运行任务
+    UINT32 ret = OsTaskDelayCheck(runTask);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    OsHookCall(LOS_HOOK_TYPE_TASK_DELAY, tick);  // 调用任务延迟钩子函数
+    if (tick == 0) {  // 延迟为0时，直接让出CPU
+        return LOS_TaskYield();  // 调用任务让出函数
+    }
+
+    // 转换滴答数为周期数
+    return OsTaskDelayCycle(runTask, OS_SCHED_TICK_TO_CYCLE(tick));
+}
+
+/**
+ * @brief 任务微秒级延迟（外部API）
+ * @details 与LOS_TaskDelay相同，但延迟时间以微秒为单位，到期时间不对齐到滴答；
+ * 实际精度取决于OS_TICK_RESPONSE_PRECISION（开启LOSCFG_KERNEL_HRTIMER后为微秒级）
+ * @param microseconds 延迟的微秒数，0表示立即让出CPU
+ * @return 操作结果，错误码与LOS_TaskDelay相同
+ */
+LITE_OS_SEC_TEXT UINT32 LOS_TaskDelayUs(UINT64 microseconds)
+{
+    LosTaskCB *runTask = OsCurrTaskGet();  // 获取当前运行任务
+    UINT32 ret = OsTaskDelayCheck(runTask);
+    if (ret != LOS_OK) {
+        return ret;
+    }
+
+    if (microseconds == 0) {  // 延迟为0时，直接让出CPU
+        return LOS_TaskYield();
+    }
+
+    UINT64 cycles = OS_SYS_US_TO_CYCLE(microseconds);
+    if (cycles == 0) {  // 不足一个时钟周期按一个周期延迟
+        cycles = 1;
+    }
+    return OsTaskDelayCycle(runTask, cycles);
+}
+
 /**
  * @brief 获取任务优先级（外部API）
  * @details 获取指定任务ID的当前优先级
@@ -1583,6 +1631,13 @@ LITE_OS_SEC_TEXT BOOL OsTaskCpuAffiSetUnsafe(UINT32 taskID, UINT16 newCpuAffiMas
     LosTaskCB *taskCB = OS_TCB_FROM_TID(taskID);  // 获取任务控制块
 
     taskCB->cpuAffiMask = newCpuAffiMask;         // 设置新的CPU亲和性掩码
+    if (taskCB->taskStatus & OS_TASK_STATUS_READY) {  // 就绪任务可能挂在不再允许的CPU队列上
+        SchedRunqueue *rq = OsSchedRunqueue();
+        taskCB->ops->dequeue(rq, taskCB);         // 从原就绪队列摘除
+        taskCB->ops->enqueue(rq, taskCB);         // 按新的亲和性重新入队
+        *oldCpuAffiMask = newCpuAffiMask;         // 通知新亲和性范围内的CPU
+        return TRUE;                              // 需要调度
+    }
     *oldCpuAffiMask = CPUID_TO_AFFI_MASK(taskCB->currCpu);  // 计算旧的CPU亲和性掩码
     if (!((*oldCpuAffiMask) & newCpuAffiMask)) {  // 检查当前CPU是否在新的亲和性掩码中
         taskCB->signal = SIGNAL_AFFI;             // 设置CPU亲和性变更信号
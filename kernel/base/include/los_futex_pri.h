@@ -69,6 +69,7 @@
 #define FUTEX_WAIT        0   ///< 等待操作：阻塞等待FUTEX值变化
 #define FUTEX_WAKE        1   ///< 唤醒操作：唤醒一个或多个等待的线程
 #define FUTEX_REQUEUE     3   ///< 重排队操作：将等待线程从一个FUTEX转移到另一个
+#define FUTEX_CMP_REQUEUE 4   ///< 比较重排队：FUTEX值等于val3时才执行重排队
 #define FUTEX_WAKE_OP     5   ///< 唤醒并操作：唤醒线程并对FUTEX值执行原子操作
 #define FUTEX_LOCK_PI     6   ///< PI锁定操作：获取优先级继承锁
 #define FUTEX_UNLOCK_PI   7   ///< PI解锁操作：释放优先级继承锁
@@ -80,7 +81,34 @@
  * @details 用于指定FUTEX的属性和行为特征
  */
 #define FUTEX_PRIVATE     128 ///< 私有FUTEX标志：仅本进程内可见
-#define FUTEX_MASK        0x3U ///< FUTEX操作掩码：用于提取操作类型（十六进制0x3U对应十进制3）
+#define FUTEX_MASK        0x7FU ///< FUTEX操作掩码：去掉FUTEX_PRIVATE等标志位后得到操作类型
+
+/**
+ * @brief FUTEX_WAKE_OP的操作编码
+ * @details val3 = (op << 28) | (cmp << 24) | ((oparg & 0xfff) << 12) | (cmparg & 0xfff)，
+ *          对uaddr2执行 *uaddr2 = *uaddr2 op oparg，再用旧值与cmparg比较决定是否唤醒uaddr2上的等待者
+ */
+#define FUTEX_OP_SET         0   ///< *uaddr2 = oparg
+#define FUTEX_OP_ADD         1   ///< *uaddr2 += oparg
+#define FUTEX_OP_OR          2   ///< *uaddr2 |= oparg
+#define FUTEX_OP_ANDN        3   ///< *uaddr2 &= ~oparg
+#define FUTEX_OP_XOR         4   ///< *uaddr2 ^= oparg
+#define FUTEX_OP_OPARG_SHIFT 8   ///< 使用(1 << oparg)作为操作数
+
+#define FUTEX_OP_CMP_EQ      0   ///< 旧值 == cmparg 时唤醒
+#define FUTEX_OP_CMP_NE      1   ///< 旧值 != cmparg 时唤醒
+#define FUTEX_OP_CMP_LT      2   ///< 旧值 < cmparg 时唤醒
+#define FUTEX_OP_CMP_LE      3   ///< 旧值 <= cmparg 时唤醒
+#define FUTEX_OP_CMP_GT      4   ///< 旧值 > cmparg 时唤醒
+#define FUTEX_OP_CMP_GE      5   ///< 旧值 >= cmparg 时唤醒
+
+/**
+ * @brief PI FUTEX用户字的位定义
+ * @details 用户字低位保存持有者的线程ID，最高位表示内核中有等待者，用户态快速解锁必须失败并进入内核
+ */
+#define FUTEX_WAITERS        0x80000000U ///< 内核中存在等待者
+#define FUTEX_OWNER_DIED     0x40000000U ///< 持有者已退出
+#define FUTEX_TID_MASK       0x3FFFFFFFU ///< 持有者线程ID掩码
 
 /**
  * @brief FUTEX节点结构体
@@ -101,4 +129,11 @@ extern INT32 OsFutexWake(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber
 extern INT32 OsFutexWait(const UINT32 *userVaddr, UINT32 flags, UINT32 val, UINT32 absTime);
 extern INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber,
                             INT32 count, const UINT32 *newUserVaddr);
+extern INT32 OsFutexCmpRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber,
+                               INT32 count, const UINT32 *newUserVaddr, UINT32 val);
+extern INT32 OsFutexWakeOp(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber,
+                           INT32 wakeNumber2, const UINT32 *userVaddr2, UINT32 encodedOp);
+extern INT32 OsFutexLockPi(const UINT32 *userVaddr, UINT32 flags, UINT32 absTime);
+extern INT32 OsFutexTrylockPi(const UINT32 *userVaddr, UINT32 flags);
+extern INT32 OsFutexUnlockPi(const UINT32 *userVaddr, UINT32 flags);
 #endif
@@ -61,6 +61,8 @@ typedef enum {
  */
 typedef struct {
     UINT32      excFlag;               /* CPU暂停或异常标志 */
+    UINT32      schedIpiSend;          /* 本CPU发出的调度IPI次数，按目标CPU个数计 */
+    UINT32      schedIpiRecv;          /* 本CPU收到的调度IPI次数 */
 #ifdef LOSCFG_KERNEL_SMP_CALL
     LOS_DL_LIST funcLink;              /* 多处理器函数调用链表 */
 #endif
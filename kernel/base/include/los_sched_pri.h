@@ -68,12 +68,28 @@ extern "C" {
  */
 #define OS_SCHED_MINI_PERIOD          (OS_SYS_CLOCK / LOSCFG_BASE_CORE_TICK_PER_SECOND_MINI)
 
+#ifdef LOSCFG_KERNEL_HRTIMER
+/**
+ * @ingroup los_sched
+ * @brief 高精度定时器的到期合并精度（单位：微秒）
+ */
+#define OS_HRTIMER_PRECISION_US       10
+
+/**
+ * @ingroup los_sched
+ * @brief 滴答响应精度（单位：系统时钟周期）
+ * @details 高精度模式下到期时间只在OS_HRTIMER_PRECISION_US范围内合并，
+ * 使nanosleep等微秒级延时不再被对齐到毫秒
+ */
+#define OS_TICK_RESPONSE_PRECISION    (UINT32)((OS_SYS_CLOCK / OS_SYS_US_PER_SECOND) * OS_HRTIMER_PRECISION_US)
+#else
 /**
  * @ingroup los_sched
  * @brief 滴答响应精度（单位：系统时钟周期）
  * @details 取值为调度最小周期的75%，用于确保调度响应的时间精度
  */
 #define OS_TICK_RESPONSE_PRECISION    (UINT32)((OS_SCHED_MINI_PERIOD * 75) / 100)
+#endif
 
 /**
  * @ingroup los_sched
@@ -98,6 +114,13 @@ extern "C" {
  */
 #define AFFI_MASK_TO_CPUID(mask)      ((UINT16)((mask) - 1))
 
+/**
+ * @ingroup los_sched
+ * @brief 周期性负载均衡间隔（单位：系统时钟周期）
+ * @details 每个CPU在滴答处理中至多每隔该时间从最繁忙的CPU拉取一次就绪任务
+ */
+#define OS_SCHED_BALANCE_PERIOD       ((10000 * OS_SYS_NS_PER_US) / OS_NS_PER_CYCLE) /* 10ms */
+
 /** @ingroup los_sched EDF调度最小运行时间（单位：微秒） */
 #define OS_SCHED_EDF_MIN_RUNTIME    100 /* 100 us */
 /** @ingroup los_sched EDF调度最小截止时间（单位：微秒） */
@@ -184,6 +207,7 @@ typedef struct {
 typedef struct {
     HPFQueue queueList[OS_PRIORITY_QUEUE_NUM]; /**< HPF队列数组 */
     UINT32   queueBitmap;                      /**< 队列位图，用于标识非空HPF队列 */
+    UINT32   readyTasks;                       /**< 该队列上的就绪任务总数，负载均衡依据 */
 } HPFRunqueue;
 
 /**
@@ -200,10 +224,16 @@ typedef struct {
 /**
  * @ingroup los_sched
  * @brief 调度运行队列结构
- * @details 包含系统调度所需的各类队列和调度控制参数
+ * @details 包含系统调度所需的各类队列和调度控制参数。
+ * 加锁顺序：g_taskSpin -> 超时队列锁。g_taskSpin保护任务状态、等待链表与各CPU的HPF就绪队列。
+ * 就绪队列没有独立的锁：唤醒、超时扫描与futex路径在修改任务状态和等待链表的同时入队，
+ * 单独为就绪队列加锁不能减少g_taskSpin的竞争，拆分须先把这些路径移出g_taskSpin。
  */
 typedef struct {
     SortLinkAttribute timeoutQueue;  /**< 任务超时队列，用于管理任务超时事件 */
+#ifdef LOSCFG_KERNEL_HRTIMER
+    SortLinkAttribute hrtimerQueue;  /**< 高精度定时器队列，到期回调在滴答中断中执行 */
+#endif
     HPFRunqueue       *hpfRunqueue;  /**< 指向HPF调度队列的指针 */
     EDFRunqueue       *edfRunqueue;  /**< 指向EDF调度队列的指针 */
     UINT64            responseTime;  /**< 当前CPU滴答中断的响应时间（单位：系统时钟周期） */
@@ -211,6 +241,15 @@ typedef struct {
     LosTaskCB         *idleTask;     /**< 空闲任务指针 */
     UINT32            taskLockCnt;   /**< 任务锁计数器，0表示未锁定，>0表示锁定调度 */
     UINT32            schedFlag;     /**< 调度挂起标志，取值为SchedFlag枚举类型 */
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+    UINT64            timerIrqCount;    /**< 该CPU定时器中断到期次数 */
+    UINT64            idleWakeupCount;  /**< 其中打断空闲任务的次数，即空闲唤醒次数 */
+#endif
+#ifdef LOSCFG_KERNEL_SMP
+    UINT64            balanceTime;   /**< 上一次周期性负载均衡的时间（单位：系统时钟周期） */
+    LosTaskCB         *runTask;      /**< 该CPU正在运行的任务，在g_taskSpin保护下更新，供跨CPU唤醒判断是否需要抢占 */
+    LosTaskCB         *handoffTask;  /**< OsSchedWakeHandoff正在唤醒的任务，HPF入队时据此放入本CPU就绪队列而不做跨CPU选择 */
+#endif
 } SchedRunqueue;
 
 extern SchedRunqueue g_schedRunqueue[LOSCFG_KERNEL_CORE_NUM];
@@ -418,6 +457,7 @@ typedef struct {
     UINT16  policy;             /* This field must be present for all scheduling policies and must be the first in the structure */
     UINT16  basePrio;           /**< 基础优先级 */
     UINT16  priority;           /**< 当前优先级 */
+    UINT16  cpuid;              /**< 任务就绪时所在HPF运行队列的CPU编号 */
     UINT32  initTimeSlice;      /* cycle */ /**< 初始时间片大小（单位：系统时钟周期） */
     UINT32  priBitmap;          /* Bitmap for recording the change of task priority, the priority can not be greater than 31 */ /**< 优先级变化记录位图，优先级最大不超过31 */
 } SchedHPF;
@@ -1115,7 +1155,10 @@ UINT32 EDFTaskSchedParamInit(LosTaskCB *taskCB, UINT16 policy,
                              const SchedParam *parentParam,
                              const LosSchedParam *param);
 
-VOID HPFSchedPolicyInit(SchedRunqueue *rq);
+VOID HPFSchedPolicyInit(SchedRunqueue *rq, UINT16 cpuid);
+#ifdef LOSCFG_KERNEL_SMP
+UINT32 HPFLoadBalance(SchedRunqueue *rq, BOOL idle);
+#endif
 VOID HPFTaskSchedParamInit(LosTaskCB *taskCB, UINT16 policy,
                            const SchedParam *parentParam,
                            const LosSchedParam *param);
@@ -1147,6 +1190,14 @@ VOID OsSchedRunqueueInit(VOID);
 VOID OsSchedResched(VOID);
 VOID OsSchedIrqEndCheckNeedSched(VOID);
 
+/**
+ * @brief 直接切换唤醒：把taskCB唤醒到本CPU就绪队列，RR任务同时接过runTask剩余的时间片
+ * @details 调用者随后阻塞或让出CPU时直接切换到taskCB，用于同步IPC的请求与应答。
+ *          EDF任务或本CPU不在taskCB亲和性范围内时按普通方式唤醒。调用者须持有g_taskSpin
+ * @return BOOL taskCB是否已放入本CPU就绪队列
+ */
+BOOL OsSchedWakeHandoff(LosTaskCB *runTask, LosTaskCB *taskCB);
+
 /*
 * This function inserts the runTask to the lock pending list based on the
 * task priority.
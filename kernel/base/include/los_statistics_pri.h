@@ -69,6 +69,10 @@ UINT32 OsShellShowEdfSchedStatistics(VOID);
 VOID EDFDebugRecord(UINTPTR *taskCB, UINT64 oldFinish);
 #endif
 
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+UINT32 OsShellShowSchedWakeup(VOID);
+#endif
+
 #ifdef __cplusplus
 #if __cplusplus
 }
@@ -62,12 +62,11 @@ enum SwtmrState {
 /**
  * @ingroup los_swtmr_pri
  * @brief 软件定时器超时回调函数结构体
- * @core 封装定时器超时处理的回调函数及其参数，用于定时器事件分发
+ * @core 定时器到期时在时间轮锁内拷贝回调及其参数，出锁后由定时器任务批量执行
  */
 typedef struct {
     SWTMR_PROC_FUNC handler;    /**< 超时回调函数：定时器到期时执行的处理函数 */
     UINTPTR arg;                /**< 回调参数：传递给超时处理函数的实参，支持指针或整数类型 */
-    LOS_DL_LIST node;           /**< 双向链表节点：用于将回调函数挂载到定时器事件链表 */
 #ifdef LOSCFG_SWTMR_DEBUG
     UINT32 swtmrID;             /**< 定时器ID：调试模式下记录所属定时器ID，用于问题定位 */
 #endif
@@ -125,7 +124,7 @@ extern VOID OsSwtmrResponseTimeReset(UINT64 startTime);
 extern UINT32 OsSwtmrInit(VOID);
 extern VOID OsSwtmrRecycle(UINTPTR ownerID);
 extern BOOL OsSwtmrWorkQueueFind(SCHED_TL_FIND_FUNC checkFunc, UINTPTR arg);
-extern SPIN_LOCK_S g_swtmrSpin;
+extern SPIN_LOCK_S *OsSwtmrLock(const SWTMR_CTRL_S *swtmr, UINT32 *intSave);
 extern UINT32 OsSwtmrTaskIDGetByCpuid(UINT16 cpuid);
 
 /**
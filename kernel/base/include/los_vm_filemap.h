@@ -113,6 +113,24 @@ typedef struct FilePage {
     UINT16                  dirtyEnd;       ///< 脏数据结束偏移，单位：字节（相对于页面起始）
 } LosFilePage;
 
+#define VM_PAGE_INDEX_BITS      6                               ///< 页缓存索引每层使用的pgoff位数
+#define VM_PAGE_INDEX_SLOTS     (1U << VM_PAGE_INDEX_BITS)      ///< 每个索引节点的槽位数
+#define VM_PAGE_INDEX_MASK      (VM_PAGE_INDEX_SLOTS - 1)       ///< 槽位号掩码
+
+/**
+ * @brief 页缓存基数树节点，按pgoff索引文件页
+ * @core 叶子节点(shift为0)的槽位存放LosFilePage，中间节点的槽位存放子节点；
+ *       树根挂在vnode上，与page_list一样受page_mapping.list_lock保护，
+ *       page_list仍按pgoff有序，仅用于顺序回写与遍历
+ */
+typedef struct VmPageIndexNode {
+    struct VmPageIndexNode  *parent;        ///< 父节点，根节点为NULL
+    UINT8                   shift;          ///< 本节点槽位号对应的pgoff位偏移
+    UINT8                   offset;         ///< 本节点在父节点中的槽位号
+    UINT16                  count;          ///< 非空槽位数，为0时节点被回收
+    VOID                    *slots[VM_PAGE_INDEX_SLOTS]; ///< 子节点或文件页
+} VmPageIndexNode;
+
 /**
  * @brief 映射信息结构体，描述虚拟地址与物理页面的映射关系
  * @core 建立用户虚拟地址到文件物理页面的映射桥梁
@@ -136,6 +154,7 @@ enum OsPageFlags {
     FILE_PAGE_LRU,           ///< 页面在LRU链表中
     FILE_PAGE_ACTIVE,        ///< 页面活跃，近期被访问过
     FILE_PAGE_SHARED,        ///< 页面共享，被多个进程映射
+    FILE_PAGE_READAHEAD,     ///< 页面由预读读入，尚未被访问
 };
 
 /**
@@ -147,6 +166,9 @@ enum OsPageFlags {
 #define MAX_SHRINK_PAGECACHE_TRY        2U      ///< 页缓存收缩最大尝试次数，防止过度回收
 #define VM_FILEMAP_MAX_SCAN             (SYS_MEM_SIZE_DEFAULT >> PAGE_SHIFT)  ///< 最大扫描页面数 = 默认内存大小 / 页面大小
 #define VM_FILEMAP_MIN_SCAN             32U     ///< 最小扫描页面数，即使内存充足也至少扫描32页
+#define VM_READAHEAD_MIN_PAGES          4U      ///< 识别到顺序访问时的初始预读窗口(页)
+#define VM_READAHEAD_MAX_PAGES          32U     ///< 预读窗口上限(页)，窗口随连续的顺序缺页加倍直至该值
+#define VM_FAULT_AROUND_PAGES           16U     ///< 读缺页时至少尝试顺带映射的后续已缓存页数
 /** @} */
 /**
  * @brief 设置页面锁定标志
@@ -365,9 +387,20 @@ VOID OsPageRefDecNoLock(LosFilePage *page);
 VOID OsPageRefIncLocked(LosFilePage *page);
 int OsTryShrinkMemory(size_t nPage);
 VOID OsMarkPageDirty(LosFilePage *fpage, const LosVmMapRegion *region, int off, int len);
+VOID OsVmmFileReadAround(LosVmMapRegion *region, const LosVmPgFault *vmf);
 
 #ifdef LOSCFG_DEBUG_VERSION
-VOID ResetPageCacheHitInfo(int *try, int *hit);
+/**
+ * @brief 文件缺页预读统计
+ */
+typedef struct {
+    int readAheadPages;      ///< 预读读入页缓存的页数
+    int readAheadHit;        ///< 预读页随后被缺页或周边映射使用的次数
+    int faultAroundPages;    ///< 读缺页时顺带映射的已缓存页数
+    int maxWindow;           ///< 统计周期内预读窗口达到的最大值(页)
+} PageCacheRaInfo;
+
+VOID ResetPageCacheHitInfo(int *try, int *hit, PageCacheRaInfo *ra);
 struct file_map* GetFileMappingList(void);
 #endif
 #ifdef __cplusplus
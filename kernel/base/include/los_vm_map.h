@@ -152,6 +152,9 @@ struct VmMapRegion {
             int f_oflags;               /**< 文件打开标志 */
             struct Vnode *vnode;        /**< 文件vnode指针 */
             const LosVmFileOps *vmFOps; /**< 文件操作接口指针 */
+            VM_OFFSET_T raPrevPgoff;    /**< 上一次读缺页的文件页偏移 */
+            VM_OFFSET_T raNextPgoff;    /**< 上一次读缺页预读并周边映射后，顺序访问时下一个缺页的页偏移 */
+            UINT32 raWindow;            /**< 预读窗口(页)，顺序访问时加倍，随机访问时为0 */
         } rf;
         /** @brief 匿名类型区域数据 */
         struct VmRegionAnon {
@@ -461,6 +464,7 @@ VADDR_T OsAllocRange(LosVmSpace *vmSpace, size_t len);
 VADDR_T OsAllocSpecificRange(LosVmSpace *vmSpace, VADDR_T vaddr, size_t len, UINT32 regionFlags);
 LosVmMapRegion *OsCreateRegion(VADDR_T vaddr, size_t len, UINT32 regionFlags, unsigned long offset);
 BOOL OsInsertRegion(LosRbTree *regionRbTree, LosVmMapRegion *region);
+LosVmMapRegion *OsFindRegion(LosRbTree *regionRbTree, VADDR_T vaddr, size_t len);
 LosVmSpace *LOS_SpaceGet(VADDR_T vaddr);
 LosVmSpace *LOS_CurrSpaceGet(VOID);
 BOOL LOS_IsRegionFileValid(LosVmMapRegion *region);
@@ -103,6 +103,22 @@ struct VmFreeList {
     UINT32 listCnt;            /* 该阶数空闲页块的数量计数 */
 };
 
+/**
+ * @brief 每CPU单页缓存
+ * @note 单页的分配与释放先走本CPU缓存，只在缓存空或超过上限时批量访问伙伴系统，
+ *       减少对段空闲链表锁的争用。链表头部是最近释放的热页，尾部是冷页：
+ *       分配从头部取热页，归还伙伴系统时从尾部取冷页
+ */
+struct VmPhysPcp {
+    SPIN_LOCK_S lock;          /* 缓存锁，平时只有本CPU访问，内存紧张时全局回收会跨CPU获取 */
+    LOS_DL_LIST list;          /* 缓存的单页链表，页面通过LosVmPage.node挂入 */
+    UINT32 count;              /* 缓存中的页数 */
+    UINT32 allocCnt;           /* 从缓存分配的页数 */
+    UINT32 freeCnt;            /* 释放进缓存的页数 */
+    UINT32 refillCnt;          /* 从伙伴系统批量补充的次数 */
+    UINT32 drainCnt;           /* 批量归还伙伴系统的次数 */
+};
+
 /**
  * @brief LRU(最近最少使用)页面链表类型枚举
  * @note 用于页面回收算法中对不同类型页面进行分类管理
@@ -127,6 +143,9 @@ typedef struct VmPhysSeg {
 
     SPIN_LOCK_S freeListLock; /* 伙伴链表自旋锁，保护空闲页操作的原子性 */
     struct VmFreeList freeList[VM_LIST_ORDER_MAX];  /* 伙伴系统空闲页链表数组，按阶数索引 */
+    UINT32 allocCnt[VM_LIST_ORDER_MAX]; /* 各阶直接从伙伴系统分配的次数，单页分配计入每CPU缓存 */
+    UINT32 freeCnt[VM_LIST_ORDER_MAX];  /* 各阶直接释放回伙伴系统的次数，单页释放计入每CPU缓存 */
+    struct VmPhysPcp pcp[LOSCFG_KERNEL_CORE_NUM]; /* 每CPU单页缓存 */
 
     SPIN_LOCK_S lruLock;      /* LRU链表自旋锁，保护LRU页面操作的原子性 */
     size_t lruSize[VM_NR_LRU_LISTS]; /* 各类型LRU链表的页面数量 */
@@ -157,6 +176,7 @@ VOID OsPhysSharePageCopy(PADDR_T oldPaddr, PADDR_T *newPaddr, LosVmPage *newPage
 VOID OsVmPhysPagesFreeContiguous(LosVmPage *page, size_t nPages);
 LosVmPage *OsVmPhysToPage(paddr_t pa, UINT8 segID);
 LosVmPage *OsVmPaddrToPage(paddr_t paddr);
+UINT32 OsVmPhysPcpPagesGet(LosVmPhysSeg *seg);
 
 LosVmPage *LOS_PhysPageAlloc(VOID);
 VOID LOS_PhysPageFree(LosVmPage *page);
@@ -376,7 +376,6 @@ LITE_OS_SEC_TEXT STATIC UINT32 OsEventWrite(PEVENT_CB_S eventCB, UINT32 events,
     SCHEDULER_UNLOCK(intSave);  // 解锁调度器
 
     if (exitFlag == 1) {  // 如果需要调度
-        LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度
         LOS_Schedule();  // 触发任务调度
     }
     return LOS_OK;
@@ -86,12 +86,14 @@
 #include "los_exc.h"
 #include "los_hash.h"
 #include "los_init.h"
+#include "los_memory.h"
 #include "los_process_pri.h"
 #include "los_sched_pri.h"
 #include "los_sys_pri.h"
 #include "los_mp.h"
 #include "los_mux_pri.h"
 #include "user_copy.h"
+#include "los_user_cmpxchg.h"
 
 #ifdef LOSCFG_KERNEL_VM
 
@@ -119,17 +121,33 @@
  */
 #define OS_FUTEX_KEY_MAX (USER_ASPACE_BASE + USER_ASPACE_SIZE)
 
-/* private: 0~63    hash index_num
- * shared:  64~79   hash index_num */
+/* private: 0 ~ g_futexIndexPrivateMax - 1
+ * shared:  g_futexIndexPrivateMax ~ FUTEX_INDEX_MAX - 1
+ * 桶数在启动时按最大任务数确定，均为2的幂 */
+/**
+ * @brief 私有futex哈希桶数下限
+ */
+#define FUTEX_INDEX_PRIVATE_MIN     64
+
+/**
+ * @brief 共享futex哈希桶数下限
+ */
+#define FUTEX_INDEX_SHARED_MIN      16
+
+/**
+ * @brief 私有桶数与共享桶数之比（以2为底的对数）
+ */
+#define FUTEX_INDEX_SHARED_SHIFT    2
+
 /**
  * @brief 私有futex哈希表索引最大值
  */
-#define FUTEX_INDEX_PRIVATE_MAX     64
+#define FUTEX_INDEX_PRIVATE_MAX     g_futexIndexPrivateMax
 
 /**
  * @brief 共享futex哈希表索引最大值
  */
-#define FUTEX_INDEX_SHARED_MAX      16
+#define FUTEX_INDEX_SHARED_MAX      g_futexIndexSharedMax
 
 /**
  * @brief 哈希表索引最大值
@@ -157,12 +175,29 @@
 typedef struct {
     LosMux      listLock;         /**< 哈希表项链表锁 */
     LOS_DL_LIST lockList;         /**< futex节点链表 */
+    LOS_DL_LIST piList;           /**< PI futex状态链表 */
 } FutexHash;
 
 /**
- * @brief Futex哈希表全局实例
+ * @brief PI futex内核状态
+ * @details 用户字上存在竞争时才创建，借用LosMux的优先级继承实现持有者提权和按优先级交接，
+ *          只要状态存在，用户字就带FUTEX_WAITERS位，迫使用户态的快速加解锁路径进入内核
  */
-FutexHash g_futexHash[FUTEX_INDEX_MAX];
+typedef struct {
+    LosMux      mux;              /**< 承载优先级继承的内核互斥锁 */
+    UINTPTR     key;              /**< futex键值 */
+    UINT32      pid;              /**< 私有futex所属进程ID，共享futex为OS_INVALID */
+    UINT32      refCount;         /**< 正在加锁（含阻塞等待）的任务数，为0时销毁 */
+    LOS_DL_LIST piList;           /**< 挂入哈希表项的piList */
+} FutexPiState;
+
+/**
+ * @brief Futex哈希表全局实例，启动时按桶数分配
+ */
+FutexHash *g_futexHash = NULL;
+
+STATIC UINT32 g_futexIndexPrivateMax; /**< 私有futex哈希桶数 */
+STATIC UINT32 g_futexIndexSharedMax;  /**< 共享futex哈希桶数 */
 
 /**
  * @brief 加锁futex哈希表锁
@@ -194,19 +229,45 @@ STATIC INT32 OsFutexUnlock(LosMux *lock)
     return LOS_OK;
 }
 
+/**
+ * @brief 计算不小于给定值的2的幂
+ * @param num 给定值
+ * @param min 结果下限，须为2的幂
+ * @return UINT32 - 不小于num和min的最小2的幂
+ */
+STATIC UINT32 OsFutexHashSizeRound(UINT32 num, UINT32 min)
+{
+    UINT32 size = min;
+
+    while ((size < num) && (size < (1U << 31))) { /* 31: UINT32中最高的2的幂 */
+        size <<= 1;
+    }
+    return size;
+}
+
 /**
  * @brief 初始化futex哈希表
- * @details 初始化所有哈希表项的链表和互斥锁
+ * @details 私有桶数取不小于最大任务数的2的幂，共享桶数为其1/4，使不同进程、不同地址上的
+ *          竞争分散到各自的桶锁上；随后初始化所有哈希表项的链表和互斥锁
  * @return UINT32 - 操作结果，LOS_OK表示成功，其他值表示失败
  */
 UINT32 OsFutexInit(VOID)
 {
-    INT32 count;
+    UINT32 count;
     UINT32 ret;
 
+    g_futexIndexPrivateMax = OsFutexHashSizeRound(g_taskMaxNum, FUTEX_INDEX_PRIVATE_MIN);
+    g_futexIndexSharedMax = OsFutexHashSizeRound(g_futexIndexPrivateMax >> FUTEX_INDEX_SHARED_SHIFT,
+                                                 FUTEX_INDEX_SHARED_MIN);
+    g_futexHash = (FutexHash *)LOS_MemAlloc(m_aucSysMem0, FUTEX_INDEX_MAX * sizeof(FutexHash));
+    if (g_futexHash == NULL) {
+        return LOS_NOK;
+    }
+
     // 遍历所有哈希表项，初始化链表和互斥锁
     for (count = 0; count < FUTEX_INDEX_MAX; count++) {
         LOS_ListInit(&g_futexHash[count].lockList);
+        LOS_ListInit(&g_futexHash[count].piList);
         ret = LOS_MuxInit(&(g_futexHash[count].listLock), NULL);
         if (ret) {
             return ret;
@@ -299,17 +360,20 @@ STATIC INLINE UINTPTR OsFutexFlagsToKey(const UINT32 *userVaddr, const UINT32 fl
 }
 
 /**
- * @brief 将futex键转换为哈希表索引
+ * @brief 将futex键和所属进程转换为哈希表索引
  * @param futexKey futex键
- * @param flags futex标志
+ * @param pid 私有futex所属进程ID，共享futex为OS_INVALID
  * @return UINT32 - 哈希表索引
+ * @note 私有futex的键是虚拟地址，不同进程的同名全局变量地址往往相同，因此把进程ID一并哈希，
+ *       避免无关进程落入同一个桶；共享futex的键是物理地址，本身已全局唯一
  */
-STATIC INLINE UINT32 OsFutexKeyToIndex(const UINTPTR futexKey, const UINT32 flags)
+STATIC INLINE UINT32 OsFutexHashIndex(const UINTPTR futexKey, const UINT32 pid)
 {
     UINT32 index = LOS_HashFNV32aBuf(&futexKey, sizeof(UINTPTR), FNV1_32A_INIT);
 
-    // 根据私有/共享标志计算不同的哈希索引
-    if (flags & FUTEX_PRIVATE) {
+    // 根据私有/共享计算不同的哈希索引
+    if (pid != OS_INVALID) {
+        index = LOS_HashFNV32aBuf(&pid, sizeof(UINT32), index);
         index &= FUTEX_HASH_PRIVATE_MASK;
     } else {
         index &= FUTEX_HASH_SHARED_MASK;
@@ -319,6 +383,17 @@ STATIC INLINE UINT32 OsFutexKeyToIndex(const UINTPTR futexKey, const UINT32 flag
     return index;
 }
 
+/**
+ * @brief 将当前进程的futex键转换为哈希表索引
+ * @param futexKey futex键
+ * @param flags futex标志
+ * @return UINT32 - 哈希表索引
+ */
+STATIC INLINE UINT32 OsFutexKeyToIndex(const UINTPTR futexKey, const UINT32 flags)
+{
+    return OsFutexHashIndex(futexKey, (flags & FUTEX_PRIVATE) ? LOS_GetCurrProcessID() : OS_INVALID);
+}
+
 /**
  * @brief 设置futex节点的键信息
  * @param futexKey futex键
@@ -423,7 +498,7 @@ VOID OsFutexNodeDeleteFromFutexHash(FutexNode *node, BOOL isDeleteHead, FutexNod
 {
     FutexHash *hashNode = NULL;
 
-    UINT32 index = OsFutexKeyToIndex(node->key, (node->pid == OS_INVALID) ? 0 : FUTEX_PRIVATE);
+    UINT32 index = OsFutexHashIndex(node->key, node->pid);
     if (index >= FUTEX_INDEX_MAX) {
         return;
     }
@@ -979,54 +1054,68 @@ STATIC INT32 OsFutexWakeParamCheck(const UINT32 *userVaddr, UINT32 flags)
 }
 
 /**
- * @brief 检查并唤醒等待的Futex任务
- * @details 遍历等待队列，唤醒指定数量的任务，并处理超时情况
+ * @brief 从等待队列头部摘下待唤醒的Futex节点
+ * @details 在桶锁下把至多wakeNumber个节点移出等待队列并置为无效，暂存到wakeList，
+ *          已超时的任务随后在桶锁下看到节点无效便不再操作队列
  * @param headNode 等待队列头节点
- * @param wakeNumber 要唤醒的任务数量
- * @param hashNode 哈希表节点
- * @param nextNode 下一个节点指针的指针
- * @param wakeAny 是否有任务被唤醒的标志指针
+ * @param wakeNumber 要摘下的节点数量
+ * @param wakeList 暂存摘下节点的链表
+ * @param nextNode 输出参数，剩余队列的新头节点，队列已空时为NULL
  */
-STATIC VOID OsFutexCheckAndWakePendTask(FutexNode *headNode, const INT32 wakeNumber,
-                                        FutexHash *hashNode, FutexNode **nextNode, BOOL *wakeAny)
+STATIC VOID OsFutexDetachPendTask(FutexNode *headNode, const INT32 wakeNumber,
+                                  LOS_DL_LIST *wakeList, FutexNode **nextNode)
 {
     INT32 count; // 计数器
-    LosTaskCB *taskCB = NULL; // 任务控制块指针
     FutexNode *node = headNode; // 当前节点
-    for (count = 0; count < wakeNumber; count++) {
-        /* 确保头部完整性 */
-        // 删除已唤醒任务并获取下一个节点
-        *nextNode = OsFutexDeleteAlreadyWakeTaskAndGetNext(node, NULL, FALSE);
-        if (*nextNode == NULL) {
-            /* 队列中的最后一个节点无效或整个列表无效 */
-            return;
-        }
+
+    for (count = 0; (count < wakeNumber) && (node != NULL); count++) {
+        // 先取得队列中的下一个节点，再把当前节点移出队列
+        *nextNode = LOS_ListEmpty(&node->queueList) ? NULL :
+                    OS_FUTEX_FROM_QUEUELIST(LOS_DL_LIST_FIRST(&(node->queueList)));
+        OsFutexDeinitFutexNode(node);
+        LOS_ListTailInsert(wakeList, &node->queueList);
         node = *nextNode; // 移动到下一个节点
+    }
+    *nextNode = node;
+}
+
+/**
+ * @brief 唤醒已摘下的Futex节点上的任务
+ * @details 只在这里持有调度锁：超时唤醒在调度锁下摘除pendList，因此判断任务是否仍在等待
+ *          与唤醒它必须在同一临界区内完成
+ * @param wakeList 暂存摘下节点的链表
+ * @return INT32 - 实际唤醒的任务数，已超时的任务不计入
+ */
+STATIC INT32 OsFutexWakeDetachedTask(LOS_DL_LIST *wakeList)
+{
+    UINT32 intSave; // 中断状态保存变量
+    INT32 count = 0; // 唤醒计数
+    FutexNode *node = NULL; // 当前节点
+    FutexNode *nextNode = NULL; // 下一个节点
+    LosTaskCB *taskCB = NULL; // 任务控制块指针
+
+    SCHEDULER_LOCK(intSave); // 锁定调度器
+    LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(node, nextNode, wakeList, FutexNode, queueList) {
+        LOS_ListDelete(&node->queueList); // 唤醒前断开与临时链表的联系
+        if (LOS_ListEmpty(&node->pendList)) {
+            continue; // 任务已超时唤醒
+        }
         // 从等待列表获取任务控制块
         taskCB = OS_TCB_FROM_PENDLIST(LOS_DL_LIST_FIRST(&(node->pendList)));
         OsTaskWakeClearPendMask(taskCB); // 清除任务等待掩码
         taskCB->ops->wake(taskCB); // 唤醒任务
-        *wakeAny = TRUE; // 设置唤醒标志
-        // 获取队列列表中的下一个节点
-        *nextNode = OS_FUTEX_FROM_QUEUELIST(LOS_DL_LIST_FIRST(&(node->queueList)));
-        if (node != headNode) {
-            OsFutexDeinitFutexNode(node); // 释放非头节点资源
-        }
-
-        if (LOS_ListEmpty(&headNode->queueList)) {
-            /* 唤醒整个链表节点 */
-            *nextNode = NULL;
-            return;
-        }
-
-        node = *nextNode; // 移动到下一个节点
+        count++;
     }
-    return;
+    SCHEDULER_UNLOCK(intSave); // 解锁调度器
+
+    return count;
 }
 
 /**
  * @brief 执行Futex唤醒操作
- * @details 根据futex键查找并唤醒指定数量的等待任务
+ * @details 根据futex键查找并唤醒指定数量的等待任务。调用者持有桶锁，队列调整在桶锁下完成，
+ *          被唤醒的任务在最后统一唤醒，因为任务一旦运行就可能用自身的Futex节点去等待别的键；
+ *          若摘下的节点中有已超时的任务，则继续从剩余队列中补足唤醒数量
  * @param futexKey Futex键值
  * @param flags futex操作标志
  * @param wakeNumber 要唤醒的任务数量
@@ -1036,11 +1125,10 @@ STATIC VOID OsFutexCheckAndWakePendTask(FutexNode *headNode, const INT32 wakeNum
  */
 STATIC INT32 OsFutexWakeTask(UINTPTR futexKey, UINT32 flags, INT32 wakeNumber, FutexNode **newHeadNode, BOOL *wakeAny)
 {
-    UINT32 intSave; // 中断状态保存变量
-    FutexNode *node = NULL; // Futex节点指针
     FutexNode *headNode = NULL; // 头节点指针
+    LOS_DL_LIST wakeList; // 待唤醒节点的临时链表
+    INT32 wakeCount = 0; // 已唤醒的任务数
     UINT32 index = OsFutexKeyToIndex(futexKey, flags); // 计算哈希索引
-    FutexHash *hashNode = &g_futexHash[index]; // 获取哈希表节点
     // 初始化临时Futex节点
     FutexNode tempNode = {
         .key = futexKey,
@@ -1048,27 +1136,31 @@ STATIC INT32 OsFutexWakeTask(UINTPTR futexKey, UINT32 flags, INT32 wakeNumber, F
         .pid = (flags & FUTEX_PRIVATE) ? LOS_GetCurrProcessID() : OS_INVALID,
     };
 
-    node = OsFindFutexNode(&tempNode); // 查找Futex节点
-    if (node == NULL) {
+    headNode = OsFindFutexNode(&tempNode); // 查找Futex节点
+    if (headNode == NULL) {
         return LOS_EBADF; // 节点不存在，返回错误
     }
 
-    headNode = node; // 设置头节点
+    *newHeadNode = headNode;
+    while ((wakeCount < wakeNumber) && (headNode != NULL)) {
+        LOS_ListInit(&wakeList);
+        // 摘下待唤醒的节点
+        OsFutexDetachPendTask(headNode, wakeNumber - wakeCount, &wakeList, newHeadNode);
+        if ((*newHeadNode) != NULL) {
+            // 替换队列列表头节点
+            OsFutexReplaceQueueListHeadNode(headNode, *newHeadNode);
+        } else {
+            // 从Futex列表中删除键
+            OsFutexDeleteKeyFromFutexList(headNode);
+        }
 
-    SCHEDULER_LOCK(intSave); // 锁定调度器
-    // 检查并唤醒等待任务
-    OsFutexCheckAndWakePendTask(headNode, wakeNumber, hashNode, newHeadNode, wakeAny);
-    if ((*newHeadNode) != NULL) {
-        // 替换队列列表头节点
-        OsFutexReplaceQueueListHeadNode(headNode, *newHeadNode);
-        OsFutexDeinitFutexNode(headNode); // 释放旧头节点资源
-    } else if (headNode->index < FUTEX_INDEX_MAX) {
-        // 从Futex列表中删除键
-        OsFutexDeleteKeyFromFutexList(headNode);
-        OsFutexDeinitFutexNode(headNode); // 释放头节点资源
+        wakeCount += OsFutexWakeDetachedTask(&wakeList);
+        headNode = *newHeadNode;
     }
-    SCHEDULER_UNLOCK(intSave); // 解锁调度器
 
+    if (wakeCount > 0) {
+        *wakeAny = TRUE; // 设置唤醒标志
+    }
     return LOS_OK; // 唤醒成功
 }
 
@@ -1117,7 +1209,6 @@ INT32 OsFutexWake(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber)
     }
 
     if (wakeAny == TRUE) { // 如果有任务被唤醒
-        LOS_MpSchedule(OS_MP_CPU_ALL); // 多处理器调度
         LOS_Schedule(); // 触发调度
     }
 
@@ -1151,7 +1242,7 @@ STATIC INT32 OsFutexRequeueInsertNewKey(UINTPTR newFutexKey, INT32 newIndex, Fut
     FutexNode newTempNode = {
         .key = newFutexKey,
         .index = newIndex,
-        .pid = (newIndex < FUTEX_INDEX_SHARED_POS) ? LOS_GetCurrProcessID() : OS_INVALID,
+        .pid = ((UINT32)newIndex < FUTEX_INDEX_SHARED_POS) ? LOS_GetCurrProcessID() : OS_INVALID,
     };
     LOS_DL_LIST *queueList = &oldHeadNode->queueList; // 队列列表指针
     // 查找新的Futex节点
@@ -1307,9 +1398,11 @@ STATIC FutexNode *OsFutexRequeueRemoveOldKeyAndGetHead(UINTPTR oldFutexKey, UINT
  * @param oldUserVaddr 旧的用户空间地址指针
  * @param flags futex操作标志
  * @param newUserVaddr 新的用户空间地址指针
+ * @param cmd 期望的操作类型（FUTEX_REQUEUE或FUTEX_CMP_REQUEUE）
  * @return 成功返回LOS_OK，失败返回LOS_EINVAL
  */
-STATIC INT32 OsFutexRequeueParamCheck(const UINT32 *oldUserVaddr, UINT32 flags, const UINT32 *newUserVaddr)
+STATIC INT32 OsFutexRequeueParamCheck(const UINT32 *oldUserVaddr, UINT32 flags, const UINT32 *newUserVaddr,
+                                      UINT32 cmd)
 {
     VADDR_T oldVaddr = (VADDR_T)(UINTPTR)oldUserVaddr; // 旧地址转换为虚拟地址
     VADDR_T newVaddr = (VADDR_T)(UINTPTR)newUserVaddr; // 新地址转换为虚拟地址
@@ -1319,7 +1412,7 @@ STATIC INT32 OsFutexRequeueParamCheck(const UINT32 *oldUserVaddr, UINT32 flags,
     }
 
     // 检查标志位是否有效
-    if ((flags & (~FUTEX_PRIVATE)) != FUTEX_REQUEUE) {
+    if ((flags & (~FUTEX_PRIVATE)) != cmd) {
         PRINT_ERR("Futex requeue param check failed! error flags: 0x%x\n", flags);
         return LOS_EINVAL; // 标志无效，返回错误
     }
@@ -1340,16 +1433,19 @@ STATIC INT32 OsFutexRequeueParamCheck(const UINT32 *oldUserVaddr, UINT32 flags,
 }
 
 /**
- * @brief Futex重新排队系统调用实现
- * @details 将等待任务从一个Futex键重新排队到另一个Futex键
+ * @brief 执行Futex重新排队操作
+ * @details 将等待任务从一个Futex键重新排队到另一个Futex键；FUTEX_CMP_REQUEUE在持有旧哈希表锁时
+ *          先比较用户字，与等待者的比较-入队处于同一把锁下，因此不会丢失唤醒
  * @param userVaddr 旧的用户空间地址指针
  * @param flags futex操作标志
  * @param wakeNumber 要唤醒的任务数量
  * @param count 要重新排队的任务数量
  * @param newUserVaddr 新的用户空间地址指针
- * @return 成功返回LOS_OK，失败返回相应错误码
+ * @param val FUTEX_CMP_REQUEUE的期望值
+ * @return 成功返回LOS_OK，值不匹配返回LOS_EAGAIN，失败返回相应错误码
  */
-INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, INT32 count, const UINT32 *newUserVaddr)
+STATIC INT32 OsFutexRequeueTask(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, INT32 count,
+                                const UINT32 *newUserVaddr, UINT32 val)
 {
     INT32 ret; // 返回值
     UINTPTR oldFutexKey; // 旧的Futex键值
@@ -1360,11 +1456,7 @@ INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, IN
     FutexHash *newHashNode = NULL; // 新的哈希表节点指针
     FutexNode *oldHeadNode = NULL; // 旧的头节点指针
     BOOL wakeAny = FALSE; // 是否有任务被唤醒的标志
-
-    // 检查重新排队参数
-    if (OsFutexRequeueParamCheck(userVaddr, flags, newUserVaddr)) {
-        return LOS_EINVAL; // 参数错误，返回错误码
-    }
+    UINT32 lockVal; // 用户字当前值
 
     oldFutexKey = OsFutexFlagsToKey(userVaddr, flags); // 生成旧的futex键
     newFutexKey = OsFutexFlagsToKey(newUserVaddr, flags); // 生成新的futex键
@@ -1376,6 +1468,18 @@ INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, IN
         return LOS_EINVAL; // 加锁失败，返回错误
     }
 
+    if ((flags & FUTEX_MASK) == FUTEX_CMP_REQUEUE) { // 比较重排队：值已变化则交由调用者重试
+        if (LOS_ArchCopyFromUser(&lockVal, userVaddr, sizeof(UINT32))) {
+            (VOID)OsFutexUnlock(&oldHashNode->listLock);
+            return LOS_EFAULT;
+        }
+
+        if (lockVal != val) {
+            (VOID)OsFutexUnlock(&oldHashNode->listLock);
+            return LOS_EAGAIN;
+        }
+    }
+
     // 移除旧键并获取头节点
     oldHeadNode = OsFutexRequeueRemoveOldKeyAndGetHead(oldFutexKey, flags, wakeNumber, newFutexKey, count, &wakeAny);
     if (oldHeadNode == NULL) { // 如果头节点为空
@@ -1407,10 +1511,733 @@ INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, IN
 
 EXIT:
     if (wakeAny == TRUE) { // 如果有任务被唤醒
-        LOS_MpSchedule(OS_MP_CPU_ALL); // 多处理器调度
         LOS_Schedule(); // 触发调度
     }
 
     return ret; // 返回结果
 }
+
+/**
+ * @brief Futex重新排队系统调用实现
+ * @details 将等待任务从一个Futex键重新排队到另一个Futex键
+ * @param userVaddr 旧的用户空间地址指针
+ * @param flags futex操作标志
+ * @param wakeNumber 要唤醒的任务数量
+ * @param count 要重新排队的任务数量
+ * @param newUserVaddr 新的用户空间地址指针
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+INT32 OsFutexRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, INT32 count, const UINT32 *newUserVaddr)
+{
+    // 检查重新排队参数
+    if (OsFutexRequeueParamCheck(userVaddr, flags, newUserVaddr, FUTEX_REQUEUE)) {
+        return LOS_EINVAL; // 参数错误，返回错误码
+    }
+
+    return OsFutexRequeueTask(userVaddr, flags, wakeNumber, count, newUserVaddr, 0);
+}
+
+/**
+ * @brief Futex比较重新排队系统调用实现
+ * @details 仅当旧地址上的值仍等于val时才唤醒并重新排队，否则返回LOS_EAGAIN由用户态重试
+ * @param userVaddr 旧的用户空间地址指针
+ * @param flags futex操作标志
+ * @param wakeNumber 要唤醒的任务数量
+ * @param count 要重新排队的任务数量
+ * @param newUserVaddr 新的用户空间地址指针
+ * @param val 期望的futex值
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+INT32 OsFutexCmpRequeue(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber, INT32 count,
+                        const UINT32 *newUserVaddr, UINT32 val)
+{
+    // 检查重新排队参数
+    if (OsFutexRequeueParamCheck(userVaddr, flags, newUserVaddr, FUTEX_CMP_REQUEUE)) {
+        return LOS_EINVAL; // 参数错误，返回错误码
+    }
+
+    return OsFutexRequeueTask(userVaddr, flags, wakeNumber, count, newUserVaddr, val);
+}
+
+/**
+ * @brief 检查用户空间futex地址
+ * @param userVaddr 用户空间地址指针
+ * @return 按INT32对齐且位于用户空间时返回TRUE
+ */
+STATIC INLINE BOOL OsFutexUserVaddrIsValid(const UINT32 *userVaddr)
+{
+    VADDR_T vaddr = (VADDR_T)(UINTPTR)userVaddr; // 转换为虚拟地址
+
+    return !((vaddr % sizeof(INT32)) || (vaddr < OS_FUTEX_KEY_BASE) || (vaddr >= OS_FUTEX_KEY_MAX));
+}
+
+/**
+ * @brief 检查WAKE_OP/PI类Futex操作的参数有效性
+ * @param userVaddr 用户空间地址指针
+ * @param flags futex操作标志
+ * @param cmd 期望的操作类型
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+STATIC INT32 OsFutexOpParamCheck(const UINT32 *userVaddr, UINT32 flags, UINT32 cmd)
+{
+    if (OS_INT_ACTIVE) { // 中断上下文中不允许操作futex
+        return LOS_EINTR;
+    }
+
+    // 检查标志位是否有效
+    if ((flags & (~FUTEX_PRIVATE)) != cmd) {
+        PRINT_ERR("Futex op param check failed! error flags: 0x%x\n", flags);
+        return LOS_EINVAL;
+    }
+
+    // 检查地址是否按INT32对齐且在有效范围内
+    if (!OsFutexUserVaddrIsValid(userVaddr)) {
+        PRINT_ERR("Futex op param check failed! error userVaddr: 0x%x\n", userVaddr);
+        return LOS_EINVAL;
+    }
+
+    // 检查共享内存权限
+    if (OsFutexKeyShmPermCheck(userVaddr, flags) != LOS_OK) {
+        PRINT_ERR("Futex op param check failed! error shared memory perm userVaddr: 0x%x\n", userVaddr);
+        return LOS_EINVAL;
+    }
+
+    return LOS_OK;
+}
+
+/**
+ * @brief 以CAS方式把用户字设置为指定值
+ * @param userVaddr 用户空间地址指针
+ * @param val 新值
+ * @return 成功返回LOS_OK，地址错误返回LOS_EFAULT
+ */
+STATIC INT32 OsFutexUserWordSet(UINT32 *userVaddr, UINT32 val)
+{
+    UINT32 cur, expected;
+
+    if (LOS_ArchCopyFromUser(&cur, userVaddr, sizeof(UINT32))) {
+        return LOS_EFAULT;
+    }
+
+    do {
+        expected = cur;
+        if (LOS_UserCmpXchg(userVaddr, &cur, val)) {
+            return LOS_EFAULT;
+        }
+    } while (cur != expected); // 期间用户态修改过该字则重试
+
+    return LOS_OK;
+}
+
+/**
+ * @brief 按FUTEX_WAKE_OP编码对用户字执行原子读-改-写
+ * @param userVaddr 用户空间地址指针
+ * @param encodedOp val3中的操作编码
+ * @param oldVal 输出修改前的值
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+STATIC INT32 OsFutexWakeOpModify(UINT32 *userVaddr, UINT32 encodedOp, UINT32 *oldVal)
+{
+    UINT32 op = (encodedOp >> 28) & 0xFU;
+    INT32 oparg = ((INT32)(encodedOp << 8)) >> 20; // 12位有符号操作数
+    UINT32 cur, expected, newVal;
+
+    if (op & FUTEX_OP_OPARG_SHIFT) {
+        if ((oparg < 0) || (oparg > 31)) {
+            return LOS_EINVAL;
+        }
+        oparg = (INT32)(1U << (UINT32)oparg);
+        op &= ~FUTEX_OP_OPARG_SHIFT;
+    }
+
+    if (LOS_ArchCopyFromUser(&cur, userVaddr, sizeof(UINT32))) {
+        return LOS_EFAULT;
+    }
+
+    do {
+        switch (op) {
+            case FUTEX_OP_SET:
+                newVal = (UINT32)oparg;
+                break;
+            case FUTEX_OP_ADD:
+                newVal = cur + (UINT32)oparg;
+                break;
+            case FUTEX_OP_OR:
+                newVal = cur | (UINT32)oparg;
+                break;
+            case FUTEX_OP_ANDN:
+                newVal = cur & ~(UINT32)oparg;
+                break;
+            case FUTEX_OP_XOR:
+                newVal = cur ^ (UINT32)oparg;
+                break;
+            default:
+                return LOS_EINVAL;
+        }
+
+        expected = cur;
+        if (LOS_UserCmpXchg(userVaddr, &cur, newVal)) {
+            return LOS_EFAULT;
+        }
+    } while (cur != expected);
+
+    *oldVal = cur;
+    return LOS_OK;
+}
+
+/**
+ * @brief 按FUTEX_WAKE_OP编码比较修改前的值
+ * @param encodedOp val3中的操作编码
+ * @param oldVal 修改前的值
+ * @return 条件成立返回TRUE
+ */
+STATIC BOOL OsFutexWakeOpCompare(UINT32 encodedOp, UINT32 oldVal)
+{
+    UINT32 cmp = (encodedOp >> 24) & 0xFU;
+    INT32 cmparg = ((INT32)(encodedOp << 20)) >> 20; // 12位有符号比较数
+    INT32 val = (INT32)oldVal;
+
+    switch (cmp) {
+        case FUTEX_OP_CMP_EQ:
+            return (val == cmparg);
+        case FUTEX_OP_CMP_NE:
+            return (val != cmparg);
+        case FUTEX_OP_CMP_LT:
+            return (val < cmparg);
+        case FUTEX_OP_CMP_LE:
+            return (val <= cmparg);
+        case FUTEX_OP_CMP_GT:
+            return (val > cmparg);
+        case FUTEX_OP_CMP_GE:
+            return (val >= cmparg);
+        default:
+            return FALSE;
+    }
+}
+
+/**
+ * @brief Futex唤醒并操作系统调用实现
+ * @details 同时持有两个地址的哈希表锁（按索引顺序加锁避免死锁），原子修改userVaddr2后
+ *          唤醒userVaddr上的wakeNumber个任务，比较条件成立时再唤醒userVaddr2上的wakeNumber2个任务，
+ *          条件变量的“解锁+通知”因此只需一次系统调用
+ * @param userVaddr 第一个用户空间地址指针
+ * @param flags futex操作标志
+ * @param wakeNumber userVaddr上要唤醒的任务数量
+ * @param wakeNumber2 userVaddr2上要唤醒的任务数量
+ * @param userVaddr2 第二个用户空间地址指针
+ * @param encodedOp 操作与比较编码（val3）
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+INT32 OsFutexWakeOp(const UINT32 *userVaddr, UINT32 flags, INT32 wakeNumber,
+                    INT32 wakeNumber2, const UINT32 *userVaddr2, UINT32 encodedOp)
+{
+    INT32 ret;
+    UINT32 oldVal = 0;
+    UINTPTR futexKey, futexKey2;
+    UINT32 index, index2;
+    FutexHash *firstHash = NULL;
+    FutexHash *secondHash = NULL;
+    FutexNode *headNode = NULL;
+    BOOL wakeAny = FALSE;
+
+    ret = OsFutexOpParamCheck(userVaddr, flags, FUTEX_WAKE_OP);
+    if (ret) {
+        return ret;
+    }
+
+    if (!OsFutexUserVaddrIsValid(userVaddr2) || (OsFutexKeyShmPermCheck(userVaddr2, flags) != LOS_OK)) {
+        PRINT_ERR("Futex wake op param check failed! error userVaddr2: 0x%x\n", userVaddr2);
+        return LOS_EINVAL;
+    }
+
+    if ((((encodedOp >> 24) & 0xFU) > FUTEX_OP_CMP_GE) ||
+        ((((encodedOp >> 28) & 0xFU) & ~FUTEX_OP_OPARG_SHIFT) > FUTEX_OP_XOR)) {
+        return LOS_EINVAL;
+    }
+
+    futexKey = OsFutexFlagsToKey(userVaddr, flags);
+    futexKey2 = OsFutexFlagsToKey(userVaddr2, flags);
+    index = OsFutexKeyToIndex(futexKey, flags);
+    index2 = OsFutexKeyToIndex(futexKey2, flags);
+    firstHash = &g_futexHash[(index < index2) ? index : index2];
+    secondHash = &g_futexHash[(index < index2) ? index2 : index];
+
+    if (OsFutexLock(&firstHash->listLock)) {
+        return LOS_EINVAL;
+    }
+
+    if ((secondHash != firstHash) && OsFutexLock(&secondHash->listLock)) {
+        (VOID)OsFutexUnlock(&firstHash->listLock);
+        return LOS_EINVAL;
+    }
+
+    ret = OsFutexWakeOpModify((UINT32 *)userVaddr2, encodedOp, &oldVal);
+    if (ret == LOS_OK) {
+        if (wakeNumber > 0) { // 没有等待者时返回LOS_EBADF，WAKE_OP不把它当作错误
+            (VOID)OsFutexWakeTask(futexKey, flags, wakeNumber, &headNode, &wakeAny);
+        }
+
+        if ((wakeNumber2 > 0) && OsFutexWakeOpCompare(encodedOp, oldVal)) {
+            headNode = NULL;
+            (VOID)OsFutexWakeTask(futexKey2, flags, wakeNumber2, &headNode, &wakeAny);
+        }
+    }
+
+#ifdef LOS_FUTEX_DEBUG
+    OsFutexHashShow(); // 调试模式下显示哈希表状态
+#endif
+
+    if (secondHash != firstHash) {
+        (VOID)OsFutexUnlock(&secondHash->listLock);
+    }
+    (VOID)OsFutexUnlock(&firstHash->listLock);
+
+    if (wakeAny == TRUE) { // 如果有任务被唤醒
+        LOS_Schedule(); // 触发调度
+    }
+
+    return ret;
+}
+
+/**
+ * @brief 查找PI futex状态
+ * @param hashNode 哈希表节点
+ * @param futexKey futex键值
+ * @param pid 私有futex所属进程ID，共享futex为OS_INVALID
+ * @return 找到返回状态指针，否则返回NULL
+ */
+STATIC FutexPiState *OsFutexPiStateFind(FutexHash *hashNode, UINTPTR futexKey, UINT32 pid)
+{
+    FutexPiState *state = NULL;
+
+    LOS_DL_LIST_FOR_EACH_ENTRY(state, &hashNode->piList, FutexPiState, piList) {
+        if ((state->key == futexKey) && (state->pid == pid)) {
+            return state;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 判断持有者的地址空间中是否有区域与当前进程的共享区域映射同一对象
+ * @param region 持有者地址空间中的区域
+ * @param curRegion 当前进程中futex所在的区域
+ * @param filePgOff futex所在页在文件中的页偏移
+ * @return 映射同一共享内存段或同一文件的同一页返回TRUE
+ */
+STATIC BOOL OsFutexPiRegionAlias(const LosVmMapRegion *region, const LosVmMapRegion *curRegion, VM_OFFSET_T filePgOff)
+{
+    if ((curRegion->regionFlags & VM_MAP_REGION_FLAG_SHM) && (region->regionFlags & VM_MAP_REGION_FLAG_SHM)) {
+        return (region->shmid == curRegion->shmid);
+    }
+
+    if ((curRegion->regionType == VM_MAP_REGION_TYPE_FILE) && (region->regionType == VM_MAP_REGION_TYPE_FILE) &&
+        (region->regionFlags & VM_MAP_REGION_FLAG_SHARED) &&
+        (region->unTypeData.rf.vnode == curRegion->unTypeData.rf.vnode)) {
+        return (filePgOff >= region->pgOff) && (filePgOff < (region->pgOff + (region->range.size >> PAGE_SHIFT)));
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief 检查共享PI futex用户字中的持有者能否访问同一futex键
+ * @details 持有者线程ID由用户态写入，不可信。持有者进程在同一虚拟地址映射了同一物理页（fork继承的共享映射），
+ *          或映射了同一共享内存段、同一文件覆盖该页的共享映射时才认为其可以持有该锁。
+ *          持有g_vmSpaceListMux期间持有者进程的地址空间不会被LOS_VmSpaceFree释放
+ * @param userVaddr 用户空间地址指针
+ * @param futexKey futex键值，共享futex为用户字的物理地址
+ * @param owner 用户字中的持有者
+ * @return 可以访问返回LOS_OK，持有者不存在或不是用户态任务返回LOS_ESRCH，不能访问返回LOS_EPERM
+ */
+STATIC INT32 OsFutexPiOwnerKeyCheck(const UINT32 *userVaddr, UINTPTR futexKey, const LosTaskCB *owner)
+{
+    UINT32 intSave;
+    PADDR_T paddr = 0;
+    INT32 ret = LOS_EPERM;
+    VADDR_T vaddr = (VADDR_T)(UINTPTR)userVaddr;
+    LosVmSpace *curSpace = OsCurrProcessGet()->vmSpace;
+    LosVmSpace *space = NULL;
+    LosVmMapRegion curRegion;
+    LosVmMapRegion *region = NULL;
+    LosRbNode *pstRbNode = NULL;
+    LosRbNode *pstRbNodeNext = NULL;
+    VM_OFFSET_T filePgOff;
+    LosMux *spaceListMux = OsGVmSpaceMuxGet();
+
+    (VOID)LOS_MuxAcquire(&curSpace->regionMux);
+    region = OsFindRegion(&curSpace->regionRbTree, vaddr, 1);
+    if (region == NULL) {
+        (VOID)LOS_MuxRelease(&curSpace->regionMux);
+        return LOS_EFAULT;
+    }
+    curRegion = *region;  // 只比较区域属性，拷贝后即可释放锁
+    (VOID)LOS_MuxRelease(&curSpace->regionMux);
+    filePgOff = curRegion.pgOff + ((vaddr - curRegion.range.base) >> PAGE_SHIFT);
+
+    (VOID)LOS_MuxAcquire(spaceListMux);
+    SCHEDULER_LOCK(intSave);
+    if (OsTaskIsUnused(owner) || (owner->taskStatus & OS_TASK_STATUS_EXIT) || !OsTaskIsUserMode(owner)) {
+        SCHEDULER_UNLOCK(intSave);
+        (VOID)LOS_MuxRelease(spaceListMux);
+        return LOS_ESRCH;
+    }
+    space = ((LosProcessCB *)owner->processCB)->vmSpace;
+    SCHEDULER_UNLOCK(intSave);
+
+    if (space != NULL) {
+        (VOID)LOS_MuxAcquire(&space->regionMux);
+        if ((LOS_ArchMmuQuery(&space->archMmu, vaddr, &paddr, NULL) == LOS_OK) && (paddr == futexKey)) {
+            ret = LOS_OK;
+        } else {
+            RB_SCAN_SAFE(&space->regionRbTree, pstRbNode, pstRbNodeNext)
+                if (OsFutexPiRegionAlias((LosVmMapRegion *)pstRbNode, &curRegion, filePgOff)) {
+                    ret = LOS_OK;
+                    break;
+                }
+            RB_SCAN_SAFE_END(&space->regionRbTree, pstRbNode, pstRbNodeNext)
+        }
+        (VOID)LOS_MuxRelease(&space->regionMux);
+    }
+    (VOID)LOS_MuxRelease(spaceListMux);
+    return ret;
+}
+
+/**
+ * @brief 为PI futex创建内核状态
+ * @details 以用户字中的持有者作为互斥锁持有者，把互斥锁挂到持有者的lockList上，
+ *          之后的等待者经由OsMuxPendOp阻塞并对持有者进行优先级继承；持有者退出时
+ *          OsTaskReleaseHoldLock会把锁交给最高优先级的等待者。
+ *          持有者须是用户态任务：私有futex须属于当前进程，共享futex须能访问同一futex键
+ * @param hashNode 哈希表节点
+ * @param userVaddr 用户空间地址指针
+ * @param futexKey futex键值
+ * @param flags futex操作标志
+ * @param ownerTid 用户字中的持有者线程ID
+ * @param state 输出新建的状态
+ * @return 成功返回LOS_OK，持有者不存在返回LOS_ESRCH，持有者不能访问该锁返回LOS_EPERM，
+ *         内存不足返回LOS_ENOMEM
+ */
+STATIC INT32 OsFutexPiStateCreate(FutexHash *hashNode, const UINT32 *userVaddr, UINTPTR futexKey, UINT32 flags,
+                                  UINT32 ownerTid, FutexPiState **state)
+{
+    INT32 ret;
+    UINT32 intSave;
+    UINT32 ownerPid = OS_INVALID;
+    LosMuxAttr attr;
+    LosTaskCB *owner = NULL;
+    LosTaskCB *runTask = OsCurrTaskGet();
+    FutexPiState *newState = NULL;
+
+    if (OS_TID_CHECK_INVALID(ownerTid)) {
+        return LOS_ESRCH;
+    }
+    owner = OS_TCB_FROM_RTID(ownerTid);
+
+    if (!(flags & FUTEX_PRIVATE) && (owner->processCB != runTask->processCB)) {
+        ret = OsFutexPiOwnerKeyCheck(userVaddr, futexKey, owner);
+        if (ret != LOS_OK) {
+            return ret;
+        }
+        ownerPid = ((LosProcessCB *)owner->processCB)->processID;
+    }
+
+    newState = (FutexPiState *)LOS_MemAlloc(m_aucSysMem1, sizeof(FutexPiState));
+    if (newState == NULL) {
+        return LOS_ENOMEM;
+    }
+
+    (VOID)LOS_MuxAttrInit(&attr);
+    (VOID)LOS_MuxAttrSetProtocol(&attr, LOS_MUX_PRIO_INHERIT);
+    (VOID)LOS_MuxAttrSetType(&attr, LOS_MUX_ERRORCHECK);
+    (VOID)LOS_MuxInit(&newState->mux, &attr);
+    newState->key = futexKey;
+    newState->pid = (flags & FUTEX_PRIVATE) ? LOS_GetCurrProcessID() : OS_INVALID;
+    newState->refCount = 0;
+
+    SCHEDULER_LOCK(intSave);
+    if (OsTaskIsUnused(owner) || (owner->taskStatus & OS_TASK_STATUS_EXIT) || !OsTaskIsUserMode(owner) ||
+        ((flags & FUTEX_PRIVATE) && (owner->processCB != runTask->processCB)) ||
+        ((ownerPid != OS_INVALID) && (((LosProcessCB *)owner->processCB)->processID != ownerPid))) {
+        SCHEDULER_UNLOCK(intSave);
+        (VOID)LOS_MemFree(m_aucSysMem1, newState);
+        return LOS_ESRCH;
+    }
+
+    newState->mux.muxCount = 1;
+    newState->mux.owner = (VOID *)owner;
+    LOS_ListTailInsert(&owner->lockList, &newState->mux.holdList);
+    SCHEDULER_UNLOCK(intSave);
+
+    LOS_ListTailInsert(&hashNode->piList, &newState->piList);
+    *state = newState;
+    return LOS_OK;
+}
+
+/**
+ * @brief 释放对PI futex状态的引用
+ * @details 最后一个引用者销毁状态，并把用户字还原为不带FUTEX_WAITERS的持有者线程ID，
+ *          此后无竞争的加解锁重新回到用户态完成
+ * @param state PI futex状态
+ * @param userVaddr 用户空间地址指针
+ */
+STATIC VOID OsFutexPiStatePut(FutexPiState *state, UINT32 *userVaddr)
+{
+    UINT32 intSave;
+    LosTaskCB *owner = NULL;
+
+    if (--state->refCount != 0) {
+        return;
+    }
+
+    SCHEDULER_LOCK(intSave);
+    owner = (LosTaskCB *)state->mux.owner;
+    if (owner != NULL) {
+        LOS_ListDelete(&state->mux.holdList);
+    }
+    SCHEDULER_UNLOCK(intSave);
+
+    (VOID)OsFutexUserWordSet(userVaddr, (owner != NULL) ? owner->taskID : 0);
+    LOS_ListDelete(&state->piList);
+    (VOID)LOS_MemFree(m_aucSysMem1, state);
+}
+
+/**
+ * @brief 在没有内核状态时通过用户字加锁
+ * @details 用户字无持有者时写入当前线程ID完成加锁；已被持有时按需置FUTEX_WAITERS位，
+ *          使持有者的用户态快速解锁失败并进入内核
+ * @param userVaddr 用户空间地址指针
+ * @param runTask 当前任务
+ * @param setWaiters 是否需要置FUTEX_WAITERS位
+ * @param ownerTid 输出持有者线程ID
+ * @return 加锁成功返回LOS_OK，已被持有返回LOS_EBUSY，失败返回相应错误码
+ */
+STATIC INT32 OsFutexPiWordAcquire(UINT32 *userVaddr, const LosTaskCB *runTask, BOOL setWaiters, UINT32 *ownerTid)
+{
+    UINT32 cur, expected, newVal, tid;
+
+    if (LOS_ArchCopyFromUser(&cur, userVaddr, sizeof(UINT32))) {
+        return LOS_EFAULT;
+    }
+
+    do {
+        tid = cur & FUTEX_TID_MASK;
+        if (tid == runTask->taskID) {
+            return LOS_EDEADLK;
+        }
+
+        if (tid == 0) {
+            newVal = runTask->taskID;
+        } else {
+            *ownerTid = tid;
+            if (!setWaiters || (cur & FUTEX_WAITERS)) {
+                return LOS_EBUSY;
+            }
+            newVal = cur | FUTEX_WAITERS;
+        }
+
+        expected = cur;
+        if (LOS_UserCmpXchg(userVaddr, &cur, newVal)) {
+            return LOS_EFAULT;
+        }
+    } while (cur != expected);
+
+    return (tid == 0) ? LOS_OK : LOS_EBUSY;
+}
+
+/**
+ * @brief 在没有内核状态时通过用户字解锁
+ * @param userVaddr 用户空间地址指针
+ * @param runTask 当前任务
+ * @return 成功返回LOS_OK，非持有者返回LOS_EPERM，地址错误返回LOS_EFAULT
+ */
+STATIC INT32 OsFutexPiWordRelease(UINT32 *userVaddr, const LosTaskCB *runTask)
+{
+    UINT32 cur, expected;
+
+    if (LOS_ArchCopyFromUser(&cur, userVaddr, sizeof(UINT32))) {
+        return LOS_EFAULT;
+    }
+
+    do {
+        if ((cur & FUTEX_TID_MASK) != runTask->taskID) {
+            return LOS_EPERM;
+        }
+
+        expected = cur;
+        if (LOS_UserCmpXchg(userVaddr, &cur, 0)) {
+            return LOS_EFAULT;
+        }
+    } while (cur != expected);
+
+    return LOS_OK;
+}
+
+/**
+ * @brief 执行PI futex加锁
+ * @details 无内核状态时先尝试用户字；有竞争时取得（或创建）内核状态，释放哈希表锁后在其互斥锁上
+ *          阻塞。释放哈希表锁到入队之间持有者若解锁，互斥锁会空出而由本任务直接获得，因此不会丢失唤醒
+ * @param userVaddr 用户空间地址指针
+ * @param flags futex操作标志
+ * @param timeout 超时时间（滴答数）
+ * @param isTry 是否为非阻塞尝试
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+STATIC INT32 OsFutexLockPiTask(UINT32 *userVaddr, UINT32 flags, UINT32 timeout, BOOL isTry)
+{
+    INT32 futexRet;
+    UINT32 ret, intSave;
+    UINT32 ownerTid = 0;
+    LosTaskCB *runTask = OsCurrTaskGet();
+    UINTPTR futexKey = OsFutexFlagsToKey(userVaddr, flags);
+    UINT32 pid = (flags & FUTEX_PRIVATE) ? LOS_GetCurrProcessID() : OS_INVALID;
+    FutexHash *hashNode = &g_futexHash[OsFutexKeyToIndex(futexKey, flags)];
+    FutexPiState *state = NULL;
+
+    if (OsFutexLock(&hashNode->listLock)) {
+        return LOS_EINVAL;
+    }
+
+    state = OsFutexPiStateFind(hashNode, futexKey, pid);
+    if (state == NULL) {
+        futexRet = OsFutexPiWordAcquire(userVaddr, runTask, !isTry, &ownerTid);
+        if (futexRet == LOS_EBUSY) {
+            futexRet = isTry ? LOS_EAGAIN : OsFutexPiStateCreate(hashNode, userVaddr, futexKey, flags, ownerTid, &state);
+        }
+
+        if (state == NULL) {
+            (VOID)OsFutexUnlock(&hashNode->listLock);
+            return futexRet;
+        }
+    }
+    state->refCount++;
+    (VOID)OsFutexUnlock(&hashNode->listLock);
+
+    SCHEDULER_LOCK(intSave);
+    ret = isTry ? OsMuxTrylockUnsafe(&state->mux, 0) : OsMuxLockUnsafe(&state->mux, timeout);
+    SCHEDULER_UNLOCK(intSave);
+
+    if (OsFutexLock(&hashNode->listLock)) {
+        return LOS_EINVAL;
+    }
+
+    if (ret == LOS_OK) { // 内核把锁交给了本任务，用户字同步为本任务的线程ID
+        futexRet = OsFutexUserWordSet(userVaddr, runTask->taskID | FUTEX_WAITERS);
+    } else if (ret == LOS_EBUSY) {
+        futexRet = LOS_EAGAIN;
+    } else if ((ret == LOS_ETIMEDOUT) || (ret == LOS_EDEADLK)) {
+        futexRet = (INT32)ret;
+    } else {
+        futexRet = LOS_EINVAL;
+    }
+
+    OsFutexPiStatePut(state, userVaddr);
+    (VOID)OsFutexUnlock(&hashNode->listLock);
+    return futexRet;
+}
+
+/**
+ * @brief Futex PI加锁系统调用实现
+ * @details 持有者以等待者中的最高优先级运行，直到解锁
+ * @param userVaddr 用户空间地址指针
+ * @param flags futex操作标志
+ * @param absTime 超时时间（微秒），LOS_WAIT_FOREVER表示永久等待
+ * @return 成功返回LOS_OK，失败返回相应错误码
+ */
+INT32 OsFutexLockPi(const UINT32 *userVaddr, UINT32 flags, UINT32 absTime)
+{
+    INT32 ret;
+    UINT32 timeout = LOS_WAIT_FOREVER; // 超时时间（默认永久等待）
+
+    ret = OsFutexOpParamCheck(userVaddr, flags, FUTEX_LOCK_PI);
+    if (ret) {
+        return ret;
+    }
+
+    if (!absTime) { // 零超时退化为尝试加锁
+        ret = OsFutexLockPiTask((UINT32 *)userVaddr, flags, 0, TRUE);
+        return (ret == LOS_EAGAIN) ? LOS_ETIMEDOUT : ret;
+    }
+
+    // 转换超时时间为滴答数
+    if (absTime != LOS_WAIT_FOREVER) {
+        timeout = OsNS2Tick((UINT64)absTime * OS_SYS_NS_PER_US);
+    }
+
+    return OsFutexLockPiTask((UINT32 *)userVaddr, flags, timeout, FALSE);
+}
+
+/**
+ * @brief Futex PI尝试加锁系统调用实现
+ * @param userVaddr 用户空间地址指针
+ * @param flags futex操作标志
+ * @return 成功返回LOS_OK，已被持有返回LOS_EAGAIN，失败返回相应错误码
+ */
+INT32 OsFutexTrylockPi(const UINT32 *userVaddr, UINT32 flags)
+{
+    INT32 ret = OsFutexOpParamCheck(userVaddr, flags, FUTEX_TRYLOCK_PI);
+    if (ret) {
+        return ret;
+    }
+
+    return OsFutexLockPiTask((UINT32 *)userVaddr, flags, 0, TRUE);
+}
+
+/**
+ * @brief Futex PI解锁系统调用实现
+ * @details 有内核状态时经由OsMuxUnlockUnsafe恢复持有者优先级并把锁交给最高优先级的等待者，
+ *          用户字同步为新持有者的线程ID；状态仍被引用，因此保留FUTEX_WAITERS位
+ * @param userVaddr 用户空间地址指针
+ * @param flags futex操作标志
+ * @return 成功返回LOS_OK，非持有者返回LOS_EPERM，失败返回相应错误码
+ */
+INT32 OsFutexUnlockPi(const UINT32 *userVaddr, UINT32 flags)
+{
+    INT32 futexRet;
+    UINT32 ret, intSave;
+    BOOL needSched = FALSE;
+    LosTaskCB *runTask = OsCurrTaskGet();
+    LosTaskCB *newOwner = NULL;
+    UINTPTR futexKey;
+    UINT32 pid;
+    FutexHash *hashNode = NULL;
+    FutexPiState *state = NULL;
+
+    futexRet = OsFutexOpParamCheck(userVaddr, flags, FUTEX_UNLOCK_PI);
+    if (futexRet) {
+        return futexRet;
+    }
+
+    futexKey = OsFutexFlagsToKey(userVaddr, flags);
+    pid = (flags & FUTEX_PRIVATE) ? LOS_GetCurrProcessID() : OS_INVALID;
+    hashNode = &g_futexHash[OsFutexKeyToIndex(futexKey, flags)];
+    if (OsFutexLock(&hashNode->listLock)) {
+        return LOS_EINVAL;
+    }
+
+    state = OsFutexPiStateFind(hashNode, futexKey, pid);
+    if (state == NULL) {
+        futexRet = OsFutexPiWordRelease((UINT32 *)userVaddr, runTask);
+    } else {
+        SCHEDULER_LOCK(intSave);
+        ret = OsMuxUnlockUnsafe(runTask, &state->mux, &needSched);
+        newOwner = (LosTaskCB *)state->mux.owner;
+        SCHEDULER_UNLOCK(intSave);
+        if (ret != LOS_OK) {
+            futexRet = LOS_EPERM;
+        } else {
+            futexRet = OsFutexUserWordSet((UINT32 *)userVaddr,
+                                          ((newOwner != NULL) ? newOwner->taskID : 0) | FUTEX_WAITERS);
+        }
+    }
+
+    (VOID)OsFutexUnlock(&hashNode->listLock);
+
+    if (needSched == TRUE) { // 锁已交给被唤醒的等待者
+        LOS_Schedule();
+    }
+
+    return futexRet;
+}
 #endif
\ No newline at end of file
@@ -747,7 +747,6 @@ LITE_OS_SEC_TEXT UINT32 LOS_MuxUnlock(LosMux *mutex)
     ret = OsMuxUnlockUnsafe(runTask, mutex, &needSched);  // 调用不安全解锁函数完成核心逻辑
     SCHEDULER_UNLOCK(intSave);  // 恢复调度器，恢复中断状态
     if (needSched == TRUE) {  // 检查是否需要调度
-        LOS_MpSchedule(OS_MP_CPU_ALL);  // 触发多处理器调度
         LOS_Schedule();  // 执行任务调度
     }
     return ret;  // 返回操作结果
@@ -428,7 +428,6 @@ UINT32 OsQueueOperate(UINT32 queueID, UINT32 operateType, VOID *bufferAddr, UINT
         OsTaskWakeClearPendMask(resumedTask);  // 清除任务等待掩码
         resumedTask->ops->wake(resumedTask);  // 唤醒任务
         SCHEDULER_UNLOCK(intSave);  // 开调度器
-        LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度
         LOS_Schedule();  // 任务调度
         return LOS_OK;  // 返回成功
     } else {  // 没有等待的对立操作任务
@@ -583,7 +583,6 @@ UINT32 LOS_RwlockUnLock(LosRwlock *rwlock)
     SCHEDULER_LOCK(intSave);  // 关调度器
     ret = OsRwlockUnlockUnsafe(rwlock, &needSched);  // 不安全的释放锁
     SCHEDULER_UNLOCK(intSave);  // 开调度器
-    LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度
     if (needSched == TRUE) {  // 需要调度
         LOS_Schedule();  // 任务调度
     }
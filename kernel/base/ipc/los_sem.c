@@ -346,7 +346,6 @@ LITE_OS_SEC_TEXT UINT32 LOS_SemPost(UINT32 semHandle)  // 信号量释放函数
     ret = OsSemPostUnsafe(semHandle, &needSched);  // 调用不安全的信号量释放函数
         SCHEDULER_UNLOCK(intSave);  // 调度器解锁
     if (needSched) {  // 如果需要调度
-        LOS_MpSchedule(OS_MP_CPU_ALL);  // 多CPU调度
         LOS_Schedule();  // 触发调度
     }
 
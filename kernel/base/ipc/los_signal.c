@@ -981,6 +981,9 @@ VOID *OsSaveSignalContext(VOID *sp, VOID *newSp)
         OsMoveTmpInfoToUnbInfo(sigcb, signo);  // 移动信号信息
         OsProcessExitCodeSignalSet(process, signo);  // 设置进程退出码信号
         sigcb->sigContext = sp;  // 保存当前上下文
+#ifdef ARCH_FPU_LAZY
+        OsFpuSignalSave(task->taskID);  // 栈帧中没有浮点寄存器，单独保存
+#endif
 
         OsInitSignalContext(sp, newSp, sigHandler, signo, sigVal);  // 初始化信号上下文
 
@@ -1018,6 +1021,9 @@ VOID *OsRestorSignalContext(VOID *sp)
     LosProcessCB *process = OsCurrProcessGet();  // 获取当前进程
     VOID *saveContext = sigcb->sigContext;  // 获取保存的上下文
     sigcb->sigContext = NULL;  // 清空上下文
+#ifdef ARCH_FPU_LAZY
+    OsFpuSignalRestore(task->taskID);  // 恢复被打断代码的浮点状态
+#endif
     sigcb->count--;  // 减少信号嵌套计数
     process->sigShare = 0;  // 清除共享信号
     OsProcessExitCodeSignalClear(process);  // 清除进程退出码信号
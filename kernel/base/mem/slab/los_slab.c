@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file los_slab.c
+ * @brief 定长对象缓存（slab）
+ * @details
+ * 每个缓存管理若干个slab，slab是从伙伴系统申请的2的幂个连续物理页，按自身大小对齐，
+ * slab头部之后切分为定长对象。每个CPU持有一个容量为OS_SLAB_MAGAZINE_SIZE的空闲对象栈（magazine），
+ * 分配释放只关本核中断操作该栈；栈空时从slab批量取一半，栈满时批量还一半，
+ * 只有批量搬运时才持有缓存锁。新建slab与构造对象在开中断时进行。
+ */
+
+#include "los_slab.h"
+#include "los_memory.h"
+#include "los_spinlock.h"
+#include "los_hw_cpu.h"
+#include "los_vm_common.h"
+#include "los_vm_phys.h"
+
+#define OS_SLAB_MAGAZINE_SIZE   16                          /* 每个CPU的空闲对象栈容量 */
+#define OS_SLAB_BATCH           (OS_SLAB_MAGAZINE_SIZE / 2) /* 栈与slab之间一次搬运的对象数 */
+#define OS_SLAB_ALIGN           8                           /* 对象对齐，满足UINT64成员 */
+#define OS_SLAB_MIN_SIZE        PAGE_SIZE                   /* slab最小一页 */
+#define OS_SLAB_MIN_OBJS        8                           /* 一个slab至少容纳的对象数 */
+#define OS_SLAB_OBJ_MAX         2048                        /* 对象大小上限 */
+#define OS_SLAB_EMPTY_KEEP      1                           /* 保留的空slab个数，避免边界抖动 */
+
+typedef struct {
+    LOS_DL_LIST node;   /* 挂在缓存的partialList或fullList上 */
+    VOID *freeList;     /* 空闲对象单链表 */
+    UINT32 inUse;       /* 已取出的对象数，包括留在magazine中的 */
+} OsSlabHead;
+
+#define OS_SLAB_HEAD_SIZE       ALIGN(sizeof(OsSlabHead), OS_SLAB_ALIGN)
+/* 空闲链接放在对象尾部，不破坏构造后的对象内容 */
+#define OS_SLAB_LINK(cache, obj) (*(VOID **)((UINTPTR)(obj) + (cache)->linkOffset))
+#define OS_SLAB_OF(cache, obj)  ((OsSlabHead *)((UINTPTR)(obj) & ~((UINTPTR)(cache)->slabSize - 1)))
+
+typedef struct {
+    UINT32 count;                       /* 栈中对象数 */
+    UINT32 allocCount;                  /* 本核分配次数 */
+    UINT32 freeCount;                   /* 本核释放次数 */
+    UINT32 hitCount;                    /* 本核直接命中栈的分配次数 */
+    VOID *objs[OS_SLAB_MAGAZINE_SIZE];
+} OsSlabMagazine;
+
+struct LosSlabCache {
+    LOS_DL_LIST node;                   /* 挂在g_slabCacheList上 */
+    CHAR name[LOS_SLAB_NAME_LEN];
+    UINT32 objSize;                     /* 使用者请求的对象大小 */
+    UINT32 linkOffset;                  /* 空闲链接在对象中的偏移 */
+    UINT32 stride;                      /* 相邻对象间距 */
+    UINT32 slabSize;                    /* slab大小，2的幂个页，slab按此对齐 */
+    UINT32 objPerSlab;                  /* 每个slab的对象数 */
+    LosSlabCtor ctor;
+    SPIN_LOCK_S lock;                   /* 保护以下slab链表与计数 */
+    LOS_DL_LIST partialList;            /* 有空闲对象的slab，空slab在尾部 */
+    LOS_DL_LIST fullList;               /* 对象全部取出的slab */
+    UINT32 slabNum;
+    UINT32 emptyNum;                    /* 空slab个数 */
+    UINT32 freeObjs;                    /* slab内空闲对象数 */
+    OsSlabMagazine magazine[LOSCFG_KERNEL_CORE_NUM];
+};
+
+STATIC LOS_DL_LIST_HEAD(g_slabCacheList);         /* 全部对象缓存 */
+LITE_OS_SEC_BSS STATIC SPIN_LOCK_INIT(g_slabListSpin); /* 保护g_slabCacheList */
+
+STATIC INLINE VOID OsSlabPagesFree(const LosSlabCache *cache, OsSlabHead *slab)
+{
+    LOS_PhysPagesFreeContiguous(slab, cache->slabSize >> PAGE_SHIFT);
+}
+
+/**
+ * @brief 新建一个slab，切分、构造全部对象后挂入缓存
+ * @details 在调用者的中断状态下运行，LOS_SlabAlloc开中断后才调用，构造函数不在关中断区内执行。
+ *          伙伴系统分配的2^n页块物理地址按自身大小对齐，内核线性映射保持该对齐，OS_SLAB_OF依赖于此
+ * @return LOS_OK表示成功，LOS_NOK表示内存不足
+ */
+STATIC UINT32 OsSlabGrow(LosSlabCache *cache)
+{
+    OsSlabHead *slab = (OsSlabHead *)LOS_PhysPagesAllocContiguous(cache->slabSize >> PAGE_SHIFT);
+    UINTPTR obj;
+    UINT32 index;
+    UINT32 intSave;
+
+    if (slab == NULL) {
+        return LOS_NOK;
+    }
+
+    LOS_ListInit(&slab->node);
+    slab->freeList = NULL;
+    slab->inUse = 0;
+    obj = (UINTPTR)slab + OS_SLAB_HEAD_SIZE + (cache->objPerSlab - 1) * cache->stride;
+    for (index = 0; index < cache->objPerSlab; index++, obj -= cache->stride) { /* 逆序入链，分配时地址递增 */
+        if (cache->ctor != NULL) {
+            cache->ctor((VOID *)obj);
+        }
+        OS_SLAB_LINK(cache, obj) = slab->freeList;
+        slab->freeList = (VOID *)obj;
+    }
+
+    LOS_SpinLockSave(&cache->lock, &intSave);
+    LOS_ListAdd(&cache->partialList, &slab->node);
+    cache->slabNum++;
+    cache->emptyNum++;
+    cache->freeObjs += cache->objPerSlab;
+    LOS_SpinUnlockRestore(&cache->lock, intSave);
+    return LOS_OK;
+}
+
+/**
+ * @brief 从slab批量取对象填充本核magazine，调用者已关中断，不新建slab
+ * @return 填充后栈中的对象数，0表示没有空闲对象
+ */
+STATIC UINT32 OsSlabMagazineFill(LosSlabCache *cache, OsSlabMagazine *mag)
+{
+    OsSlabHead *slab = NULL;
+    VOID *obj = NULL;
+
+    LOS_SpinLock(&cache->lock);
+    while ((mag->count < OS_SLAB_BATCH) && !LOS_ListEmpty(&cache->partialList)) {
+        slab = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&cache->partialList), OsSlabHead, node);
+        if (slab->inUse == 0) {
+            cache->emptyNum--;
+        }
+        while ((mag->count < OS_SLAB_BATCH) && (slab->freeList != NULL)) {
+            obj = slab->freeList;
+            slab->freeList = OS_SLAB_LINK(cache, obj);
+            slab->inUse++;
+            cache->freeObjs--;
+            mag->objs[mag->count++] = obj;
+        }
+        if (slab->freeList == NULL) {
+            LOS_ListDelete(&slab->node);
+            LOS_ListAdd(&cache->fullList, &slab->node);
+        }
+    }
+    LOS_SpinUnlock(&cache->lock);
+    return mag->count;
+}
+
+/**
+ * @brief 将一个对象还给所属slab，调用者持有缓存锁
+ * @param releaseList [输出] 超出保留数的空slab，由调用者开中断后释放
+ */
+STATIC VOID OsSlabObjPut(LosSlabCache *cache, VOID *obj, LOS_DL_LIST *releaseList)
+{
+    OsSlabHead *slab = OS_SLAB_OF(cache, obj);
+
+    if (slab->freeList == NULL) { /* 原先是满slab */
+        LOS_ListDelete(&slab->node);
+        LOS_ListAdd(&cache->partialList, &slab->node);
+    }
+    OS_SLAB_LINK(cache, obj) = slab->freeList;
+    slab->freeList = obj;
+    slab->inUse--;
+    cache->freeObjs++;
+    if (slab->inUse != 0) {
+        return;
+    }
+
+    LOS_ListDelete(&slab->node);
+    if (cache->emptyNum < OS_SLAB_EMPTY_KEEP) {
+        LOS_ListTailInsert(&cache->partialList, &slab->node);
+        cache->emptyNum++;
+    } else {
+        LOS_ListAdd(releaseList, &slab->node);
+        cache->slabNum--;
+        cache->freeObjs -= cache->objPerSlab;
+    }
+}
+
+/**
+ * @brief 将本核magazine中的一半对象还给slab，调用者已关中断
+ * @param releaseList [输出] 超出保留数的空slab，由调用者开中断后释放
+ */
+STATIC VOID OsSlabMagazineFlush(LosSlabCache *cache, OsSlabMagazine *mag, LOS_DL_LIST *releaseList)
+{
+    LOS_SpinLock(&cache->lock);
+    while (mag->count > OS_SLAB_BATCH) {
+        OsSlabObjPut(cache, mag->objs[--mag->count], releaseList);
+    }
+    LOS_SpinUnlock(&cache->lock);
+}
+
+LITE_OS_SEC_TEXT_INIT LosSlabCache *LOS_SlabCacheCreate(const CHAR *name, UINT32 objSize, LosSlabCtor ctor)
+{
+    LosSlabCache *cache = NULL;
+    UINT32 intSave;
+
+    if ((name == NULL) || (objSize == 0) || (objSize > OS_SLAB_OBJ_MAX)) {
+        return NULL;
+    }
+
+    cache = (LosSlabCache *)LOS_MemAlloc(m_aucSysMem0, sizeof(LosSlabCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    (VOID)memset_s(cache, sizeof(LosSlabCache), 0, sizeof(LosSlabCache));
+    (VOID)strncpy_s(cache->name, LOS_SLAB_NAME_LEN, name, LOS_SLAB_NAME_LEN - 1);
+    cache->objSize = objSize;
+    cache->linkOffset = ALIGN(objSize, sizeof(VOID *));
+    cache->stride = ALIGN(cache->linkOffset + sizeof(VOID *), OS_SLAB_ALIGN);
+    cache->slabSize = OS_SLAB_MIN_SIZE;
+    while ((cache->slabSize - OS_SLAB_HEAD_SIZE) < (cache->stride * OS_SLAB_MIN_OBJS)) {
+        cache->slabSize <<= 1;
+    }
+    cache->objPerSlab = (cache->slabSize - OS_SLAB_HEAD_SIZE) / cache->stride;
+    cache->ctor = ctor;
+    LOS_SpinInit(&cache->lock);
+    LOS_ListInit(&cache->partialList);
+    LOS_ListInit(&cache->fullList);
+
+    LOS_SpinLockSave(&g_slabListSpin, &intSave);
+    LOS_ListTailInsert(&g_slabCacheList, &cache->node);
+    LOS_SpinUnlockRestore(&g_slabListSpin, intSave);
+    return cache;
+}
+
+LITE_OS_SEC_TEXT VOID *LOS_SlabAlloc(LosSlabCache *cache)
+{
+    OsSlabMagazine *mag = NULL;
+    VOID *obj = NULL;
+    UINT32 intSave;
+
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    for (;;) {
+        intSave = LOS_IntLock();
+        mag = &cache->magazine[ArchCurrCpuid()];
+        if (mag->count != 0) {
+            mag->hitCount++;
+            break;
+        }
+        if (OsSlabMagazineFill(cache, mag) != 0) {
+            break;
+        }
+        LOS_IntRestore(intSave);
+
+        /* 所有slab都已取空，开中断新建slab后重试，期间可能被其他核取走 */
+        if (OsSlabGrow(cache) != LOS_OK) {
+            return NULL;
+        }
+    }
+    obj = mag->objs[--mag->count];
+    mag->allocCount++;
+    LOS_IntRestore(intSave);
+    return obj;
+}
+
+LITE_OS_SEC_TEXT VOID LOS_SlabFree(LosSlabCache *cache, VOID *obj)
+{
+    OsSlabMagazine *mag = NULL;
+    OsSlabHead *slab = NULL;
+    OsSlabHead *next = NULL;
+    LOS_DL_LIST releaseList;
+    UINT32 intSave;
+
+    if ((cache == NULL) || (obj == NULL)) {
+        return;
+    }
+
+    LOS_ListInit(&releaseList);
+    intSave = LOS_IntLock();
+    mag = &cache->magazine[ArchCurrCpuid()];
+    if (mag->count == OS_SLAB_MAGAZINE_SIZE) {
+        OsSlabMagazineFlush(cache, mag, &releaseList);
+    }
+    mag->objs[mag->count++] = obj;
+    mag->freeCount++;
+    LOS_IntRestore(intSave);
+
+    LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(slab, next, &releaseList, OsSlabHead, node) {
+        OsSlabPagesFree(cache, slab);
+    }
+}
+
+LITE_OS_SEC_TEXT_MINOR UINT32 LOS_SlabCacheDestroy(LosSlabCache *cache)
+{
+    OsSlabMagazine *mag = NULL;
+    OsSlabHead *slab = NULL;
+    OsSlabHead *next = NULL;
+    LOS_DL_LIST releaseList;
+    UINT32 intSave;
+    UINT32 cpu;
+
+    if (cache == NULL) {
+        return LOS_NOK;
+    }
+
+    LOS_ListInit(&releaseList);
+    /* 使用者保证销毁期间没有并发的分配释放，各核magazine可直接倒空 */
+    LOS_SpinLockSave(&cache->lock, &intSave);
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        mag = &cache->magazine[cpu];
+        while (mag->count != 0) {
+            OsSlabObjPut(cache, mag->objs[--mag->count], &releaseList);
+        }
+    }
+    if (!LOS_ListEmpty(&cache->fullList) || (cache->freeObjs != (cache->slabNum * cache->objPerSlab))) {
+        LOS_SpinUnlockRestore(&cache->lock, intSave);
+        LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(slab, next, &releaseList, OsSlabHead, node) {
+            OsSlabPagesFree(cache, slab);
+        }
+        return LOS_NOK; /* 仍有对象未释放，缓存保持可用 */
+    }
+    LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(slab, next, &cache->partialList, OsSlabHead, node) {
+        LOS_ListDelete(&slab->node);
+        LOS_ListAdd(&releaseList, &slab->node);
+    }
+    LOS_SpinUnlockRestore(&cache->lock, intSave);
+
+    LOS_SpinLockSave(&g_slabListSpin, &intSave);
+    LOS_ListDelete(&cache->node);
+    LOS_SpinUnlockRestore(&g_slabListSpin, intSave);
+
+    LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(slab, next, &releaseList, OsSlabHead, node) {
+        OsSlabPagesFree(cache, slab);
+    }
+    (VOID)LOS_MemFree(m_aucSysMem0, cache);
+    return LOS_OK;
+}
+
+LITE_OS_SEC_TEXT_MINOR UINT32 LOS_SlabInfoGet(LosSlabInfo *info, UINT32 num)
+{
+    LosSlabCache *cache = NULL;
+    LosSlabInfo *curr = NULL;
+    UINT32 magObjs;
+    UINT32 count = 0;
+    UINT32 intSave;
+    UINT32 cpu;
+
+    if (info == NULL) {
+        return 0;
+    }
+
+    LOS_SpinLockSave(&g_slabListSpin, &intSave);
+    LOS_DL_LIST_FOR_EACH_ENTRY(cache, &g_slabCacheList, LosSlabCache, node) {
+        if (count >= num) {
+            break;
+        }
+        curr = &info[count++];
+        (VOID)memcpy_s(curr->name, LOS_SLAB_NAME_LEN, cache->name, LOS_SLAB_NAME_LEN);
+        curr->objSize = cache->objSize;
+        curr->slabSize = cache->slabSize;
+        curr->allocCount = 0;
+        curr->freeCount = 0;
+        curr->magazineHit = 0;
+        magObjs = 0;
+        /* 其他核的magazine计数不加锁读取，统计值只是近似 */
+        for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+            magObjs += cache->magazine[cpu].count;
+            curr->allocCount += cache->magazine[cpu].allocCount;
+            curr->freeCount += cache->magazine[cpu].freeCount;
+            curr->magazineHit += cache->magazine[cpu].hitCount;
+        }
+        LOS_SpinLock(&cache->lock);
+        curr->slabNum = cache->slabNum;
+        curr->objTotal = cache->slabNum * cache->objPerSlab;
+        curr->objActive = curr->objTotal - cache->freeObjs;
+        LOS_SpinUnlock(&cache->lock);
+        curr->objActive = (curr->objActive > magObjs) ? (curr->objActive - magObjs) : 0;
+    }
+    LOS_SpinUnlockRestore(&g_slabListSpin, intSave);
+    return count;
+}
@@ -260,11 +260,29 @@ struct OsMemPoolHead {
 #define OS_MEM_MIDDLE_ADDR(startAddr, middleAddr, endAddr) \
     (((UINT8 *)(startAddr) <= (UINT8 *)(middleAddr)) && ((UINT8 *)(middleAddr) <= (UINT8 *)(endAddr)))
 #define OS_MEM_SET_MAGIC(node)      ((node)->magic = OS_MEM_NODE_MAGIC)
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+/* Used nodes parked in a per-CPU cache carry this magic, so that a second free is caught. */
+#define OS_MEM_NODE_CACHED_MAGIC    0xABCDCACE
+#define OS_MEM_MAGIC_VALID(node)    (((node)->magic == OS_MEM_NODE_MAGIC) || \
+                                     ((node)->magic == OS_MEM_NODE_CACHED_MAGIC))
+#define OS_MEM_NODE_IS_PARKED(node) ((node)->magic == OS_MEM_NODE_CACHED_MAGIC)
+#else
 #define OS_MEM_MAGIC_VALID(node)    ((node)->magic == OS_MEM_NODE_MAGIC)
+#define OS_MEM_NODE_IS_PARKED(node) FALSE
+#endif
 
 STATIC INLINE VOID OsMemFreeNodeAdd(VOID *pool, struct OsMemFreeNodeHead *node);
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+STATIC INLINE BOOL OsMemCacheEnabled(const VOID *pool)
+{
+    return (pool == (VOID *)m_aucSysMem1);
+}
+#endif
 STATIC INLINE UINT32 OsMemFree(struct OsMemPoolHead *pool, struct OsMemNodeHead *node);
 STATIC VOID OsMemInfoPrint(VOID *pool);
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+STATIC UINT32 OsMemCacheReclaim(struct OsMemPoolHead *pool);
+#endif
 #ifdef LOSCFG_BASE_MEM_NODE_INTEGRITY_CHECK
 STATIC INLINE UINT32 OsMemAllocCheck(struct OsMemPoolHead *pool, UINT32 intSave);
 #endif
@@ -1058,6 +1076,16 @@ UINT32 LOS_MemPoolList(VOID)
 }
 #endif
 
+STATIC INLINE VOID OsMemUsedNodeSet(struct OsMemPoolHead *pool, struct OsMemNodeHead *allocNode, UINT32 allocSize)
+{
+    if ((allocSize + OS_MEM_NODE_HEAD_SIZE + OS_MEM_MIN_ALLOC_SIZE) <= allocNode->sizeAndFlag) {
+        OsMemSplitNode(pool, allocNode, allocSize);
+    }
+
+    OS_MEM_NODE_SET_USED_FLAG(allocNode->sizeAndFlag);
+    OsMemWaterUsedRecord(pool, OS_MEM_NODE_GET_SIZE(allocNode->sizeAndFlag));
+}
+
 STATIC INLINE VOID *OsMemAlloc(struct OsMemPoolHead *pool, UINT32 size, UINT32 intSave)
 {
     struct OsMemNodeHead *allocNode = NULL;
@@ -1069,11 +1097,23 @@ STATIC INLINE VOID *OsMemAlloc(struct OsMemPoolHead *pool, UINT32 size, UINT32 i
 #endif
 
     UINT32 allocSize = OS_MEM_ALIGN(size + OS_MEM_NODE_HEAD_SIZE, OS_MEM_ALIGN_SIZE);
-#if OS_MEM_EXPAND_ENABLE
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+    BOOL reclaimed = FALSE;
+#endif
+#if OS_MEM_EXPAND_ENABLE || defined(LOSCFG_KERNEL_MEM_PERCPU_CACHE)
 retry:
 #endif
     allocNode = OsMemFreeNodeGet(pool, allocSize);
     if (allocNode == NULL) {
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+        /* blocks parked in the per-CPU caches are free memory, give them back before failing */
+        if (!reclaimed && OsMemCacheEnabled(pool)) {
+            reclaimed = TRUE;
+            if (OsMemCacheReclaim(pool) != 0) {
+                goto retry;
+            }
+        }
+#endif
 #if OS_MEM_EXPAND_ENABLE
         if (pool->info.attr & OS_MEM_POOL_EXPAND_ENABLE) {
             INT32 ret = OsMemPoolExpand(pool, allocSize, intSave);
@@ -1093,12 +1133,7 @@ retry:
         return NULL;
     }
 
-    if ((allocSize + OS_MEM_NODE_HEAD_SIZE + OS_MEM_MIN_ALLOC_SIZE) <= allocNode->sizeAndFlag) {
-        OsMemSplitNode(pool, allocNode, allocSize);
-    }
-
-    OS_MEM_NODE_SET_USED_FLAG(allocNode->sizeAndFlag);
-    OsMemWaterUsedRecord(pool, OS_MEM_NODE_GET_SIZE(allocNode->sizeAndFlag));
+    OsMemUsedNodeSet(pool, allocNode, allocSize);
 
 #ifdef LOSCFG_MEM_LEAKCHECK
     OsMemLinkRegisterRecord(allocNode);
@@ -1106,6 +1141,193 @@ retry:
     return OsMemCreateUsedNode((VOID *)allocNode);
 }
 
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+/*
+ * Per-CPU front end of the system pool for small blocks. Freed blocks of up to
+ * OS_MEM_CACHE_MAX_SIZE bytes (node head included) are parked, still marked used,
+ * in a per-CPU stack of their size class and handed out again without taking the
+ * pool lock. A miss refills OS_MEM_CACHE_BATCH blocks in one locked pass, and a
+ * full stack drains OS_MEM_CACHE_BATCH blocks back to TLSF the same way. Parked
+ * blocks keep a valid node layout, so integrity checks and pool walks see them as
+ * used nodes, while the usage statistics count them as free and free and realloc
+ * reject them as already freed. Before the pool reports
+ * an allocation failure every cache is reclaimed into TLSF and the search retried.
+ *
+ * Each cache is only touched by its own CPU with interrupts disabled, under its
+ * own lock. The lock is uncontended except when another CPU reclaims the cache
+ * while holding the pool lock, so the order is cache lock before pool lock.
+ */
+#define OS_MEM_CACHE_CLASS_SIZE     16
+#define OS_MEM_CACHE_CLASS_NUM      16
+#define OS_MEM_CACHE_MAX_SIZE       (OS_MEM_CACHE_CLASS_SIZE * OS_MEM_CACHE_CLASS_NUM)
+#define OS_MEM_CACHE_DEPTH          8
+#define OS_MEM_CACHE_BATCH          (OS_MEM_CACHE_DEPTH / 2)
+
+typedef struct {
+    UINT32 count[OS_MEM_CACHE_CLASS_NUM];
+    struct OsMemNodeHead *node[OS_MEM_CACHE_CLASS_NUM][OS_MEM_CACHE_DEPTH];
+    UINT32 cachedSize;  /* bytes parked on this CPU */
+    SPIN_LOCK_S lock;
+} OsMemPercpuCache;
+
+STATIC OsMemPercpuCache g_memPercpuCache[LOSCFG_KERNEL_CORE_NUM];
+
+STATIC VOID OsMemCacheInit(VOID)
+{
+    UINT32 cpu;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        LOS_SpinInit(&g_memPercpuCache[cpu].lock);
+    }
+}
+
+STATIC INLINE VOID *OsMemCacheNodeUse(struct OsMemNodeHead *node)
+{
+    OS_MEM_SET_MAGIC(node);
+#ifdef LOSCFG_MEM_LEAKCHECK
+    OsMemLinkRegisterRecord(node);
+#endif
+    return OsMemCreateUsedNode((VOID *)node);
+}
+
+/* Refill a size class on a miss, the caller has disabled interrupts and holds the cache lock */
+STATIC VOID *OsMemCacheRefill(struct OsMemPoolHead *pool, OsMemPercpuCache *cache, UINT32 cls)
+{
+    UINT32 allocSize = (cls + 1) * OS_MEM_CACHE_CLASS_SIZE;
+    struct OsMemNodeHead *node = NULL;
+    VOID *ptr = NULL;
+    UINT32 intSave;
+
+    MEM_LOCK(pool, intSave);
+    ptr = OsMemAlloc(pool, allocSize - OS_MEM_NODE_HEAD_SIZE, intSave);
+    while ((ptr != NULL) && (cache->count[cls] < OS_MEM_CACHE_BATCH)) {
+        node = OsMemFreeNodeGet(pool, allocSize); /* the extra blocks are best effort, no expand, no error print */
+        if (node == NULL) {
+            break;
+        }
+        OsMemUsedNodeSet(pool, node, allocSize);
+        node->magic = OS_MEM_NODE_CACHED_MAGIC;
+        cache->node[cls][cache->count[cls]++] = node;
+        cache->cachedSize += OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+    }
+    MEM_UNLOCK(pool, intSave);
+    return ptr;
+}
+
+STATIC INLINE VOID *OsMemCacheAlloc(struct OsMemPoolHead *pool, UINT32 size)
+{
+    UINT32 allocSize = OS_MEM_ALIGN(size + OS_MEM_NODE_HEAD_SIZE, OS_MEM_ALIGN_SIZE);
+    UINT32 cls = (allocSize + OS_MEM_CACHE_CLASS_SIZE - 1) / OS_MEM_CACHE_CLASS_SIZE - 1;
+    OsMemPercpuCache *cache = NULL;
+    struct OsMemNodeHead *node = NULL;
+    VOID *ptr = NULL;
+    UINT32 intSave;
+
+    intSave = LOS_IntLock();
+    cache = &g_memPercpuCache[ArchCurrCpuid()];
+    LOS_SpinLock(&cache->lock);
+    if (cache->count[cls] == 0) {
+        ptr = OsMemCacheRefill(pool, cache, cls);
+    } else {
+        node = cache->node[cls][--cache->count[cls]];
+        cache->cachedSize -= OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+        ptr = OsMemCacheNodeUse(node);
+    }
+    LOS_SpinUnlock(&cache->lock);
+    LOS_IntRestore(intSave);
+    return ptr;
+}
+
+/* Return half of a full size class to TLSF, the caller has disabled interrupts and holds the cache lock */
+STATIC VOID OsMemCacheDrain(struct OsMemPoolHead *pool, OsMemPercpuCache *cache, UINT32 cls)
+{
+    struct OsMemNodeHead *node = NULL;
+    UINT32 intSave;
+
+    MEM_LOCK(pool, intSave);
+    while (cache->count[cls] > OS_MEM_CACHE_BATCH) {
+        node = cache->node[cls][--cache->count[cls]];
+        cache->cachedSize -= OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+        OS_MEM_SET_MAGIC(node);
+        (VOID)OsMemFree(pool, node);
+    }
+    MEM_UNLOCK(pool, intSave);
+}
+
+/*
+ * Park a freed block in the per-CPU cache. Returns LOS_NOK when the block is not
+ * cacheable and must go through the checked TLSF free path instead.
+ */
+STATIC INLINE UINT32 OsMemCacheFree(struct OsMemPoolHead *pool, struct OsMemNodeHead *node)
+{
+    UINT32 nodeSize = OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+    struct OsMemNodeHead *nextNode = NULL;
+    OsMemPercpuCache *cache = NULL;
+    UINT32 intSave;
+    UINT32 cls;
+
+    if ((nodeSize < OS_MEM_CACHE_CLASS_SIZE) || (nodeSize > OS_MEM_CACHE_MAX_SIZE) || (node->magic != OS_MEM_NODE_MAGIC) ||
+        ((node->sizeAndFlag & OS_MEM_NODE_ALIGNED_AND_USED_FLAG) != OS_MEM_NODE_USED_FLAG)) {
+        return LOS_NOK;
+    }
+    nextNode = OS_MEM_NEXT_NODE(node);
+    if (!OS_MEM_NODE_GET_LAST_FLAG(nextNode->sizeAndFlag) && (nextNode->ptr.prev != node)) {
+        return LOS_NOK;
+    }
+
+    cls = nodeSize / OS_MEM_CACHE_CLASS_SIZE - 1; /* a node larger than its class still serves it */
+    intSave = LOS_IntLock();
+    cache = &g_memPercpuCache[ArchCurrCpuid()];
+    LOS_SpinLock(&cache->lock);
+    if (cache->count[cls] == OS_MEM_CACHE_DEPTH) {
+        OsMemCacheDrain(pool, cache, cls);
+    }
+    node->magic = OS_MEM_NODE_CACHED_MAGIC;
+    cache->node[cls][cache->count[cls]++] = node;
+    cache->cachedSize += nodeSize;
+    LOS_SpinUnlock(&cache->lock);
+    LOS_IntRestore(intSave);
+    return LOS_OK;
+}
+
+/*
+ * Give every parked block back to TLSF, the caller holds the pool lock. Nothing
+ * but this CPU touches the local cache while interrupts are off here, even when
+ * the caller is a refill of that very cache. A remote cache whose lock is busy is
+ * skipped rather than waited for, because its owner may be spinning on the pool
+ * lock. Returns the number of bytes reclaimed.
+ */
+STATIC UINT32 OsMemCacheReclaim(struct OsMemPoolHead *pool)
+{
+    UINT32 self = ArchCurrCpuid();
+    OsMemPercpuCache *cache = NULL;
+    struct OsMemNodeHead *node = NULL;
+    UINT32 reclaimed = 0;
+    UINT32 cpu, cls;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        cache = &g_memPercpuCache[cpu];
+        if ((cpu != self) && (LOS_SpinTrylock(&cache->lock) != LOS_OK)) {
+            continue;
+        }
+        for (cls = 0; cls < OS_MEM_CACHE_CLASS_NUM; cls++) {
+            while (cache->count[cls] > 0) {
+                node = cache->node[cls][--cache->count[cls]];
+                cache->cachedSize -= OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+                reclaimed += OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
+                OS_MEM_SET_MAGIC(node);
+                (VOID)OsMemFree(pool, node);
+            }
+        }
+        if (cpu != self) {
+            LOS_SpinUnlock(&cache->lock);
+        }
+    }
+    return reclaimed;
+}
+
+#endif
+
 VOID *LOS_MemAlloc(VOID *pool, UINT32 size)
 {
     if ((pool == NULL) || (size == 0)) {
@@ -1124,6 +1346,12 @@ VOID *LOS_MemAlloc(VOID *pool, UINT32 size)
         if (OS_MEM_NODE_GET_USED_FLAG(size) || OS_MEM_NODE_GET_ALIGNED_FLAG(size)) {
             break;
         }
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+        if (OsMemCacheEnabled(pool) && (size <= (OS_MEM_CACHE_MAX_SIZE - OS_MEM_NODE_HEAD_SIZE))) {
+            ptr = OsMemCacheAlloc(poolHead, size);
+            break;
+        }
+#endif
         MEM_LOCK(poolHead, intSave);
         ptr = OsMemAlloc(poolHead, size, intSave);
         MEM_UNLOCK(poolHead, intSave);
@@ -1254,6 +1482,10 @@ STATIC  BOOL MemCheckUsedNode(const struct OsMemPoolHead *pool, const struct OsM
         return FALSE;
     }
 
+    if (OS_MEM_NODE_IS_PARKED(node)) { /* parked in a per-CPU cache, i.e. already freed */
+        return FALSE;
+    }
+
     const struct OsMemNodeHead *nextNode = OS_MEM_NEXT_NODE(node);
     if (!OsMemIsNodeValid(nextNode, startNode, endNode, pool)) {
         return FALSE;
@@ -1383,6 +1615,18 @@ UINT32 LOS_MemFree(VOID *pool, VOID *ptr)
             }
             node = (struct OsMemNodeHead *)((UINTPTR)ptr - gapSize - OS_MEM_NODE_HEAD_SIZE);
         }
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+        if (OsMemCacheEnabled(pool)) {
+            if (node->magic == OS_MEM_NODE_CACHED_MAGIC) {
+                PRINT_ERR("[%s] node %p has been freed already\n", __FUNCTION__, node);
+                break;
+            }
+            if (OsMemCacheFree(poolHead, node) == LOS_OK) {
+                ret = LOS_OK;
+                break;
+            }
+        }
+#endif
         MEM_LOCK(poolHead, intSave);
         ret = OsMemFree(poolHead, node);
         MEM_UNLOCK(poolHead, intSave);
@@ -1575,6 +1819,11 @@ UINT32 LOS_MemFreeByTaskID(VOID *pool, UINT32 taskID)
             node = (struct OsMemUsedNodeHead *)tmpNode;
             tmpNode = OS_MEM_NEXT_NODE(tmpNode);
 
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+            if (node->header.magic == OS_MEM_NODE_CACHED_MAGIC) { /* already freed, parked in a per-CPU cache */
+                continue;
+            }
+#endif
             if (node->taskID == taskID) {
                 OsMemFree(poolHead, &node->header);
             }
@@ -1639,7 +1888,7 @@ UINT32 LOS_MemTotalUsedGet(VOID *pool)
                 break;
             }
         } else {
-            if (OS_MEM_NODE_GET_USED_FLAG(tmpNode->sizeAndFlag)) {
+            if (OS_MEM_NODE_GET_USED_FLAG(tmpNode->sizeAndFlag) && !OS_MEM_NODE_IS_PARKED(tmpNode)) {
                 memUsed += OS_MEM_NODE_GET_SIZE(tmpNode->sizeAndFlag);
             }
             tmpNode = OS_MEM_NEXT_NODE(tmpNode);
@@ -1647,7 +1896,7 @@ UINT32 LOS_MemTotalUsedGet(VOID *pool)
     }
 #else
     for (tmpNode = OS_MEM_FIRST_NODE(pool); tmpNode < endNode;) {
-        if (OS_MEM_NODE_GET_USED_FLAG(tmpNode->sizeAndFlag)) {
+        if (OS_MEM_NODE_GET_USED_FLAG(tmpNode->sizeAndFlag) && !OS_MEM_NODE_IS_PARKED(tmpNode)) {
             memUsed += OS_MEM_NODE_GET_SIZE(tmpNode->sizeAndFlag);
         }
         tmpNode = OS_MEM_NEXT_NODE(tmpNode);
@@ -1926,6 +2175,8 @@ STATIC INLINE VOID OsMemInfoGet(struct OsMemPoolHead *poolInfo, struct OsMemNode
         if (maxFreeSize < size) {
             maxFreeSize = size;
         }
+    } else if (OS_MEM_NODE_IS_PARKED(node)) { /* freed but parked in a per-CPU cache, not a free node yet */
+        totalFreeSize += OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
     } else {
         size = OS_MEM_NODE_GET_SIZE(node->sizeAndFlag);
         ++usedNodeNum;
@@ -2094,6 +2345,9 @@ STATUS_T OsKHeapInit(size_t size)
         g_vmBootMemBase -= size;
         return ret;
     }
+#ifdef LOSCFG_KERNEL_MEM_PERCPU_CACHE
+    OsMemCacheInit();
+#endif
 #if OS_MEM_EXPAND_ENABLE
     LOS_MemExpandEnable(OS_SYS_MEM_ADDR);
 #endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "los_config.h"
+#ifdef LOSCFG_SHELL
+#include "shcmd.h"
+#include "shell.h"
+#endif
+#include "los_percpu_pri.h"
+
+
+#if defined(LOSCFG_SHELL_CMD_DEBUG) && defined(LOSCFG_KERNEL_SMP)
+/**
+ * @brief  ipistat shell命令处理函数，显示各CPU调度IPI的发送与接收次数
+ * @param[in]  argc - 命令参数个数
+ * @param[in]  argv - 命令参数列表，"-r"表示清零统计
+ * @return UINT32 - 执行结果（LOS_OK表示成功）
+ */
+LITE_OS_SEC_TEXT_MINOR UINT32 OsShellCmdIpiStat(INT32 argc, const CHAR **argv)
+{
+    UINT32 cpuid;
+
+    if ((argc == 1) && (strcmp(argv[0], "-r") == 0)) {  // 清零统计
+        for (cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+            g_percpu[cpuid].schedIpiSend = 0;
+            g_percpu[cpuid].schedIpiRecv = 0;
+        }
+        PRINTK("ipi statistics reset\n");
+        return LOS_OK;
+    }
+
+    if (argc != 0) {
+        PRINTK("usage: ipistat [-r]\n");
+        return LOS_OK;
+    }
+
+    PRINTK("%-4s %-12s %-12s\n", "CPU", "SchedSend", "SchedRecv");
+    for (cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+        PRINTK("%-4u %-12u %-12u\n", cpuid, g_percpu[cpuid].schedIpiSend, g_percpu[cpuid].schedIpiRecv);  // 读取快照
+    }
+    return LOS_OK;
+}
+
+SHELLCMD_ENTRY(ipistat_shellcmd, CMD_TYPE_EX, "ipistat", XARGS, (CmdCallBackFunc)OsShellCmdIpiStat);
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "los_config.h"
+#ifdef LOSCFG_SHELL
+#include "shcmd.h"
+#include "shell.h"
+#endif
+#include "los_task_pri.h"
+#include "los_sched_pri.h"
+
+
+#if defined(LOSCFG_SHELL_CMD_DEBUG) && defined(LOSCFG_KERNEL_SMP_LOCK_STAT)
+/**
+ * @brief  打印单个自旋锁的获取与竞争统计
+ * @param[in]  name - 显示名称
+ * @param[in]  cpuid - 所属CPU编号，全局锁传入OS_TASK_INVALID_CPUID
+ * @param[in]  lock - 自旋锁
+ */
+STATIC VOID OsLockStatShow(const CHAR *name, UINT32 cpuid, const SPIN_LOCK_S *lock)
+{
+    UINT32 acquired = lock->acquired;       // 读取快照，统计期间计数仍可能增长
+    UINT32 contended = lock->contended;
+    UINT32 ratio = (acquired == 0) ? 0 : (UINT32)(((UINT64)contended * 1000) / acquired);  // 千分比
+
+    if (cpuid == OS_TASK_INVALID_CPUID) {
+        PRINTK("%-16s %-4s %-12u %-12u %u.%u%%\n", name, "-", acquired, contended, ratio / 10, ratio % 10);
+    } else {
+        PRINTK("%-16s %-4u %-12u %-12u %u.%u%%\n", name, cpuid, acquired, contended, ratio / 10, ratio % 10);
+    }
+}
+
+/**
+ * @brief  清零自旋锁统计
+ * @param[in]  lock - 自旋锁
+ */
+STATIC VOID OsLockStatReset(SPIN_LOCK_S *lock)
+{
+    lock->acquired = 0;
+    lock->contended = 0;
+}
+
+/**
+ * @brief  lockstat shell命令处理函数，显示调度相关自旋锁的竞争情况
+ * @param[in]  argc - 命令参数个数
+ * @param[in]  argv - 命令参数列表，"-r"表示清零统计
+ * @return UINT32 - 执行结果（LOS_OK表示成功）
+ */
+LITE_OS_SEC_TEXT_MINOR UINT32 OsShellCmdLockStat(INT32 argc, const CHAR **argv)
+{
+    UINT16 cpuid;
+
+    if ((argc == 1) && (strcmp(argv[0], "-r") == 0)) {  // 清零统计
+        OsLockStatReset(&g_taskSpin);
+        for (cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+            SchedRunqueue *rq = OsSchedRunqueueByID(cpuid);
+            OsLockStatReset(&rq->timeoutQueue.spinLock);
+        }
+        PRINTK("lock statistics reset\n");
+        return LOS_OK;
+    }
+
+    if (argc != 0) {
+        PRINTK("usage: lockstat [-r]\n");
+        return LOS_OK;
+    }
+
+    PRINTK("%-16s %-4s %-12s %-12s %s\n", "Name", "CPU", "Acquired", "Contended", "Ratio");
+    OsLockStatShow("g_taskSpin", OS_TASK_INVALID_CPUID, &g_taskSpin);
+    for (cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+        SchedRunqueue *rq = OsSchedRunqueueByID(cpuid);
+        OsLockStatShow("timeoutQueue", cpuid, &rq->timeoutQueue.spinLock);
+    }
+    return LOS_OK;
+}
+
+SHELLCMD_ENTRY(lockstat_shellcmd, CMD_TYPE_EX, "lockstat", XARGS, (CmdCallBackFunc)OsShellCmdLockStat);
+#endif
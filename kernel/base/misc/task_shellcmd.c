@@ -53,7 +53,7 @@
 #include "los_sched_pri.h"
 #include "los_swtmr_pri.h"
 #include "los_info_pri.h"
-#ifdef LOSCFG_SCHED_DEBUG
+#if defined(LOSCFG_SCHED_DEBUG) || defined(LOSCFG_KERNEL_SCHED_STATISTICS)
 #include "los_statistics_pri.h"
 #endif
 
@@ -545,6 +545,13 @@ LITE_OS_SEC_TEXT_MINOR UINT32 OsShellCmdDumpTask(INT32 argc, const CHAR **argv)
         }
         goto TASK_HELP;
 #endif
+#endif
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+    } else if (strcmp("-w", argv[0]) == 0) {  // 显示各CPU定时器中断与空闲唤醒频率
+        if (!OsShellShowSchedWakeup()) {
+            return LOS_OK;
+        }
+        goto TASK_HELP;
 #endif
     } else {  // 未知参数
         goto TASK_HELP;
@@ -558,6 +565,9 @@ TASK_HELP:  // 显示命令帮助信息
     PRINTK(" task          --- Basic information about all created processes.\n");
     PRINTK(" task -a       --- Complete information about all created processes.\n");
     PRINTK(" task -p [pid] --- Complete information about specifies processes and its task.\n");
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+    PRINTK(" task -w       --- Timer interrupts and idle wakeups per second of each cpu.\n");
+#endif
     return LOS_NOK;
 }
 
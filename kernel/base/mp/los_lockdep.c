@@ -129,6 +129,9 @@ STATIC INLINE CHAR *OsLockDepErrorStringGet(enum LockDepErrType type)
         case LOCKDEP_ERR_OVERFLOW:
             errorString = "lockdep overflow";     // 锁依赖深度溢出
             break;
+        case LOCKDEP_ERR_ORDER:
+            errorString = "lock order inversion"; // 违反锁类别加锁顺序
+            break;
         default:
             errorString = "unknown error code";   // 未知错误
             break;
@@ -267,11 +270,44 @@ STATIC BOOL OsLockDepCheckDependency(const LosTaskCB *current, LosTaskCB *lockOw
     return checkResult;                     // 返回检查结果
 }
 
+/**
+ * @brief 检查加锁顺序是否符合锁类别约定
+ * @param lockDep 当前任务的锁依赖结构
+ * @param lock 要获取的自旋锁指针
+ * @return BOOL TRUE-顺序正确，FALSE-顺序反转
+ * @note 已持有的锁中不得存在类别更大的锁，或同类别且子序号不小于待获取锁的锁，
+ *       未设置类别的锁不参与校验
+ */
+STATIC BOOL OsLockDepOrderCheck(const LockDep *lockDep, const SPIN_LOCK_S *lock)
+{
+    INT32 i;
+    const SPIN_LOCK_S *held = NULL;
+
+    if (lock->lockClass == LOCKDEP_CLASS_NONE) {
+        return TRUE;
+    }
+
+    for (i = 0; i < lockDep->lockDepth; i++) {
+        held = (const SPIN_LOCK_S *)lockDep->heldLocks[i].lockPtr;
+        if ((held == lock) || (held->lockClass == LOCKDEP_CLASS_NONE)) {
+            continue; /* 重复加锁由后续的双重加锁检查报告 */
+        }
+        if (held->lockClass > lock->lockClass) {
+            return FALSE;
+        }
+        if ((held->lockClass == lock->lockClass) && (held->subClass >= lock->subClass)) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
 /**
  * @brief 锁获取前的依赖检查
  * @param lock 要获取的自旋锁指针
  * @return VOID
- * @note 检查双重加锁、死锁和深度溢出，通过后记录等待信息
+ * @note 检查双重加锁、死锁、加锁顺序和深度溢出，通过后记录等待信息
  */
 VOID OsLockDepCheckIn(SPIN_LOCK_S *lock)
 {
@@ -290,6 +326,12 @@ VOID OsLockDepCheckIn(SPIN_LOCK_S *lock)
         goto OUT;
     }
 
+    // 检查是否违反锁类别的加锁顺序
+    if (OsLockDepOrderCheck(lockDep, lock) != TRUE) {
+        checkResult = LOCKDEP_ERR_ORDER;
+        goto OUT;
+    }
+
     lockOwner = lock->owner;                // 获取当前锁持有者
     /* 如果锁未被任何任务持有，无需进一步检查 */
     if (lockOwner == SPINLOCK_OWNER_INIT) {
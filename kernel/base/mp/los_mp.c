@@ -71,7 +71,17 @@ LITE_OS_SEC_BSS SPIN_LOCK_INIT(g_mpCallSpin);
 VOID LOS_MpSchedule(UINT32 target)//target每位对应CPU core 
 {
     UINT32 cpuid = ArchCurrCpuid();
+    UINT32 index;
+
     target &= ~(1U << cpuid);//获取除了自身之外的其他CPU
+    if (target == 0) {
+        return;
+    }
+    for (index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {//按目标CPU个数统计发出的IPI
+        if (target & CPUID_TO_AFFI_MASK(index)) {
+            g_percpu[cpuid].schedIpiSend++;
+        }
+    }
     HalIrqSendIpi(target, LOS_MP_IPI_SCHEDULE);//向目标CPU发送调度信号,核间中断(Inter-Processor Interrupts),IPI
 }
 ///硬中断唤醒处理函数
@@ -86,6 +96,7 @@ VOID OsMpScheduleHandler(VOID)
      * set schedule flag to differ from wake function,
      * so that the scheduler can be triggered at the end of irq.
      */
+    OsPercpuGet()->schedIpiRecv++;
     OsSchedRunqueuePendingSet();
 }
 ///硬中断暂停处理函数
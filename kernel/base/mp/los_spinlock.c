@@ -45,6 +45,29 @@ VOID LOS_SpinInit(SPIN_LOCK_S *lock)
     lock->cpuid   = (UINT32)-1;  // CPU ID初始化为无效值
     lock->owner   = SPINLOCK_OWNER_INIT;  // 锁拥有者初始化为默认值
     lock->name    = "spinlock";  // 锁名称设置为默认字符串
+    LOCKDEP_CLASS_SET(lock, LOCKDEP_CLASS_NONE, 0);  // 默认不参与加锁顺序校验
+#ifdef LOSCFG_KERNEL_SMP_LOCK_STAT
+    lock->acquired  = 0;  // 获取次数清零
+    lock->contended = 0;  // 竞争次数清零
+#endif
+}
+
+/**
+ * @brief 获取架构自旋锁，并统计获取与竞争次数
+ * @param lock [IN/OUT] 指向自旋锁结构的指针
+ * @note 统计开启时先尝试一次无等待获取，失败即记为一次竞争；计数在持锁期间更新，无需原子操作
+ */
+STATIC INLINE VOID SpinLockAcquire(SPIN_LOCK_S *lock)
+{
+#ifdef LOSCFG_KERNEL_SMP_LOCK_STAT
+    if (ArchSpinTrylock(&lock->rawLock) != LOS_OK) {
+        ArchSpinLock(&lock->rawLock);  // 锁已被持有，自旋等待
+        lock->contended++;
+    }
+    lock->acquired++;
+#else
+    ArchSpinLock(&lock->rawLock);  // 架构相关的自旋锁获取实现
+#endif
 }
 
 /**
@@ -54,7 +77,8 @@ VOID LOS_SpinInit(SPIN_LOCK_S *lock)
  */
 BOOL LOS_SpinHeld(const SPIN_LOCK_S *lock)
 {
-    return (lock->rawLock != 0);  // 通过原始锁值判断锁状态
+    size_t rawLock = lock->rawLock;  // 票据锁的服务号与票号需来自同一次读取
+    return (ARCH_SPIN_OWNER(rawLock) != ARCH_SPIN_NEXT(rawLock));  // 已发出的票尚未全部服务完即为被持有
 }
 
 /**
@@ -69,7 +93,7 @@ VOID LOS_SpinLock(SPIN_LOCK_S *lock)
     LOS_IntRestore(intSave);  // 恢复中断状态
 
     LOCKDEP_CHECK_IN(lock);  // 锁依赖检查（进入阶段）
-    ArchSpinLock(&lock->rawLock);  // 架构相关的自旋锁获取实现
+    SpinLockAcquire(lock);  // 获取自旋锁
     LOCKDEP_RECORD(lock);  // 记录当前锁的依赖关系
 }
 
@@ -87,6 +111,9 @@ INT32 LOS_SpinTrylock(SPIN_LOCK_S *lock)
 
     INT32 ret = ArchSpinTrylock(&lock->rawLock);  // 尝试获取架构相关自旋锁
     if (ret == LOS_OK) {  // 判断是否成功获取锁
+#ifdef LOSCFG_KERNEL_SMP_LOCK_STAT
+        lock->acquired++;
+#endif
         LOCKDEP_CHECK_IN(lock);  // 锁依赖检查（进入阶段）
         LOCKDEP_RECORD(lock);  // 记录当前锁的依赖关系
         return ret;  // 返回成功状态
@@ -133,7 +160,7 @@ VOID LOS_SpinLockSave(SPIN_LOCK_S *lock, UINT32 *intSave)
     OsSchedLock();  // 禁用任务调度
 
     LOCKDEP_CHECK_IN(lock);  // 锁依赖检查（进入阶段）
-    ArchSpinLock(&lock->rawLock);  // 架构相关的自旋锁获取实现
+    SpinLockAcquire(lock);  // 获取自旋锁
     LOCKDEP_RECORD(lock);  // 记录当前锁的依赖关系
 }
 
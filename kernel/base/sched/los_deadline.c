@@ -34,6 +34,7 @@
 #include "los_hook.h"
 #include "los_tick_pri.h"
 #include "los_sys_pri.h"
+#include "los_mp.h"
 
 STATIC EDFRunqueue g_schedEDF;
 
@@ -253,6 +254,11 @@ STATIC VOID EDFEnqueue(SchedRunqueue *rq, LosTaskCB *taskCB)
     DeadlineQueueInsert(erq, taskCB);  // 将任务插入EDF就绪队列（按截止时间排序）
     taskCB->taskStatus &= ~(OS_TASK_STATUS_BLOCKED | OS_TASK_STATUS_TIMEOUT);  // 清除阻塞和超时状态
     taskCB->taskStatus |= OS_TASK_STATUS_READY;  // 设置任务状态为就绪
+#ifdef LOSCFG_KERNEL_SMP
+    if (!OsTaskIsRunning(taskCB)) {  // EDF就绪队列为全局共享，任意CPU都可能需要抢占，仍通知所有CPU
+        LOS_MpSchedule(OS_MP_CPU_ALL);
+    }
+#endif
 }
 
 
@@ -45,7 +45,7 @@
 
 //基于优先数调度算法 Highest-Priority-First (HPF)
 
-STATIC HPFRunqueue g_schedHPF;
+STATIC HPFRunqueue g_schedHPF[LOSCFG_KERNEL_CORE_NUM]; // 每个CPU独立的HPF就绪队列
 
 STATIC VOID HPFDequeue(SchedRunqueue *rq, LosTaskCB *taskCB);
 STATIC VOID HPFEnqueue(SchedRunqueue *rq, LosTaskCB *taskCB);
@@ -198,6 +198,7 @@ STATIC INLINE VOID PriQueHeadInsert(HPFRunqueue *rq, UINT32 basePrio, LOS_DL_LIS
 
     LOS_ListHeadInsert(&priQueList[priority], priQue);  // 将任务插入到队列头部
     queueList->readyTasks[priority]++;  // 增加就绪任务计数
+    rq->readyTasks++;  // 增加队列就绪任务总数
 }
 
 
@@ -232,6 +233,7 @@ STATIC INLINE VOID PriQueTailInsert(HPFRunqueue *rq, UINT32 basePrio, LOS_DL_LIS
 
     LOS_ListTailInsert(&priQueList[priority], priQue);  // 将任务插入到队列尾部
     queueList->readyTasks[priority]++;  // 增加就绪任务计数
+    rq->readyTasks++;  // 增加队列就绪任务总数
 }
 
 /**
@@ -250,6 +252,7 @@ STATIC INLINE VOID PriQueDelete(HPFRunqueue *rq, UINT32 basePrio, LOS_DL_LIST *p
 
     LOS_ListDelete(priQue);  // 从队列中删除节点
     queueList->readyTasks[priority]--;  // 减少就绪任务计数
+    rq->readyTasks--;  // 减少队列就绪任务总数
     if (LOS_ListEmpty(&priQueList[priority])) {  // 如果队列已空
         *bitmap &= ~(PRIQUEUE_PRIOR0_BIT >> priority);  // 清除优先级位
     }
@@ -306,6 +309,92 @@ STATIC INLINE VOID PriQueInsert(HPFRunqueue *rq, LosTaskCB *taskCB)
 }
 
 
+#ifdef LOSCFG_KERNEL_SMP
+/**
+ * @brief 比较两个CPU上正在运行的任务，哪个更容易被抢占
+ * @return 大于0表示cpu1上的运行任务优先级更低（空闲CPU最低），等于0表示相同
+ * @details 尚未启动调度的CPU视同空闲
+ */
+STATIC INLINE INT32 HPFRunTaskCompare(UINT16 cpu1, UINT16 cpu2)
+{
+    SchedRunqueue *rq1 = OsSchedRunqueueByID(cpu1);
+    SchedRunqueue *rq2 = OsSchedRunqueueByID(cpu2);
+    BOOL idle1 = (rq1->runTask == NULL) || (rq1->runTask == rq1->idleTask);
+    BOOL idle2 = (rq2->runTask == NULL) || (rq2->runTask == rq2->idleTask);
+
+    if (idle1 || idle2) {
+        return (INT32)idle1 - (INT32)idle2;
+    }
+    return OsSchedParamCompare(rq1->runTask, rq2->runTask);
+}
+#endif
+
+/**
+ * @brief 为入队任务选择目标CPU的就绪队列
+ * @param taskCB 任务控制块指针
+ * @return 目标CPU编号
+ * @details 正在运行的任务与直接切换唤醒的任务放回当前CPU；其他任务放到亲和性范围内运行任务优先级最低
+ *          的CPU（空闲CPU优先），由HPFRunqueuePreemptNotify向该CPU发送调度IPI。优先级相同时优先当前CPU
+ *          （唤醒者与被唤醒者通常共享缓存），其次是就绪任务最少的CPU
+ */
+STATIC INLINE UINT16 HPFRunqueueSelect(const LosTaskCB *taskCB)
+{
+#ifdef LOSCFG_KERNEL_SMP
+    UINT16 cpuid = ArchCurrCpuid();  // 当前CPU
+    UINT16 target = LOSCFG_KERNEL_CORE_NUM;  // 运行任务优先级最低的CPU
+    BOOL local = ((taskCB->cpuAffiMask & CPUID_TO_AFFI_MASK(cpuid)) != 0);  // 当前CPU在亲和性范围内
+
+    if (local && ((taskCB->taskStatus & OS_TASK_STATUS_RUNNING) || (OsSchedRunqueue()->handoffTask == taskCB))) {
+        return cpuid;
+    }
+
+    if (local) {
+        target = cpuid;
+    }
+    for (UINT16 index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {  // 遍历亲和性范围内的CPU
+        if ((index == cpuid) || !(taskCB->cpuAffiMask & CPUID_TO_AFFI_MASK(index))) {
+            continue;
+        }
+        if (target == LOSCFG_KERNEL_CORE_NUM) {
+            target = index;
+            continue;
+        }
+        INT32 cmp = HPFRunTaskCompare(index, target);
+        if ((cmp > 0) || ((cmp == 0) && (target != cpuid) &&
+                          (g_schedHPF[index].readyTasks < g_schedHPF[target].readyTasks))) {
+            target = index;
+        }
+    }
+    return (target == LOSCFG_KERNEL_CORE_NUM) ? cpuid : target;
+#else
+    (VOID)taskCB;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 任务进入其他CPU的就绪队列后，仅在其能抢占该CPU当前任务时向该CPU发送调度IPI
+ * @param cpuid 任务所在就绪队列的CPU
+ * @param taskCB 任务控制块指针
+ * @details 当前CPU由调用者随后的LOS_Schedule处理；尚未启动调度的CPU启动时自然会选到该任务
+ */
+STATIC INLINE VOID HPFRunqueuePreemptNotify(UINT16 cpuid, const LosTaskCB *taskCB)
+{
+#ifdef LOSCFG_KERNEL_SMP
+    SchedRunqueue *rq = OsSchedRunqueueByID(cpuid);
+
+    if ((cpuid == ArchCurrCpuid()) || (rq->runTask == NULL)) {
+        return;
+    }
+    if (OsSchedParamCompare(rq->runTask, taskCB) > 0) {  // 被唤醒任务优先级更高，或目标CPU空闲
+        LOS_MpSchedule(CPUID_TO_AFFI_MASK(cpuid));
+    }
+#else
+    (VOID)cpuid;
+    (VOID)taskCB;
+#endif
+}
+
 /**
  * @brief HPF调度策略任务入队
  * @param rq 运行队列指针
@@ -314,12 +403,18 @@ STATIC INLINE VOID PriQueInsert(HPFRunqueue *rq, LosTaskCB *taskCB)
  */
 STATIC VOID HPFEnqueue(SchedRunqueue *rq, LosTaskCB *taskCB)
 {
+    SchedHPF *sched = (SchedHPF *)&taskCB->sp;  // 获取HPF调度参数
+
+    (VOID)rq;
 #ifdef LOSCFG_SCHED_HPF_DEBUG
     if (!(taskCB->taskStatus & OS_TASK_STATUS_RUNNING)) {  // 如果任务未运行
         taskCB->startTime = OsGetCurrSchedTimeCycle();  // 设置开始时间为当前调度时间
     }
 #endif
-    PriQueInsert(rq->hpfRunqueue, taskCB);  // 插入到优先级队列
+    sched->cpuid = HPFRunqueueSelect(taskCB);  // 选择目标CPU的就绪队列
+    PriQueInsert(&g_schedHPF[sched->cpuid], taskCB);  // 插入到优先级队列
+
+    HPFRunqueuePreemptNotify(sched->cpuid, taskCB);  // 需要抢占时只通知目标CPU
 }
 
 /**
@@ -333,7 +428,9 @@ STATIC VOID HPFDequeue(SchedRunqueue *rq, LosTaskCB *taskCB)
     SchedHPF *sched = (SchedHPF *)&taskCB->sp;  // 获取HPF调度参数
 
     if (taskCB->taskStatus & OS_TASK_STATUS_READY) {  // 如果任务处于就绪状态
-        PriQueDelete(rq->hpfRunqueue, sched->basePrio, &taskCB->pendList, sched->priority);  // 从队列中删除
+        (VOID)rq;
+        /* 任务可能位于其他CPU的就绪队列上，以入队时记录的CPU为准 */
+        PriQueDelete(&g_schedHPF[sched->cpuid], sched->basePrio, &taskCB->pendList, sched->priority);  // 从队列中删除
         taskCB->taskStatus &= ~OS_TASK_STATUS_READY;  // 更新成非就绪状态
     }
 }
@@ -723,25 +820,117 @@ VOID HPFProcessDefaultSchedParamGet(SchedParam *param)
     param->basePrio = OS_USER_PROCESS_PRIORITY_HIGHEST;  // 设置默认基础优先级为用户进程最高优先级
 }
 
+#ifdef LOSCFG_KERNEL_SMP
+/**
+ * @brief 将就绪任务从一个CPU的HPF队列迁移到另一个CPU的HPF队列
+ * @param src 源HPF运行队列
+ * @param dst 目标HPF运行队列
+ * @param taskCB 被迁移的就绪任务
+ * @param cpuid 目标CPU编号
+ * @details 迁移保留任务剩余时间片，插入目标队列同优先级的尾部
+ */
+STATIC INLINE VOID HPFTaskMigrate(HPFRunqueue *src, HPFRunqueue *dst, LosTaskCB *taskCB, UINT16 cpuid)
+{
+    SchedHPF *sched = (SchedHPF *)&taskCB->sp;  // 获取HPF调度参数
+
+    PriQueDelete(src, sched->basePrio, &taskCB->pendList, sched->priority);  // 从源队列摘除
+    sched->cpuid = cpuid;  // 更新任务所在队列
+    PriQueTailInsert(dst, sched->basePrio, &taskCB->pendList, sched->priority);  // 挂入目标队列
+}
+
+/**
+ * @brief 查找就绪任务最多的其他CPU
+ * @param cpuid 当前CPU编号
+ * @return 最繁忙CPU的编号，找不到时返回OS_TASK_INVALID_CPUID
+ */
+STATIC UINT16 HPFBusiestRunqueueFind(UINT16 cpuid)
+{
+    UINT16 busiest = OS_TASK_INVALID_CPUID;  // 最繁忙的CPU
+    UINT32 maxReady = 0;  // 最多就绪任务数
+
+    for (UINT16 index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {  // 遍历其他CPU
+        if ((index == cpuid) || (g_schedHPF[index].readyTasks <= maxReady)) {
+            continue;
+        }
+        maxReady = g_schedHPF[index].readyTasks;
+        busiest = index;
+    }
+    return busiest;
+}
+
+/**
+ * @brief HPF负载均衡：从最繁忙的CPU窃取就绪任务到当前CPU
+ * @param rq 当前CPU的调度运行队列
+ * @param idle TRUE表示当前CPU即将空闲（只需窃取一个任务），FALSE表示周期性均衡
+ * @return 迁移到当前CPU的任务数量
+ * @details 调用者必须持有调度锁。按优先级从高到低扫描源队列，仅迁移亲和性掩码允许在当前CPU上运行的任务。
+ *          周期性均衡仅在两队列就绪任务数相差超过1时迁移差值的一半
+ */
+UINT32 HPFLoadBalance(SchedRunqueue *rq, BOOL idle)
+{
+    UINT16 cpuid = ArchCurrCpuid();  // 当前CPU
+    HPFRunqueue *dst = rq->hpfRunqueue;  // 目标(本地)队列
+    UINT32 moved = 0;  // 已迁移任务数
+    UINT32 nrMove;  // 计划迁移任务数
+
+    UINT16 busiest = HPFBusiestRunqueueFind(cpuid);
+    if (busiest == OS_TASK_INVALID_CPUID) {  // 其他CPU都没有就绪任务
+        return 0;
+    }
+
+    HPFRunqueue *src = &g_schedHPF[busiest];  // 源队列
+    if (idle) {
+        nrMove = (src->readyTasks > 0) ? 1 : 0;  // 空闲时只需拿到一个可运行任务
+    } else if (src->readyTasks <= (dst->readyTasks + 1)) {  // 负载已基本均衡
+        nrMove = 0;
+    } else {
+        nrMove = (src->readyTasks - dst->readyTasks) >> 1;  // 迁移差值的一半
+    }
+
+    UINT32 baseBitmap = src->queueBitmap;
+    while (baseBitmap && (moved < nrMove)) {  // 从最高基础优先级开始扫描
+        UINT32 basePrio = CLZ(baseBitmap);
+        HPFQueue *queueList = &src->queueList[basePrio];
+        UINT32 bitmap = queueList->queueBitmap;
+        while (bitmap && (moved < nrMove)) {
+            UINT32 priority = CLZ(bitmap);
+            LosTaskCB *taskCB = NULL;
+            LosTaskCB *next = NULL;
+            LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(taskCB, next, &queueList->priQueList[priority], LosTaskCB, pendList) {
+                if (!(taskCB->cpuAffiMask & CPUID_TO_AFFI_MASK(cpuid))) {  // 不允许在当前CPU上运行
+                    continue;
+                }
+                HPFTaskMigrate(src, dst, taskCB, cpuid);
+                if (++moved >= nrMove) {
+                    break;
+                }
+            }
+            bitmap &= ~(1U << (OS_PRIORITY_QUEUE_NUM - priority - 1));
+        }
+        baseBitmap &= ~(1U << (OS_PRIORITY_QUEUE_NUM - basePrio - 1));
+    }
+
+    return moved;
+}
+#endif
+
 /**
  * @brief HPF调度策略初始化
  * @param rq 运行队列指针
- * @details 初始化HPF调度的运行队列和优先级队列
+ * @param cpuid 运行队列所属CPU编号
+ * @details 初始化该CPU私有的HPF运行队列和优先级队列
  */
-VOID HPFSchedPolicyInit(SchedRunqueue *rq)
+VOID HPFSchedPolicyInit(SchedRunqueue *rq, UINT16 cpuid)
 {
-    if (ArchCurrCpuid() > 0) {  // 如果不是0号CPU
-        rq->hpfRunqueue = &g_schedHPF;  // 共享全局HPF运行队列
-        return;
-    }
+    HPFRunqueue *hpfRq = &g_schedHPF[cpuid];  // 该CPU私有的HPF运行队列
 
     for (UINT16 index = 0; index < OS_PRIORITY_QUEUE_NUM; index++) {  // 遍历所有基础优先级
-        HPFQueue *queueList = &g_schedHPF.queueList[index];  // 获取基础优先级队列
+        HPFQueue *queueList = &hpfRq->queueList[index];  // 获取基础优先级队列
         LOS_DL_LIST *priQue = &queueList->priQueList[0];  // 获取优先级队列列表
         for (UINT16 prio = 0; prio < OS_PRIORITY_QUEUE_NUM; prio++) {  // 遍历所有优先级
             LOS_ListInit(&priQue[prio]);  // 初始化优先级队列
         }
     }
 
-    rq->hpfRunqueue = &g_schedHPF;  // 设置运行队列的HPF运行队列指针
+    rq->hpfRunqueue = hpfRq;  // 设置运行队列的HPF运行队列指针
 }
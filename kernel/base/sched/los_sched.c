@@ -45,6 +45,9 @@
 #include "los_stackinfo_pri.h"
 #endif
 #include "los_mp.h"
+#ifdef LOSCFG_KERNEL_HRTIMER
+#include "los_hrtimer.h"
+#endif
 /**
  * @brief 调度运行队列数组，每个CPU核心对应一个调度运行队列
  */
@@ -63,6 +66,12 @@ STATIC INLINE VOID SchedNextExpireTimeSet(UINT32 responseID, UINT64 taskEndTime,
     BOOL isTimeSlice = FALSE;  // 是否为时间片到期标志
     UINT64 currTime = OsGetCurrSchedTimeCycle();  // 获取当前调度时间周期
     UINT64 nextExpireTime = OsGetSortLinkNextExpireTime(&rq->timeoutQueue, currTime, OS_TICK_RESPONSE_PRECISION);  // 获取超时队列中下一个到期时间
+#ifdef LOSCFG_KERNEL_HRTIMER
+    UINT64 hrtimerExpireTime = OsGetSortLinkNextExpireTime(&rq->hrtimerQueue, currTime, OS_TICK_RESPONSE_PRECISION);
+    if (hrtimerExpireTime < nextExpireTime) {  // 高精度定时器先到期，同样按其到期时间设置比较值
+        nextExpireTime = hrtimerExpireTime;
+    }
+#endif
 
     rq->schedFlag &= ~INT_PEND_TICK;  // 清除调度标志中的滴答 pending 位
     if (rq->responseID == oldResponseID) {  // 如果当前响应ID与旧响应ID匹配
@@ -206,6 +215,60 @@ STATIC INLINE BOOL SchedTimeoutQueueScan(SchedRunqueue *rq)
     return needSched;  // 返回是否需要调度
 }
 
+#ifdef LOSCFG_KERNEL_HRTIMER
+/**
+ * @brief 扫描高精度定时器队列
+ * @details 摘下所有已到期的定时器并在释放队列锁后执行回调，回调中可以重新启动定时器
+ * @param rq 调度运行队列指针
+ */
+STATIC INLINE VOID SchedHrtimerQueueScan(SchedRunqueue *rq)
+{
+    SortLinkAttribute *hrtimerQueue = &rq->hrtimerQueue;
+    LOS_DL_LIST *listObject = &hrtimerQueue->sortLink;
+    UINT64 currTime = OsGetCurrSchedTimeCycle();
+
+    LOS_SpinLock(&hrtimerQueue->spinLock);
+    while (!LOS_ListEmpty(listObject)) {
+        SortLinkList *sortList = LOS_DL_LIST_ENTRY(listObject->pstNext, SortLinkList, sortLinkNode);
+        if (sortList->responseTime > currTime) {  // 队列按到期时间排序，首个未到期即可结束
+            break;
+        }
+
+        LosHrtimer *timer = LOS_DL_LIST_ENTRY(sortList, LosHrtimer, sortList);
+        OsDeleteNodeSortLink(hrtimerQueue, sortList);  // 摘下后节点到期时间为无效值，即未启动状态
+        LOS_SpinUnlock(&hrtimerQueue->spinLock);
+
+        timer->handler(timer->arg);  // 执行到期回调
+
+        LOS_SpinLock(&hrtimerQueue->spinLock);
+    }
+    LOS_SpinUnlock(&hrtimerQueue->spinLock);
+}
+#endif
+
+#ifdef LOSCFG_KERNEL_SMP
+/**
+ * @brief 周期性负载均衡
+ * @details 距上次均衡超过OS_SCHED_BALANCE_PERIOD时，从最繁忙的CPU拉取就绪任务，
+ *          拉取成功则标记当前CPU需要重新调度
+ * @param rq 当前CPU的调度运行队列
+ */
+STATIC INLINE VOID SchedLoadBalance(SchedRunqueue *rq)
+{
+    UINT64 currTime = OsGetCurrSchedTimeCycle();  // 当前调度时间
+    if ((currTime - rq->balanceTime) < OS_SCHED_BALANCE_PERIOD) {  // 未到均衡周期
+        return;
+    }
+
+    rq->balanceTime = currTime;  // 记录本次均衡时间
+    LOS_SpinLock(&g_taskSpin);  // 获取任务自旋锁
+    if (HPFLoadBalance(rq, FALSE) > 0) {  // 拉取到了任务
+        rq->schedFlag |= INT_PEND_RESCH;  // 设置重新调度标志
+    }
+    LOS_SpinUnlock(&g_taskSpin);  // 释放任务自旋锁
+}
+#endif
+
 /**
  * @brief 调度滴答处理函数
  * @details 处理调度滴答事件，扫描超时队列并更新调度标志
@@ -214,12 +277,23 @@ VOID OsSchedTick(VOID)
 {
     SchedRunqueue *rq = OsSchedRunqueue();  // 获取当前CPU的调度运行队列
 
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+    rq->timerIrqCount++;  // 统计定时器中断次数
+    if (OsCurrTaskGet() == rq->idleTask) {  // 中断打断的是空闲任务，计为一次空闲唤醒
+        rq->idleWakeupCount++;
+    }
+#endif
+#ifdef LOSCFG_KERNEL_HRTIMER
+    SchedHrtimerQueueScan(rq);  // 时间片到期时也可能有高精度定时器同时到期，每次都扫描
+#endif
     if (rq->responseID == OS_INVALID_VALUE) {  // 如果响应ID无效
-        if (SchedTimeoutQueueScan(rq)) {  // 扫描超时队列，如果有超时任务
-            LOS_MpSchedule(OS_MP_CPU_ALL);  // 多处理器调度所有CPU
+        if (SchedTimeoutQueueScan(rq)) {  // 扫描超时队列，如果有超时任务，其他CPU需要抢占时已在入队时通知
             rq->schedFlag |= INT_PEND_RESCH;  // 设置调度标志为需要重新调度
         }
     }
+#ifdef LOSCFG_KERNEL_SMP
+    SchedLoadBalance(rq);  // 周期性负载均衡
+#endif
     rq->schedFlag |= INT_PEND_TICK;  // 设置调度标志为滴答 pending
     rq->responseTime = OS_SCHED_MAX_RESPONSE_TIME;  // 设置响应时间为最大响应时间
 }
@@ -247,8 +321,12 @@ VOID OsSchedRunqueueInit(VOID)
     for (UINT16 index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {  // 遍历所有CPU核心
         SchedRunqueue *rq = OsSchedRunqueueByID(index);  // 获取指定CPU的调度运行队列
         OsSortLinkInit(&rq->timeoutQueue);  // 初始化超时队列
+#ifdef LOSCFG_KERNEL_HRTIMER
+        OsSortLinkInit(&rq->hrtimerQueue);  // 初始化高精度定时器队列
+#endif
         rq->responseTime = OS_SCHED_MAX_RESPONSE_TIME;  // 设置响应时间为最大响应时间
     }
+    LOCKDEP_CLASS_SET(&g_taskSpin, LOCKDEP_CLASS_TASK, 0);  // g_taskSpin须先于软件定时器时间轮锁获取
 }
 
 /**
@@ -272,7 +350,7 @@ UINT32 OsSchedInit(VOID)
     for (UINT16 cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {  // 遍历所有CPU核心
         SchedRunqueue *rq = OsSchedRunqueueByID(cpuid);  // 获取指定CPU的调度运行队列
         EDFSchedPolicyInit(rq);  // 初始化EDF调度策略
-        HPFSchedPolicyInit(rq);  // 初始化HPF调度策略
+        HPFSchedPolicyInit(rq, cpuid);  // 初始化该CPU私有的HPF调度队列
     }
 
 #ifdef LOSCFG_SCHED_TICK_DEBUG
@@ -378,6 +456,16 @@ STATIC LosTaskCB *TopTaskGet(SchedRunqueue *rq)
         goto FIND;  // 跳转到FIND标签
     }
 
+#ifdef LOSCFG_KERNEL_SMP
+    /* 本地队列为空，即将进入空闲前先尝试从其他CPU窃取任务 */
+    if (HPFLoadBalance(rq, TRUE) > 0) {
+        newTask = HPFRunqueueTopTaskGet(rq->hpfRunqueue);
+        if (newTask != NULL) {
+            goto FIND;
+        }
+    }
+#endif
+
     newTask = rq->idleTask;  // 如果没有就绪任务，使用空闲任务
 
 FIND:
@@ -409,6 +497,7 @@ VOID OsSchedStart(VOID)
      * 注意：需要设置当前CPU，以防第一个任务删除时因该标志与实际当前CPU不匹配而失败
      */
     newTask->currCpu = cpuid;  // 设置任务当前运行的CPU
+    rq->runTask = newTask;  // 记录本CPU正在运行的任务
 #endif
 
     OsCurrTaskSet((VOID *)newTask);  // 设置当前运行任务
@@ -494,6 +583,7 @@ STATIC VOID SchedTaskSwitch(SchedRunqueue *rq, LosTaskCB *runTask, LosTaskCB *ne
     /* 标记新运行任务的所属处理器 */
     runTask->currCpu = OS_TASK_INVALID_CPUID;  // 重置当前任务的CPU ID
     newTask->currCpu = ArchCurrCpuid();  // 设置新任务的CPU ID
+    rq->runTask = newTask;  // 记录本CPU正在运行的任务
 #endif
 
     OsCurrTaskSet((VOID *)newTask);  // 更新当前运行任务
@@ -592,6 +682,53 @@ VOID OsSchedResched(VOID)
     SchedTaskSwitch(rq, runTask, newTask);  // 执行任务切换
 }
 
+/**
+ * @brief 直接切换唤醒：唤醒等待中的任务，使其紧接当前任务在本CPU上运行
+ * @details 用于同步IPC的请求与应答。双方均为HPF策略且本CPU在目标任务亲和性范围内时，
+ *          目标任务放入本CPU就绪队列（不迁移、不发IPI），RR任务还继承当前任务剩余的时间片而排在同优先级队首，
+ *          调用者随后须阻塞或让出CPU，即一次切换到目标任务；高优先级就绪任务仍优先运行。
+ *          不满足条件时退化为普通唤醒。调用者须持有g_taskSpin。
+ * @param runTask 当前运行任务控制块指针
+ * @param taskCB 待唤醒任务控制块指针
+ * @return BOOL 目标任务是否已放入本CPU就绪队列
+ */
+BOOL OsSchedWakeHandoff(LosTaskCB *runTask, LosTaskCB *taskCB)
+{
+    SchedRunqueue *rq = OsSchedRunqueue();  // 获取当前CPU的调度运行队列
+    SchedHPF *runSched = (SchedHPF *)&runTask->sp;
+    SchedHPF *sched = (SchedHPF *)&taskCB->sp;
+
+    LOS_ASSERT(LOS_SpinHeld(&g_taskSpin));  // 断言任务自旋锁已被持有
+    if (OsSchedPolicyIsEDF(runTask) || OsSchedPolicyIsEDF(taskCB) ||
+        (taskCB->taskStatus & OS_TASK_STATUS_SUSPENDED)) {
+        taskCB->ops->wake(taskCB);  // EDF任务使用全局队列，按普通方式唤醒
+        return FALSE;
+    }
+#ifdef LOSCFG_KERNEL_SMP
+    if (!(taskCB->cpuAffiMask & CPUID_TO_AFFI_MASK(ArchCurrCpuid()))) {
+        taskCB->ops->wake(taskCB);  // 不能在本CPU运行，按普通方式唤醒
+        return FALSE;
+    }
+#endif
+
+    if ((runSched->policy == LOS_SCHED_RR) && (sched->policy == LOS_SCHED_RR)) {
+        runTask->ops->timeSliceUpdate(rq, runTask, OsGetCurrSchedTimeCycle());  // 结算当前任务已用的时间片
+        if (runTask->timeSlice > 0) {  // 时间片随调用转交给目标任务，当前任务随后阻塞或让出CPU
+            taskCB->timeSlice = runTask->timeSlice;
+            runTask->timeSlice = 0;
+        }
+    }
+
+#ifdef LOSCFG_KERNEL_SMP
+    rq->handoffTask = taskCB;
+    taskCB->ops->wake(taskCB);
+    rq->handoffTask = NULL;
+#else
+    taskCB->ops->wake(taskCB);
+#endif
+    return TRUE;
+}
+
 /**
  * @brief 触发任务调度
  * @details 检查调度条件，更新当前任务时间片并将其重新加入就绪队列，然后执行重新调度
@@ -416,3 +416,52 @@ UINT32 OsShellShowEdfSchedStatistics(VOID)
 }
 #endif
 #endif
+
+#ifdef LOSCFG_KERNEL_SCHED_STATISTICS
+typedef struct {
+    UINT64 timerIrqCount;      // 上次采样时的定时器中断次数
+    UINT64 idleWakeupCount;    // 上次采样时的空闲唤醒次数
+} SchedWakeupSample;           // 唤醒统计采样结构体
+STATIC SchedWakeupSample g_schedWakeupSample[LOSCFG_KERNEL_CORE_NUM];
+STATIC UINT64 g_schedWakeupSampleTime = 0;  // 上次采样时间(周期数)，0表示从启动开始统计
+
+STATIC UINT64 SchedWakeupPerSecond(UINT64 count, UINT64 periodUs)
+{
+    if (periodUs == 0) {
+        return 0;
+    }
+    return (count * OS_SYS_US_PER_SECOND) / periodUs;
+}
+
+// 显示每个CPU的定时器中断与空闲唤醒频率（两次调用之间的增量），供shell命令调用
+UINT32 OsShellShowSchedWakeup(VOID)
+{
+    UINT32 intSave;
+    UINT16 cpu;
+    SchedWakeupSample curr[LOSCFG_KERNEL_CORE_NUM];
+
+    SCHEDULER_LOCK(intSave);
+    UINT64 currTime = OsGetCurrSchedTimeCycle();
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        SchedRunqueue *rq = OsSchedRunqueueByID(cpu);
+        curr[cpu].timerIrqCount = rq->timerIrqCount;
+        curr[cpu].idleWakeupCount = rq->idleWakeupCount;
+    }
+    SCHEDULER_UNLOCK(intSave);
+
+    // 统计区间：距上次调用（首次调用为系统启动以来）
+    UINT64 periodUs = OS_SYS_CYCLE_TO_US(currTime - g_schedWakeupSampleTime);
+    PRINTK("Period: %llu ms\n", periodUs / OS_SYS_US_PER_MS);
+    PRINTK("cpu     TimerIrq   IdleWakeup  TimerIrq/s  IdleWakeup/s\n");
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        UINT64 irqCount = curr[cpu].timerIrqCount - g_schedWakeupSample[cpu].timerIrqCount;
+        UINT64 idleCount = curr[cpu].idleWakeupCount - g_schedWakeupSample[cpu].idleWakeupCount;
+        PRINTK("%3u%13llu%13llu%12llu%14llu\n", cpu, irqCount, idleCount,
+               SchedWakeupPerSecond(irqCount, periodUs), SchedWakeupPerSecond(idleCount, periodUs));
+    }
+
+    (VOID)memcpy_s(g_schedWakeupSample, sizeof(g_schedWakeupSample), curr, sizeof(curr));
+    g_schedWakeupSampleTime = currTime;
+    return LOS_OK;
+}
+#endif
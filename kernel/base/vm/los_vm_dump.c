@@ -589,6 +589,7 @@ UINT32 OsVmPhySegPagesGet(LosVmPhysSeg *seg)
         segFreePages += ((1 << flindex) * seg->freeList[flindex].listCnt);//1 << flindex等于页数, * 节点数 得到组块的总页数.
     }
     LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+    segFreePages += OsVmPhysPcpPagesGet(seg);//每CPU缓存中的页也是空闲页
 
     return segFreePages;//返回剩余未分配的总物理页框
 }
@@ -618,6 +619,10 @@ VOID OsVmPhysDump(VOID)
     UINT32 intSave;                          // 中断状态保存变量
     UINT32 flindex;                          // 空闲链表索引计数器
     UINT32 listCount[VM_LIST_ORDER_MAX] = {0};  // 各阶空闲块数量数组
+    UINT32 pcpAlloc;                         // 每CPU缓存分配的单页数
+    UINT32 pcpFree;                          // 释放到每CPU缓存的单页数
+    UINT32 cpu;                              // CPU索引
+    struct VmPhysPcp *pcp = NULL;            // 每CPU缓存指针
 
     // 遍历所有物理内存段（数组实现）
     for (segIndex = 0; segIndex < g_vmPhysSegNum; segIndex++) {  // 循环取段
@@ -641,9 +646,22 @@ VOID OsVmPhysDump(VOID)
             }
             LOS_SpinUnlockRestore(&seg->freeListLock, intSave);  // 释放自旋锁
 
-            // 打印伙伴系统各阶空闲块分布
+            // 打印每CPU单页缓存状态：缓存页数、命中次数、补充及归还批次
+            pcpAlloc = 0;
+            pcpFree = 0;
+            for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+                pcp = &seg->pcp[cpu];
+                PRINTK("cpu%u pcp: count = %u, alloc = %u, free = %u, refill = %u, drain = %u\n",
+                       cpu, pcp->count, pcp->allocCnt, pcp->freeCnt, pcp->refillCnt, pcp->drainCnt);
+                pcpAlloc += pcp->allocCnt;
+                pcpFree += pcp->freeCnt;
+            }
+
+            // 打印伙伴系统各阶空闲块分布及分配/释放次数,0阶包含经每CPU缓存的单页
             for (flindex = 0; flindex < VM_LIST_ORDER_MAX; flindex++) {
-                PRINTK("order = %d, free_count = %d\n", flindex, listCount[flindex]);
+                PRINTK("order = %d, free_count = %d, alloc = %u, free = %u\n", flindex, listCount[flindex],
+                       seg->allocCnt[flindex] + ((flindex == 0) ? pcpAlloc : 0),
+                       seg->freeCnt[flindex] + ((flindex == 0) ? pcpFree : 0));
             }
 
             // 打印LRU（最近最少使用）页面状态统计
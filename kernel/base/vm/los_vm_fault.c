@@ -190,6 +190,7 @@ STATIC STATUS_T OsDoReadFault(LosVmMapRegion *region, LosVmPgFault *vmPgFault)
             return LOS_ERRNO_VM_NO_MEMORY;
         }
 
+        OsVmmFileReadAround(region, vmPgFault); // 自适应预读并映射后续已缓存页
         (VOID)LOS_MuxRelease(&region->unTypeData.rf.vnode->mapping.mux_lock);
         return LOS_OK;
     }
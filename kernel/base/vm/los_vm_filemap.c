@@ -41,6 +41,8 @@
 #include "los_vm_fault.h"
 #include "los_process_pri.h"
 #include "los_vm_lock.h"
+#include "los_slab.h"
+#include "los_init.h"
 #ifdef LOSCFG_FS_VFS
 #include "vnode.h"
 #endif
@@ -52,51 +54,305 @@
 #ifdef LOSCFG_DEBUG_VERSION
 static int g_totalPageCacheTry = 0;    // 页面缓存尝试次数统计
 static int g_totalPageCacheHit = 0;    // 页面缓存命中次数统计
+static PageCacheRaInfo g_pageCacheRaInfo = {0}; // 预读统计
 #define TRACE_TRY_CACHE() do { g_totalPageCacheTry++; } while (0)  // 增加缓存尝试计数
 #define TRACE_HIT_CACHE() do { g_totalPageCacheHit++; } while (0)  // 增加缓存命中计数
+#define TRACE_READ_AHEAD(nr) do { g_pageCacheRaInfo.readAheadPages += (int)(nr); } while (0) // 增加预读页数
+#define TRACE_READ_AHEAD_HIT() do { g_pageCacheRaInfo.readAheadHit++; } while (0) // 增加预读命中次数
+#define TRACE_FAULT_AROUND(nr) do { g_pageCacheRaInfo.faultAroundPages += (int)(nr); } while (0) // 增加周边映射页数
+#define TRACE_RA_WINDOW(window) do {                                  \
+    if ((int)(window) > g_pageCacheRaInfo.maxWindow) {                \
+        g_pageCacheRaInfo.maxWindow = (int)(window);                  \
+    }                                                                 \
+} while (0)                                                           // 记录最大预读窗口
 
 /**
  * @brief  重置页面缓存命中统计信息
  * @param  try [out] 输出之前的尝试次数
  * @param  hit [out] 输出之前的命中次数
+ * @param  ra [out] 输出之前的预读统计，可为NULL
  * @return 无
  */
-VOID ResetPageCacheHitInfo(int *try, int *hit)
+VOID ResetPageCacheHitInfo(int *try, int *hit, PageCacheRaInfo *ra)
 {
     *try = g_totalPageCacheTry;        // 保存尝试次数
     *hit = g_totalPageCacheHit;        // 保存命中次数
+    if (ra != NULL) {
+        *ra = g_pageCacheRaInfo;       // 保存预读统计
+    }
     g_totalPageCacheHit = 0;           // 重置命中次数
     g_totalPageCacheTry = 0;           // 重置尝试次数
+    (VOID)memset_s(&g_pageCacheRaInfo, sizeof(g_pageCacheRaInfo), 0, sizeof(g_pageCacheRaInfo)); // 重置预读统计
 }
 #else
 #define TRACE_TRY_CACHE()              // 调试版本未启用时为空宏
 #define TRACE_HIT_CACHE()              // 调试版本未启用时为空宏
+#define TRACE_READ_AHEAD(nr)           // 调试版本未启用时为空宏
+#define TRACE_READ_AHEAD_HIT()         // 调试版本未启用时为空宏
+#define TRACE_FAULT_AROUND(nr)         // 调试版本未启用时为空宏
+#define TRACE_RA_WINDOW(window)        // 调试版本未启用时为空宏
 #endif
 #ifdef LOSCFG_KERNEL_VM
 
+STATIC LosSlabCache *g_filePageCache = NULL; // LosFilePage对象缓存，页缓存增删时频繁分配释放
+
+/**
+ * @brief  创建LosFilePage对象缓存
+ * @return 成功返回LOS_OK，失败返回LOS_NOK
+ */
+STATIC UINT32 OsFilePageCacheInit(VOID)
+{
+    g_filePageCache = LOS_SlabCacheCreate("file_page", sizeof(LosFilePage), NULL);
+    return (g_filePageCache != NULL) ? LOS_OK : LOS_NOK;
+}
+
+LOS_MODULE_INIT(OsFilePageCacheInit, LOS_INIT_LEVEL_VM_COMPLETE);
+
+/**************************************************************************************************
+ 页缓存基数树：每层取pgoff的VM_PAGE_INDEX_BITS位作为槽位号，树高随最大pgoff增长，
+ 查找与插入只需O(树高)次访问，与文件已缓存的页数无关。所有操作均在mapping->list_lock内进行
+**************************************************************************************************/
+/**
+ * @brief  获取page_mapping对应的页缓存索引根
+ * @param  mapping [in] 文件映射结构，页缓存只建立在vnode内嵌的page_mapping上
+ * @return 索引根指针的地址
+ */
+STATIC INLINE VmPageIndexNode **OsPageIndexRoot(struct page_mapping *mapping)
+{
+    return &(LOS_DL_LIST_ENTRY(mapping, struct Vnode, mapping)->pageIndex);
+}
+
+/**
+ * @brief  计算以shift为根节点位偏移的索引树能容纳的最大pgoff
+ * @param  shift [in] 根节点位偏移
+ * @return 最大pgoff
+ */
+STATIC INLINE VM_OFFSET_T OsPageIndexMaxGet(UINT8 shift)
+{
+    if ((shift + VM_PAGE_INDEX_BITS) >= (sizeof(VM_OFFSET_T) * 8)) { /* 8: bits per byte */
+        return (VM_OFFSET_T)-1;
+    }
+    return ((VM_OFFSET_T)1 << (shift + VM_PAGE_INDEX_BITS)) - 1;
+}
+
+/**
+ * @brief  分配并初始化一个索引节点
+ * @param  parent [in] 父节点
+ * @param  shift [in] 节点位偏移
+ * @param  offset [in] 在父节点中的槽位号
+ * @return 成功返回节点，内存不足返回NULL
+ */
+STATIC VmPageIndexNode *OsPageIndexNodeAlloc(VmPageIndexNode *parent, UINT8 shift, UINT8 offset)
+{
+    VmPageIndexNode *node = (VmPageIndexNode *)LOS_MemAlloc(m_aucSysMem0, sizeof(VmPageIndexNode));
+    if (node == NULL) {
+        return NULL;
+    }
+    (VOID)memset_s(node, sizeof(VmPageIndexNode), 0, sizeof(VmPageIndexNode));
+    node->parent = parent;
+    node->shift = shift;
+    node->offset = offset;
+    return node;
+}
+
+/**
+ * @brief  自下而上回收空的索引节点
+ * @param  root [in/out] 索引根
+ * @param  node [in] 起始节点
+ */
+STATIC VOID OsPageIndexPrune(VmPageIndexNode **root, VmPageIndexNode *node)
+{
+    VmPageIndexNode *parent = NULL;
+
+    while ((node != NULL) && (node->count == 0)) {
+        parent = node->parent;
+        if (parent != NULL) {
+            parent->slots[node->offset] = NULL;
+            parent->count--;
+        } else {
+            *root = NULL;
+        }
+        LOS_MemFree(m_aucSysMem0, node);
+        node = parent;
+    }
+}
+
+/**
+ * @brief  在索引中查找文件页
+ * @param  root [in] 索引根
+ * @param  pgoff [in] 页面偏移量
+ * @return 找到返回文件页，否则返回NULL
+ */
+STATIC LosFilePage *OsPageIndexLookup(const VmPageIndexNode *root, VM_OFFSET_T pgoff)
+{
+    const VmPageIndexNode *node = root;
+
+    if ((node == NULL) || (pgoff > OsPageIndexMaxGet(node->shift))) {
+        return NULL;
+    }
+    while (node->shift != 0) {
+        node = (const VmPageIndexNode *)node->slots[(pgoff >> node->shift) & VM_PAGE_INDEX_MASK];
+        if (node == NULL) {
+            return NULL;
+        }
+    }
+    return (LosFilePage *)node->slots[pgoff & VM_PAGE_INDEX_MASK];
+}
+
+/**
+ * @brief  查找pgoff不小于指定值的第一个文件页
+ * @param  root [in] 索引根
+ * @param  pgoff [in] 起始页面偏移量
+ * @return 找到返回文件页，否则返回NULL
+ * @note   用于在有序的page_list中定位插入位置
+ */
+STATIC LosFilePage *OsPageIndexNextGet(VmPageIndexNode *root, VM_OFFSET_T pgoff)
+{
+    VmPageIndexNode *node = root;
+    BOOL onPath = TRUE;                // 是否仍沿着pgoff自身的路径下降
+    UINT32 off;
+
+    if ((node == NULL) || (pgoff > OsPageIndexMaxGet(node->shift))) {
+        return NULL;
+    }
+
+    off = (pgoff >> node->shift) & VM_PAGE_INDEX_MASK;
+    while (TRUE) {
+        if ((off < VM_PAGE_INDEX_SLOTS) && (node->slots[off] == NULL)) {
+            off++;                     // 跳过空槽位，之后的子树都从最小pgoff开始找
+            onPath = FALSE;
+            continue;
+        }
+        if (off == VM_PAGE_INDEX_SLOTS) { // 本节点已找完，回到父节点的下一个槽位
+            if (node->parent == NULL) {
+                return NULL;
+            }
+            off = node->offset + 1U;
+            node = node->parent;
+            onPath = FALSE;
+            continue;
+        }
+        if (node->shift == 0) {
+            return (LosFilePage *)node->slots[off];
+        }
+        node = (VmPageIndexNode *)node->slots[off];
+        off = onPath ? ((pgoff >> node->shift) & VM_PAGE_INDEX_MASK) : 0;
+    }
+}
+
+/**
+ * @brief  将文件页插入索引
+ * @param  root [in/out] 索引根
+ * @param  page [in] 文件页
+ * @param  pgoff [in] 页面偏移量
+ * @return 成功返回LOS_OK，节点内存不足返回LOS_ENOMEM且索引保持不变
+ */
+STATIC STATUS_T OsPageIndexInsert(VmPageIndexNode **root, LosFilePage *page, VM_OFFSET_T pgoff)
+{
+    VmPageIndexNode *node = *root;
+    VmPageIndexNode *child = NULL;
+    UINT32 off;
+    UINT8 shift = 0;
+
+    if (node == NULL) {                // 空树：建立恰好能容纳pgoff的根节点
+        while (pgoff > OsPageIndexMaxGet(shift)) {
+            shift += VM_PAGE_INDEX_BITS;
+        }
+        node = OsPageIndexNodeAlloc(NULL, shift, 0);
+        if (node == NULL) {
+            return LOS_ENOMEM;
+        }
+        *root = node;
+    }
+
+    while (pgoff > OsPageIndexMaxGet(node->shift)) { // 树高不足：在原根之上增加一层
+        child = OsPageIndexNodeAlloc(NULL, node->shift + VM_PAGE_INDEX_BITS, 0);
+        if (child == NULL) {
+            return LOS_ENOMEM;
+        }
+        child->slots[0] = node;
+        child->count = 1;
+        node->parent = child;
+        node = child;
+        *root = node;
+    }
+
+    while (node->shift != 0) {
+        off = (pgoff >> node->shift) & VM_PAGE_INDEX_MASK;
+        child = (VmPageIndexNode *)node->slots[off];
+        if (child == NULL) {
+            child = OsPageIndexNodeAlloc(node, node->shift - VM_PAGE_INDEX_BITS, (UINT8)off);
+            if (child == NULL) {
+                OsPageIndexPrune(root, node); // 回收本次新建但仍为空的节点
+                return LOS_ENOMEM;
+            }
+            node->slots[off] = child;
+            node->count++;
+        }
+        node = child;
+    }
+
+    off = pgoff & VM_PAGE_INDEX_MASK;
+    LOS_ASSERT(node->slots[off] == NULL);
+    node->slots[off] = page;
+    node->count++;
+    return LOS_OK;
+}
+
+/**
+ * @brief  将文件页从索引中删除
+ * @param  root [in/out] 索引根
+ * @param  page [in] 文件页
+ */
+STATIC VOID OsPageIndexDelete(VmPageIndexNode **root, const LosFilePage *page)
+{
+    VmPageIndexNode *node = *root;
+    UINT32 off;
+
+    if ((node == NULL) || (page->pgoff > OsPageIndexMaxGet(node->shift))) {
+        return;
+    }
+    while (node->shift != 0) {
+        node = (VmPageIndexNode *)node->slots[(page->pgoff >> node->shift) & VM_PAGE_INDEX_MASK];
+        if (node == NULL) {
+            return;
+        }
+    }
+
+    off = page->pgoff & VM_PAGE_INDEX_MASK;
+    if (node->slots[off] != page) {    // 页面未被索引（插入前即被释放）
+        return;
+    }
+    node->slots[off] = NULL;
+    node->count--;
+    OsPageIndexPrune(root, node);
+}
 
 /**
  * @brief  将文件页添加到页面缓存链表
  * @param  page [in] 要添加的文件页
  * @param  mapping [in] 文件映射结构
  * @param  pgoff [in] 页面偏移量
- * @return 无
+ * @return 成功返回LOS_OK，索引节点内存不足返回LOS_ENOMEM
  */
-STATIC VOID OsPageCacheAdd(LosFilePage *page, struct page_mapping *mapping, VM_OFFSET_T pgoff)
+STATIC STATUS_T OsPageCacheAdd(LosFilePage *page, struct page_mapping *mapping, VM_OFFSET_T pgoff)
 {
-    LosFilePage *fpage = NULL;         // 遍历用的文件页指针
+    VmPageIndexNode **root = OsPageIndexRoot(mapping);
+    LosFilePage *next = NULL;          // pgoff之后的第一个文件页
 
-    LOS_DL_LIST_FOR_EACH_ENTRY(fpage, &mapping->page_list, LosFilePage, node) {// 遍历page_list链表
-        if (fpage->pgoff > pgoff) {    // 找到第一个pgoff大于当前页的节点
-            LOS_ListTailInsert(&fpage->node, &page->node); // 插入到该节点前面
-            goto done_add;             // 跳转至添加完成处理
-        }
+    if (OsPageIndexInsert(root, page, pgoff) != LOS_OK) {
+        return LOS_ENOMEM;
     }
 
-    LOS_ListTailInsert(&mapping->page_list, &page->node); // 未找到更大pgoff的节点，添加到链表末尾
+    next = OsPageIndexNextGet(*root, pgoff + 1);
+    if (next != NULL) {
+        LOS_ListTailInsert(&next->node, &page->node); // 插入到该节点前面，保持page_list按pgoff有序
+    } else {
+        LOS_ListTailInsert(&mapping->page_list, &page->node); // 没有更大pgoff的节点，添加到链表末尾
+    }
 
-done_add:
     mapping->nrpages++;                // 文件在缓存中的页面计数加1
+    return LOS_OK;
 }
 
 /**
@@ -104,12 +360,15 @@ done_add:
  * @param  page [in] 要添加的文件页
  * @param  mapping [in] 文件映射结构
  * @param  pgoff [in] 页面偏移量
- * @return 无
+ * @return 成功返回LOS_OK，内存不足返回LOS_ENOMEM，此时页面未加入任何链表
  */
-VOID OsAddToPageacheLru(LosFilePage *page, struct page_mapping *mapping, VM_OFFSET_T pgoff)
+STATUS_T OsAddToPageacheLru(LosFilePage *page, struct page_mapping *mapping, VM_OFFSET_T pgoff)
 {
-    OsPageCacheAdd(page, mapping, pgoff);                  // 添加到页面缓存
+    if (OsPageCacheAdd(page, mapping, pgoff) != LOS_OK) {  // 添加到页面缓存
+        return LOS_ENOMEM;
+    }
     OsLruCacheAdd(page, VM_LRU_ACTIVE_FILE);               // 添加到活跃文件LRU链表
+    return LOS_OK;
 }
 
 /**
@@ -120,6 +379,8 @@ VOID OsAddToPageacheLru(LosFilePage *page, struct page_mapping *mapping, VM_OFFS
 VOID OsPageCacheDel(LosFilePage *fpage)
 {
     /* delete from file cache list */
+    OsPageIndexDelete(OsPageIndexRoot(fpage->mapping), fpage); // 从索引中删除
+    LOS_BitmapClr(&fpage->vmPage->flags, FILE_PAGE_READAHEAD); // 物理页将被复用，清除预读标记
     LOS_ListDelete(&fpage->node);      // 将文件页从链表中摘除
     fpage->mapping->nrpages--;         // 文件在缓存中的页面计数减1
 
@@ -129,7 +390,7 @@ VOID OsPageCacheDel(LosFilePage *fpage)
     }
 
     LOS_PhysPageFree(fpage->vmPage);   // 释放物理内存
-    LOS_MemFree(m_aucSysMem0, fpage);  // 释放文件页结构体内存
+    LOS_SlabFree(g_filePageCache, fpage); // 释放文件页结构体内存
 }
 
 /**************************************************************************************************
@@ -385,7 +646,7 @@ LosFilePage *OsDumpDirtyPage(LosFilePage *oldFPage)
 {
     LosFilePage *newFPage = NULL;      // 新文件页指针
 
-    newFPage = (LosFilePage *)LOS_MemAlloc(m_aucSysMem0, sizeof(LosFilePage)); // 分配内存
+    newFPage = (LosFilePage *)LOS_SlabAlloc(g_filePageCache); // 分配内存
     if (newFPage == NULL) {
         VM_ERR("Failed to allocate for temp page!"); // 分配失败
         return NULL;
@@ -409,7 +670,19 @@ VOID OsDoFlushDirtyPage(LosFilePage *fpage)
         return;                        // 参数检查
     }
     (VOID)OsFlushDirtyPage(fpage);     // 刷新脏页
-    LOS_MemFree(m_aucSysMem0, fpage);  // 释放文件页内存
+    LOS_SlabFree(g_filePageCache, fpage); // 释放文件页内存
+}
+
+/**
+ * @brief  释放尚未加入页面缓存的文件页
+ * @param  fpage [in] 文件页，调用者已锁定其物理页
+ * @return 无
+ */
+STATIC VOID OsPageCacheFree(LosFilePage *fpage)
+{
+    OsCleanPageLocked(fpage->vmPage);  // 清除页面锁定
+    LOS_PhysPageFree(fpage->vmPage);   // 释放物理页
+    LOS_SlabFree(g_filePageCache, fpage); // 释放文件页结构体
 }
 
 /**
@@ -503,6 +776,10 @@ INT32 OsVmmFileFault(LosVmMapRegion *region, LosVmPgFault *vmf)
     TRACE_TRY_CACHE();                 // 增加缓存尝试计数
     if (fpage != NULL) {               // 找到缓存页
         TRACE_HIT_CACHE();             // 增加缓存命中计数
+        if (BIT_GET(fpage->vmPage->flags, FILE_PAGE_READAHEAD)) { // 预读页首次被访问
+            LOS_BitmapClr(&fpage->vmPage->flags, FILE_PAGE_READAHEAD);
+            TRACE_READ_AHEAD_HIT();
+        }
         OsPageRefIncLocked(fpage);     // 增加引用计数
     } else {                           // 未找到缓存页
         fpage = OsPageCacheAlloc(mapping, vmf->pgoff); // 分配新缓存页
@@ -526,7 +803,12 @@ INT32 OsVmmFileFault(LosVmMapRegion *region, LosVmPgFault *vmf)
             return LOS_NOK;
         }
         LOS_SpinLockSave(&mapping->list_lock, &intSave); // 获取锁
-        OsAddToPageacheLru(fpage, mapping, vmf->pgoff); // 添加到缓存和LRU
+        if (OsAddToPageacheLru(fpage, mapping, vmf->pgoff) != LOS_OK) { // 添加到缓存和LRU
+            LOS_SpinUnlockRestore(&mapping->list_lock, intSave); // 释放锁
+            VM_ERR("Failed to index page cache!"); // 索引节点分配失败，页面未进入缓存
+            OsPageCacheFree(fpage);    // 释放文件页
+            return LOS_NOK;
+        }
         LOS_SpinUnlockRestore(&mapping->list_lock, intSave); // 释放锁
     }
 
@@ -550,6 +832,160 @@ INT32 OsVmmFileFault(LosVmMapRegion *region, LosVmPgFault *vmf)
     return LOS_OK;
 }
 
+/**
+ * @brief  将[start, end)内尚未缓存的文件页预读进页面缓存
+ * @param  vnode [in] 文件vnode
+ * @param  start [in] 起始页偏移
+ * @param  end [in] 结束页偏移(不含)
+ * @return 实际读入的页数
+ * @note   调用者持有mapping->mux_lock，与其他缺页互斥。vnode只提供单页读接口，
+ *         这里在一次缺页内连续读取，由文件系统与块缓存合并底层访问。读到文件尾或出错即停止
+ */
+STATIC UINT32 OsVmmFileReadAhead(struct Vnode *vnode, VM_OFFSET_T start, VM_OFFSET_T end)
+{
+    struct page_mapping *mapping = &vnode->mapping;
+    LosFilePage *fpage = NULL;
+    UINT32 intSave;
+    UINT32 nr = 0;
+    INT32 ret;
+
+    for (VM_OFFSET_T pgoff = start; pgoff < end; pgoff++) {
+        LOS_SpinLockSave(&mapping->list_lock, &intSave);
+        fpage = OsFindGetEntry(mapping, pgoff);
+        LOS_SpinUnlockRestore(&mapping->list_lock, intSave);
+        if (fpage != NULL) {           // 已在缓存中
+            continue;
+        }
+
+        fpage = OsPageCacheAlloc(mapping, pgoff);
+        if (fpage == NULL) {
+            break;
+        }
+        OsSetPageLocked(fpage->vmPage);
+        ret = vnode->vop->ReadPage(vnode, OsVmPageToVaddr(fpage->vmPage), pgoff << PAGE_SHIFT);
+        if (ret <= 0) {                // 文件尾或读失败
+            OsPageCacheFree(fpage);
+            break;
+        }
+
+        LOS_SpinLockSave(&mapping->list_lock, &intSave);
+        if (OsAddToPageacheLru(fpage, mapping, pgoff) != LOS_OK) {
+            LOS_SpinUnlockRestore(&mapping->list_lock, intSave);
+            OsPageCacheFree(fpage);
+            break;
+        }
+        LOS_BitmapSet(&fpage->vmPage->flags, FILE_PAGE_READAHEAD); // 标记为预读页，用于命中统计
+        OsCleanPageLocked(fpage->vmPage);
+        LOS_SpinUnlockRestore(&mapping->list_lock, intSave);
+        nr++;
+    }
+
+    TRACE_READ_AHEAD(nr);
+    return nr;
+}
+
+/**
+ * @brief  缺页周边映射：把缺页地址之后连续的、已在页面缓存中的页一并映射
+ * @param  region [in] 文件映射区域
+ * @param  vmf [in] 已处理完毕的读缺页
+ * @param  end [in] 最多映射到该页偏移(不含)
+ * @return 额外映射的页数
+ * @note   遇到未缓存或已映射的页即停止，保证映射范围连续。与读缺页一样以只读方式映射，
+ *         写访问仍会触发写时复制或共享写缺页
+ */
+STATIC UINT32 OsVmmFileMapAround(LosVmMapRegion *region, const LosVmPgFault *vmf, VM_OFFSET_T end)
+{
+    struct page_mapping *mapping = &region->unTypeData.rf.vnode->mapping;
+    LosArchMmu *archMmu = &region->space->archMmu;
+    LosFilePage *fpage = NULL;
+    LosVmPage *vmPage = NULL;
+    VADDR_T vaddr;
+    UINT32 intSave;
+    UINT32 nr = 0;
+    STATUS_T ret;
+
+    for (VM_OFFSET_T pgoff = vmf->pgoff + 1; pgoff < end; pgoff++) {
+        vaddr = vmf->vaddr + ((VADDR_T)(pgoff - vmf->pgoff) << PAGE_SHIFT);
+        if (LOS_ArchMmuQuery(archMmu, vaddr, NULL, NULL) == LOS_OK) { // 已映射
+            break;
+        }
+
+        LOS_SpinLockSave(&mapping->list_lock, &intSave);
+        fpage = OsFindGetEntry(mapping, pgoff);
+        if (fpage == NULL) {
+            LOS_SpinUnlockRestore(&mapping->list_lock, intSave);
+            break;
+        }
+        vmPage = fpage->vmPage;
+        if (BIT_GET(vmPage->flags, FILE_PAGE_READAHEAD)) {
+            LOS_BitmapClr(&vmPage->flags, FILE_PAGE_READAHEAD);
+            TRACE_READ_AHEAD_HIT();
+        }
+        OsPageRefIncLocked(fpage);     // 增加引用计数
+        OsSetPageLocked(vmPage);       // 映射完成前禁止回收
+        OsAddMapInfo(fpage, archMmu, vaddr);
+        fpage->flags = region->regionFlags;
+        LOS_AtomicInc(&vmPage->refCounts);
+        LOS_SpinUnlockRestore(&mapping->list_lock, intSave);
+
+        ret = LOS_ArchMmuMap(archMmu, vaddr, VM_PAGE_TO_PHYS(vmPage), 1,
+                             region->regionFlags & (~VM_MAP_REGION_FLAG_PERM_WRITE));
+        OsCleanPageLocked(vmPage);
+        if (ret < 0) {
+            LosVmPgFault around = { vmf->flags, pgoff, vaddr, NULL };
+            OsDelMapInfo(region, &around, FALSE); // 撤销映射信息与引用计数
+            break;
+        }
+        nr++;
+    }
+
+    TRACE_FAULT_AROUND(nr);
+    return nr;
+}
+
+/**
+ * @brief  读缺页后的自适应预读与周边映射
+ * @param  region [in] 文件映射区域
+ * @param  vmf [in] 已成功映射的读缺页
+ * @return 无
+ * @details 缺页落在上一次映射范围之后紧邻的位置即视为顺序访问，预读窗口从
+ *          VM_READAHEAD_MIN_PAGES开始加倍直至VM_READAHEAD_MAX_PAGES；否则视为随机访问，关闭预读。
+ *          随后把缺页之后连续的已缓存页一并映射，使顺序访问的下一次缺页落在映射范围之后。
+ *          调用者持有mapping->mux_lock
+ */
+VOID OsVmmFileReadAround(LosVmMapRegion *region, const LosVmPgFault *vmf)
+{
+    struct VmRegionFile *rf = &region->unTypeData.rf;
+    VM_OFFSET_T pgoff = vmf->pgoff;
+    VM_OFFSET_T regionEnd = region->pgOff + (region->range.size >> PAGE_SHIFT); // 区域之后第一页的页偏移
+    VM_OFFSET_T end;
+    UINT32 window;
+    UINT32 mapped;
+
+    if ((rf->vnode == NULL) || (rf->vnode->vop == NULL) || (rf->vnode->vop->ReadPage == NULL)) {
+        return;
+    }
+
+    if ((pgoff == rf->raNextPgoff) || (pgoff == (rf->raPrevPgoff + 1))) { // 顺序访问，扩大窗口
+        window = (rf->raWindow == 0) ? VM_READAHEAD_MIN_PAGES : MIN2(rf->raWindow << 1, VM_READAHEAD_MAX_PAGES);
+    } else {                           // 随机访问，关闭预读
+        window = 0;
+    }
+    rf->raWindow = window;
+    rf->raPrevPgoff = pgoff;
+    TRACE_RA_WINDOW(window);
+
+    end = MIN2(pgoff + 1 + window, regionEnd);
+    if (end > (pgoff + 1)) {
+        (VOID)OsVmmFileReadAhead(rf->vnode, pgoff + 1, end);
+    }
+
+    window = (window > VM_FAULT_AROUND_PAGES) ? window : VM_FAULT_AROUND_PAGES; // 周边映射至少覆盖VM_FAULT_AROUND_PAGES页
+    end = MIN2(pgoff + 1 + window, regionEnd);
+    mapped = OsVmmFileMapAround(region, vmf, end);
+    rf->raNextPgoff = pgoff + 1 + mapped;
+}
+
 /**
  * @brief  刷新文件缓存
  * @param  mapping [in] 页面映射结构
@@ -697,19 +1133,7 @@ STATUS_T OsNamedMMap(struct file *filep, LosVmMapRegion *region)
  */
 LosFilePage *OsFindGetEntry(struct page_mapping *mapping, VM_OFFSET_T pgoff)
 {
-    LosFilePage *fpage = NULL;         // 文件页指针
-
-    LOS_DL_LIST_FOR_EACH_ENTRY(fpage, &mapping->page_list, LosFilePage, node) { // 遍历文件页
-        if (fpage->pgoff == pgoff) {   // 找到指定偏移的页
-            return fpage;              // 返回文件页
-        }
-
-        if (fpage->pgoff > pgoff) {    // 找到大于目标偏移的页
-            break;                     // 跳出循环（链表按pgoff排序）
-        }
-    }
-
-    return NULL;                       // 未找到返回NULL
+    return OsPageIndexLookup(*OsPageIndexRoot(mapping), pgoff); // 通过基数树索引查找，调用者持有list_lock
 }
 
 /* need mutex & change memory to dma zone. */
@@ -739,7 +1163,7 @@ LosFilePage *OsPageCacheAlloc(struct page_mapping *mapping, VM_OFFSET_T pgoff)
         return NULL;
     }
 
-    fpage = (LosFilePage *)LOS_MemAlloc(m_aucSysMem0, sizeof(LosFilePage)); // 分配文件页
+    fpage = (LosFilePage *)LOS_SlabAlloc(g_filePageCache); // 分配文件页
     if (fpage == NULL) {
         LOS_PhysPageFree(vmPage);      // 释放物理页
         VM_ERR("Failed to allocate for page!"); // 分配失败
@@ -323,7 +323,8 @@ STATUS_T LOS_VmSpaceClone(UINT32 cloneFlags, LosVmSpace *oldVmSpace, LosVmSpace
     PADDR_T paddr;
     VADDR_T vaddr;
     LosVmPage *page = NULL;
-    UINT32 flags, i, intSave, numPages;
+    UINT32 i, intSave, numPages;
+    INT32 copied;
 
     if ((OsVmSpaceParamCheck(oldVmSpace) == FALSE) || (OsVmSpaceParamCheck(newVmSpace) == FALSE)) {
         return LOS_ERRNO_VM_INVALID_ARGS;
@@ -364,9 +365,11 @@ STATUS_T LOS_VmSpaceClone(UINT32 cloneFlags, LosVmSpace *oldVmSpace, LosVmSpace
         }
 
         numPages = newRegion->range.size >> PAGE_SHIFT;//计算线性区页数
-        for (i = 0; i < numPages; i++) {//一页一页进行重新映射
+        //整段批量复制页表项,老空间可写页就地改为只读,每个线性区只刷新一次TLB
+        copied = LOS_ArchMmuCopy(&oldVmSpace->archMmu, &newVmSpace->archMmu, newRegion->range.base, numPages);
+        for (i = 0; i < numPages; i++) {//逐页补上物理页引用计数和文件页映射信息,复制失败时也要为已复制的页补上
             vaddr = newRegion->range.base + (i << PAGE_SHIFT);
-            if (LOS_ArchMmuQuery(&oldVmSpace->archMmu, vaddr, &paddr, &flags) != LOS_OK) {//先查物理地址
+            if (LOS_ArchMmuQuery(&newVmSpace->archMmu, vaddr, &paddr, NULL) != LOS_OK) {//只查页表,不再解除/重建映射
                 continue;
             }
 
@@ -374,11 +377,6 @@ STATUS_T LOS_VmSpaceClone(UINT32 cloneFlags, LosVmSpace *oldVmSpace, LosVmSpace
             if (page != NULL) {
                 LOS_AtomicInc(&page->refCounts);//refCounts 自增
             }
-            if (flags & VM_MAP_REGION_FLAG_PERM_WRITE) {//可写入区标签
-                LOS_ArchMmuUnmap(&oldVmSpace->archMmu, vaddr, 1);//先删除老空间映射
-                LOS_ArchMmuMap(&oldVmSpace->archMmu, vaddr, paddr, 1, flags & ~VM_MAP_REGION_FLAG_PERM_WRITE);//老空间重新映射
-            }
-            LOS_ArchMmuMap(&newVmSpace->archMmu, vaddr, paddr, 1, flags & ~VM_MAP_REGION_FLAG_PERM_WRITE);//映射新空间
 
 #ifdef LOSCFG_FS_VFS //文件系统开关
             if (LOS_IsRegionFileValid(oldRegion)) {//是都是一个文件映射线性区
@@ -392,6 +390,11 @@ STATUS_T LOS_VmSpaceClone(UINT32 cloneFlags, LosVmSpace *oldVmSpace, LosVmSpace
             }
 #endif
         }
+        if (copied < 0) {
+            VM_ERR("copy region mapping failed, ret %d", copied);
+            ret = LOS_ERRNO_VM_NO_MEMORY;
+            break;
+        }
     RB_SCAN_SAFE_END(&oldVmSpace->regionRbTree, pstRbNode, pstRbNodeNext)//红黑树循环结束
     (VOID)LOS_MuxRelease(&oldVmSpace->regionMux);
     return ret;
@@ -974,9 +977,12 @@ STATUS_T LOS_VmSpaceFree(LosVmSpace *space)
         return LOS_OK;
     }
 
-    /* pop it out of the global aspace list */
-    (VOID)LOS_MuxAcquire(&space->regionMux);
+    /* pop it out of the global aspace list, walkers holding g_vmSpaceListMux keep the space alive */
+    (VOID)LOS_MuxAcquire(&g_vmSpaceListMux);
     LOS_ListDelete(&space->node);//从g_vmSpaceList链表里删除，g_vmSpaceList记录了所有空间节点。
+    (VOID)LOS_MuxRelease(&g_vmSpaceListMux);
+
+    (VOID)LOS_MuxAcquire(&space->regionMux);
 
     OsVmSpaceAllRegionFree(space);
 
@@ -70,11 +70,14 @@
 #include "los_vm_map.h"
 #include "los_vm_dump.h"
 #include "los_process_pri.h"
+#include "los_hw_cpu.h"
 
 
 #ifdef LOSCFG_KERNEL_VM
 
 #define ONE_PAGE    1
+#define VM_PCP_HIGH     64  ///< 每CPU缓存页数超过该值时归还一批给伙伴系统
+#define VM_PCP_BATCH    16  ///< 每CPU缓存与伙伴系统之间一次搬运的页数
 
 /* Physical memory area array | 物理内存区数组 */
 STATIC struct VmPhysArea g_physArea[] = {///< 这里只有一个区域,即只生成一个段
@@ -177,6 +180,19 @@ STATIC INLINE VOID OsVmPhysFreeListInit(struct VmPhysSeg *seg)
     }
     LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
 }
+/// 初始化每CPU单页缓存
+STATIC INLINE VOID OsVmPhysPcpInit(struct VmPhysSeg *seg)
+{
+    UINT32 cpu;
+    struct VmPhysPcp *pcp = NULL;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        pcp = &seg->pcp[cpu];
+        LOS_SpinInit(&pcp->lock);
+        LOS_ListInit(&pcp->list);
+        pcp->count = 0;
+    }
+}
 /// 物理段初始化
 VOID OsVmPhysInit(VOID)
 {
@@ -189,6 +205,7 @@ VOID OsVmPhysInit(VOID)
         seg->pageBase = &g_vmPageArray[nPages];//记录本段首页物理页框地址
         nPages += seg->size >> PAGE_SHIFT;//偏移12位,按4K一页,算出本段总页数
         OsVmPhysFreeListInit(seg);	//初始化空闲链表,分配页框使用伙伴算法
+        OsVmPhysPcpInit(seg);		//初始化每CPU单页缓存
         OsVmPhysLruInit(seg);		//初始化LRU置换链表
     }
 }
@@ -452,28 +469,166 @@ VOID OsVmPhysPagesFreeContiguous(LosVmPage *page, size_t nPages)
  *
  * @see
  */
-STATIC LosVmPage *OsVmPhysPagesGet(size_t nPages)
+/// 从每CPU缓存尾部取冷页归还伙伴系统,调用者持有pcp->lock
+STATIC VOID OsVmPhysPcpDrainUnsafe(struct VmPhysSeg *seg, struct VmPhysPcp *pcp, UINT32 count)
 {
     UINT32 intSave;
-    struct VmPhysSeg *seg = NULL;
     LosVmPage *page = NULL;
+
+    LOS_SpinLockSave(&seg->freeListLock, &intSave);
+    while ((count > 0) && (pcp->count > 0)) {
+        page = LOS_DL_LIST_ENTRY(pcp->list.pstPrev, LosVmPage, node);//尾部是最久未被使用的冷页
+        LOS_ListDelete(&page->node);
+        pcp->count--;
+        OsVmPhysPagesFree(page, 0);
+        count--;
+    }
+    LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+    pcp->drainCnt++;
+}
+/// 内存紧张时把所有CPU缓存的页归还伙伴系统,以便合并出连续内存,返回是否归还了页
+STATIC BOOL OsVmPhysPcpDrainAll(VOID)
+{
+    UINT32 intSave;
     UINT32 segID;
+    UINT32 cpu;
+    BOOL drained = FALSE;
+    struct VmPhysSeg *seg = NULL;
+    struct VmPhysPcp *pcp = NULL;
 
     for (segID = 0; segID < g_vmPhysSegNum; segID++) {
         seg = &g_vmPhysSeg[segID];
-        LOS_SpinLockSave(&seg->freeListLock, &intSave);
-        page = OsVmPhysPagesAlloc(seg, nPages);//分配指定页数的物理页,nPages需小于伙伴算法一次能分配的最大页数
-        if (page != NULL) {//分配成功
-            /*  */
-            LOS_AtomicSet(&page->refCounts, 0);//设置引用次数为0
-            page->nPages = nPages;//页数
-            LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
-            return page;
+        for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+            pcp = &seg->pcp[cpu];
+            LOS_SpinLockSave(&pcp->lock, &intSave);
+            if (pcp->count > 0) {
+                OsVmPhysPcpDrainUnsafe(seg, pcp, pcp->count);
+                drained = TRUE;
+            }
+            LOS_SpinUnlockRestore(&pcp->lock, intSave);
+        }
+    }
+    return drained;
+}
+/// 从本CPU缓存分配一页,缓存为空时从伙伴系统批量补充
+STATIC LosVmPage *OsVmPhysPcpAlloc(struct VmPhysSeg *seg)
+{
+    UINT32 intSave;
+    UINT32 segSave;
+    LosVmPage *page = NULL;
+    struct VmPhysPcp *pcp = &seg->pcp[ArchCurrCpuid()];//即使随后被迁移到其他CPU,持锁访问也是安全的
+
+    LOS_SpinLockSave(&pcp->lock, &intSave);
+    if (pcp->count == 0) {
+        LOS_SpinLockSave(&seg->freeListLock, &segSave);
+        while (pcp->count < VM_PCP_BATCH) {
+            page = OsVmPhysPagesAlloc(seg, ONE_PAGE);
+            if (page == NULL) {
+                break;
+            }
+            LOS_ListTailInsert(&pcp->list, &page->node);
+            pcp->count++;
+        }
+        LOS_SpinUnlockRestore(&seg->freeListLock, segSave);
+        pcp->refillCnt++;
+        if (pcp->count == 0) {
+            LOS_SpinUnlockRestore(&pcp->lock, intSave);
+            return NULL;
         }
-        LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
     }
+
+    page = LOS_DL_LIST_ENTRY(LOS_DL_LIST_FIRST(&pcp->list), LosVmPage, node);//头部是最近释放的热页
+    LOS_ListDelete(&page->node);
+    pcp->count--;
+    pcp->allocCnt++;
+    LOS_SpinUnlockRestore(&pcp->lock, intSave);
+    return page;
+}
+/// 释放一页到本CPU缓存头部,超过上限时把一批冷页归还伙伴系统
+STATIC VOID OsVmPhysPcpFree(LosVmPage *page)
+{
+    UINT32 intSave;
+    struct VmPhysSeg *seg = &g_vmPhysSeg[page->segID];
+    struct VmPhysPcp *pcp = &seg->pcp[ArchCurrCpuid()];
+
+    LOS_SpinLockSave(&pcp->lock, &intSave);
+    LOS_ListAdd(&pcp->list, &page->node);
+    pcp->count++;
+    pcp->freeCnt++;
+    if (pcp->count > VM_PCP_HIGH) {
+        OsVmPhysPcpDrainUnsafe(seg, pcp, VM_PCP_BATCH);
+    }
+    LOS_SpinUnlockRestore(&pcp->lock, intSave);
+}
+/// 统计段内所有CPU缓存的页数,这些页对伙伴系统是已分配的,但实际空闲
+UINT32 OsVmPhysPcpPagesGet(LosVmPhysSeg *seg)
+{
+    UINT32 cpu;
+    UINT32 pages = 0;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        pages += seg->pcp[cpu].count;
+    }
+    return pages;
+}
+/// 从伙伴系统分配nPages个连续页
+STATIC LosVmPage *OsVmPhysBuddyGet(struct VmPhysSeg *seg, size_t nPages)
+{
+    UINT32 intSave;
+    LosVmPage *page = NULL;
+
+    LOS_SpinLockSave(&seg->freeListLock, &intSave);
+    page = OsVmPhysPagesAlloc(seg, nPages);//分配指定页数的物理页,nPages需小于伙伴算法一次能分配的最大页数
+    if (page != NULL) {
+        seg->allocCnt[min(OsVmPagesToOrder(nPages), VM_LIST_ORDER_MAX - 1)]++;
+    }
+    LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+    return page;
+}
+
+STATIC LosVmPage *OsVmPhysPagesGet(size_t nPages)
+{
+    struct VmPhysSeg *seg = NULL;
+    LosVmPage *page = NULL;
+    UINT32 segID;
+    BOOL drained = FALSE;
+
+    do {
+        for (segID = 0; segID < g_vmPhysSegNum; segID++) {
+            seg = &g_vmPhysSeg[segID];
+            //单页走每CPU缓存,多页直接向伙伴系统申请
+            page = (nPages == ONE_PAGE) ? OsVmPhysPcpAlloc(seg) : OsVmPhysBuddyGet(seg, nPages);
+            if (page != NULL) {//分配成功
+                LOS_AtomicSet(&page->refCounts, 0);//设置引用次数为0
+                page->nPages = nPages;//页数
+                return page;
+            }
+        }
+        if (drained) {
+            break;
+        }
+        drained = OsVmPhysPcpDrainAll();//伙伴系统已分配不出,收回各CPU缓存后重试一次
+    } while (drained);
+
     return NULL;
 }
+/// 释放页到伙伴系统或每CPU缓存,单页进入缓存
+STATIC VOID OsVmPhysPagesPut(LosVmPage *page, size_t nPages)
+{
+    UINT32 intSave;
+    struct VmPhysSeg *seg = NULL;
+
+    if (nPages == ONE_PAGE) {
+        OsVmPhysPcpFree(page);
+        return;
+    }
+
+    seg = &g_vmPhysSeg[page->segID];
+    LOS_SpinLockSave(&seg->freeListLock, &intSave);
+    OsVmPhysPagesFreeContiguous(page, nPages);
+    seg->freeCnt[min(OsVmPagesToOrder(nPages), VM_LIST_ORDER_MAX - 1)]++;
+    LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+}
 ///分配连续的物理页
 VOID *LOS_PhysPagesAllocContiguous(size_t nPages)
 {
@@ -493,8 +648,6 @@ VOID *LOS_PhysPagesAllocContiguous(size_t nPages)
 /// 释放指定页数地址连续的物理内存
 VOID LOS_PhysPagesFreeContiguous(VOID *ptr, size_t nPages)
 {
-    UINT32 intSave;
-    struct VmPhysSeg *seg = NULL;
     LosVmPage *page = NULL;
 
     if (ptr == NULL) {
@@ -508,12 +661,7 @@ VOID LOS_PhysPagesFreeContiguous(VOID *ptr, size_t nPages)
     }
     page->nPages = 0;//被分配的页数置为0,表示不被分配
 
-    seg = &g_vmPhysSeg[page->segID];
-    LOS_SpinLockSave(&seg->freeListLock, &intSave);
-
-    OsVmPhysPagesFreeContiguous(page, nPages);//具体释放实现
-
-    LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+    OsVmPhysPagesPut(page, nPages);//具体释放实现
 #ifdef LOSCFG_KERNEL_PLIMITS
     OsMemLimitMemFree(nPages * PAGE_SIZE);
 #endif
@@ -548,21 +696,13 @@ VADDR_T *LOS_PaddrToKVaddr(PADDR_T paddr)
 ///释放一个物理页框
 VOID LOS_PhysPageFree(LosVmPage *page)
 {
-    UINT32 intSave;
-    struct VmPhysSeg *seg = NULL;
-
     if (page == NULL) {
         return;
     }
 
     if (LOS_AtomicDecRet(&page->refCounts) <= 0) {//减少引用数后不能小于0
-        seg = &g_vmPhysSeg[page->segID];
-        LOS_SpinLockSave(&seg->freeListLock, &intSave);
-
-        OsVmPhysPagesFreeContiguous(page, ONE_PAGE);//释放一页
         LOS_AtomicSet(&page->refCounts, 0);//只要物理内存被释放了,引用数就必须得重置为 0
-
-        LOS_SpinUnlockRestore(&seg->freeListLock, intSave);
+        OsVmPhysPagesPut(page, ONE_PAGE);//释放一页到本CPU缓存
     }
 #ifdef LOSCFG_KERNEL_PLIMITS
     OsMemLimitMemFree(PAGE_SIZE);
@@ -666,10 +806,8 @@ UINT32 OsVmPagesToOrder(size_t nPages)
 ///释放双链表中的所有节点内存,本质是回归到伙伴orderlist中
 size_t LOS_PhysPagesFree(LOS_DL_LIST *list)
 {
-    UINT32 intSave;
     LosVmPage *page = NULL;
     LosVmPage *nPage = NULL;
-    LosVmPhysSeg *seg = NULL;
     size_t count = 0;
 
     if (list == NULL) {
@@ -679,11 +817,8 @@ size_t LOS_PhysPagesFree(LOS_DL_LIST *list)
     LOS_DL_LIST_FOR_EACH_ENTRY_SAFE(page, nPage, list, LosVmPage, node) {//宏循环
         LOS_ListDelete(&page->node);//先把自己摘出去
         if (LOS_AtomicDecRet(&page->refCounts) <= 0) {//无引用
-            seg = &g_vmPhysSeg[page->segID];//获取物理段
-            LOS_SpinLockSave(&seg->freeListLock, &intSave);//锁住freeList
-            OsVmPhysPagesFreeContiguous(page, ONE_PAGE);//连续释放,注意这里的ONE_PAGE其实有误导,让人以为是释放4K,其实是指连续的物理页框,如果3页连在一块是一起释放的.
             LOS_AtomicSet(&page->refCounts, 0);//引用重置为0
-            LOS_SpinUnlockRestore(&seg->freeListLock, intSave);//恢复锁
+            OsVmPhysPagesPut(page, ONE_PAGE);//单页进入本CPU缓存
         }
         count++;//继续取下一个node
     }
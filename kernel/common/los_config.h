@@ -414,15 +414,6 @@ extern UINT32 __heap_end;
 #define OS_SWTMR_MAX_TIMERID ((0xFFFF / LOSCFG_BASE_CORE_SWTMR_LIMIT) * LOSCFG_BASE_CORE_SWTMR_LIMIT)
 #endif
 
-/**
- * @ingroup los_config
- * @brief 软件定时器队列最大长度
- * @details 存储定时器句柄的队列大小，应不小于定时器数量
- */
-#ifndef OS_SWTMR_HANDLE_QUEUE_SIZE
-#define OS_SWTMR_HANDLE_QUEUE_SIZE LOSCFG_BASE_CORE_SWTMR_LIMIT  /* 队列大小等于定时器数量 */
-#endif
-
 #endif  /* LOSCFG_BASE_IPC_QUEUE */
 
 // ==============================================
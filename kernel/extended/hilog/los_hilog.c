@@ -40,10 +40,33 @@
 #include "los_vm_map.h"
 #include "los_vm_lock.h"
 #include "user_copy.h"
-#define HILOG_BUFFER LOSCFG_HILOG_BUFFER_SIZE  // 日志缓冲区大小，由配置项定义
+#include "los_atomic.h"
+#include "los_event.h"
+#include "los_hw_cpu.h"
+#include "los_sys.h"
+#define HILOG_BUFFER LOSCFG_HILOG_BUFFER_SIZE  // 每个CPU的日志环形缓冲区大小，由配置项定义
 #define DRIVER_MODE 0666                       // 驱动文件访问权限：读写权限
 #define HILOG_DRIVER "/dev/hilog"              // 日志驱动设备路径
 
+#if ((HILOG_BUFFER & (HILOG_BUFFER - 1)) != 0)
+#error "LOSCFG_HILOG_BUFFER_SIZE must be a power of two"
+#endif
+
+#define HILOG_RECORD_ALIGN     8U  // 环形缓冲区内记录的对齐粒度
+
+#define HILOG_RECORD_FREE      0U  // 记录槽空闲（或写者已预留但尚未标记）
+#define HILOG_RECORD_BUSY      1U  // 写者已预留，正在拷贝日志内容
+#define HILOG_RECORD_READY     2U  // 日志写入完成，可被读者读取
+#define HILOG_RECORD_PAD       3U  // 填充或作废的记录，读者直接跳过
+
+#define HILOG_READER_RUNNING   0   // 读者正在处理日志，写者无需唤醒
+#define HILOG_READER_IDLE      1   // 读者无日志可读，任意写入都需唤醒
+#define HILOG_READER_BATCH     2   // 读者在攒批等待，待写入量超过水位才唤醒
+
+#define HILOG_EVENT_DATA       0x1U                  // 读者攒批时等待的日志事件位
+#define HILOG_WAKEUP_WATERMARK (HILOG_BUFFER / 4)    // 唤醒读者的单CPU待读字节水位
+#define HILOG_FLUSH_MS         50                    // 未达水位时读者攒批的最长等待时间（毫秒）
+
 /**
  * @brief 日志条目结构体定义
  * @details 用于存储单条日志的完整信息，包括头部和消息内容
@@ -59,6 +82,32 @@ struct HiLogEntry {
     char msg[0];                // 日志消息内容（柔性数组）
 };
 
+/**
+ * @brief 环形缓冲区内的日志记录
+ * @details 记录在缓冲区内连续存放、不跨越缓冲区末尾，entry之后紧跟消息内容，
+ *          state由写者在内容写完后置为READY，读者据此判断记录是否可读
+ */
+struct HiLogRecord {
+    volatile UINT32 state;      // 记录状态：HILOG_RECORD_*
+    UINT32 size;                // 记录总大小（含记录头与对齐填充）
+    struct HiLogEntry entry;    // 对用户态可见的日志条目
+};
+
+#define HILOG_RECORD_SIZE(len) \
+    ((UINT32)(((len) + sizeof(struct HiLogRecord) + HILOG_RECORD_ALIGN - 1) & ~(HILOG_RECORD_ALIGN - 1)))
+
+/**
+ * @brief 每CPU日志环形缓冲区
+ * @details 写者通过CAS推进reserve预留空间，无需加锁，可在中断上下文使用；
+ *          readOffset只由读者推进。两个偏移量单调递增，按HILOG_BUFFER取模得到缓冲区内位置
+ */
+struct HiLogRing {
+    unsigned char *buffer;          // 环形缓冲区指针
+    Atomic reserve;                 // 写者预留位置
+    volatile UINT32 readOffset;     // 读者消费位置
+    Atomic dropped;                 // 缓冲区满时丢弃的日志条数
+};
+
 // 文件操作函数声明
 ssize_t HilogRead(struct file *filep, char __user *buf, size_t count);
 ssize_t HilogWrite(struct file *filep, const char __user *buf, size_t count);
@@ -89,27 +138,17 @@ STATIC struct file_operations_vfs g_hilogFops = {
 
 /**
  * @brief 日志字符设备结构体
- * @details 管理日志设备的状态、缓冲区和同步机制
+ * @details 管理每CPU环形缓冲区以及读者的同步与唤醒状态
  */
 struct HiLogCharDevice {
-    int flag;                     // 设备标志
-    LosMux mtx;                   // 互斥锁，保护设备操作
-    unsigned char *buffer;        // 环形缓冲区指针
-    wait_queue_head_t wq;         // 等待队列，用于阻塞读写
-    size_t writeOffset;           // 写指针偏移量
-    size_t headOffset;            // 读指针偏移量
-    size_t size;                  // 当前缓冲区数据大小
-    size_t count;                 // 日志条目计数
-} g_hiLogDev;                     // 日志设备全局实例
-
-/**
- * @brief 获取缓冲区头部指针
- * @return 缓冲区头部（读指针位置）的地址
- */
-static inline unsigned char *HiLogBufferHead(void)
-{
-    return g_hiLogDev.buffer + g_hiLogDev.headOffset;  // 计算并返回读指针位置
-}
+    int flag;                                       // 设备标志
+    LosMux mtx;                                     // 互斥锁，仅用于串行化读者
+    wait_queue_head_t wq;                           // 等待队列，写者唤醒空闲的读者，可被信号中断
+    EVENT_CB_S event;                               // 日志事件，写者提前结束读者的攒批等待
+    Atomic readerState;                             // 读者状态：HILOG_READER_*
+    BOOL draining;                                  // 读者正在批量读空缓冲区
+    struct HiLogRing ring[LOSCFG_KERNEL_CORE_NUM];  // 每CPU环形缓冲区
+} g_hiLogDev;                                       // 日志设备全局实例
 
 /**
  * @brief 打开日志设备
@@ -133,36 +172,6 @@ int HiLogClose(struct file *filep)
     return 0;     // 始终返回成功
 }
 
-/**
- * @brief 增加缓冲区数据大小
- * @param sz 新增数据大小
- * @note 仅当缓冲区有足够空间时才更新状态
- */
-static void HiLogBufferInc(size_t sz)
-{
-    if (g_hiLogDev.size + sz <= HILOG_BUFFER) {  // 检查缓冲区是否有足够空间
-        g_hiLogDev.size += sz;                   // 更新数据大小
-        g_hiLogDev.writeOffset += sz;            // 更新写指针
-        g_hiLogDev.writeOffset %= HILOG_BUFFER;  // 环形缓冲区写指针回绕
-        g_hiLogDev.count++;                      // 增加日志条目计数
-    }
-}
-
-/**
- * @brief 减少缓冲区数据大小
- * @param sz 减少的数据大小
- * @note 仅当缓冲区数据大小大于等于sz时才更新状态
- */
-static void HiLogBufferDec(size_t sz)
-{
-    if (g_hiLogDev.size >= sz) {                 // 检查缓冲区数据是否足够
-        g_hiLogDev.size -= sz;                   // 更新数据大小
-        g_hiLogDev.headOffset += sz;             // 更新读指针
-        g_hiLogDev.headOffset %= HILOG_BUFFER;   // 环形缓冲区读指针回绕
-        g_hiLogDev.count--;                      // 减少日志条目计数
-    }
-}
-
 /**
  * @brief 日志缓冲区数据拷贝
  * @param dst 目标缓冲区
@@ -194,179 +203,325 @@ static int HiLogBufferCopy(unsigned char *dst, unsigned dstLen, const unsigned c
 }
 
 /**
- * @brief 从环形缓冲区读取数据
- * @param buffer 目标缓冲区
- * @param bufLen 要读取的长度
- * @return 0 - 成功；其他值 - 失败
- * @note 处理环形缓冲区的边界回绕情况
+ * @brief 初始化日志条目头部
+ * @param header 日志头部指针
+ * @param len 日志消息体长度
+ * @note 自动填充进程ID、任务ID和时间戳信息
  */
-static int HiLogReadRingBuffer(unsigned char *buffer, size_t bufLen)
+static void HiLogHeadInit(struct HiLogEntry *header, size_t len)
 {
-    int retval;
-    size_t bufLeft = HILOG_BUFFER - g_hiLogDev.headOffset;  // 计算当前读指针到缓冲区末尾的空间
-    if (bufLeft > bufLen) {
-        // 无需回绕，直接从读指针位置拷贝
-        retval = HiLogBufferCopy(buffer, bufLen, HiLogBufferHead(), bufLen);
-    } else {
-        // 先拷贝从读指针到缓冲区末尾的数据
-        retval = HiLogBufferCopy(buffer, bufLen, HiLogBufferHead(), bufLeft);
-        if (retval < 0) {
-            return retval;  // 拷贝失败，直接返回
-        }
+    struct timespec now = {0};      // 时间戳结构体
+    (void)clock_gettime(CLOCK_REALTIME, &now);  // 获取当前系统时间
+
+    header->len = len;              // 设置消息体长度
+    header->pid = LOS_GetCurrProcessID();  // 设置当前进程ID
+    header->taskId = LOS_CurTaskIDGet();   // 设置当前任务ID
+    header->sec = now.tv_sec;       // 设置秒级时间戳
+    header->nsec = now.tv_nsec;     // 设置纳秒级时间戳
+    header->hdrSize = sizeof(struct HiLogEntry);  // 设置头部大小
+    header->reserved = 0;
+}
 
-        // 再拷贝从缓冲区开头到剩余长度的数据（处理回绕）
-        retval = HiLogBufferCopy(buffer + bufLeft, bufLen - bufLeft, g_hiLogDev.buffer, bufLen - bufLeft);
+/**
+ * @brief 获取环形缓冲区中尚未被读取的字节数
+ * @param ring 环形缓冲区
+ * @return 待读字节数（含正在写入的记录）
+ */
+STATIC INLINE UINT32 HiLogRingPending(const struct HiLogRing *ring)
+{
+    return (UINT32)LOS_AtomicRead((Atomic *)&ring->reserve) - ring->readOffset;
+}
+
+/**
+ * @brief 在环形缓冲区中预留一条记录
+ * @param ring 环形缓冲区
+ * @param recSize 记录大小，已按HILOG_RECORD_ALIGN对齐
+ * @param len 日志消息体长度
+ * @return 预留到的记录，状态为BUSY；缓冲区空间不足时返回NULL
+ * @details 记录不跨越缓冲区末尾，末尾剩余空间不足时连同一条PAD记录一起预留；
+ *          日志头部在置BUSY之前写好，读者可据BUSY记录的时间戳判断是否需要等待其提交
+ */
+STATIC struct HiLogRecord *HiLogRingReserve(struct HiLogRing *ring, UINT32 recSize, size_t len)
+{
+    struct HiLogRecord *rec = NULL;
+    UINT32 head;
+    UINT32 pos;
+    UINT32 pad;
+
+    do {
+        head = (UINT32)LOS_AtomicRead(&ring->reserve);
+        pos = head & (HILOG_BUFFER - 1);
+        pad = ((pos + recSize) > HILOG_BUFFER) ? (HILOG_BUFFER - pos) : 0;
+        if ((head + pad + recSize - ring->readOffset) > HILOG_BUFFER) {
+            return NULL;  // 缓冲区已满，由调用者计入丢弃
+        }
+    } while (LOS_AtomicCmpXchg32bits(&ring->reserve, (INT32)(head + pad + recSize), (INT32)head));
+    DMB;  // 预留成功后才能写入该区域
+
+    if (pad != 0) {
+        rec = (struct HiLogRecord *)(ring->buffer + pos);
+        rec->size = pad;
+        DMB;
+        rec->state = HILOG_RECORD_PAD;  // 末尾空间作为填充记录
+        pos = 0;
     }
-    return retval;  // 返回读取结果
+
+    rec = (struct HiLogRecord *)(ring->buffer + pos);
+    rec->size = recSize;
+    HiLogHeadInit(&rec->entry, len);
+    DMB;  // 头部（含时间戳）先于BUSY状态对读者可见
+    rec->state = HILOG_RECORD_BUSY;
+    return rec;
 }
+
 /**
- * @brief 从日志设备读取数据
- * @param filep 文件指针
- * @param buffer 接收数据的缓冲区
- * @param bufLen 缓冲区长度
- * @return 成功时返回读取的字节数；失败时返回负数错误码
- * @note 该函数会阻塞等待直到有数据可读
+ * @brief 提交一条记录，使其对读者可见
+ * @param rec 已预留的记录
+ * @param state 提交状态：READY表示可读，PAD表示作废
  */
-static ssize_t HiLogRead(struct file *filep, char *buffer, size_t bufLen)
+STATIC INLINE VOID HiLogRecordCommit(struct HiLogRecord *rec, UINT32 state)
 {
-    int retval;                     // 函数返回值
-    struct HiLogEntry header;       // 日志条目头部
+    DMB;  // 记录内容先于状态对读者可见
+    rec->state = state;
+    DMB;  // 状态先于读者状态的检查，与读者进入睡眠前的屏障配对
+}
 
-    (void)filep;                    // 未使用的参数
-    // 阻塞等待直到缓冲区有数据（可被信号中断）
-    wait_event_interruptible(g_hiLogDev.wq, (g_hiLogDev.size > 0));
+/**
+ * @brief 消费环形缓冲区头部的一条记录
+ * @param ring 环形缓冲区
+ * @param rec 头部记录
+ * @details 先清零记录所占空间，再推进读指针，保证写者重新预留到该区域时看到的状态为FREE
+ */
+STATIC VOID HiLogRingConsume(struct HiLogRing *ring, struct HiLogRecord *rec)
+{
+    UINT32 size = rec->size;
 
-    (VOID)LOS_MuxAcquire(&g_hiLogDev.mtx);  // 获取互斥锁，保护缓冲区操作
-    // 从环形缓冲区读取日志头部
-    retval = HiLogReadRingBuffer((unsigned char *)&header, sizeof(header));
-    if (retval < 0) {
-        retval = -EINVAL;           // 读取失败，设置参数无效错误
-        goto out;                   // 跳转到释放资源处
+    (VOID)memset_s(rec, size, 0, size);
+    DMB;  // 清零先于读指针推进对写者可见
+    ring->readOffset += size;
+}
+
+/**
+ * @brief 获取环形缓冲区头部的一条记录
+ * @param ring 环形缓冲区
+ * @param state [OUT] 记录状态：READY、BUSY，或FREE（写者已预留但头部尚未写入）
+ * @return 头部记录；缓冲区为空时返回NULL
+ * @note 仅由持有读者锁的读者调用，途中遇到的PAD记录会被直接消费
+ */
+STATIC struct HiLogRecord *HiLogRingPeek(struct HiLogRing *ring, UINT32 *state)
+{
+    struct HiLogRecord *rec = NULL;
+
+    if (ring->buffer == NULL) {
+        return NULL;
     }
 
-    // 检查缓冲区是否足够容纳头部+消息体
-    if (bufLen < header.len + sizeof(header)) {
-        PRINTK("buffer too small,bufLen=%d, header.len=%d,%d\n", bufLen, header.len, header.hdrSize);
-        retval = -ENOMEM;           // 设置内存不足错误
-        goto out;                   // 跳转到释放资源处
+    while (HiLogRingPending(ring) != 0) {
+        rec = (struct HiLogRecord *)(ring->buffer + (ring->readOffset & (HILOG_BUFFER - 1)));
+        *state = rec->state;
+        DMB;  // 状态先于记录大小与内容读取
+        if (*state == HILOG_RECORD_PAD) {
+            HiLogRingConsume(ring, rec);
+            continue;
+        }
+        return rec;
     }
+    return NULL;
+}
 
-    HiLogBufferDec(sizeof(header));  // 减少缓冲区已用大小（头部）
+/**
+ * @brief 比较两条记录的时间戳
+ * @param rec 待比较的记录
+ * @param than 参照记录，为NULL时视为最晚
+ * @return TRUE - rec早于than；FALSE - rec不早于than
+ */
+STATIC INLINE BOOL HiLogRecordBefore(const struct HiLogRecord *rec, const struct HiLogRecord *than)
+{
+    return (than == NULL) || (rec->entry.sec < than->entry.sec) ||
+           ((rec->entry.sec == than->entry.sec) && (rec->entry.nsec < than->entry.nsec));
+}
 
-    // 将日志头部拷贝到用户缓冲区
-    retval = HiLogBufferCopy((unsigned char *)buffer, bufLen, (unsigned char *)&header, sizeof(header));
-    if (retval < 0) {
-        retval = -EINVAL;           // 拷贝失败，设置参数无效错误
-        goto out;                   // 跳转到释放资源处
+/**
+ * @brief 在所有CPU的环形缓冲区中选出时间戳最早的可读记录
+ * @param oldest [OUT] 记录所在的环形缓冲区
+ * @param pending [OUT] 各环形缓冲区待读字节数的最大值（含正在写入的记录）
+ * @return 时间戳最早的记录；没有可读记录，或某条更早的记录仍在写入时返回NULL
+ * @details 写入中的BUSY记录时间戳已可读，早于候选记录时须等待其提交，否则会乱序输出；
+ *          已预留但尚未置BUSY的记录时间戳未知，同样等待其提交
+ */
+STATIC struct HiLogRecord *HiLogOldestRecord(struct HiLogRing **oldest, UINT32 *pending)
+{
+    struct HiLogRecord *best = NULL;    // 时间戳最早的可读记录
+    struct HiLogRecord *busy = NULL;    // 时间戳最早的写入中记录
+    struct HiLogRecord *rec = NULL;
+    BOOL unknown = FALSE;               // 存在时间戳未知的写入中记录
+    UINT32 state;
+    UINT32 cpu;
+
+    *pending = 0;
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        struct HiLogRing *ring = &g_hiLogDev.ring[cpu];
+        rec = HiLogRingPeek(ring, &state);
+        if (rec == NULL) {
+            continue;
+        }
+        *pending = MAX(*pending, HiLogRingPending(ring));
+        if (state == HILOG_RECORD_READY) {
+            if (HiLogRecordBefore(rec, best)) {
+                best = rec;
+                *oldest = ring;
+            }
+        } else if (state == HILOG_RECORD_BUSY) {
+            if (HiLogRecordBefore(rec, busy)) {
+                busy = rec;
+            }
+        } else {
+            unknown = TRUE;
+        }
     }
 
-    // 从环形缓冲区读取日志消息体
-    retval = HiLogReadRingBuffer((unsigned char *)(buffer + sizeof(header)), header.len);
-    if (retval < 0) {
-        retval = -EINVAL;           // 读取失败，设置参数无效错误
-        goto out;                   // 跳转到释放资源处
+    if ((best != NULL) && (unknown || ((busy != NULL) && HiLogRecordBefore(busy, best)))) {
+        return NULL;  // 更早的日志仍在写入，等待其提交后再按时间顺序输出
     }
+    return best;
+}
 
-    HiLogBufferDec(header.len);     // 减少缓冲区已用大小（消息体）
-    retval = header.len + sizeof(header);  // 返回总读取字节数
-out:
-    if (retval == -ENOMEM) {        // 如果是内存不足错误
-        // 清空环形缓冲区
-        g_hiLogDev.writeOffset = 0;
-        g_hiLogDev.headOffset = 0;
-        g_hiLogDev.size = 0;
-        g_hiLogDev.count = 0;
+/**
+ * @brief 打印并清零各CPU环形缓冲区的丢弃计数
+ */
+STATIC VOID HiLogReportDropped(VOID)
+{
+    UINT32 cpu;
+    INT32 dropped;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        if (LOS_AtomicRead(&g_hiLogDev.ring[cpu].dropped) == 0) {
+            continue;
+        }
+        dropped = LOS_AtomicXchg32bits(&g_hiLogDev.ring[cpu].dropped, 0);
+        PRINTK("hilog ringbuffer of cpu%u full, drop %d line(s) log\n", cpu, dropped);
     }
-    (VOID)LOS_MuxRelease(&g_hiLogDev.mtx);  // 释放互斥锁
-    return (ssize_t)retval;         // 返回结果
 }
 
 /**
- * @brief 向环形缓冲区写入数据
- * @param buffer 待写入的数据缓冲区
- * @param bufLen 待写入数据长度
- * @return 0 - 成功；-1 - 失败
- * @note 自动处理环形缓冲区的边界回绕
+ * @brief 等待并取出下一条要读取的记录
+ * @param ring [OUT] 记录所在的环形缓冲区
+ * @return 下一条要读取的记录；等待被信号中断时返回NULL
+ * @details 读者空闲时任意提交都会唤醒读者；唤醒后若待读数据未达水位，读者先等待
+ *          HILOG_FLUSH_MS攒批（期间超过水位的写者会提前唤醒），随后连续读空所有缓冲区
+ *          才再次睡眠，从而将每条日志一次唤醒合并为每批一次。更早的日志仍在写入时，
+ *          读者同样以空闲状态等待其提交
  */
-static int HiLogWriteRingBuffer(unsigned char *buffer, size_t bufLen)
+STATIC struct HiLogRecord *HiLogWaitRecord(struct HiLogRing **ring)
 {
-    int retval;                     // 函数返回值
-    // 计算当前写指针到缓冲区末尾的剩余空间
-    size_t bufLeft = HILOG_BUFFER - g_hiLogDev.writeOffset;
-    if (bufLen > bufLeft) {         // 如果剩余空间不足，需要分两次写入
-        // 先写满当前剩余空间
-        retval = HiLogBufferCopy(g_hiLogDev.buffer + g_hiLogDev.writeOffset, bufLeft, buffer, bufLeft);
-        if (retval) {
-            return -1;              // 拷贝失败，返回错误
+    struct HiLogRecord *rec = NULL;
+    UINT32 pending;
+    INT32 ret;
+
+    while (TRUE) {
+        rec = HiLogOldestRecord(ring, &pending);
+        if ((rec != NULL) && (g_hiLogDev.draining || (pending >= HILOG_WAKEUP_WATERMARK))) {
+            g_hiLogDev.draining = TRUE;
+            return rec;
         }
-        // 再从缓冲区开头写入剩余数据
-        retval = HiLogBufferCopy(g_hiLogDev.buffer, HILOG_BUFFER, buffer + bufLeft, bufLen - bufLeft);
-    } else {
-        // 空间足够，直接写入
-        retval = HiLogBufferCopy(g_hiLogDev.buffer + g_hiLogDev.writeOffset, bufLeft, buffer, bufLen);
-    }
-    if (retval < 0) {
-        return -1;                  // 拷贝失败，返回错误
+
+        if (rec == NULL) {
+            if (pending == 0) {
+                g_hiLogDev.draining = FALSE;  // 缓冲区已读空，下一批重新攒批
+            }
+            LOS_AtomicSet(&g_hiLogDev.readerState, HILOG_READER_IDLE);
+            DMB;  // 读者状态先于缓冲区的再次检查，与写者提交时的屏障配对
+            ret = 0;
+            if (HiLogOldestRecord(ring, &pending) == NULL) {
+                ret = wait_event_interruptible(g_hiLogDev.wq,
+                    (LOS_AtomicRead(&g_hiLogDev.readerState) != HILOG_READER_IDLE));
+            }
+            LOS_AtomicSet(&g_hiLogDev.readerState, HILOG_READER_RUNNING);
+            if (ret != 0) {
+                return NULL;
+            }
+            continue;
+        }
+
+        LOS_AtomicSet(&g_hiLogDev.readerState, HILOG_READER_BATCH);
+        DMB;
+        (VOID)LOS_EventRead(&g_hiLogDev.event, HILOG_EVENT_DATA,
+                            LOS_WAITMODE_OR | LOS_WAITMODE_CLR, LOS_MS2Tick(HILOG_FLUSH_MS));
+        LOS_AtomicSet(&g_hiLogDev.readerState, HILOG_READER_RUNNING);
+        g_hiLogDev.draining = TRUE;
     }
-    return 0;                       // 成功返回
 }
 
 /**
- * @brief 初始化日志条目头部
- * @param header 日志头部指针
- * @param len 日志消息体长度
- * @note 自动填充进程ID、任务ID和时间戳信息
+ * @brief 从日志设备读取数据
+ * @param filep 文件指针
+ * @param buffer 接收数据的缓冲区
+ * @param bufLen 缓冲区长度
+ * @return 成功时返回读取的字节数；失败时返回负数错误码
+ * @note 该函数会阻塞等待直到有数据可读，每次读取所有CPU中时间戳最早的一条日志；
+ *       等待被信号中断时返回-EINTR，不消费日志
  */
-static void HiLogHeadInit(struct HiLogEntry *header, size_t len)
+static ssize_t HiLogRead(struct file *filep, char *buffer, size_t bufLen)
 {
-    struct timespec now = {0};      // 时间戳结构体
-    (void)clock_gettime(CLOCK_REALTIME, &now);  // 获取当前系统时间
+    int retval;                     // 函数返回值
+    struct HiLogRing *ring = NULL;  // 日志所在的环形缓冲区
+    struct HiLogRecord *rec = NULL; // 待读取的日志记录
+    size_t total;                   // 日志头部与消息体总长度
 
-    header->len = len;              // 设置消息体长度
-    header->pid = LOS_GetCurrProcessID();  // 设置当前进程ID
-    header->taskId = LOS_CurTaskIDGet();   // 设置当前任务ID
-    header->sec = now.tv_sec;       // 设置秒级时间戳
-    header->nsec = now.tv_nsec;     // 设置纳秒级时间戳
-    header->hdrSize = sizeof(struct HiLogEntry);  // 设置头部大小
+    (void)filep;                    // 未使用的参数
+    (VOID)LOS_MuxAcquire(&g_hiLogDev.mtx);  // 获取读者锁，串行化多个读者
+    rec = HiLogWaitRecord(&ring);
+    if (rec == NULL) {
+        (VOID)LOS_MuxRelease(&g_hiLogDev.mtx);
+        return -EINTR;
+    }
+    HiLogReportDropped();
+
+    total = rec->entry.len + sizeof(struct HiLogEntry);
+    // 检查缓冲区是否足够容纳头部+消息体
+    if (bufLen < total) {
+        PRINTK("buffer too small,bufLen=%d, header.len=%d,%d\n", bufLen, rec->entry.len, rec->entry.hdrSize);
+        retval = -ENOMEM;           // 设置内存不足错误，丢弃该条日志
+        goto out;
+    }
+
+    // 将日志头部和消息体一次拷贝到用户缓冲区
+    retval = HiLogBufferCopy((unsigned char *)buffer, bufLen, (unsigned char *)&rec->entry, total);
+    if (retval < 0) {
+        retval = -EINVAL;           // 拷贝失败，设置参数无效错误
+        goto out;
+    }
+    retval = (int)total;            // 返回总读取字节数
+out:
+    HiLogRingConsume(ring, rec);
+    (VOID)LOS_MuxRelease(&g_hiLogDev.mtx);  // 释放读者锁
+    return (ssize_t)retval;         // 返回结果
 }
 
 /**
- * @brief 当日志缓冲区满时覆盖旧日志
- * @param bufLen 新日志数据长度
- * @note 当缓冲区空间不足时，删除最旧的日志条目直到有足够空间
+ * @brief 按水位唤醒读者
+ * @param ring 刚提交日志的环形缓冲区
+ * @note 读者空闲时总是唤醒；读者攒批时仅在待读数据超过水位时唤醒；读者运行时不唤醒；
+ *       记录作废时同样需要调用，读者可能正在等待该记录提交
  */
-static void HiLogCoverOldLog(size_t bufLen)
+STATIC VOID HiLogReaderWake(const struct HiLogRing *ring)
 {
-    int retval;                     // 函数返回值
-    struct HiLogEntry header;       // 日志条目头部
-    // 计算新日志所需总空间（头部+消息体）
-    size_t totalSize = bufLen + sizeof(struct HiLogEntry);
-    static int dropLogLines = 0;    // 丢弃日志计数（静态变量）
-    static int isLastTimeFull = 0;  // 上次是否缓冲区满标志
-    int isThisTimeFull = 0;         // 本次是否缓冲区满标志
-
-    // 循环删除旧日志直到有足够空间
-    while (totalSize + g_hiLogDev.size > HILOG_BUFFER) {
-        // 读取最旧日志的头部
-        retval = HiLogReadRingBuffer((unsigned char *)&header, sizeof(header));
-        if (retval < 0) {
-            break;                  // 读取失败，退出循环
-        }
+    INT32 state = LOS_AtomicRead(&g_hiLogDev.readerState);
 
-        dropLogLines++;              // 增加丢弃计数
-        isThisTimeFull = 1;         // 设置本次缓冲区满标志
-        isLastTimeFull = 1;         // 设置上次缓冲区满标志
-        HiLogBufferDec(sizeof(header));  // 减少缓冲区已用大小（头部）
-        HiLogBufferDec(header.len);     // 减少缓冲区已用大小（消息体）
+    if (state == HILOG_READER_RUNNING) {
+        return;
     }
-    // 如果上次满但本次不满（缓冲区刚刚腾出空间）
-    if (isLastTimeFull == 1 && isThisTimeFull == 0) {
-        /* 短时间内缓冲区满只打印一次丢弃日志信息 */
-        if (dropLogLines > 0) {
-            PRINTK("hilog ringbuffer full, drop %d line(s) log\n", dropLogLines);
-        }
-        isLastTimeFull = 0;         // 重置上次满标志
-        dropLogLines = 0;           // 重置丢弃计数
+    if ((state == HILOG_READER_BATCH) && (HiLogRingPending(ring) < HILOG_WAKEUP_WATERMARK)) {
+        return;
+    }
+    // 只有将读者状态切换为运行的写者负责唤醒，避免重复写事件
+    if (LOS_AtomicCmpXchg32bits(&g_hiLogDev.readerState, HILOG_READER_RUNNING, state)) {
+        return;
+    }
+    if (state == HILOG_READER_IDLE) {
+        wake_up_interruptible(&g_hiLogDev.wq);
+    } else {
+        (VOID)LOS_EventWrite(&g_hiLogDev.event, HILOG_EVENT_DATA);
     }
 }
 
@@ -375,51 +530,43 @@ static void HiLogCoverOldLog(size_t bufLen)
  * @param buffer 日志数据缓冲区
  * @param bufLen 日志数据长度
  * @return 成功时返回写入的字节数；失败时返回负数错误码
- * @note 处理日志写入的核心逻辑，包括缓冲区检查、加锁和唤醒等待进程
+ * @note 写入当前CPU的环形缓冲区，不加锁，可在中断上下文和系统任务中调用；
+ *       缓冲区满时丢弃本条日志并计数，由读者统一打印
  */
 int HiLogWriteInternal(const char *buffer, size_t bufLen)
 {
-    struct HiLogEntry header;       // 日志条目头部
+    struct HiLogRing *ring = &g_hiLogDev.ring[ArchCurrCpuid()];  // 当前CPU的环形缓冲区
+    struct HiLogRecord *rec = NULL; // 预留的日志记录
     int retval;                     // 函数返回值
-    LosTaskCB *runTask =  (LosTaskCB *)OsCurrTaskGet();  // 获取当前任务控制块
 
-    // 如果缓冲区未初始化、处于中断上下文或系统任务，则直接打印
-    if ((g_hiLogDev.buffer == NULL) || (OS_INT_ACTIVE) || (runTask->taskStatus & OS_TASK_FLAG_SYSTEM_TASK)) {
+    // 如果缓冲区未初始化，则直接打印
+    if (ring->buffer == NULL) {
         PRINTK("%s\n", buffer);   // 直接使用PRINTK输出
         return -EAGAIN;             // 返回重试错误
     }
 
-    (VOID)LOS_MuxAcquire(&g_hiLogDev.mtx);  // 获取互斥锁，保护缓冲区操作
-    HiLogCoverOldLog(bufLen);       // 确保有足够空间（必要时覆盖旧日志）
-    HiLogHeadInit(&header, bufLen); // 初始化日志头部
-
-    // 写入日志头部到环形缓冲区
-    retval = HiLogWriteRingBuffer((unsigned char *)&header, sizeof(header));
-    if (retval) {
-        retval = -ENODATA;          // 写入失败，设置无数据错误
-        goto out;                   // 跳转到释放资源处
+    if (bufLen > (HILOG_BUFFER - sizeof(struct HiLogRecord))) {
+        return -ENOMEM;             // 超出单个CPU缓冲区大小
     }
-    HiLogBufferInc(sizeof(header));  // 增加缓冲区已用大小（头部）
 
-    // 写入日志消息体到环形缓冲区
-    retval = HiLogWriteRingBuffer((unsigned char *)(buffer), header.len);
-    if (retval) {
-        retval = -ENODATA;          // 写入失败，设置无数据错误
-        goto out;                   // 跳转到释放资源处
+    rec = HiLogRingReserve(ring, HILOG_RECORD_SIZE(bufLen), bufLen);
+    if (rec == NULL) {
+        LOS_AtomicInc(&ring->dropped);  // 缓冲区满，丢弃本条日志
+        return (int)bufLen;
     }
 
-    HiLogBufferInc(header.len);     // 增加缓冲区已用大小（消息体）
-    retval = header.len;            // 设置返回值为消息体长度
-
-out:
-    (VOID)LOS_MuxRelease(&g_hiLogDev.mtx);  // 释放互斥锁
-    if (retval > 0) {
-        wake_up_interruptible(&g_hiLogDev.wq);  // 唤醒等待读的进程
+    // 写入日志消息体到预留的记录
+    retval = HiLogBufferCopy((unsigned char *)rec->entry.msg, bufLen, (const unsigned char *)buffer, bufLen);
+    if (retval != 0) {
+        HiLogRecordCommit(rec, HILOG_RECORD_PAD);  // 作废该记录，读者直接跳过
+        HiLogReaderWake(ring);
+        PRINTK("write fail retval=%d\n", -ENODATA);  // 打印写入失败信息
+        return -ENODATA;
     }
-    if (retval < 0) {
-        PRINTK("write fail retval=%d\n", retval);  // 打印写入失败信息
-    }
-    return retval;                  // 返回结果
+
+    HiLogRecordCommit(rec, HILOG_RECORD_READY);
+    HiLogReaderWake(ring);          // 按水位唤醒读者
+    return (int)bufLen;             // 返回消息体长度
 }
 
 /**
@@ -433,9 +580,9 @@ out:
 static ssize_t HiLogWrite(struct file *filep, const char *buffer, size_t bufLen)
 {
     (void)filep;                    // 未使用的参数
-    // 计算总所需空间（头部+消息体）
-    size_t totalBufLen = bufLen + sizeof(struct HiLogEntry);
-    // 检查是否溢出或超出缓冲区总大小
+    // 计算总所需空间（记录头+消息体）
+    size_t totalBufLen = bufLen + sizeof(struct HiLogRecord);
+    // 检查是否溢出或超出单个CPU缓冲区大小
     if ((totalBufLen < bufLen) || (totalBufLen > HILOG_BUFFER)) {
         PRINTK("input bufLen %lld too large\n", bufLen);  // 打印缓冲区过大信息
         return -ENOMEM;             // 返回内存不足错误
@@ -446,24 +593,31 @@ static ssize_t HiLogWrite(struct file *filep, const char *buffer, size_t bufLen)
 
 /**
  * @brief 日志设备初始化函数
- * @note 完成缓冲区分配、等待队列初始化和互斥锁初始化
+ * @note 完成每CPU缓冲区分配、等待队列与日志事件初始化和读者锁初始化
  */
 static void HiLogDeviceInit(void)
 {
-    // 从系统内存分配日志缓冲区
-    g_hiLogDev.buffer = LOS_MemAlloc((VOID *)OS_SYS_MEM_ADDR, HILOG_BUFFER);
-    if (g_hiLogDev.buffer == NULL) {
-        PRINTK("In %s line %d,LOS_MemAlloc fail\n", __FUNCTION__, __LINE__);  // 打印分配失败信息
+    UINT32 cpu;
+
+    for (cpu = 0; cpu < LOSCFG_KERNEL_CORE_NUM; cpu++) {
+        struct HiLogRing *ring = &g_hiLogDev.ring[cpu];
+        LOS_AtomicSet(&ring->reserve, 0);
+        LOS_AtomicSet(&ring->dropped, 0);
+        ring->readOffset = 0;
+        // 从系统内存分配日志缓冲区，记录状态依赖缓冲区初始为零
+        ring->buffer = LOS_MemAlloc((VOID *)OS_SYS_MEM_ADDR, HILOG_BUFFER);
+        if (ring->buffer == NULL) {
+            PRINTK("In %s line %d,LOS_MemAlloc fail\n", __FUNCTION__, __LINE__);  // 打印分配失败信息
+            continue;
+        }
+        (VOID)memset_s(ring->buffer, HILOG_BUFFER, 0, HILOG_BUFFER);
     }
 
-    init_waitqueue_head(&g_hiLogDev.wq);  // 初始化等待队列
-    LOS_MuxInit(&g_hiLogDev.mtx, NULL);   // 初始化互斥锁
-
-    // 初始化缓冲区指针和状态
-    g_hiLogDev.writeOffset = 0;
-    g_hiLogDev.headOffset = 0;
-    g_hiLogDev.size = 0;
-    g_hiLogDev.count = 0;
+    init_waitqueue_head(&g_hiLogDev.wq);     // 初始化等待队列
+    (VOID)LOS_EventInit(&g_hiLogDev.event);  // 初始化日志事件
+    LOS_MuxInit(&g_hiLogDev.mtx, NULL);      // 初始化读者锁
+    LOS_AtomicSet(&g_hiLogDev.readerState, HILOG_READER_RUNNING);
+    g_hiLogDev.draining = FALSE;
 }
 
 /**
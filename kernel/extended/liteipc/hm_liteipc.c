@@ -1412,6 +1412,43 @@ LITE_OS_SEC_TEXT STATIC UINT32 CheckPara(IpcContent *content, UINT32 *dstTid)
     return LOS_OK;
 }
 
+/**
+ * @brief 唤醒等待IPC消息的目标任务，同步调用走直接切换
+ * @param content IPC内容结构体指针
+ * @param tcb 等待消息的目标任务控制块指针
+ * @return BOOL 是否还需要调用者执行LOS_Schedule
+ * @note 调用者持有调度锁。同步请求（SEND|RECV）的调用者随后在LiteIpcRead中阻塞，服务线程继承其时间片
+ *       放在本CPU上，阻塞时一次切换即运行服务线程；应答时若调用者与服务线程同优先级，服务线程直接让出CPU切回调用者
+ */
+LITE_OS_SEC_TEXT STATIC BOOL LiteIpcWakeTask(const IpcContent *content, LosTaskCB *tcb)
+{
+    LosTaskCB *runTask = OsCurrTaskGet();
+    INT32 cmp = OsSchedParamCompare(runTask, tcb);  // 大于0表示目标任务优先级更高
+
+    OsTaskWakeClearPendMask(tcb);  // 清除等待标志
+    if (content->outMsg->type == MT_REQUEST) {
+        if ((content->flag & RECV) != RECV) {  // 单向请求，普通唤醒
+            tcb->ops->wake(tcb);
+            return TRUE;
+        }
+        (VOID)OsSchedWakeHandoff(runTask, tcb);
+        if (cmp > 0) {  // 调用者若未能阻塞，确保服务线程不被延误
+            OsSchedRunqueuePendingSet();
+        }
+        return FALSE;  // 随后的阻塞完成切换
+    }
+
+    if ((cmp == 0) && OsPreemptableInSched()) {
+        if (OsSchedWakeHandoff(runTask, tcb)) {
+            runTask->ops->yield(runTask);  // 应答直接切回调用者
+            return FALSE;
+        }
+        return TRUE;
+    }
+    tcb->ops->wake(tcb);
+    return TRUE;
+}
+
 /**
  * @brief IPC消息写入的主函数
  * @param content IPC内容结构体指针
@@ -1464,11 +1501,11 @@ LITE_OS_SEC_TEXT STATIC UINT32 LiteIpcWrite(IpcContent *content)
     LOS_ListTailInsert(&(tcb->ipcTaskInfo->msgListHead), &(buf->listNode));  // 将消息节点插入链表尾部
     OsHookCall(LOS_HOOK_TYPE_IPC_WRITE, &buf->msg, dstTid, pcb->processID, tcb->waitFlag);  // 调用钩子函数
     if (tcb->waitFlag == OS_TASK_WAIT_LITEIPC) {  // 如果目标任务正在等待IPC消息
-        OsTaskWakeClearPendMask(tcb);  // 唤醒任务并清除等待标志
-        tcb->ops->wake(tcb);
+        BOOL needSched = LiteIpcWakeTask(content, tcb);  // 唤醒任务
         SCHEDULER_UNLOCK(intSave);  // 开调度器
-        LOS_MpSchedule(OS_MP_CPU_ALL);  // 多核调度
-        LOS_Schedule();  // 触发调度
+        if (needSched) {
+            LOS_Schedule();  // 触发调度
+        }
     } else {
         SCHEDULER_UNLOCK(intSave);  // 开调度器
     }
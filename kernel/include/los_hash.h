@@ -114,6 +114,19 @@ LITE_OS_SEC_ALW_INLINE STATIC INLINE UINT32 LOS_HashFNV32aStr(CHAR *str, UINT32
     return hval;
 }
 
+/*
+ * murmur3 32位终结函数：FNV对末尾字节和指针低位的扩散较弱，取低位作桶号前用它把各位充分混合
+ */
+LITE_OS_SEC_ALW_INLINE STATIC INLINE UINT32 LOS_HashMix32(UINT32 hval)
+{
+    hval ^= hval >> 16; /* 16: fold the high half into the low half */
+    hval *= 0x85ebca6bU;
+    hval ^= hval >> 13; /* 13: murmur3 fmix32 shift */
+    hval *= 0xc2b2ae35U;
+    hval ^= hval >> 16; /* 16: fold the high half into the low half */
+    return hval;
+}
+
 #ifdef __cplusplus
 #if __cplusplus
 }
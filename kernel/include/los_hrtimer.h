@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @defgroup los_hrtimer High resolution timer
+ * @ingroup kernel
+ */
+
+#ifndef _LOS_HRTIMER_H
+#define _LOS_HRTIMER_H
+
+#include "los_base.h"
+#include "los_sortlink_pri.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#ifdef LOSCFG_KERNEL_HRTIMER
+/**
+ * @ingroup los_hrtimer
+ * High resolution timer error code: The timer or the callback function is NULL.
+ *
+ * Value: 0x02001a00
+ *
+ * Solution: Pass in a valid timer and callback function.
+ */
+#define LOS_ERRNO_HRTIMER_PTR_NULL          LOS_ERRNO_OS_ERROR(LOS_MOD_TIMER, 0x00)
+
+/**
+ * @ingroup los_hrtimer
+ * High resolution timer error code: The expiration time is 0.
+ *
+ * Value: 0x02001a01
+ *
+ * Solution: Re-define the expiration time.
+ */
+#define LOS_ERRNO_HRTIMER_INTERVAL_INVALID  LOS_ERRNO_OS_ERROR(LOS_MOD_TIMER, 0x01)
+
+/**
+ * @ingroup los_hrtimer
+ * High resolution timer error code: The timer is not started or has already expired.
+ *
+ * Value: 0x02001a02
+ *
+ * Solution: None.
+ */
+#define LOS_ERRNO_HRTIMER_NOT_STARTED       LOS_ERRNO_OS_ERROR(LOS_MOD_TIMER, 0x02)
+
+/**
+ * @ingroup los_hrtimer
+ * 高精度定时器到期回调，在滴答中断上下文中关中断执行，不能阻塞
+ */
+typedef VOID (*HRTIMER_PROC_FUNC)(UINTPTR arg);
+
+/**
+ * @ingroup los_hrtimer
+ * 高精度定时器控制块，由使用者分配，内容只能通过接口访问
+ */
+typedef struct {
+    SortLinkList      sortList; /**< 挂在启动CPU的高精度定时器队列上，未启动时到期时间为无效值 */
+    HRTIMER_PROC_FUNC handler;  /**< 到期回调 */
+    UINTPTR           arg;      /**< 回调参数 */
+} LosHrtimer;
+
+/**
+ * @ingroup los_hrtimer
+ * @brief 初始化高精度定时器
+ *
+ * @par Description:
+ * 定时器为单次模式，到期后需在回调中再次调用LOS_HrtimerStart实现周期触发。
+ *
+ * @param  timer   [IN] 定时器控制块。
+ * @param  handler [IN] 到期回调。
+ * @param  arg     [IN] 回调参数。
+ *
+ * @retval #LOS_ERRNO_HRTIMER_PTR_NULL  定时器或回调为空。
+ * @retval #LOS_OK                      初始化成功。
+ * @par Dependency:
+ * <ul><li>los_hrtimer.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_HrtimerStart | LOS_HrtimerCancel
+ */
+extern UINT32 LOS_HrtimerCreate(LosHrtimer *timer, HRTIMER_PROC_FUNC handler, UINTPTR arg);
+
+/**
+ * @ingroup los_hrtimer
+ * @brief 启动高精度定时器
+ *
+ * @par Description:
+ * 定时器挂到当前CPU的高精度定时器队列上，并直接按到期时间设置该CPU滴答定时器的比较值，
+ * 到期误差在OS_HRTIMER_PRECISION_US以内。已启动的定时器会按新的时长重新启动。
+ * @attention
+ * <ul>
+ * <li>同一个定时器的启动与取消需由使用者串行化，回调中重新启动自身除外。</li>
+ * </ul>
+ *
+ * @param  timer [IN] 定时器控制块。
+ * @param  us    [IN] 从当前时刻起的相对时长（微秒）。
+ *
+ * @retval #LOS_ERRNO_HRTIMER_PTR_NULL          定时器为空或未初始化。
+ * @retval #LOS_ERRNO_HRTIMER_INTERVAL_INVALID  时长为0。
+ * @retval #LOS_OK                              启动成功。
+ * @par Dependency:
+ * <ul><li>los_hrtimer.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_HrtimerCancel
+ */
+extern UINT32 LOS_HrtimerStart(LosHrtimer *timer, UINT64 us);
+
+/**
+ * @ingroup los_hrtimer
+ * @brief 取消高精度定时器
+ *
+ * @par Description:
+ * 不等待其他CPU上正在执行的回调结束。
+ *
+ * @param  timer [IN] 定时器控制块。
+ *
+ * @retval #LOS_ERRNO_HRTIMER_PTR_NULL     定时器为空。
+ * @retval #LOS_ERRNO_HRTIMER_NOT_STARTED  定时器未启动或已到期。
+ * @retval #LOS_OK                         取消成功。
+ * @par Dependency:
+ * <ul><li>los_hrtimer.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_HrtimerStart
+ */
+extern UINT32 LOS_HrtimerCancel(LosHrtimer *timer);
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#endif /* _LOS_HRTIMER_H */
@@ -49,8 +49,17 @@ enum LockDepErrType {
     LOCKDEP_ERR_UNLOCK_WITOUT_LOCK,
     /* overflow, needs expand */
     LOCKDEP_ERR_OVERFLOW,
+    LOCKDEP_ERR_ORDER,  //违反锁类别的加锁顺序
 };
 
+/*
+ * 锁类别，类别值小的锁必须先获取：g_taskSpin -> 软件定时器时间轮锁
+ * 未设置类别的锁（LOCKDEP_CLASS_NONE）不参与顺序校验
+ */
+#define LOCKDEP_CLASS_NONE      0U
+#define LOCKDEP_CLASS_TASK      1U //任务调度器全局锁g_taskSpin
+#define LOCKDEP_CLASS_SWTMR     2U //每CPU软件定时器时间轮锁，子序号为CPU编号
+
 typedef struct {
     VOID *lockPtr;
     VOID *lockAddr;
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @defgroup los_slab Slab object cache
+ * @ingroup kernel
+ */
+
+#ifndef _LOS_SLAB_H
+#define _LOS_SLAB_H
+
+#include "los_typedef.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+/**
+ * @ingroup los_slab
+ * 对象缓存名称的最大长度（含结束符）
+ */
+#define LOS_SLAB_NAME_LEN 16
+
+/**
+ * @ingroup los_slab
+ * 对象构造函数，新slab切分出对象时对每个对象调用一次。
+ * 对象释放回缓存时必须保持构造后的状态，再次分配时不会重新构造。
+ */
+typedef VOID (*LosSlabCtor)(VOID *obj);
+
+/**
+ * @ingroup los_slab
+ * 对象缓存控制块，结构对使用者不可见
+ */
+typedef struct LosSlabCache LosSlabCache;
+
+/**
+ * @ingroup los_slab
+ * 对象缓存统计信息
+ */
+typedef struct {
+    CHAR   name[LOS_SLAB_NAME_LEN]; /**< 缓存名称 */
+    UINT32 objSize;                 /**< 对象大小（字节） */
+    UINT32 slabSize;                /**< 单个slab大小（字节） */
+    UINT32 slabNum;                 /**< slab个数 */
+    UINT32 objTotal;                /**< 全部slab可容纳的对象数 */
+    UINT32 objActive;               /**< 使用者持有的对象数 */
+    UINT32 allocCount;              /**< 累计分配次数 */
+    UINT32 freeCount;               /**< 累计释放次数 */
+    UINT32 magazineHit;             /**< 直接命中per-CPU对象栈的分配次数 */
+} LosSlabInfo;
+
+/**
+ * @ingroup los_slab
+ * @brief 创建定长对象缓存
+ *
+ * @par Description:
+ * 对象从伙伴系统分配的连续物理页（slab）中切分，每个CPU在本地缓存少量空闲对象，
+ * 分配释放命中本地缓存时只关中断，不争用内存池锁。
+ * @attention
+ * <ul>
+ * <li>应在模块初始化时创建，不再使用时调用LOS_SlabCacheDestroy销毁。</li>
+ * <li>objSize不能超过2048字节。</li>
+ * </ul>
+ *
+ * @param  name    [IN] 缓存名称，在/proc/slabinfo中显示。
+ * @param  objSize [IN] 对象大小。
+ * @param  ctor    [IN] 对象构造函数，可为NULL。
+ *
+ * @retval #NULL  参数错误或内存不足。
+ * @retval 缓存控制块指针。
+ * @par Dependency:
+ * <ul><li>los_slab.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_SlabAlloc | LOS_SlabFree | LOS_SlabCacheDestroy
+ */
+extern LosSlabCache *LOS_SlabCacheCreate(const CHAR *name, UINT32 objSize, LosSlabCtor ctor);
+
+/**
+ * @ingroup los_slab
+ * @brief 销毁对象缓存
+ *
+ * @par Description:
+ * 收回各CPU本地缓存的对象，释放全部slab与缓存控制块。
+ * @attention
+ * <ul>
+ * <li>调用期间不能有其他任务或中断使用该缓存。</li>
+ * <li>仍有对象未释放时返回失败，缓存保持可用。</li>
+ * </ul>
+ *
+ * @param  cache [IN] 对象缓存。
+ *
+ * @retval #LOS_NOK  参数错误或仍有对象未释放。
+ * @retval #LOS_OK   销毁成功。
+ * @par Dependency:
+ * <ul><li>los_slab.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_SlabCacheCreate
+ */
+extern UINT32 LOS_SlabCacheDestroy(LosSlabCache *cache);
+
+/**
+ * @ingroup los_slab
+ * @brief 从对象缓存分配一个对象
+ *
+ * @par Description:
+ * 对象内容为构造函数初始化后或上次释放时的状态，未注册构造函数时内容不确定。
+ *
+ * @param  cache [IN] 对象缓存。
+ *
+ * @retval #NULL  内存不足。
+ * @retval 对象地址。
+ * @par Dependency:
+ * <ul><li>los_slab.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_SlabFree
+ */
+extern VOID *LOS_SlabAlloc(LosSlabCache *cache);
+
+/**
+ * @ingroup los_slab
+ * @brief 将对象释放回对象缓存
+ *
+ * @param  cache [IN] 分配该对象的缓存。
+ * @param  obj   [IN] 对象地址，为NULL时直接返回。
+ *
+ * @retval 无
+ * @par Dependency:
+ * <ul><li>los_slab.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_SlabAlloc
+ */
+extern VOID LOS_SlabFree(LosSlabCache *cache, VOID *obj);
+
+/**
+ * @ingroup los_slab
+ * @brief 获取对象缓存统计信息
+ *
+ * @param  info [OUT] 统计信息数组。
+ * @param  num  [IN]  数组元素个数。
+ *
+ * @retval 实际填写的缓存个数。
+ * @par Dependency:
+ * <ul><li>los_slab.h: the header file that contains the API declaration.</li></ul>
+ */
+extern UINT32 LOS_SlabInfoGet(LosSlabInfo *info, UINT32 num);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+
+#endif /* _LOS_SLAB_H */
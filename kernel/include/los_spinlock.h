@@ -46,16 +46,34 @@ extern "C" {
 extern VOID ArchSpinLock(size_t *lock);
 extern VOID ArchSpinUnlock(size_t *lock);
 extern INT32 ArchSpinTrylock(size_t *lock);
+
+/**
+ * @brief 票据锁字段解析
+ * @details rawLock 低16位为当前服务号，高16位为下一个待发放的票号，二者相等表示未上锁；
+ *          各核按领票顺序依次获得锁，保证竞争下的公平性
+ */
+#define ARCH_SPIN_TICKET_SHIFT  16
+#define ARCH_SPIN_TICKET_MASK   0xFFFFU
+#define ARCH_SPIN_OWNER(raw)    ((UINT32)(raw) & ARCH_SPIN_TICKET_MASK)                              // 当前服务号
+#define ARCH_SPIN_NEXT(raw)     (((UINT32)(raw) >> ARCH_SPIN_TICKET_SHIFT) & ARCH_SPIN_TICKET_MASK)  // 下一个票号
 /**
  * @brief 自旋锁结构体定义
  * @details 用于实现多处理器环境下的同步机制，确保临界区资源的互斥访问
  */
 typedef struct Spinlock {
-    size_t      rawLock;                  // 自旋锁原始状态值，0表示未锁定，1表示已锁定
+    size_t      rawLock;                  // 票据锁原始值，低16位为当前服务号，高16位为下一个票号，相等表示未锁定
 #ifdef LOSCFG_KERNEL_SMP                  // 若启用SMP（对称多处理）配置
     UINT32      cpuid;                    // 持有锁的CPU核心ID
     VOID        *owner;                   // 持有锁的任务/线程指针
     const CHAR  *name;                    // 自旋锁名称，用于调试和跟踪
+#ifdef LOSCFG_KERNEL_SMP_LOCKDEP
+    UINT16      lockClass;                // 锁类别，锁依赖检查据此校验加锁顺序，0表示不参与校验
+    UINT16      subClass;                 // 同类别锁的子序号，同类锁必须按子序号递增的顺序嵌套获取
+#endif
+#ifdef LOSCFG_KERNEL_SMP_LOCK_STAT
+    UINT32      acquired;                 // 成功获取锁的次数
+    UINT32      contended;                // 获取锁时发生竞争（需要自旋等待）的次数
+#endif
 #endif
 } SPIN_LOCK_S;                            // 自旋锁结构体类型定义
 
@@ -79,11 +97,22 @@ typedef struct Spinlock {
  * @brief 清除所有锁依赖记录
  */
 #define LOCKDEP_CLEAR_LOCKS()   OsLockdepClearSpinlocks() // 清除自旋锁的依赖记录
+/**
+ * @brief 设置锁类别
+ * @param[in] lock 自旋锁指针
+ * @param[in] cls 锁类别，取值为LOCKDEP_CLASS_xxx
+ * @param[in] sub 同类别锁的子序号
+ */
+#define LOCKDEP_CLASS_SET(lock, cls, sub) do { \
+    (lock)->lockClass = (cls);                  \
+    (lock)->subClass = (sub);                   \
+} while (0)
 #else                                     // 未启用锁依赖检查时
 #define LOCKDEP_CHECK_IN(lock)                           // 空宏，不执行任何操作
 #define LOCKDEP_RECORD(lock)                             // 空宏，不执行任何操作
 #define LOCKDEP_CHECK_OUT(lock)                          // 空宏，不执行任何操作
 #define LOCKDEP_CLEAR_LOCKS()                            // 空宏，不执行任何操作
+#define LOCKDEP_CLASS_SET(lock, cls, sub)                // 空宏，不执行任何操作
 #endif
 
 #ifdef LOSCFG_KERNEL_SMP                  // 若启用SMP配置
@@ -150,12 +150,8 @@ extern "C" {
 
 /**
  * @ingroup los_swtmr
- * Software timer error code: Insufficient memory allocated by membox.
- *
- * Value: 0x0200030a
- *
- * Solution: Expand the memory allocated by membox.
- */	//membox分配的内存不足
+ * This error code is not in use temporarily. It is reserved since the software timer handler pool was removed.
+ */	//暂不使用该错误码，回调句柄池移除后保留
 #define LOS_ERRNO_SWTMR_HANDLER_POOL_NO_MEM    LOS_ERRNO_OS_ERROR(LOS_MOD_SWTMR, 0x0a)
 
 /**
@@ -915,6 +915,33 @@ extern UINT32 LOS_TaskDelete(UINT32 taskID);
  */
 extern UINT32 LOS_TaskDelay(UINT32 tick);
 
+/**
+ * @ingroup  los_task
+ * @brief Delay a task in microseconds.
+ *
+ * @par Description:
+ * This API is used to delay the execution of the current task for a specified number of microseconds. The expiry is
+ * programmed into the one-shot tick timer directly instead of being rounded up to whole Ticks.
+ *
+ * @attention
+ * <ul>
+ * <li>The restrictions of #LOS_TaskDelay also apply to this API.</li>
+ * <li>The expiry may be merged with a neighbouring one within #OS_TICK_RESPONSE_PRECISION, which is about 10us when
+ * LOSCFG_KERNEL_HRTIMER is enabled and 0.75 Tick otherwise. The task is never woken up early.</li>
+ * </ul>
+ *
+ * @param  microseconds [IN] Type #UINT64 Number of microseconds for which the task is delayed.
+ *
+ * @retval #LOS_ERRNO_TSK_DELAY_IN_INT              The task delay occurs during an interrupt.
+ * @retval #LOS_ERRNO_TSK_DELAY_IN_LOCK             The task delay occurs when the task scheduling is locked.
+ * @retval #LOS_ERRNO_TSK_OPERATE_SYSTEM_TASK       The current task is a system task.
+ * @retval #LOS_OK                                  The task is successfully delayed.
+ * @par Dependency:
+ * <ul><li>los_task.h: the header file that contains the API declaration.</li></ul>
+ * @see LOS_TaskDelay
+ */
+extern UINT32 LOS_TaskDelayUs(UINT64 microseconds);
+
 /**
  * @ingroup  los_task
  * @brief Lock the task scheduling.
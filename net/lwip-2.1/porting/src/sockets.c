@@ -257,6 +257,9 @@ static ssize_t lwip_sendto_wrap(int s, const void *dataptr, size_t size, int fla
 struct file;
 extern void poll_wait(struct file *filp, wait_queue_head_t *wait_address, poll_table *p);
 extern void __wake_up_interruptible_poll(wait_queue_head_t *wait, pollevent_t key);
+#ifdef LOSCFG_FS_VFS
+extern void EpollNotify(int fd, unsigned int events);
+#endif
 
 static void poll_check_waiters(int s, int check_waiters)
 {
@@ -282,6 +285,12 @@ static void poll_check_waiters(int s, int check_waiters)
 
     SYS_ARCH_UNPROTECT(lev);
 
+#ifdef LOSCFG_FS_VFS
+    if (mask) {
+        EpollNotify(s, mask);
+    }
+#endif
+
     spin_lock_irqsave(&sock->wq.lock, int_save);
     wq_empty = LOS_ListEmpty(&(sock->wq.poll_queue));
     spin_unlock_irqrestore(&sock->wq.lock, int_save);
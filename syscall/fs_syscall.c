@@ -63,6 +63,8 @@
 #define TIMESPEC_TIMES_NUM  2
 // 定义默认的epoll大小
 #define EPOLL_DEFAULT_SIZE  100
+// 定义readv/writev类调用使用栈上iovec数组的最大元素数量，超过时才从堆分配
+#define UIO_FASTIOV         8
 
 /**
  * @brief 检查并更新文件属性的访问时间和修改时间
@@ -175,15 +177,29 @@ static int UserIovItemCheck(const struct iovec *iov, const int iovcnt)
     return iovcnt;  // 所有元素有效，返回元素总数
 }
 
+/**
+ * @brief 释放UserIovCopy得到的内核iovec数组
+ * @param[in] iovBuf 内核空间的iovec数组
+ * @param[in] iovStack 调用者提供的栈上数组，iovBuf指向它时无需释放
+ */
+static void UserIovFree(struct iovec *iovBuf, const struct iovec *iovStack)
+{
+    if ((iovBuf != NULL) && (iovBuf != iovStack)) {  // 仅释放堆上分配的数组
+        (void)LOS_MemFree(OS_SYS_MEM_ADDR, iovBuf);
+    }
+}
+
 /**
  * @brief 从用户空间复制iovec数组并检查有效性
  * @param[out] iovBuf 输出内核空间的iovec数组
+ * @param[in] iovStack 调用者栈上的UIO_FASTIOV个元素的数组，元素不多时直接使用，避免堆分配
  * @param[in] iov 用户空间的iovec数组
  * @param[in] iovcnt 数组元素数量
  * @param[out] valid_iovcnt 有效元素数量
- * @return 成功返回0，失败返回错误码
+ * @return 成功返回0，失败返回错误码；用完后以UserIovFree释放
  */
-static int UserIovCopy(struct iovec **iovBuf, const struct iovec *iov, const int iovcnt, int *valid_iovcnt)
+static int UserIovCopy(struct iovec **iovBuf, struct iovec *iovStack, const struct iovec *iov,
+                       const int iovcnt, int *valid_iovcnt)
 {
     int ret;  // 返回值
     int bufLen = iovcnt * sizeof(struct iovec);  // 计算缓冲区大小
@@ -191,22 +207,25 @@ static int UserIovCopy(struct iovec **iovBuf, const struct iovec *iov, const int
         return -EINVAL;  // 无效大小返回错误
     }
 
-    // 分配内核空间缓冲区
-    *iovBuf = (struct iovec*)LOS_MemAlloc(OS_SYS_MEM_ADDR, bufLen);
-    if (*iovBuf == NULL) {  // 检查分配是否成功
-        return -ENOMEM;  // 内存不足返回错误
+    if (iovcnt <= UIO_FASTIOV) {  // 常见的少量元素直接使用栈上数组
+        *iovBuf = iovStack;
+    } else {  // 分配内核空间缓冲区
+        *iovBuf = (struct iovec*)LOS_MemAlloc(OS_SYS_MEM_ADDR, bufLen);
+        if (*iovBuf == NULL) {  // 检查分配是否成功
+            return -ENOMEM;  // 内存不足返回错误
+        }
     }
 
     // 从用户空间复制iovec数组
     if (LOS_ArchCopyFromUser(*iovBuf, iov, bufLen) != 0) {
-        (void)LOS_MemFree(OS_SYS_MEM_ADDR, *iovBuf);  // 复制失败释放内存
+        UserIovFree(*iovBuf, iovStack);  // 复制失败释放内存
         return -EFAULT;  // 返回访问错误
     }
 
     // 检查iovec数组有效性
     ret = UserIovItemCheck(*iovBuf, iovcnt);
     if (ret == 0) {  // 第一个元素就无效
-        (void)LOS_MemFree(OS_SYS_MEM_ADDR, *iovBuf);  // 释放内存
+        UserIovFree(*iovBuf, iovStack);  // 释放内存
         return -EFAULT;  // 返回访问错误
     }
 
@@ -1841,6 +1860,7 @@ ssize_t SysReadv(int fd, const struct iovec *iov, int iovcnt)
     int ret;                                 // 函数返回值
     int valid_iovcnt = -1;                   // 有效向量数量
     struct iovec *iovRet = NULL;             // 向量数组副本
+    struct iovec iovStack[UIO_FASTIOV];      // 栈上向量数组
 
     /* Process fd convert to system global fd */
     fd = GetAssociatedSystemFd(fd);          // 将进程文件描述符转换为系统全局描述符
@@ -1852,7 +1872,7 @@ ssize_t SysReadv(int fd, const struct iovec *iov, int iovcnt)
         return 0;                            // 返回0
     }
 
-    ret = UserIovCopy(&iovRet, iov, iovcnt, &valid_iovcnt);  // 复制并验证向量数组
+    ret = UserIovCopy(&iovRet, iovStack, iov, iovcnt, &valid_iovcnt);  // 复制并验证向量数组
     if (ret != 0) {                          // 检查复制是否成功
         return ret;                          // 返回错误码
     }
@@ -1868,7 +1888,7 @@ ssize_t SysReadv(int fd, const struct iovec *iov, int iovcnt)
     }
 
 OUT:
-    (void)LOS_MemFree(OS_SYS_MEM_ADDR, iovRet);  // 释放内存
+    UserIovFree(iovRet, iovStack);           // 释放内存
     return ret;                              // 返回读取字节数
 }
 
@@ -1884,6 +1904,7 @@ ssize_t SysWritev(int fd, const struct iovec *iov, int iovcnt)
     int ret;                                 // 函数返回值
     int valid_iovcnt = -1;                   // 有效向量数量
     struct iovec *iovRet = NULL;             // 向量数组副本
+    struct iovec iovStack[UIO_FASTIOV];      // 栈上向量数组
 
     /* Process fd convert to system global fd */
     int sysfd = GetAssociatedSystemFd(fd);   // 将进程文件描述符转换为系统全局描述符
@@ -1899,7 +1920,7 @@ ssize_t SysWritev(int fd, const struct iovec *iov, int iovcnt)
         return -EFAULT;                      // 返回内存访问错误
     }
 
-    ret = UserIovCopy(&iovRet, iov, iovcnt, &valid_iovcnt);  // 复制并验证向量数组
+    ret = UserIovCopy(&iovRet, iovStack, iov, iovcnt, &valid_iovcnt);  // 复制并验证向量数组
     if (ret != 0) {                          // 检查复制是否成功
         return ret;                          // 返回错误码
     }
@@ -1915,7 +1936,7 @@ ssize_t SysWritev(int fd, const struct iovec *iov, int iovcnt)
     }
 
 OUT_FREE:
-    (void)LOS_MemFree(OS_SYS_MEM_ADDR, iovRet);  // 释放内存
+    UserIovFree(iovRet, iovStack);           // 释放内存
     return ret;                              // 返回写入字节数
 }
 
@@ -2619,6 +2640,7 @@ ssize_t SysPreadv(int fd, const struct iovec *iov, int iovcnt, long loffset, lon
     int ret;  // preadv返回值
     int valid_iovcnt = -1;  // 有效的iovec数量
     struct iovec *iovRet = NULL;  // 内核空间iovec数组
+    struct iovec iovStack[UIO_FASTIOV];  // 栈上iovec数组，元素较少时免去堆分配
 
     /* Process fd convert to system global fd */
     fd = GetAssociatedSystemFd(fd);  // 将进程文件描述符转换为系统全局文件描述符
@@ -2630,7 +2652,7 @@ ssize_t SysPreadv(int fd, const struct iovec *iov, int iovcnt, long loffset, lon
         return 0;
     }
 
-    ret = UserIovCopy(&iovRet, iov, iovcnt, &valid_iovcnt);  // 复制用户空间iovec到内核空间
+    ret = UserIovCopy(&iovRet, iovStack, iov, iovcnt, &valid_iovcnt);  // 复制用户空间iovec到内核空间
     if (ret != 0) {  // 复制失败处理
         return ret;  // 返回错误码
     }
@@ -2646,7 +2668,7 @@ ssize_t SysPreadv(int fd, const struct iovec *iov, int iovcnt, long loffset, lon
     }
 
 OUT_FREE:  // 释放资源标签
-    (void)(void)LOS_MemFree(OS_SYS_MEM_ADDR, iovRet);  // 释放内核空间iovec数组
+    UserIovFree(iovRet, iovStack);  // 释放内核空间iovec数组
     return ret;  // 返回结果
 }
 
@@ -2667,6 +2689,7 @@ ssize_t SysPwritev(int fd, const struct iovec *iov, int iovcnt, long loffset, lo
     int ret;  // pwritev返回值
     int valid_iovcnt = -1;  // 有效的iovec数量
     struct iovec *iovRet = NULL;  // 内核空间iovec数组
+    struct iovec iovStack[UIO_FASTIOV];  // 栈上iovec数组，元素较少时免去堆分配
 
     /* Process fd convert to system global fd */
     fd = GetAssociatedSystemFd(fd);  // 将进程文件描述符转换为系统全局文件描述符
@@ -2678,7 +2701,7 @@ ssize_t SysPwritev(int fd, const struct iovec *iov, int iovcnt, long loffset, lo
         return 0;
     }
 
-    ret = UserIovCopy(&iovRet, iov, iovcnt, &valid_iovcnt);  // 复制用户空间iovec到内核空间
+    ret = UserIovCopy(&iovRet, iovStack, iov, iovcnt, &valid_iovcnt);  // 复制用户空间iovec到内核空间
     if (ret != 0) {  // 复制失败处理
         return ret;  // 返回错误码
     }
@@ -2694,7 +2717,7 @@ ssize_t SysPwritev(int fd, const struct iovec *iov, int iovcnt, long loffset, lo
     }
 
 OUT_FREE:  // 释放资源标签
-    (void)LOS_MemFree(OS_SYS_MEM_ADDR, iovRet);  // 释放内核空间iovec数组
+    UserIovFree(iovRet, iovStack);  // 释放内核空间iovec数组
     return ret;  // 返回结果
 }
 
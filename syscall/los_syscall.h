@@ -144,7 +144,7 @@ extern int SysThreadJoin(unsigned int taskID);
 extern void SysUserExitGroup(int status);
 extern void SysThreadExit(int status);
 extern int SysFutex(const unsigned int *uAddr, unsigned int flags, int val,
-                    unsigned int absTime, const unsigned int *newUserAddr);
+                    unsigned int absTime, const unsigned int *newUserAddr, unsigned int val3);
 extern int SysSchedGetAffinity(int id, unsigned int *cpuset, int flag);
 extern int SysSchedSetAffinity(int id, const unsigned short cpuset, int flag);
 
@@ -1637,19 +1637,31 @@ void SysThreadExit(int status)
  * @param uAddr 用户空间地址
  * @param flags 操作标志
  * @param val 值
- * @param absTime 绝对时间
+ * @param absTime 绝对时间；REQUEUE类操作为重排队数量，WAKE_OP为第二个地址的唤醒数量
  * @param newUserAddr 新用户空间地址
+ * @param val3 CMP_REQUEUE的期望值或WAKE_OP的操作编码
  * @return 成功返回0，失败返回错误码
  */
 int SysFutex(const unsigned int *uAddr, unsigned int flags, int val,
-             unsigned int absTime, const unsigned int *newUserAddr)
+             unsigned int absTime, const unsigned int *newUserAddr, unsigned int val3)
 {
-    if ((flags & FUTEX_MASK) == FUTEX_REQUEUE) {  // 重新排队操作
-        return -OsFutexRequeue(uAddr, flags, val, absTime, newUserAddr);
-    }
-
-    if ((flags & FUTEX_MASK) == FUTEX_WAKE) {  // 唤醒操作
-        return -OsFutexWake(uAddr, flags, val);
+    switch (flags & FUTEX_MASK) {
+        case FUTEX_REQUEUE:  // 重新排队操作
+            return -OsFutexRequeue(uAddr, flags, val, absTime, newUserAddr);
+        case FUTEX_CMP_REQUEUE:  // 比较重新排队操作
+            return -OsFutexCmpRequeue(uAddr, flags, val, absTime, newUserAddr, val3);
+        case FUTEX_WAKE:  // 唤醒操作
+            return -OsFutexWake(uAddr, flags, val);
+        case FUTEX_WAKE_OP:  // 唤醒并操作
+            return -OsFutexWakeOp(uAddr, flags, val, (int)absTime, newUserAddr, val3);
+        case FUTEX_LOCK_PI:  // 优先级继承加锁
+            return -OsFutexLockPi(uAddr, flags, absTime);
+        case FUTEX_TRYLOCK_PI:  // 优先级继承尝试加锁
+            return -OsFutexTrylockPi(uAddr, flags);
+        case FUTEX_UNLOCK_PI:  // 优先级继承解锁
+            return -OsFutexUnlockPi(uAddr, flags);
+        default:
+            break;
     }
 
     return -OsFutexWait(uAddr, flags, val, absTime);  // 等待操作
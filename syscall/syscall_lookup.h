@@ -217,7 +217,7 @@ SYSCALL_HAND_DEF(__NR_gettid, SysGetTid, unsigned int, ARG_NUM_0)  // 获取线
 
 SYSCALL_HAND_DEF(__NR_tkill, SysPthreadKill, int, ARG_NUM_2)  // 向线程发送信号系统调用
 
-SYSCALL_HAND_DEF(__NR_futex, SysFutex, int, ARG_NUM_4)  // 快速用户空间互斥锁系统调用
+SYSCALL_HAND_DEF(__NR_futex, SysFutex, int, ARG_NUM_6)  // 快速用户空间互斥锁系统调用
 SYSCALL_HAND_DEF(__NR_exit_group, SysUserExitGroup, void, ARG_NUM_1)  // 退出进程组系统调用
 SYSCALL_HAND_DEF(__NR_set_thread_area, SysSetThreadArea, int, ARG_NUM_1)  // 设置线程局部存储系统调用
 SYSCALL_HAND_DEF(__NR_get_thread_area, SysGetThreadArea, char *, ARG_NUM_0)  // 获取线程局部存储系统调用
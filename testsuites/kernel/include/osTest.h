@@ -326,12 +326,15 @@ extern VOID ItSuiteLosTask(VOID);
 extern VOID ItSuiteLosEvent(VOID);
 
 extern VOID ItSuiteLosMux(VOID);
+extern VOID ItSuiteLosPage(VOID);
+extern VOID ItSuiteLosSlab(VOID);
 extern VOID ItSuiteLosRwlock(VOID);
 extern VOID ItSuiteLosSem(VOID);
 extern VOID ItSuiteSmpHwi(VOID);
 extern VOID ItSuiteHwiNesting(VOID);
 
 extern VOID ItSuiteExtendCpup(VOID);
+extern VOID ItSuiteExtendFs(VOID);
 
 extern VOID ItSuitePosixMutex(VOID);
 extern VOID ItSuitePosixPthread(VOID);
@@ -132,6 +132,10 @@ VOID ItSuiteLosSwtmr(VOID)
     ItLosSwtmr076();
     ItLosSwtmr077();
     ItLosSwtmr078();
+    ItLosSwtmr079();
+#ifdef LOSCFG_KERNEL_HRTIMER
+    ItLosSwtmr084();
+#endif
 #endif
 
 #if defined(LOSCFG_TEST_PRESSURE)
@@ -177,6 +177,10 @@ VOID ItLosSwtmr075(VOID);
 VOID ItLosSwtmr076(VOID);
 VOID ItLosSwtmr077(VOID);
 VOID ItLosSwtmr078(VOID);
+VOID ItLosSwtmr079(VOID);
+#ifdef LOSCFG_KERNEL_HRTIMER
+VOID ItLosSwtmr084(VOID);
+#endif
 #endif
 
 #if defined(LOSCFG_TEST_PRESSURE)
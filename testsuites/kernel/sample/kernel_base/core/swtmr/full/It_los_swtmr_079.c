@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_swtmr.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Timer churn: restart and stop a set of long periodic timers many times,
+ * the way network retransmit and poll timeouts do, and report the cost of one
+ * start/stop pair. A short one-shot timer armed in the middle of the churn must
+ * still fire on time.
+ */
+#define CHURN_TIMER_NUM    32
+#define CHURN_LOOP_NUM     2000
+#define CHURN_TICK_BASE    1000
+
+static VOID SwtmrF01(UINT32 arg)
+{
+    (VOID)arg;
+    g_testCount++;
+}
+
+static UINT32 Testcase(VOID)
+{
+    UINT32 ret;
+    UINT32 index;
+    UINT32 loop;
+    UINT16 swTmrID[CHURN_TIMER_NUM];
+    UINT16 shortID = 0;
+    UINT32 created = 0;
+    UINT64 start;
+    UINT64 cost;
+
+    g_testCount = 0;
+
+    for (index = 0; index < CHURN_TIMER_NUM; index++) {
+        ret = LOS_SwtmrCreate(CHURN_TICK_BASE + index, LOS_SWTMR_MODE_PERIOD, (SWTMR_PROC_FUNC)SwtmrF01,
+                              &swTmrID[index], 0);
+        ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+        created++;
+    }
+
+    ret = LOS_SwtmrCreate(5, LOS_SWTMR_MODE_NO_SELFDELETE, (SWTMR_PROC_FUNC)SwtmrF01, &shortID, 0); // 5, timeout
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    ret = LOS_SwtmrStart(shortID);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT1);
+
+    start = LOS_CurrNanosec();
+    for (loop = 0; loop < CHURN_LOOP_NUM; loop++) {
+        for (index = 0; index < CHURN_TIMER_NUM; index++) {
+            (VOID)LOS_SwtmrStart(swTmrID[index]);
+        }
+        for (index = 0; index < CHURN_TIMER_NUM; index++) {
+            (VOID)LOS_SwtmrStop(swTmrID[index]);
+        }
+    }
+    cost = LOS_CurrNanosec() - start;
+
+    dprintf("swtmr churn: %llu ns per start/stop pair over %u timers\n",
+            cost / ((UINT64)CHURN_LOOP_NUM * CHURN_TIMER_NUM), CHURN_TIMER_NUM);
+
+    ret = LOS_TaskDelay(10); // 10, set delay time
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT1);
+    ICUNIT_GOTO_EQUAL(g_testCount, 1, g_testCount, EXIT1);
+
+EXIT1:
+    (VOID)LOS_SwtmrDelete(shortID);
+EXIT:
+    for (index = 0; index < created; index++) {
+        (VOID)LOS_SwtmrDelete(swTmrID[index]);
+    }
+    return LOS_OK;
+}
+
+VOID ItLosSwtmr079(VOID)
+{
+    TEST_ADD_CASE("ItLosSwtmr079", Testcase, TEST_LOS, TEST_SWTMR, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
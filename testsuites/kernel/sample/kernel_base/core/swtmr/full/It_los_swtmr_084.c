@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "It_los_swtmr.h"
+#include "los_hrtimer.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+#ifdef LOSCFG_KERNEL_HRTIMER
+#define HRTIMER_TEST_US   500
+#define HRTIMER_LONG_US   1000000
+
+static LosHrtimer g_hrtimer;
+static UINT64 g_hrtimerFireNs;
+
+static VOID HrtimerF01(UINTPTR arg)
+{
+    if (arg != 0xffff) {
+        return;
+    }
+
+    g_hrtimerFireNs = LOS_CurrNanosec();
+    g_testCount++;
+}
+
+static UINT32 Testcase(VOID)
+{
+    UINT32 ret;
+    UINT64 startNs;
+
+    g_testCount = 0;
+
+    ret = LOS_HrtimerCreate(&g_hrtimer, NULL, 0xffff);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_ERRNO_HRTIMER_PTR_NULL, ret);
+
+    ret = LOS_HrtimerCreate(&g_hrtimer, HrtimerF01, 0xffff);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    ret = LOS_HrtimerStart(&g_hrtimer, 0);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_ERRNO_HRTIMER_INTERVAL_INVALID, ret);
+
+    ret = LOS_HrtimerCancel(&g_hrtimer);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_ERRNO_HRTIMER_NOT_STARTED, ret);
+
+    /* 短于一个tick的定时器按微秒到期，不会提前 */
+    startNs = LOS_CurrNanosec();
+    ret = LOS_HrtimerStart(&g_hrtimer, HRTIMER_TEST_US);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    LOS_TaskDelay(2); // 2, wait for the timer to expire
+    ICUNIT_ASSERT_EQUAL(g_testCount, 1, g_testCount);
+    ICUNIT_ASSERT_EQUAL((g_hrtimerFireNs - startNs) >= (HRTIMER_TEST_US * OS_SYS_NS_PER_US), TRUE, g_hrtimerFireNs);
+
+    /* 已到期的定时器不能取消 */
+    ret = LOS_HrtimerCancel(&g_hrtimer);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_ERRNO_HRTIMER_NOT_STARTED, ret);
+
+    /* 取消后不再触发 */
+    ret = LOS_HrtimerStart(&g_hrtimer, HRTIMER_LONG_US);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    ret = LOS_HrtimerStart(&g_hrtimer, HRTIMER_LONG_US);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    ret = LOS_HrtimerCancel(&g_hrtimer);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    LOS_TaskDelay(2); // 2, the canceled timer must not fire
+    ICUNIT_ASSERT_EQUAL(g_testCount, 1, g_testCount);
+
+    return LOS_OK;
+}
+
+VOID ItLosSwtmr084(VOID) // IT_Layer_ModuleORFeature_No
+{
+    TEST_ADD_CASE("ItLosSwtmr084", Testcase, TEST_LOS, TEST_SWTMR, TEST_LEVEL0, TEST_FUNCTION);
+}
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
@@ -174,6 +174,11 @@ void ItSuiteLosTask(void)
     ItSmpLosTask155();
     ItSmpLosTask156();
     ItSmpLosTask157();
+    ItSmpLosTask162(); /* scheduler switch and wakeup latency benchmark */
+    ItSmpLosTask163(); /* spinlock contention stress */
+    ItSmpLosTask164(); /* fpu and non-fpu context switch benchmark */
+    ItSmpLosTask167(); /* cross-core wakeup IPI benchmark */
+    ItSmpLosTask168(); /* vfp state across signal handler */
 #endif
 }
 #ifdef __cplusplus
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_task.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Scheduler microbenchmark: ping-pong task pairs driven by semaphores.
+ * Pair i runs its ping task on core i and its pong task on core (i + shift) % cores.
+ * shift == 0 measures same-core context switch cost, shift == 1 measures cross-core wakeup latency.
+ */
+#define BENCH_LOOP_NUM    1000
+#define BENCH_PRIO        (TASK_PRIO_TEST_TASK - 1)
+
+typedef struct {
+    UINT32 pingSem;
+    UINT32 pongSem;
+    UINT32 pingTaskID;
+    UINT32 pongTaskID;
+    UINT64 postTime;
+    UINT64 roundTripTotal;
+    UINT64 wakeupTotal;
+    UINT64 wakeupMax;
+} SchedBenchPair;
+
+static SchedBenchPair g_benchPair[LOSCFG_KERNEL_CORE_NUM];
+static UINT32 g_benchDoneSem;
+
+static void PingTask(UINTPTR index)
+{
+    SchedBenchPair *pair = &g_benchPair[index];
+
+    for (UINT32 loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        UINT64 start = LOS_CurrNanosec();
+        pair->postTime = start;
+        (VOID)LOS_SemPost(pair->pongSem);
+        (VOID)LOS_SemPend(pair->pingSem, LOS_WAIT_FOREVER);
+        pair->roundTripTotal += LOS_CurrNanosec() - start;
+    }
+
+    (VOID)LOS_SemPost(g_benchDoneSem);
+}
+
+static void PongTask(UINTPTR index)
+{
+    SchedBenchPair *pair = &g_benchPair[index];
+
+    for (UINT32 loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        (VOID)LOS_SemPend(pair->pongSem, LOS_WAIT_FOREVER);
+        UINT64 latency = LOS_CurrNanosec() - pair->postTime;
+        pair->wakeupTotal += latency;
+        if (latency > pair->wakeupMax) {
+            pair->wakeupMax = latency;
+        }
+        (VOID)LOS_SemPost(pair->pingSem);
+    }
+
+    (VOID)LOS_SemPost(g_benchDoneSem);
+}
+
+static UINT32 BenchRun(UINT32 cores, UINT32 shift)
+{
+    UINT32 ret;
+    UINT32 index;
+    TSK_INIT_PARAM_S task = { 0 };
+    UINT64 roundTrip = 0;
+    UINT64 wakeup = 0;
+    UINT64 wakeupMax = 0;
+
+    (VOID)memset_s(g_benchPair, sizeof(g_benchPair), 0, sizeof(g_benchPair));
+    for (index = 0; index < cores; index++) {
+        SchedBenchPair *pair = &g_benchPair[index];
+        ret = LOS_SemCreate(0, &pair->pingSem);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+        ret = LOS_SemCreate(0, &pair->pongSem);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+        TEST_TASK_PARAM_INIT_AFFI(task, "sched_bench_pong", PongTask, BENCH_PRIO, CPUID_TO_AFFI_MASK((index + shift) % cores));
+        task.auwArgs[0] = index;
+        ret = LOS_TaskCreate(&pair->pongTaskID, &task);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+        TEST_TASK_PARAM_INIT_AFFI(task, "sched_bench_ping", PingTask, BENCH_PRIO, CPUID_TO_AFFI_MASK(index));
+        task.auwArgs[0] = index;
+        ret = LOS_TaskCreate(&pair->pingTaskID, &task);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    }
+
+    for (index = 0; index < (cores * 2); index++) { /* 2: ping and pong task of every pair */
+        ret = LOS_SemPend(g_benchDoneSem, LOS_WAIT_FOREVER);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    }
+
+    for (index = 0; index < cores; index++) {
+        SchedBenchPair *pair = &g_benchPair[index];
+        roundTrip += pair->roundTripTotal;
+        wakeup += pair->wakeupTotal;
+        wakeupMax = (pair->wakeupMax > wakeupMax) ? pair->wakeupMax : wakeupMax;
+        (VOID)LOS_SemDelete(pair->pingSem);
+        (VOID)LOS_SemDelete(pair->pongSem);
+    }
+
+    /* a round trip contains two switches */
+    dprintf("cores: %u %s switch: %llu ns wakeup avg: %llu ns max: %llu ns\n", cores,
+            (shift == 0) ? "local" : "remote", roundTrip / ((UINT64)cores * BENCH_LOOP_NUM * 2),
+            wakeup / ((UINT64)cores * BENCH_LOOP_NUM), wakeupMax);
+    return LOS_OK;
+}
+
+static UINT32 Testcase(void)
+{
+    UINT32 ret;
+
+    ret = LOS_SemCreate(0, &g_benchDoneSem);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    for (UINT32 cores = 1; cores <= LOSCFG_KERNEL_CORE_NUM; cores++) {
+        ret = BenchRun(cores, 0);
+        ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+        if (cores > 1) {
+            ret = BenchRun(cores, 1);
+            ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+        }
+    }
+
+EXIT:
+    (VOID)LOS_SemDelete(g_benchDoneSem);
+    return LOS_OK;
+}
+
+void ItSmpLosTask162(void)
+{
+    TEST_ADD_CASE("ItSmpLosTask162", Testcase, TEST_LOS, TEST_TASK, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
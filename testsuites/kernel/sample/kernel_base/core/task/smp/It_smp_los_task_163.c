@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_task.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Spinlock contention stress: one task per core hammers the same spinlock.
+ * Checks mutual exclusion through an unprotected counter and reports the
+ * average and worst-case acquire latency seen on every core.
+ */
+#define STRESS_LOOP_NUM    20000
+#define STRESS_HOLD_NUM    16
+#define STRESS_PRIO        (TASK_PRIO_TEST_TASK - 1)
+
+typedef struct {
+    UINT64 acquireTotal;
+    UINT64 acquireMax;
+} SpinStressCore;
+
+static SPIN_LOCK_INIT(g_stressSpin);
+static SpinStressCore g_stressCore[LOSCFG_KERNEL_CORE_NUM];
+static volatile UINT32 g_stressCount;
+static UINT32 g_stressDoneSem;
+
+static void StressTask(UINTPTR index)
+{
+    SpinStressCore *core = &g_stressCore[index];
+    UINT32 intSave;
+
+    for (UINT32 loop = 0; loop < STRESS_LOOP_NUM; loop++) {
+        UINT64 start = LOS_CurrNanosec();
+        LOS_SpinLockSave(&g_stressSpin, &intSave);
+        UINT64 latency = LOS_CurrNanosec() - start;
+        /* non-atomic read-modify-write, only correct under mutual exclusion */
+        for (UINT32 hold = 0; hold < STRESS_HOLD_NUM; hold++) {
+            g_stressCount++;
+        }
+        LOS_SpinUnlockRestore(&g_stressSpin, intSave);
+
+        core->acquireTotal += latency;
+        if (latency > core->acquireMax) {
+            core->acquireMax = latency;
+        }
+    }
+
+    (VOID)LOS_SemPost(g_stressDoneSem);
+}
+
+static UINT32 Testcase(void)
+{
+    UINT32 ret;
+    UINT32 index;
+    UINT32 taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    g_stressCount = 0;
+    (VOID)memset_s(g_stressCore, sizeof(g_stressCore), 0, sizeof(g_stressCore));
+    ret = LOS_SemCreate(0, &g_stressDoneSem);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    for (index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {
+        TEST_TASK_PARAM_INIT_AFFI(task, "spin_stress", StressTask, STRESS_PRIO, CPUID_TO_AFFI_MASK(index));
+        task.auwArgs[0] = index;
+        ret = LOS_TaskCreate(&taskID, &task);
+        ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    }
+
+    for (index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {
+        ret = LOS_SemPend(g_stressDoneSem, LOS_WAIT_FOREVER);
+        ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    }
+
+    for (index = 0; index < LOSCFG_KERNEL_CORE_NUM; index++) {
+        dprintf("core %u spinlock acquire avg: %llu ns max: %llu ns\n", index,
+                g_stressCore[index].acquireTotal / STRESS_LOOP_NUM, g_stressCore[index].acquireMax);
+    }
+    ICUNIT_GOTO_EQUAL(g_stressCount, LOSCFG_KERNEL_CORE_NUM * STRESS_LOOP_NUM * STRESS_HOLD_NUM, g_stressCount, EXIT);
+
+EXIT:
+    (VOID)LOS_SemDelete(g_stressDoneSem);
+    return LOS_OK;
+}
+
+void ItSmpLosTask163(void)
+{
+    TEST_ADD_CASE("ItSmpLosTask163", Testcase, TEST_LOS, TEST_TASK, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
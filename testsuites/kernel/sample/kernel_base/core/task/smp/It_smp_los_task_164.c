@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_task.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Context switch microbenchmark for FPU and non-FPU tasks: a ping-pong task pair
+ * on one core, once with integer-only tasks and once with tasks that touch the
+ * FPU every round, so the second run includes saving and restoring VFP state.
+ */
+#define BENCH_LOOP_NUM    2000
+#define BENCH_PRIO        (TASK_PRIO_TEST_TASK - 1)
+
+static UINT32 g_pingSem;
+static UINT32 g_pongSem;
+static UINT32 g_doneSem;
+static BOOL g_useFpu;
+static volatile double g_fpuSink;
+
+static VOID FpuTouch(UINT32 loop)
+{
+    if (g_useFpu) {
+        g_fpuSink = g_fpuSink * 0.5 + (double)loop; /* 0.5: keep the value bounded */
+    }
+}
+
+static void PingTask(void)
+{
+    for (UINT32 loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        FpuTouch(loop);
+        (VOID)LOS_SemPost(g_pongSem);
+        (VOID)LOS_SemPend(g_pingSem, LOS_WAIT_FOREVER);
+    }
+    (VOID)LOS_SemPost(g_doneSem);
+}
+
+static void PongTask(void)
+{
+    for (UINT32 loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        (VOID)LOS_SemPend(g_pongSem, LOS_WAIT_FOREVER);
+        FpuTouch(loop);
+        (VOID)LOS_SemPost(g_pingSem);
+    }
+    (VOID)LOS_SemPost(g_doneSem);
+}
+
+static UINT32 BenchRun(BOOL useFpu)
+{
+    UINT32 ret;
+    UINT32 taskID;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    g_useFpu = useFpu;
+    UINT64 start = LOS_CurrNanosec();
+
+    TEST_TASK_PARAM_INIT_AFFI(task, "fpu_bench_pong", PongTask, BENCH_PRIO, CPUID_TO_AFFI_MASK(0));
+    ret = LOS_TaskCreate(&taskID, &task);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    TEST_TASK_PARAM_INIT_AFFI(task, "fpu_bench_ping", PingTask, BENCH_PRIO, CPUID_TO_AFFI_MASK(0));
+    ret = LOS_TaskCreate(&taskID, &task);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    for (UINT32 index = 0; index < 2; index++) { /* 2: ping and pong task */
+        ret = LOS_SemPend(g_doneSem, LOS_WAIT_FOREVER);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    }
+
+    /* a round contains two switches */
+    dprintf("%s tasks switch: %llu ns\n", useFpu ? "fpu" : "non-fpu",
+            (LOS_CurrNanosec() - start) / ((UINT64)BENCH_LOOP_NUM * 2));
+    return LOS_OK;
+}
+
+static UINT32 Testcase(void)
+{
+    UINT32 ret;
+
+    ret = LOS_SemCreate(0, &g_pingSem);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    ret = LOS_SemCreate(0, &g_pongSem);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT1);
+    ret = LOS_SemCreate(0, &g_doneSem);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT2);
+
+    ret = BenchRun(FALSE);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT3);
+    ret = BenchRun(TRUE);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT3);
+
+EXIT3:
+    (VOID)LOS_SemDelete(g_doneSem);
+EXIT2:
+    (VOID)LOS_SemDelete(g_pongSem);
+EXIT1:
+    (VOID)LOS_SemDelete(g_pingSem);
+    return LOS_OK;
+}
+
+void ItSmpLosTask164(void)
+{
+    TEST_ADD_CASE("ItSmpLosTask164", Testcase, TEST_LOS, TEST_TASK, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_task.h"
+#include "los_percpu_pri.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Cross-core wakeup cost: a ping task on core 0 and a pong task on core 1
+ * hand a semaphore back and forth. Reports round trips per second and the
+ * number of scheduling IPIs sent per wakeup, which should stay close to one
+ * now that wakeups only interrupt the core that has to reschedule.
+ */
+#define PINGPONG_LOOP_NUM    5000
+#define PINGPONG_PRIO        (TASK_PRIO_TEST_TASK - 1)
+
+static UINT32 g_pingSem;
+static UINT32 g_pongSem;
+static UINT32 g_doneSem;
+
+static void PingTask(UINTPTR arg)
+{
+    (VOID)arg;
+    for (UINT32 loop = 0; loop < PINGPONG_LOOP_NUM; loop++) {
+        (VOID)LOS_SemPost(g_pongSem);
+        (VOID)LOS_SemPend(g_pingSem, LOS_WAIT_FOREVER);
+    }
+    (VOID)LOS_SemPost(g_doneSem);
+}
+
+static void PongTask(UINTPTR arg)
+{
+    (VOID)arg;
+    for (UINT32 loop = 0; loop < PINGPONG_LOOP_NUM; loop++) {
+        (VOID)LOS_SemPend(g_pongSem, LOS_WAIT_FOREVER);
+        (VOID)LOS_SemPost(g_pingSem);
+    }
+    (VOID)LOS_SemPost(g_doneSem);
+}
+
+static UINT32 IpiSendSum(void)
+{
+    UINT32 sum = 0;
+
+    for (UINT32 cpuid = 0; cpuid < LOSCFG_KERNEL_CORE_NUM; cpuid++) {
+        sum += g_percpu[cpuid].schedIpiSend;
+    }
+    return sum;
+}
+
+static UINT32 Testcase(void)
+{
+    UINT32 ret;
+    UINT32 taskID;
+    UINT32 ipiStart;
+    UINT32 ipiCost;
+    UINT64 start;
+    UINT64 cost;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    ret = LOS_SemCreate(0, &g_pingSem);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    ret = LOS_SemCreate(0, &g_pongSem);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT2);
+    ret = LOS_SemCreate(0, &g_doneSem);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT1);
+
+    ipiStart = IpiSendSum();
+    start = LOS_CurrNanosec();
+    TEST_TASK_PARAM_INIT_AFFI(task, "pong_bench", PongTask, PINGPONG_PRIO, CPUID_TO_AFFI_MASK(1));
+    ret = LOS_TaskCreate(&taskID, &task);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    TEST_TASK_PARAM_INIT_AFFI(task, "ping_bench", PingTask, PINGPONG_PRIO, CPUID_TO_AFFI_MASK(0));
+    ret = LOS_TaskCreate(&taskID, &task);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+
+    for (UINT32 index = 0; index < 2; index++) { /* 2, ping and pong task */
+        ret = LOS_SemPend(g_doneSem, LOS_WAIT_FOREVER);
+        ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    }
+    cost = LOS_CurrNanosec() - start;
+    ipiCost = IpiSendSum() - ipiStart;
+
+    dprintf("cross-core sem ping-pong: %llu round trips/s, %u sched IPIs for %u wakeups\n",
+            ((UINT64)PINGPONG_LOOP_NUM * OS_SYS_NS_PER_SECOND) / (cost ? cost : 1),
+            ipiCost, PINGPONG_LOOP_NUM * 2); /* 2, two wakeups per round trip */
+
+EXIT:
+    (VOID)LOS_SemDelete(g_doneSem);
+EXIT1:
+    (VOID)LOS_SemDelete(g_pongSem);
+EXIT2:
+    (VOID)LOS_SemDelete(g_pingSem);
+    return LOS_OK;
+}
+
+void ItSmpLosTask167(void)
+{
+    TEST_ADD_CASE("ItSmpLosTask167", Testcase, TEST_LOS, TEST_TASK, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_task.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+#ifdef ARCH_FPU_LAZY
+extern VOID OsFpuTrap(UINT32 cpsr);
+extern VOID OsFpuOwnerRelease(VOID);
+extern VOID OsFpuSignalSave(UINT32 taskID);
+extern VOID OsFpuSignalRestore(UINT32 taskID);
+
+/*
+ * Signal plus VFP: replays the exception-path sequence of a signal delivered to a task that
+ * owns the VFP registers, with a handler that clobbers them, and checks that the interrupted
+ * code sees its own d0/d15 again after sigreturn.
+ */
+#define FPU_INTERRUPTED_VAL    0x0123456789abcdefULL
+#define FPU_HANDLER_VAL        0xfedcba9876543210ULL
+
+static VOID FpuRegsSet(UINT64 val)
+{
+    __asm__ __volatile__("vmov d0, %Q0, %R0\n"
+                         "vmov d15, %Q0, %R0\n"
+                         : : "r"(val) : "d0", "d15");
+}
+
+static VOID FpuRegsGet(UINT64 *d0, UINT64 *d15)
+{
+    __asm__ __volatile__("vmov %Q0, %R0, d0\n"
+                         "vmov %Q1, %R1, d15\n"
+                         : "=r"(*d0), "=r"(*d15));
+}
+
+static UINT32 Testcase(void)
+{
+    UINT64 d0;
+    UINT64 d15;
+    UINT32 taskID = OsCurrTaskGet()->taskID;
+    UINT32 intSave = LOS_IntLock();
+
+    OsFpuTrap(CPSR_USER_MODE);      /* interrupted code uses the VFP and owns the registers */
+    FpuRegsSet(FPU_INTERRUPTED_VAL);
+    OsFpuSignalSave(taskID);        /* signal delivered */
+    OsFpuTrap(CPSR_USER_MODE);      /* handler uses the VFP */
+    FpuRegsGet(&d0, &d15);
+    FpuRegsSet(FPU_HANDLER_VAL);
+    OsFpuSignalRestore(taskID);     /* sigreturn */
+    OsFpuTrap(CPSR_USER_MODE);      /* interrupted code resumes its VFP use */
+    UINT64 resumeD0;
+    UINT64 resumeD15;
+    FpuRegsGet(&resumeD0, &resumeD15);
+    OsFpuOwnerRelease();
+    LOS_IntRestore(intSave);
+
+    ICUNIT_ASSERT_EQUAL(d0 == FPU_INTERRUPTED_VAL, TRUE, d0);
+    ICUNIT_ASSERT_EQUAL(d15 == FPU_INTERRUPTED_VAL, TRUE, d15);
+    ICUNIT_ASSERT_EQUAL(resumeD0 == FPU_INTERRUPTED_VAL, TRUE, resumeD0);
+    ICUNIT_ASSERT_EQUAL(resumeD15 == FPU_INTERRUPTED_VAL, TRUE, resumeD15);
+    return LOS_OK;
+}
+#endif
+
+void ItSmpLosTask168(void)
+{
+#ifdef ARCH_FPU_LAZY
+    TEST_ADD_CASE("ItSmpLosTask168", Testcase, TEST_LOS, TEST_TASK, TEST_LEVEL1, TEST_FUNCTION);
+#endif
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
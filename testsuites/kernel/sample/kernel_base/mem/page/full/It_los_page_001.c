@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_page.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Page frame alloc/free throughput: one task per participating core keeps
+ * allocating and freeing single pages, repeated with 1..N cores so the
+ * scaling of the per-CPU page caches is visible in the reported pages/s.
+ */
+#define PAGE_LOOP_NUM     2000
+#define PAGE_BATCH_NUM    8
+#define PAGE_PRIO         (TASK_PRIO_TEST_TASK - 1)
+
+static UINT32 g_pageDoneSem;
+static volatile UINT32 g_pageFailed;
+
+static void PageTask(UINTPTR arg)
+{
+    LosVmPage *pages[PAGE_BATCH_NUM];
+    UINT32 index;
+
+    (VOID)arg;
+    for (UINT32 loop = 0; loop < PAGE_LOOP_NUM; loop++) {
+        for (index = 0; index < PAGE_BATCH_NUM; index++) {
+            pages[index] = LOS_PhysPageAlloc();
+            if (pages[index] == NULL) {
+                g_pageFailed++;
+                break;
+            }
+            LOS_AtomicInc(&pages[index]->refCounts);
+        }
+        while (index > 0) {
+            index--;
+            LOS_PhysPageFree(pages[index]);
+        }
+    }
+
+    (VOID)LOS_SemPost(g_pageDoneSem);
+}
+
+static UINT32 Testcase(VOID)
+{
+    UINT32 ret;
+    UINT32 cores;
+    UINT32 index;
+    UINT32 taskID;
+    UINT64 start;
+    UINT64 cost;
+    TSK_INIT_PARAM_S task = { 0 };
+
+    g_pageFailed = 0;
+    ret = LOS_SemCreate(0, &g_pageDoneSem);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+
+    for (cores = 1; cores <= LOSCFG_KERNEL_CORE_NUM; cores++) {
+        start = LOS_CurrNanosec();
+        for (index = 0; index < cores; index++) {
+            TEST_TASK_PARAM_INIT_AFFI(task, "page_bench", PageTask, PAGE_PRIO, CPUID_TO_AFFI_MASK(index));
+            ret = LOS_TaskCreate(&taskID, &task);
+            ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+        }
+
+        for (index = 0; index < cores; index++) {
+            ret = LOS_SemPend(g_pageDoneSem, LOS_WAIT_FOREVER);
+            ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+        }
+        cost = LOS_CurrNanosec() - start;
+
+        dprintf("%u cores page alloc/free: %llu pages/s\n", cores,
+                ((UINT64)cores * PAGE_LOOP_NUM * PAGE_BATCH_NUM * OS_SYS_NS_PER_SECOND) / (cost ? cost : 1));
+    }
+    ICUNIT_GOTO_EQUAL(g_pageFailed, 0, g_pageFailed, EXIT);
+
+EXIT:
+    (VOID)LOS_SemDelete(g_pageDoneSem);
+    return LOS_OK;
+}
+
+VOID ItLosPage001(VOID)
+{
+    TEST_ADD_CASE("ItLosPage001", Testcase, TEST_LOS, TEST_MEM, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
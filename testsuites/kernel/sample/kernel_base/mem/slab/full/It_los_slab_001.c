@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_slab.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Allocate enough objects to span several slabs, check that every object is
+ * constructed exactly once, that objects stay in their constructed state
+ * across free/alloc, and that the statistics follow the allocations. The
+ * cache is destroyed at the end, which fails while an object is still out.
+ */
+#define SLAB_TEST_OBJ_NUM   200
+#define SLAB_TEST_MAGIC     0x5A5A5A5A
+
+typedef struct {
+    UINT32 magic;
+    UINT32 data[15]; /* 15, pad the object to 64 bytes */
+} SlabTestObj;
+
+static UINT32 g_ctorCount;
+
+static VOID SlabTestCtor(VOID *obj)
+{
+    ((SlabTestObj *)obj)->magic = SLAB_TEST_MAGIC;
+    g_ctorCount++;
+}
+
+static UINT32 SlabTestInfoGet(const CHAR *name, LosSlabInfo *out)
+{
+    LosSlabInfo info[32]; /* 32, more than the caches the kernel creates */
+    UINT32 num = LOS_SlabInfoGet(info, 32); /* 32, array size */
+
+    for (UINT32 i = 0; i < num; i++) {
+        if (strcmp(info[i].name, name) == 0) {
+            *out = info[i];
+            return LOS_OK;
+        }
+    }
+    return LOS_NOK;
+}
+
+static UINT32 Testcase(VOID)
+{
+    static SlabTestObj *objs[SLAB_TEST_OBJ_NUM];
+    LosSlabCache *cache = NULL;
+    LosSlabInfo info;
+    UINT32 index;
+    UINT32 ret;
+
+    cache = LOS_SlabCacheCreate("test_slab_001", 0, NULL);
+    ICUNIT_ASSERT_EQUAL(cache, NULL, cache);
+
+    g_ctorCount = 0;
+    cache = LOS_SlabCacheCreate("test_slab_001", sizeof(SlabTestObj), SlabTestCtor);
+    ICUNIT_ASSERT_NOT_EQUAL(cache, NULL, cache);
+
+    for (index = 0; index < SLAB_TEST_OBJ_NUM; index++) {
+        objs[index] = (SlabTestObj *)LOS_SlabAlloc(cache);
+        ICUNIT_GOTO_NOT_EQUAL(objs[index], NULL, index, EXIT);
+        ICUNIT_GOTO_EQUAL(objs[index]->magic, SLAB_TEST_MAGIC, objs[index]->magic, EXIT);
+        ICUNIT_GOTO_EQUAL(((UINTPTR)objs[index] & (sizeof(UINT64) - 1)), 0, objs[index], EXIT);
+        objs[index]->data[0] = index;
+    }
+    for (index = 0; index < SLAB_TEST_OBJ_NUM; index++) {
+        ICUNIT_GOTO_EQUAL(objs[index]->data[0], index, objs[index]->data[0], EXIT);
+    }
+
+    ret = SlabTestInfoGet("test_slab_001", &info);
+    ICUNIT_GOTO_EQUAL(ret, LOS_OK, ret, EXIT);
+    ICUNIT_GOTO_EQUAL(info.objActive, SLAB_TEST_OBJ_NUM, info.objActive, EXIT);
+    ICUNIT_GOTO_EQUAL(g_ctorCount, info.objTotal, g_ctorCount, EXIT);
+    ICUNIT_GOTO_NOT_EQUAL(info.slabNum, 1, info.slabNum, EXIT);
+
+    for (index = 0; index < SLAB_TEST_OBJ_NUM; index++) {
+        LOS_SlabFree(cache, objs[index]);
+    }
+
+    /* freed objects come back in their constructed state */
+    for (index = 0; index < SLAB_TEST_OBJ_NUM; index++) {
+        objs[index] = (SlabTestObj *)LOS_SlabAlloc(cache);
+        ICUNIT_GOTO_NOT_EQUAL(objs[index], NULL, index, EXIT);
+        ICUNIT_GOTO_EQUAL(objs[index]->magic, SLAB_TEST_MAGIC, objs[index]->magic, EXIT);
+    }
+
+    for (index = 0; index < SLAB_TEST_OBJ_NUM; index++) {
+        LOS_SlabFree(cache, objs[index]);
+    }
+    ret = SlabTestInfoGet("test_slab_001", &info);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    ICUNIT_GOTO_EQUAL(info.objActive, 0, info.objActive, EXIT_DESTROY);
+    ICUNIT_GOTO_EQUAL(info.allocCount, info.freeCount, info.allocCount, EXIT_DESTROY);
+
+    /* a cache with an object still out cannot be destroyed */
+    objs[0] = (SlabTestObj *)LOS_SlabAlloc(cache);
+    ICUNIT_GOTO_NOT_EQUAL(objs[0], NULL, objs[0], EXIT_DESTROY);
+    ret = LOS_SlabCacheDestroy(cache);
+    ICUNIT_GOTO_EQUAL(ret, LOS_NOK, ret, EXIT_DESTROY);
+    LOS_SlabFree(cache, objs[0]);
+
+    ret = LOS_SlabCacheDestroy(cache);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+    ret = SlabTestInfoGet("test_slab_001", &info);
+    ICUNIT_ASSERT_EQUAL(ret, LOS_NOK, ret);
+    return LOS_OK;
+
+EXIT:
+    while (index > 0) {
+        LOS_SlabFree(cache, objs[--index]);
+    }
+EXIT_DESTROY:
+    (VOID)LOS_SlabCacheDestroy(cache);
+    return LOS_OK;
+}
+
+VOID ItLosSlab001(VOID)
+{
+    TEST_ADD_CASE("ItLosSlab001", Testcase, TEST_LOS, TEST_MEM, TEST_LEVEL1, TEST_FUNCTION);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
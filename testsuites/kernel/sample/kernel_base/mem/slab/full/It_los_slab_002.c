@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_los_slab.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Alloc/free benchmark: hold a small working set of objects the size of a
+ * file page descriptor and churn it, once through an object cache and once
+ * through LOS_MemAlloc on the system pool, and report the cost per pair.
+ */
+#define BENCH_OBJ_SIZE      96
+#define BENCH_SET_NUM       8
+#define BENCH_LOOP_NUM      20000
+
+static UINT32 Testcase(VOID)
+{
+    VOID *objs[BENCH_SET_NUM];
+    LosSlabCache *cache = NULL;
+    UINT32 loop;
+    UINT32 index;
+    UINT64 start;
+    UINT64 slabCost;
+    UINT64 memCost;
+
+    cache = LOS_SlabCacheCreate("test_slab_002", BENCH_OBJ_SIZE, NULL);
+    ICUNIT_ASSERT_NOT_EQUAL(cache, NULL, cache);
+
+    start = LOS_CurrNanosec();
+    for (loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        for (index = 0; index < BENCH_SET_NUM; index++) {
+            objs[index] = LOS_SlabAlloc(cache);
+            ICUNIT_ASSERT_NOT_EQUAL(objs[index], NULL, index);
+        }
+        for (index = 0; index < BENCH_SET_NUM; index++) {
+            LOS_SlabFree(cache, objs[index]);
+        }
+    }
+    slabCost = LOS_CurrNanosec() - start;
+    ICUNIT_ASSERT_EQUAL(LOS_SlabCacheDestroy(cache), LOS_OK, cache);
+
+    start = LOS_CurrNanosec();
+    for (loop = 0; loop < BENCH_LOOP_NUM; loop++) {
+        for (index = 0; index < BENCH_SET_NUM; index++) {
+            objs[index] = LOS_MemAlloc(m_aucSysMem0, BENCH_OBJ_SIZE);
+            ICUNIT_ASSERT_NOT_EQUAL(objs[index], NULL, index);
+        }
+        for (index = 0; index < BENCH_SET_NUM; index++) {
+            (VOID)LOS_MemFree(m_aucSysMem0, objs[index]);
+        }
+    }
+    memCost = LOS_CurrNanosec() - start;
+
+    dprintf("slab alloc/free: %llu ns per pair, LOS_MemAlloc/LOS_MemFree: %llu ns per pair\n",
+            slabCost / ((UINT64)BENCH_LOOP_NUM * BENCH_SET_NUM), memCost / ((UINT64)BENCH_LOOP_NUM * BENCH_SET_NUM));
+    return LOS_OK;
+}
+
+VOID ItLosSlab002(VOID)
+{
+    TEST_ADD_CASE("ItLosSlab002", Testcase, TEST_LOS, TEST_MEM, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
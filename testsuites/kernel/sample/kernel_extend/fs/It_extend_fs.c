@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_extend_fs.h"
+#if defined(LOSCFG_TEST_FULL) && defined(LOSCFG_FS_FAT)
+#include "fs/driver.h"
+#include "fs/fs_operation.h"
+#include "los_vm_map.h"
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+#if defined(LOSCFG_TEST_FULL) && defined(LOSCFG_FS_FAT)
+#define FS_RAMDISK_FORMAT_ANY   7   /* format() option: let mkfs pick the FAT type */
+
+static FsRamDisk *RamDiskGet(struct Vnode *vnode)
+{
+    return (FsRamDisk *)((struct drv_data *)vnode->data)->priv;
+}
+
+static ssize_t RamDiskRead(struct Vnode *vnode, unsigned char *buffer,
+                           unsigned long long startSector, unsigned int nSectors)
+{
+    FsRamDisk *ramDisk = RamDiskGet(vnode);
+
+    if ((startSector >= ramDisk->sectors) || (nSectors > (ramDisk->sectors - startSector))) {
+        return -EIO;
+    }
+    (VOID)memcpy_s(buffer, (size_t)nSectors * FS_RAMDISK_SECTOR_SIZE,
+                   ramDisk->media + startSector * FS_RAMDISK_SECTOR_SIZE, (size_t)nSectors * FS_RAMDISK_SECTOR_SIZE);
+    return (ssize_t)nSectors;
+}
+
+static ssize_t RamDiskWrite(struct Vnode *vnode, const unsigned char *buffer,
+                            unsigned long long startSector, unsigned int nSectors)
+{
+    FsRamDisk *ramDisk = RamDiskGet(vnode);
+
+    if ((startSector >= ramDisk->sectors) || (nSectors > (ramDisk->sectors - startSector))) {
+        return -EIO;
+    }
+    (VOID)memcpy_s(ramDisk->media + startSector * FS_RAMDISK_SECTOR_SIZE, (size_t)nSectors * FS_RAMDISK_SECTOR_SIZE,
+                   buffer, (size_t)nSectors * FS_RAMDISK_SECTOR_SIZE);
+    return (ssize_t)nSectors;
+}
+
+static int RamDiskGeometry(struct Vnode *vnode, struct geometry *geo)
+{
+    FsRamDisk *ramDisk = RamDiskGet(vnode);
+
+    geo->geo_available = TRUE;
+    geo->geo_mediachanged = FALSE;
+    geo->geo_writeenabled = TRUE;
+    geo->geo_nsectors = ramDisk->sectors;
+    geo->geo_sectorsize = FS_RAMDISK_SECTOR_SIZE;
+    return 0;
+}
+
+static const struct block_operations g_ramDiskOps = {
+    .read = RamDiskRead,
+    .write = RamDiskWrite,
+    .geometry = RamDiskGeometry,
+};
+
+/* Create the RAM disk, format its partition as FAT and mount it on mountDir */
+INT32 FsRamDiskCreate(FsRamDisk *ramDisk, const CHAR *name, UINT64 sectors, const CHAR *mountDir)
+{
+    struct disk_divide_info info;
+    INT32 ret;
+
+    (VOID)memset_s(ramDisk, sizeof(FsRamDisk), 0, sizeof(FsRamDisk));
+    (VOID)memset_s(&info, sizeof(info), 0, sizeof(info));
+    (VOID)snprintf_s(ramDisk->name, sizeof(ramDisk->name), sizeof(ramDisk->name) - 1, "/dev/%s", name);
+    (VOID)snprintf_s(ramDisk->part, sizeof(ramDisk->part), sizeof(ramDisk->part) - 1, "/dev/%sp0", name);
+    ramDisk->mountDir = mountDir;
+    ramDisk->sectors = sectors;
+    ramDisk->diskID = -1;
+    ramDisk->media = (UINT8 *)LOS_VMalloc(sectors * FS_RAMDISK_SECTOR_SIZE);
+    if (ramDisk->media == NULL) {
+        return -1;
+    }
+    (VOID)memset_s(ramDisk->media, sectors * FS_RAMDISK_SECTOR_SIZE, 0, sectors * FS_RAMDISK_SECTOR_SIZE);
+
+    info.sector_count = sectors;
+    info.sector_size = FS_RAMDISK_SECTOR_SIZE;
+    ret = add_mmc_partition(&info, 0, sectors);
+    if (ret != 0) {
+        goto ERROR_FREE;
+    }
+    ramDisk->diskID = los_alloc_diskid_byname(ramDisk->name);
+    if (ramDisk->diskID < 0) {
+        goto ERROR_FREE;
+    }
+    ret = los_disk_init(ramDisk->name, &g_ramDiskOps, ramDisk, ramDisk->diskID, &info);
+    if (ret != 0) {
+        goto ERROR_FREE;
+    }
+    if (format(ramDisk->part, 0, FS_RAMDISK_FORMAT_ANY) != 0) {
+        goto ERROR_DISK;
+    }
+    (VOID)mkdir(mountDir, S_IRWXU);
+    if (mount(ramDisk->part, mountDir, "vfat", 0, NULL) != 0) {
+        (VOID)rmdir(mountDir);
+        goto ERROR_DISK;
+    }
+    return 0;
+
+ERROR_DISK:
+    (VOID)los_disk_deinit(ramDisk->diskID);
+ERROR_FREE:
+    LOS_VFree(ramDisk->media);
+    ramDisk->media = NULL;
+    return -1;
+}
+
+/* Unmount and mount again, dropping every in-memory cache of the volume */
+INT32 FsRamDiskRemount(FsRamDisk *ramDisk)
+{
+    if (umount(ramDisk->mountDir) != 0) {
+        return -1;
+    }
+    return mount(ramDisk->part, ramDisk->mountDir, "vfat", 0, NULL);
+}
+
+VOID FsRamDiskDestroy(FsRamDisk *ramDisk)
+{
+    if (ramDisk->media == NULL) {
+        return;
+    }
+    (VOID)umount(ramDisk->mountDir);
+    (VOID)rmdir(ramDisk->mountDir);
+    (VOID)los_disk_deinit(ramDisk->diskID);
+    LOS_VFree(ramDisk->media);
+    ramDisk->media = NULL;
+}
+#endif
+
+VOID ItSuiteExtendFs(VOID)
+{
+#if defined(LOSCFG_TEST_FULL)
+#if defined(LOSCFG_FS_JFFS) && defined(LOSCFG_DRIVERS_MTD_RAM_NOR)
+    ItExtendFs001();
+#endif
+#if defined(LOSCFG_FS_FAT)
+    ItExtendFs002();
+    ItExtendFs003();
+#endif
+#endif
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
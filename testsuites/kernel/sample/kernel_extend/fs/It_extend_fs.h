@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IT_EXTEND_FS_H
+#define IT_EXTEND_FS_H
+
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mount.h"
+#include "sys/stat.h"
+#include "los_task.h"
+#include "osTest.h"
+#if defined(LOSCFG_TEST_FULL) && defined(LOSCFG_FS_FAT)
+#include "disk.h"
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+extern VOID ItSuiteExtendFs(VOID);
+
+#if defined(LOSCFG_TEST_FULL)
+#if defined(LOSCFG_FS_FAT)
+#define FS_RAMDISK_SECTOR_SIZE  512
+
+/* A FAT volume on a RAM backed block device, one partition covering the whole disk */
+typedef struct {
+    CHAR name[DISK_NAME + 1];   /* /dev/<name>, the partition is /dev/<name>p0 */
+    CHAR part[DISK_NAME + 1];
+    const CHAR *mountDir;
+    UINT8 *media;
+    UINT64 sectors;
+    INT32 diskID;
+} FsRamDisk;
+
+INT32 FsRamDiskCreate(FsRamDisk *ramDisk, const CHAR *name, UINT64 sectors, const CHAR *mountDir);
+INT32 FsRamDiskRemount(FsRamDisk *ramDisk);
+VOID FsRamDiskDestroy(FsRamDisk *ramDisk);
+#endif
+
+#if defined(LOSCFG_FS_JFFS) && defined(LOSCFG_DRIVERS_MTD_RAM_NOR)
+VOID ItExtendFs001(VOID);
+#endif
+#if defined(LOSCFG_FS_FAT)
+VOID ItExtendFs002(VOID);
+VOID ItExtendFs003(VOID);
+#endif
+#endif
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+#endif /* IT_EXTEND_FS_H */
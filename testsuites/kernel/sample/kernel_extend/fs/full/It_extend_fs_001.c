@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_extend_fs.h"
+#include "mtd_partition.h"
+#include "mtd_ramnor.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Mixed read/write benchmark for JFFS2 on a RAM emulated NOR flash. Reader tasks
+ * re-read small files whose inodes are cached, first alone and then while a writer
+ * task keeps rewriting a large file on a nearly full partition, so its writes run
+ * garbage collection and block erases. The erase delay makes GC as slow as on a
+ * real NOR flash. Reader latency should stay close to the idle case as long as
+ * reads do not queue behind the writer.
+ */
+#define BENCH_FLASH_SIZE        0x100000    /* 1MB, 16 erase blocks */
+#define BENCH_ERASE_SIZE        0x10000
+#define BENCH_ERASE_DELAY_MS    5
+#define BENCH_PART_NUM          (CONFIG_MTD_PATTITION_NUM - 1)
+#define BENCH_BLK_NAME_LEN      32
+#define BENCH_MOUNT_DIR         "/test_jffs2_bench"
+#define BENCH_PATH_LEN          64
+#define BENCH_READER_NUM        2
+#define BENCH_READ_FILE_NUM     4
+#define BENCH_READ_FILE_SIZE    1024
+#define BENCH_READ_LOOP_NUM     2000
+#define BENCH_WRITE_FILE_SIZE   0x30000     /* rewritten over and over, keeps GC busy */
+#define BENCH_WRITE_CHUNK       4096
+#define BENCH_TASK_STACK_SIZE   0x4000
+#define BENCH_WAIT_TICKS        10
+
+typedef struct {
+    UINT64 totalNs;
+    UINT64 maxNs;
+    UINT32 ops;
+    UINT32 errors;
+} BenchReadStat;
+
+static BenchReadStat g_readStat[BENCH_READER_NUM];
+static volatile UINT32 g_readersLeft;
+static volatile BOOL g_writerStop;
+static volatile BOOL g_writerDone;
+static volatile UINT64 g_writeBytes;
+static volatile UINT32 g_writeErrors;
+
+static VOID BenchFilePath(CHAR *path, UINT32 index)
+{
+    (VOID)snprintf_s(path, BENCH_PATH_LEN, BENCH_PATH_LEN - 1, "%s/r%u", BENCH_MOUNT_DIR, index);
+}
+
+static VOID BenchReader(UINTPTR index)
+{
+    BenchReadStat *stat = &g_readStat[index];
+    CHAR path[BENCH_PATH_LEN];
+    CHAR buf[BENCH_READ_FILE_SIZE];
+    UINT64 start, cost;
+    UINT32 loop;
+    INT32 fd;
+
+    for (loop = 0; loop < BENCH_READ_LOOP_NUM; loop++) {
+        BenchFilePath(path, (loop + index) % BENCH_READ_FILE_NUM);
+        start = LOS_CurrNanosec();
+        fd = open(path, O_RDONLY);
+        if ((fd < 0) || (read(fd, buf, sizeof(buf)) != sizeof(buf)) ||
+            (buf[0] != (CHAR)('a' + ((loop + index) % BENCH_READ_FILE_NUM)))) {
+            stat->errors++;
+        }
+        if (fd >= 0) {
+            (VOID)close(fd);
+        }
+        cost = LOS_CurrNanosec() - start;
+        stat->totalNs += cost;
+        stat->maxNs = (cost > stat->maxNs) ? cost : stat->maxNs;
+        stat->ops++;
+    }
+    LOS_AtomicDec((Atomic *)&g_readersLeft);
+}
+
+static VOID BenchWriter(VOID)
+{
+    CHAR path[BENCH_PATH_LEN];
+    CHAR buf[BENCH_WRITE_CHUNK];
+    UINT32 written;
+    INT32 fd;
+
+    (VOID)snprintf_s(path, sizeof(path), sizeof(path) - 1, "%s/w", BENCH_MOUNT_DIR);
+    (VOID)memset_s(buf, sizeof(buf), 'w', sizeof(buf));
+    while (!g_writerStop) {
+        fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            g_writeErrors++;
+            break;
+        }
+        for (written = 0; (written < BENCH_WRITE_FILE_SIZE) && !g_writerStop; written += sizeof(buf)) {
+            if (write(fd, buf, sizeof(buf)) != sizeof(buf)) {
+                g_writeErrors++;
+                break;
+            }
+            g_writeBytes += sizeof(buf);
+        }
+        (VOID)close(fd);
+    }
+    g_writerDone = TRUE;
+}
+
+static UINT32 BenchTaskCreate(const CHAR *name, TSK_ENTRY_FUNC entry, UINTPTR arg)
+{
+    TSK_INIT_PARAM_S param = {0};
+    UINT32 taskID;
+
+    param.pfnTaskEntry = entry;
+    param.auwArgs[0] = arg;
+    param.uwStackSize = BENCH_TASK_STACK_SIZE;
+    param.pcName = (CHAR *)name;
+    param.usTaskPrio = TASK_PRIO_TEST_TASK;
+    param.uwResved = LOS_TASK_STATUS_DETACHED;
+    return LOS_TaskCreate(&taskID, &param);
+}
+
+/* Run the readers to completion, with or without the writer, and report their latency */
+static UINT32 BenchReadRound(BOOL withWriter)
+{
+    UINT64 totalNs = 0;
+    UINT64 maxNs = 0;
+    UINT32 ops = 0;
+    UINT32 errors = 0;
+    UINT32 index;
+    UINT32 ret;
+
+    (VOID)memset_s(g_readStat, sizeof(g_readStat), 0, sizeof(g_readStat));
+    g_readersLeft = BENCH_READER_NUM;
+    g_writerStop = FALSE;
+    g_writerDone = !withWriter;
+    g_writeBytes = 0;
+
+    if (withWriter) {
+        ret = BenchTaskCreate("jffs2_bench_w", (TSK_ENTRY_FUNC)BenchWriter, 0);
+        ICUNIT_ASSERT_EQUAL(ret, LOS_OK, ret);
+        LOS_TaskDelay(BENCH_WAIT_TICKS); /* let GC get going before the readers start */
+    }
+    for (index = 0; index < BENCH_READER_NUM; index++) {
+        ret = BenchTaskCreate("jffs2_bench_r", (TSK_ENTRY_FUNC)BenchReader, index);
+        if (ret != LOS_OK) {
+            g_readStat[index].errors++;
+            LOS_AtomicDec((Atomic *)&g_readersLeft);
+        }
+    }
+    while (g_readersLeft != 0) {
+        LOS_TaskDelay(BENCH_WAIT_TICKS);
+    }
+    g_writerStop = TRUE;
+    while (!g_writerDone) {
+        LOS_TaskDelay(BENCH_WAIT_TICKS);
+    }
+
+    for (index = 0; index < BENCH_READER_NUM; index++) {
+        totalNs += g_readStat[index].totalNs;
+        maxNs = (g_readStat[index].maxNs > maxNs) ? g_readStat[index].maxNs : maxNs;
+        ops += g_readStat[index].ops;
+        errors += g_readStat[index].errors;
+    }
+    ICUNIT_ASSERT_EQUAL(errors, 0, errors);
+    ICUNIT_ASSERT_EQUAL(g_writeErrors, 0, g_writeErrors);
+
+    dprintf("jffs2 %s: %u reads, avg %llu ns, max %llu ns, %llu bytes written\n",
+            withWriter ? "reads with writer" : "reads alone", ops, totalNs / ops, maxNs, g_writeBytes);
+    return LOS_OK;
+}
+
+static UINT32 BenchFilesCreate(VOID)
+{
+    CHAR path[BENCH_PATH_LEN];
+    CHAR buf[BENCH_READ_FILE_SIZE];
+    UINT32 index;
+    INT32 fd;
+    INT32 ret;
+
+    for (index = 0; index < BENCH_READ_FILE_NUM; index++) {
+        BenchFilePath(path, index);
+        (VOID)memset_s(buf, sizeof(buf), 'a' + index, sizeof(buf));
+        fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+        ICUNIT_ASSERT_NOT_EQUAL(fd, -1, fd);
+        ret = write(fd, buf, sizeof(buf));
+        (VOID)close(fd);
+        ICUNIT_ASSERT_EQUAL(ret, sizeof(buf), ret);
+    }
+    return LOS_OK;
+}
+
+static VOID BenchFilesRemove(VOID)
+{
+    CHAR path[BENCH_PATH_LEN];
+    UINT32 index;
+
+    for (index = 0; index < BENCH_READ_FILE_NUM; index++) {
+        BenchFilePath(path, index);
+        (VOID)unlink(path);
+    }
+    (VOID)snprintf_s(path, sizeof(path), sizeof(path) - 1, "%s/w", BENCH_MOUNT_DIR);
+    (VOID)unlink(path);
+}
+
+static UINT32 Testcase(VOID)
+{
+    CHAR blkName[BENCH_BLK_NAME_LEN];
+    struct MtdDev *mtd = NULL;
+    UINT32 result = LOS_NOK;
+    INT32 ret;
+
+    g_writeErrors = 0;
+    mtd = RamNorCreate(BENCH_FLASH_SIZE, BENCH_ERASE_SIZE, BENCH_ERASE_DELAY_MS);
+    ICUNIT_ASSERT_NOT_EQUAL(mtd, NULL, mtd);
+    ret = add_mtd_partition("spinor", 0, BENCH_FLASH_SIZE, BENCH_PART_NUM);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT_MTD);
+    (VOID)snprintf_s(blkName, sizeof(blkName), sizeof(blkName) - 1, "%s%u", SPIBLK_NAME, BENCH_PART_NUM);
+    (VOID)mkdir(BENCH_MOUNT_DIR, S_IRWXU);
+    ret = mount(blkName, BENCH_MOUNT_DIR, "jffs2", 0, NULL);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT_PART);
+
+    ICUNIT_GOTO_EQUAL(BenchFilesCreate(), LOS_OK, LOS_NOK, EXIT_MOUNT);
+    ICUNIT_GOTO_EQUAL(BenchReadRound(FALSE), LOS_OK, LOS_NOK, EXIT_MOUNT);
+    ICUNIT_GOTO_EQUAL(BenchReadRound(TRUE), LOS_OK, LOS_NOK, EXIT_MOUNT);
+    result = LOS_OK;
+
+EXIT_MOUNT:
+    BenchFilesRemove();
+    (VOID)umount(BENCH_MOUNT_DIR);
+EXIT_PART:
+    (VOID)rmdir(BENCH_MOUNT_DIR);
+    (VOID)delete_mtd_partition(BENCH_PART_NUM, "spinor");
+EXIT_MTD:
+    (VOID)RamNorDestroy(mtd);
+    return result;
+}
+
+VOID ItExtendFs001(VOID)
+{
+    TEST_ADD_CASE("ItExtendFs001", Testcase, TEST_EXTEND, TEST_JFFS, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
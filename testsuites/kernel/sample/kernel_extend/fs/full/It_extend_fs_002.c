@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_extend_fs.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Lookup latency benchmark for FAT directories of growing size on a RAM disk. Each
+ * directory is filled with long named files and the volume is remounted, so every
+ * stat below misses the vnode and path caches and reaches fatfs_lookup. Lookups of
+ * existing names and of missing names are timed separately; with the directory name
+ * index both should stay flat as the directory grows, without it they grow linearly.
+ * The first lookup in each directory also pays for building the index and is shown
+ * on its own. A file created after the index is built must be found through it.
+ */
+#define BENCH_DISK_NAME         "ramfat_bench"
+#define BENCH_DISK_SECTORS      8192        /* 4MB */
+#define BENCH_MOUNT_DIR         "/test_fat_bench"
+#define BENCH_PATH_LEN          64
+#define BENCH_MISS_LOOP_NUM     256
+
+static const UINT32 g_benchDirSize[] = { 64, 512, 2048 };
+
+static VOID BenchFilePath(CHAR *path, UINT32 dirSize, UINT32 index)
+{
+    (VOID)snprintf_s(path, BENCH_PATH_LEN, BENCH_PATH_LEN - 1, "%s/d%u/bench_file_%04u.data",
+                     BENCH_MOUNT_DIR, dirSize, index);
+}
+
+static UINT32 BenchDirCreate(UINT32 dirSize)
+{
+    CHAR path[BENCH_PATH_LEN];
+    UINT32 index;
+    INT32 fd;
+
+    (VOID)snprintf_s(path, sizeof(path), sizeof(path) - 1, "%s/d%u", BENCH_MOUNT_DIR, dirSize);
+    ICUNIT_ASSERT_EQUAL(mkdir(path, S_IRWXU), 0, LOS_NOK);
+    for (index = 0; index < dirSize; index++) {
+        BenchFilePath(path, dirSize, index);
+        fd = open(path, O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+        ICUNIT_ASSERT_NOT_EQUAL(fd, -1, LOS_NOK);
+        (VOID)close(fd);
+    }
+    return LOS_OK;
+}
+
+static UINT32 BenchDirLookup(UINT32 dirSize)
+{
+    CHAR path[BENCH_PATH_LEN];
+    struct stat st;
+    UINT64 firstNs, hitNs, missNs, start;
+    UINT32 index;
+    INT32 ret;
+    INT32 fd;
+
+    /* The first lookup scans the directory to build its index */
+    BenchFilePath(path, dirSize, 0);
+    start = LOS_CurrNanosec();
+    ret = stat(path, &st);
+    firstNs = LOS_CurrNanosec() - start;
+    ICUNIT_ASSERT_EQUAL(ret, 0, LOS_NOK);
+
+    start = LOS_CurrNanosec();
+    for (index = 1; index < dirSize; index++) {
+        BenchFilePath(path, dirSize, index);
+        ret = stat(path, &st);
+        ICUNIT_ASSERT_EQUAL(ret, 0, LOS_NOK);
+    }
+    hitNs = LOS_CurrNanosec() - start;
+
+    /* Missing names are not cached by the VFS, every one of them reaches the file system */
+    BenchFilePath(path, dirSize, dirSize);
+    start = LOS_CurrNanosec();
+    for (index = 0; index < BENCH_MISS_LOOP_NUM; index++) {
+        ret = stat(path, &st);
+        ICUNIT_ASSERT_EQUAL(ret, -1, LOS_NOK);
+    }
+    missNs = LOS_CurrNanosec() - start;
+
+    /* Created after the index was built: it must be inserted, not missed */
+    fd = open(path, O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+    ICUNIT_ASSERT_NOT_EQUAL(fd, -1, LOS_NOK);
+    (VOID)close(fd);
+    ret = stat(path, &st);
+    ICUNIT_ASSERT_EQUAL(ret, 0, LOS_NOK);
+
+    dprintf("fat dir of %4u files: first lookup %llu ns, hit avg %llu ns, miss avg %llu ns\n",
+            dirSize, firstNs, hitNs / (dirSize - 1), missNs / BENCH_MISS_LOOP_NUM);
+    return LOS_OK;
+}
+
+static UINT32 Testcase(VOID)
+{
+    FsRamDisk ramDisk;
+    UINT32 index;
+    INT32 ret;
+
+    ret = FsRamDiskCreate(&ramDisk, BENCH_DISK_NAME, BENCH_DISK_SECTORS, BENCH_MOUNT_DIR);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+#ifdef LOSCFG_FS_FAT_DIR_INDEX
+    dprintf("fat directory name index: on, %u slots\n", LOSCFG_FS_FAT_DIR_INDEX_SLOTS);
+#else
+    dprintf("fat directory name index: off\n");
+#endif
+    for (index = 0; index < (sizeof(g_benchDirSize) / sizeof(g_benchDirSize[0])); index++) {
+        ICUNIT_GOTO_EQUAL(BenchDirCreate(g_benchDirSize[index]), LOS_OK, index, EXIT);
+    }
+    ret = FsRamDiskRemount(&ramDisk);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    for (index = 0; index < (sizeof(g_benchDirSize) / sizeof(g_benchDirSize[0])); index++) {
+        ICUNIT_GOTO_EQUAL(BenchDirLookup(g_benchDirSize[index]), LOS_OK, index, EXIT);
+    }
+    FsRamDiskDestroy(&ramDisk);
+    return LOS_OK;
+
+EXIT:
+    FsRamDiskDestroy(&ramDisk);
+    return LOS_NOK;
+}
+
+VOID ItExtendFs002(VOID)
+{
+    TEST_ADD_CASE("ItExtendFs002", Testcase, TEST_EXTEND, TEST_VFAT, TEST_LEVEL3, TEST_PERFORMANCE);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other materials
+ *    provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_extend_fs.h"
+#include "sys/statfs.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
+
+/*
+ * Coherence of FAT reads and writes that go straight to disk by cluster extent with
+ * the per file sector buffer, the cluster chain and other open instances. Every
+ * access is checked against an in-memory copy of the file.
+ */
+#define EXT_DISK_NAME           "ramfat_extent"
+#define EXT_DISK_SECTORS        4096        /* 2MB */
+#define EXT_MOUNT_DIR           "/test_fat_extent"
+#define EXT_FILE                EXT_MOUNT_DIR "/extent.bin"
+#define EXT_OTHER_FILE          EXT_MOUNT_DIR "/other.bin"
+#define EXT_MAX_CLUSTERS        8
+#define EXT_RANDOM_LOOP_NUM     300
+#define EXT_SECTOR_SIZE         FS_RAMDISK_SECTOR_SIZE
+
+static UINT8 *g_model;      /* expected file content */
+static UINT8 *g_buf;
+static UINT32 g_modelSize;  /* expected file size */
+static UINT32 g_cluster;    /* bytes per cluster */
+static UINT32 g_maxSize;
+static UINT32 g_seed;
+
+static UINT32 ExtRand(VOID)
+{
+    g_seed = g_seed * 1103515245 + 12345; /* 1103515245, 12345: LCG constants */
+    return (g_seed >> 16) & 0x7FFF;       /* 16: drop the weak low bits */
+}
+
+static VOID ExtFill(UINT8 *buf, UINT32 off, UINT32 len, UINT32 tag)
+{
+    UINT32 i;
+
+    for (i = 0; i < len; i++) {
+        buf[i] = (UINT8)(((off + i) * 7) + tag); /* 7: any odd stride tells neighbouring bytes apart */
+    }
+}
+
+/* Write len bytes of pattern tag at off through fd and apply the same write to the model */
+static UINT32 ExtWrite(INT32 fd, UINT32 off, UINT32 len, UINT32 tag)
+{
+    ExtFill(g_buf, off, len, tag);
+    ICUNIT_ASSERT_EQUAL(lseek(fd, off, SEEK_SET), (off_t)off, off);
+    ICUNIT_ASSERT_EQUAL(write(fd, g_buf, len), (ssize_t)len, len);
+    (VOID)memcpy_s(g_model + off, g_maxSize - off, g_buf, len);
+    g_modelSize = ((off + len) > g_modelSize) ? (off + len) : g_modelSize;
+    return LOS_OK;
+}
+
+/* Read len bytes at off through fd, optionally without seeking, and compare with the model */
+static UINT32 ExtRead(INT32 fd, UINT32 off, UINT32 len, BOOL seek)
+{
+    UINT32 expect = (off >= g_modelSize) ? 0 : (((g_modelSize - off) < len) ? (g_modelSize - off) : len);
+
+    if (seek) {
+        ICUNIT_ASSERT_EQUAL(lseek(fd, off, SEEK_SET), (off_t)off, off);
+    }
+    ICUNIT_ASSERT_EQUAL(read(fd, g_buf, len), (ssize_t)expect, off);
+    ICUNIT_ASSERT_EQUAL(memcmp(g_buf, g_model + off, expect), 0, off);
+    return LOS_OK;
+}
+
+/* Reopen the file and compare all of it, which also checks the size kept in the directory entry */
+static UINT32 ExtVerify(VOID)
+{
+    struct stat st;
+    INT32 fd;
+    UINT32 ret;
+
+    ICUNIT_ASSERT_EQUAL(stat(EXT_FILE, &st), 0, LOS_NOK);
+    ICUNIT_ASSERT_EQUAL(st.st_size, (off_t)g_modelSize, st.st_size);
+    fd = open(EXT_FILE, O_RDONLY);
+    ICUNIT_ASSERT_NOT_EQUAL(fd, -1, fd);
+    ret = ExtRead(fd, 0, g_modelSize, FALSE);
+    (VOID)close(fd);
+    return ret;
+}
+
+/*
+ * Random reads, writes and seeks, with offsets and lengths biased towards cluster and sector edges.
+ * Offsets never pass the end of file: a seek there on a writable FAT file extends it with undefined content.
+ */
+static UINT32 ExtInterleave(VOID)
+{
+    UINT32 loop, off, len;
+    INT32 fd;
+
+    fd = open(EXT_FILE, O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    ICUNIT_ASSERT_NOT_EQUAL(fd, -1, fd);
+    g_modelSize = 0;
+    /* Build the file with chunks that straddle cluster boundaries at odd offsets */
+    for (off = 0; off < (g_cluster * (EXT_MAX_CLUSTERS / 2)); off += len) {
+        len = (ExtRand() % (g_cluster * 2)) + 1;
+        ICUNIT_GOTO_EQUAL(ExtWrite(fd, off, len, 1), LOS_OK, off, EXIT);
+    }
+    for (loop = 0; loop < EXT_RANDOM_LOOP_NUM; loop++) {
+        off = ((ExtRand() % EXT_MAX_CLUSTERS) * g_cluster) + (ExtRand() % 3) * EXT_SECTOR_SIZE - EXT_SECTOR_SIZE;
+        off = (off > g_maxSize) ? 0 : off;                           /* wrapped below zero */
+        off = ((ExtRand() % 2) != 0) ? (off + (ExtRand() % EXT_SECTOR_SIZE)) : off;
+        off = (off > g_modelSize) ? g_modelSize : off;
+        len = ((ExtRand() % 2) != 0) ? ((ExtRand() % 5) * EXT_SECTOR_SIZE) : (ExtRand() % (g_cluster * 2));
+        len = (len == 0) ? 1 : len;
+        if ((off >= g_maxSize) || (len > (g_maxSize - off))) {
+            continue;
+        }
+        if ((ExtRand() % 2) != 0) {
+            ICUNIT_GOTO_EQUAL(ExtWrite(fd, off, len, loop), LOS_OK, loop, EXIT);
+        } else {
+            ICUNIT_GOTO_EQUAL(ExtRead(fd, off, len, TRUE), LOS_OK, loop, EXIT);
+            if ((off + len) <= g_modelSize) { /* continue from where the read stopped without a seek */
+                ICUNIT_GOTO_EQUAL(ExtRead(fd, off + len, EXT_SECTOR_SIZE + 1, FALSE), LOS_OK, loop, EXIT);
+            }
+        }
+    }
+    (VOID)close(fd);
+    return ExtVerify();
+
+EXIT:
+    (VOID)close(fd);
+    return LOS_NOK;
+}
+
+/* A sector held in the file buffer is overwritten or read by a later multi-sector request */
+static UINT32 ExtBufferOverlap(VOID)
+{
+    UINT32 off = g_cluster + 10; /* 10: inside the first sector of the second cluster */
+    INT32 fd;
+
+    fd = open(EXT_FILE, O_RDWR);
+    ICUNIT_ASSERT_NOT_EQUAL(fd, -1, fd);
+    /* Load the sector into the buffer, then overwrite it directly and read it back from the buffer */
+    ICUNIT_GOTO_EQUAL(ExtWrite(fd, off, 100, 2), LOS_OK, LOS_NOK, EXIT); /* 100: stays within the sector */
+    ICUNIT_GOTO_EQUAL(lseek(fd, off, SEEK_SET), (off_t)off, off, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtWrite(fd, 0, g_cluster * 3, 3), LOS_OK, LOS_NOK, EXIT); /* 3: covers the sector */
+    ICUNIT_GOTO_EQUAL(lseek(fd, off, SEEK_SET), (off_t)off, off, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtRead(fd, off, 100, FALSE), LOS_OK, LOS_NOK, EXIT);
+    /* Partial write ends mid sector, then a direct read covers that sector */
+    ICUNIT_GOTO_EQUAL(ExtWrite(fd, (g_cluster * 2) + 700, 300, 4), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtRead(fd, g_cluster * 2, g_cluster * 2, TRUE), LOS_OK, LOS_NOK, EXIT);
+    /* Unaligned head written through the buffer and an aligned body written directly in one call */
+    ICUNIT_GOTO_EQUAL(ExtWrite(fd, g_cluster - 1, g_cluster + EXT_SECTOR_SIZE + 1, 5), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtRead(fd, g_cluster - EXT_SECTOR_SIZE, g_cluster * 2, TRUE), LOS_OK, LOS_NOK, EXIT);
+    (VOID)close(fd);
+    return ExtVerify();
+
+EXIT:
+    (VOID)close(fd);
+    return LOS_NOK;
+}
+
+/* One instance truncates the file under another, which keeps writing and reading at its old position */
+static UINT32 ExtTwoInstances(VOID)
+{
+    UINT32 posB = (g_cluster * 3) + 100; /* 100: unaligned, inside a cluster freed by the truncation */
+    UINT32 posA = (EXT_SECTOR_SIZE * 3) + 20; /* 20: unaligned, past the second truncation */
+    UINT32 lenA = (g_cluster * 2) + 7;        /* 7: ends unaligned */
+    UINT32 otherSize = g_cluster * 4;
+    UINT8 *other = g_buf + g_maxSize;
+    INT32 fdO = -1;
+    INT32 fdA, fdB;
+
+    fdA = open(EXT_FILE, O_RDWR);
+    ICUNIT_ASSERT_NOT_EQUAL(fdA, -1, fdA);
+    fdB = open(EXT_FILE, O_RDWR);
+    ICUNIT_GOTO_NOT_EQUAL(fdB, -1, fdB, EXIT_A);
+
+    ICUNIT_GOTO_EQUAL(ExtWrite(fdA, 0, g_cluster * 5, 6), LOS_OK, LOS_NOK, EXIT); /* 5 clusters */
+    ICUNIT_GOTO_EQUAL(ExtRead(fdB, posB - 50, 50, TRUE), LOS_OK, LOS_NOK, EXIT); /* B buffers that sector */
+
+    ICUNIT_GOTO_EQUAL(ftruncate(fdA, g_cluster + 50), 0, LOS_NOK, EXIT);
+    g_modelSize = g_cluster + 50;
+    /* Another file is likely to get the freed clusters; stale writes from B must not land in it */
+    fdO = open(EXT_OTHER_FILE, O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    ICUNIT_GOTO_NOT_EQUAL(fdO, -1, fdO, EXIT);
+    ExtFill(other, 0, otherSize, 7);
+    ICUNIT_GOTO_EQUAL(write(fdO, other, otherSize), (ssize_t)otherSize, LOS_NOK, EXIT);
+
+    /* B reads nothing past the new end, then extends the file from its old position, leaving a gap */
+    ICUNIT_GOTO_EQUAL(read(fdB, g_buf, 1), 0, LOS_NOK, EXIT);
+    ExtFill(g_buf, posB, g_cluster + 1, 8);
+    ICUNIT_GOTO_EQUAL(write(fdB, g_buf, g_cluster + 1), (ssize_t)(g_cluster + 1), LOS_NOK, EXIT);
+    (VOID)memcpy_s(g_model + posB, g_maxSize - posB, g_buf, g_cluster + 1);
+    g_modelSize = posB + g_cluster + 1;
+    /* FAT does not clear the gap, so only the old head and B's data are compared */
+    ICUNIT_GOTO_EQUAL(ExtRead(fdA, 0, g_cluster + 50, TRUE), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtRead(fdA, posB, g_cluster + 1, TRUE), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(lseek(fdO, 0, SEEK_SET), 0, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(read(fdO, g_buf, otherSize), (ssize_t)otherSize, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(memcmp(g_buf, other, otherSize), 0, LOS_NOK, EXIT);
+
+    /* Now B truncates below A, whose next write lands at its old, unaligned position past the new end */
+    ICUNIT_GOTO_EQUAL(ExtWrite(fdA, 0, posA, 9), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ftruncate(fdB, 100), 0, LOS_NOK, EXIT); /* 100: inside the first sector */
+    g_modelSize = 100;
+    ICUNIT_GOTO_EQUAL(ExtRead(fdB, 0, EXT_SECTOR_SIZE, TRUE), LOS_OK, LOS_NOK, EXIT);
+    ExtFill(g_buf, posA, lenA, 10);
+    ICUNIT_GOTO_EQUAL(write(fdA, g_buf, lenA), (ssize_t)lenA, LOS_NOK, EXIT);
+    (VOID)memcpy_s(g_model + posA, g_maxSize - posA, g_buf, lenA);
+    g_modelSize = posA + lenA;
+    ICUNIT_GOTO_EQUAL(ExtRead(fdB, 0, 100, TRUE), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtRead(fdB, posA, lenA, TRUE), LOS_OK, LOS_NOK, EXIT);
+    /* Fill the gap so that the final check covers the whole file */
+    ICUNIT_GOTO_EQUAL(ExtWrite(fdB, 100, posA - 100, 11), LOS_OK, LOS_NOK, EXIT);
+
+    (VOID)close(fdO);
+    (VOID)close(fdB);
+    (VOID)close(fdA);
+    return ExtVerify();
+
+EXIT:
+    if (fdO != -1) {
+        (VOID)close(fdO);
+    }
+    (VOID)close(fdB);
+EXIT_A:
+    (VOID)close(fdA);
+    return LOS_NOK;
+}
+
+static UINT32 Testcase(VOID)
+{
+    FsRamDisk ramDisk;
+    struct statfs sfs;
+    UINT32 result = LOS_NOK;
+    INT32 ret;
+
+    ret = FsRamDiskCreate(&ramDisk, EXT_DISK_NAME, EXT_DISK_SECTORS, EXT_MOUNT_DIR);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = statfs(EXT_MOUNT_DIR, &sfs);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    g_cluster = sfs.f_bsize;
+    g_maxSize = g_cluster * EXT_MAX_CLUSTERS;
+    g_seed = 1;
+    g_model = (UINT8 *)malloc(g_maxSize);
+    g_buf = (UINT8 *)malloc(g_maxSize * 2); /* 2: the second half keeps another file's content */
+    ICUNIT_GOTO_NOT_EQUAL(g_model, NULL, 0, EXIT);
+    ICUNIT_GOTO_NOT_EQUAL(g_buf, NULL, 0, EXIT);
+
+    ICUNIT_GOTO_EQUAL(ExtInterleave(), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtBufferOverlap(), LOS_OK, LOS_NOK, EXIT);
+    ICUNIT_GOTO_EQUAL(ExtTwoInstances(), LOS_OK, LOS_NOK, EXIT);
+    result = LOS_OK;
+
+EXIT:
+    (VOID)unlink(EXT_OTHER_FILE);
+    (VOID)unlink(EXT_FILE);
+    free(g_buf);
+    free(g_model);
+    g_buf = NULL;
+    g_model = NULL;
+    FsRamDiskDestroy(&ramDisk);
+    return result;
+}
+
+VOID ItExtendFs003(VOID)
+{
+    TEST_ADD_CASE("ItExtendFs003", Testcase, TEST_EXTEND, TEST_VFAT, TEST_LEVEL1, TEST_FUNCTION);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cpluscplus */
+#endif /* __cpluscplus */
@@ -379,6 +379,10 @@ VOID TestKernelBase(VOID)
     ItSuiteLosTask();
     ItSuiteLosSwtmr();
     ItSuiteLosMux();
+#if defined(LOSCFG_TEST_KERNEL_BASE_MEM)
+    ItSuiteLosPage();
+    ItSuiteLosSlab();
+#endif
 #endif
 }
 
@@ -411,10 +415,18 @@ VOID TestKernelExtendCpup(VOID)
 #endif
 }
 
+VOID TestKernelExtendFs(VOID)
+{
+#if defined(LOSCFG_TEST_KERNEL_EXTEND_FS)
+    ItSuiteExtendFs();
+#endif
+}
+
 VOID TestKernelExtend(VOID)
 {
 #if defined(LOSCFG_TEST_KERNEL_EXTEND)
     TestKernelExtendCpup();
+    TestKernelExtendFs();
 #endif
 }
 
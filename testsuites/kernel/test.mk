@@ -64,6 +64,11 @@ TESTLIB_SUBDIRS +=  kernel/sample/kernel_base/core
 LITEOS_BASELIB += -lcoretest
 LITEOS_CMACRO += -DLOSCFG_TEST_KERNEL_BASE_CORE
 endif
+ifeq ($(LOSCFG_TEST_KERNEL_BASE_MEM), y)
+TESTLIB_SUBDIRS +=  kernel/sample/kernel_base/mem
+LITEOS_BASELIB += -lmemtest
+LITEOS_CMACRO += -DLOSCFG_TEST_KERNEL_BASE_MEM
+endif
 ifeq ($(LOSCFG_TEST_KERNEL_BASE_MP), y)
 TESTLIB_SUBDIRS +=  kernel/sample/kernel_base/mp
 LITEOS_BASELIB += -lmptest
@@ -107,6 +112,11 @@ TESTLIB_SUBDIRS +=  kernel/sample/kernel_extend/cpup
 LITEOS_BASELIB += -lcpuptest
 LITEOS_CMACRO += -DLOSCFG_TEST_KERNEL_EXTEND_CPUP
 endif
+ifeq ($(LOSCFG_TEST_KERNEL_EXTEND_FS), y)
+TESTLIB_SUBDIRS +=  kernel/sample/kernel_extend/fs
+LITEOS_BASELIB += -lfstest
+LITEOS_CMACRO += -DLOSCFG_TEST_KERNEL_EXTEND_FS
+endif
 ifeq ($(LOSCFG_TEST_KERNEL_EXTEND_EXC), y)
 TESTLIB_SUBDIRS +=  kernel/sample/kernel_extend/exc
 LITEOS_BASELIB += -lexctest
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "it_test_vm.h"
+#include <time.h>
+
+#define MAP_TEST_FILE   "/storage/testMmapFaultBench.bin"
+#define MAP_PAGE_SIZE   0x1000
+#define MAP_PAGE_NUM    2048    /* 8MB file, all pages stay resident in the page cache */
+#define MAP_RAND_STEP   7919    /* odd step, visits every page of a power-of-two sized file once */
+#define NS_PER_SEC      1000000000ULL
+
+static unsigned long long NowNs(void)
+{
+    struct timespec ts = {0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * NS_PER_SEC + (unsigned long long)ts.tv_nsec;
+}
+
+/* map the whole file and touch every page once, in sequential or pseudo random order */
+static int FaultPass(int fd, int random, unsigned long long *costNs)
+{
+    size_t len = (size_t)MAP_PAGE_SIZE * MAP_PAGE_NUM;
+    unsigned long long start;
+    unsigned int page;
+    int ret = 0;
+
+    char *map = (char *)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    start = NowNs();
+    for (unsigned int i = 0; i < MAP_PAGE_NUM; i++) {
+        page = random ? ((i * MAP_RAND_STEP) % MAP_PAGE_NUM) : i;
+        if (*(volatile unsigned int *)(map + (size_t)page * MAP_PAGE_SIZE) != page) {
+            ret = -1;
+            break;
+        }
+    }
+    *costNs = NowNs() - start;
+
+    (void)munmap(map, len);
+    return ret;
+}
+
+static int Testcase(void)
+{
+    unsigned long long coldSeq = 0;
+    unsigned long long warmSeq = 0;
+    unsigned long long warmRand = 0;
+    char buf[MAP_PAGE_SIZE] = {0};
+    int ret;
+
+    int fd = open(MAP_TEST_FILE, O_CREAT | O_RDWR | O_TRUNC, S_IRWXU | S_IRWXG | S_IRWXO);
+    ICUNIT_ASSERT_NOT_EQUAL(fd, -1, fd);
+
+    for (unsigned int page = 0; page < MAP_PAGE_NUM; page++) {
+        *(unsigned int *)buf = page;
+        ret = write(fd, buf, sizeof(buf));
+        ICUNIT_GOTO_EQUAL(ret, sizeof(buf), ret, EXIT);
+    }
+
+    ret = FaultPass(fd, 0, &coldSeq);   /* fills the page cache */
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    ret = FaultPass(fd, 0, &warmSeq);   /* every fault is a page cache lookup hit */
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    ret = FaultPass(fd, 1, &warmRand);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+
+    printf("file fault bench: %d resident pages\n", MAP_PAGE_NUM);
+    printf("  cold sequential : %llu ns/fault\n", coldSeq / MAP_PAGE_NUM);
+    printf("  warm sequential : %llu ns/fault\n", warmSeq / MAP_PAGE_NUM);
+    printf("  warm random     : %llu ns/fault\n", warmRand / MAP_PAGE_NUM);
+
+EXIT:
+    (void)close(fd);
+    (void)unlink(MAP_TEST_FILE);
+    return 0;
+}
+
+void ItTestMmap011(void)
+{
+    TEST_ADD_CASE("IT_MEM_MMAP_011", Testcase, TEST_LOS, TEST_MEM, TEST_LEVEL3, TEST_PERFORMANCE);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_test_vm.h"
+#include <time.h>
+
+#define MAP_PAGE_SIZE   0x1000
+#define MAP_MAX_PAGES   4096    /* 16MB of private anonymous memory at most */
+#define FORK_LOOPS      8
+#define NS_PER_SEC      1000000000ULL
+
+static unsigned long long NowNs(void)
+{
+    struct timespec ts = {0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * NS_PER_SEC + (unsigned long long)ts.tv_nsec;
+}
+
+/* fork with the first pageNum pages of map resident, the child checks one cow page and exits */
+static int ForkPass(char *map, unsigned int pageNum, unsigned long long *costNs)
+{
+    unsigned long long start;
+    int status = 0;
+    pid_t pid;
+
+    *costNs = 0;
+    for (int loop = 0; loop < FORK_LOOPS; loop++) {
+        for (unsigned int i = 0; i < pageNum; i++) {
+            *(volatile unsigned int *)(map + (size_t)i * MAP_PAGE_SIZE) = i; /* make every page writable again */
+        }
+
+        start = NowNs();
+        pid = fork();
+        if (pid == 0) {
+            unsigned int last = pageNum - 1;
+            if (*(volatile unsigned int *)(map + (size_t)last * MAP_PAGE_SIZE) != last) {
+                exit(1);
+            }
+            *(volatile unsigned int *)(map + (size_t)last * MAP_PAGE_SIZE) = 0; /* cow fault in the child */
+            exit(0);
+        }
+        *costNs += NowNs() - start;
+        if (pid < 0) {
+            return -1;
+        }
+
+        if ((waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+            return -1;
+        }
+        if (*(volatile unsigned int *)(map + (size_t)(pageNum - 1) * MAP_PAGE_SIZE) != (pageNum - 1)) {
+            return -1; /* the child's write must stay private */
+        }
+    }
+    *costNs /= FORK_LOOPS;
+    return 0;
+}
+
+static int Testcase(void)
+{
+    size_t len = (size_t)MAP_PAGE_SIZE * MAP_MAX_PAGES;
+    unsigned long long cost = 0;
+    int ret;
+
+    char *map = (char *)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ICUNIT_ASSERT_NOT_EQUAL(map, MAP_FAILED, map);
+
+    printf("fork latency bench:\n");
+    for (unsigned int pageNum = 64; pageNum <= MAP_MAX_PAGES; pageNum <<= 2) { /* 256KB, 1MB, 4MB, 16MB */
+        ret = ForkPass(map, pageNum, &cost);
+        ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+        printf("  rss %6u KB : %llu ns/fork\n", pageNum * (MAP_PAGE_SIZE / 1024), cost);
+    }
+
+EXIT:
+    (void)munmap(map, len);
+    return 0;
+}
+
+void ItTestMmap012(void)
+{
+    TEST_ADD_CASE("IT_MEM_MMAP_012", Testcase, TEST_LOS, TEST_MEM, TEST_LEVEL3, TEST_PERFORMANCE);
+}
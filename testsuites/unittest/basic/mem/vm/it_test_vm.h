@@ -53,6 +53,8 @@ extern void ItTestMmap007(void);
 extern void ItTestMmap008(void);
 extern void ItTestMmap009(void);
 extern void ItTestMmap010(void);
+extern void ItTestMmap011(void);
+extern void ItTestMmap012(void);
 extern void ItTestMprotect001(void);
 extern void ItTestMremap001(void);
 extern void ItTestOom001(void);
@@ -164,4 +164,26 @@ HWTEST_F(MemVmTest, open_wmemstream_test_001, TestSize.Level0)
     open_wmemstream_test_001();
 }
 #endif
+
+#if defined(LOSCFG_USER_TEST_FULL)
+/* *
+ * @tc.name: it_test_mmap_011
+ * @tc.desc: performance of file page faults with a large resident page cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(MemVmTest, ItTestMmap011, TestSize.Level0)
+{
+    ItTestMmap011();
+}
+
+/* *
+ * @tc.name: it_test_mmap_012
+ * @tc.desc: fork latency versus resident set size
+ * @tc.type: FUNC
+ */
+HWTEST_F(MemVmTest, ItTestMmap012, TestSize.Level0)
+{
+    ItTestMmap012();
+}
+#endif
 } // namespace OHOS
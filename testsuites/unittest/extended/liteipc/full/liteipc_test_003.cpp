@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "it_test_liteipc.h"
+#include "sys/wait.h"
+
+#include "unistd.h"
+#include "liteipc.h"
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "sys/time.h"
+#include "sys/ioctl.h"
+#include "fcntl.h"
+
+#include "smgr_demo.h"
+
+/*
+ * Synchronous request/reply latency: one client keeps issuing SEND|RECV
+ * calls to one service, reporting the average round trip in microseconds.
+ */
+#define PINGPONG_LOOP_NUM 20000
+#define US_PER_SECOND     1000000
+
+static int g_ipcFd;
+static char g_pingService[] = "ohos.pingservice";
+
+static int PingClient(void)
+{
+    IpcContent data1;
+    IpcMsg dataOut;
+    uint32_t ret;
+    uint32_t num;
+    uint32_t *ptr = nullptr;
+    void *retptr = nullptr;
+    unsigned int serviceHandle;
+    struct timeval start;
+    struct timeval end;
+
+    retptr = mmap(NULL, 4096, PROT_READ, MAP_PRIVATE, g_ipcFd, 0);
+    ICUNIT_ASSERT_NOT_EQUAL(static_cast<int>(static_cast<intptr_t>(retptr)), -1, retptr);
+    ret = GetService(g_ipcFd, g_pingService, sizeof(g_pingService), &serviceHandle);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    gettimeofday(&start, 0);
+    for (num = 1; num <= PINGPONG_LOOP_NUM; num++) {
+        data1.flag = SEND | RECV;
+        data1.outMsg = &dataOut;
+        (void)memset_s(data1.outMsg, sizeof(IpcMsg), 0, sizeof(IpcMsg));
+        data1.outMsg->type = MT_REQUEST;
+        data1.outMsg->target.handle = serviceHandle;
+        data1.outMsg->dataSz = sizeof(num);
+        data1.outMsg->data = &num;
+        ret = ioctl(g_ipcFd, IPC_SEND_RECV_MSG, &data1);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+        ptr = (uint32_t *)(data1.inMsg->data);
+        ICUNIT_ASSERT_EQUAL(ptr[1], num, ptr[1]);
+        FreeBuffer(g_ipcFd, data1.inMsg);
+    }
+    gettimeofday(&end, 0);
+
+    long long cost = (end.tv_sec - start.tv_sec) * US_PER_SECOND + (end.tv_usec - start.tv_usec);
+    printf("LiteIPC sync call: %d round trips, %lld us per round trip\n", PINGPONG_LOOP_NUM,
+        cost / PINGPONG_LOOP_NUM);
+    return 0;
+}
+
+static int PingService(void)
+{
+    IpcContent data1;
+    int ret;
+    void *retptr = nullptr;
+    unsigned int serviceHandle;
+
+    retptr = mmap(NULL, 4096, PROT_READ, MAP_PRIVATE, g_ipcFd, 0);
+    ICUNIT_ASSERT_NOT_EQUAL(static_cast<int>(static_cast<intptr_t>(retptr)), -1, retptr);
+    ret = RegService(g_ipcFd, g_pingService, sizeof(g_pingService), &serviceHandle);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    for (int cnt = 0; cnt < PINGPONG_LOOP_NUM; cnt++) {
+        data1.flag = RECV;
+        ret = ioctl(g_ipcFd, IPC_SEND_RECV_MSG, &data1);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+        ICUNIT_ASSERT_EQUAL(data1.inMsg->type, MT_REQUEST, data1.inMsg->type);
+        SendReply(g_ipcFd, data1.inMsg, 0, *(uint32_t *)data1.inMsg->data);
+    }
+    return 0;
+}
+
+static int PingPongTest(void)
+{
+    void *retptr = nullptr;
+    pid_t servicePid;
+    pid_t clientPid;
+    int status;
+    int ret;
+
+    retptr = mmap(NULL, 16 * 4096, PROT_READ, MAP_PRIVATE, g_ipcFd, 0); // 16: pages of the ipc pool
+    ICUNIT_ASSERT_NOT_EQUAL(static_cast<int>(static_cast<intptr_t>(retptr)), -1, retptr);
+
+    servicePid = fork();
+    ICUNIT_ASSERT_WITHIN_EQUAL(servicePid, 0, 100000, servicePid); // 100000, valid pid range
+    if (servicePid == 0) {
+        exit(PingService());
+    }
+    sleep(1); // wait service registered
+
+    clientPid = fork();
+    ICUNIT_ASSERT_WITHIN_EQUAL(clientPid, 0, 100000, clientPid); // 100000, valid pid range
+    if (clientPid == 0) {
+        exit(PingClient());
+    }
+
+    ret = waitpid(clientPid, &status, 0);
+    ICUNIT_ASSERT_EQUAL(ret, clientPid, ret);
+    ICUNIT_ASSERT_EQUAL(WEXITSTATUS(status), 0, WEXITSTATUS(status));
+    ret = waitpid(servicePid, &status, 0);
+    ICUNIT_ASSERT_EQUAL(ret, servicePid, ret);
+    ICUNIT_ASSERT_EQUAL(WEXITSTATUS(status), 0, WEXITSTATUS(status));
+    return 0;
+}
+
+static int TestCase(void)
+{
+    int ret;
+    int status;
+    g_ipcFd = open(LITEIPC_DRIVER, O_RDWR);
+    ICUNIT_ASSERT_NOT_EQUAL(g_ipcFd, -1, g_ipcFd);
+
+    pid_t pid = fork();
+    ICUNIT_GOTO_WITHIN_EQUAL(pid, 0, 100000, pid, EXIT); // 100000, valid pid range
+    if (pid == 0) {
+        sleep(1); // wait cms start
+        ret = PingPongTest();
+        StopCms(g_ipcFd);
+        exit(ret);
+    }
+
+    StartCms(g_ipcFd);
+
+    ret = waitpid(pid, &status, 0);
+    ICUNIT_GOTO_EQUAL(ret, pid, ret, EXIT);
+    status = WEXITSTATUS(status);
+    ICUNIT_GOTO_EQUAL(status, 0, status, EXIT);
+
+    return 0;
+EXIT:
+    return 1;
+}
+
+void ItPosixLiteIpc003(void)
+{
+    TEST_ADD_CASE("ItPosixLiteIpc003", TestCase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_PERFORMANCE);
+}
@@ -39,5 +39,6 @@
 
 extern void ItPosixLiteIpc001(void);
 extern void ItPosixLiteIpc002(void);
+extern void ItPosixLiteIpc003(void);
 
 #endif
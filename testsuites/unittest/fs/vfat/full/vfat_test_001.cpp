@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_test_vfat.h"
+#include <ctime>
+#include "fcntl.h"
+
+/*
+ * Block cache read throughput: a file several times larger than the FAT block
+ * cache is written once, then read back sequentially with sector, four-block
+ * and eight-block requests, and finally by two threads reading separate halves.
+ * The file is larger than the cache, so every pass misses and goes through the
+ * batched device reads; the data is verified and KB/s is reported per pass.
+ */
+#define VFAT_FILE_NAME     VFAT_MOUNT_DIR "/vfat_test_001"
+#define FILE_SIZE          (4 * 1024 * 1024)
+#define SECTOR_SIZE        512
+#define BLOCK_SIZE         (SECTOR_SIZE * 64)
+#define READ_MAX           (BLOCK_SIZE * 8)
+#define READER_NUM         2
+#define NS_PER_SECOND      1000000000LL
+
+static int ReadRange(int fd, char *buf, off_t start, off_t end, int reqSize)
+{
+    for (off_t offset = start; offset < end; offset += reqSize) {
+        ssize_t len = pread(fd, buf, reqSize, offset);
+        if (len != reqSize) {
+            return -1;
+        }
+        for (int index = 0; index < reqSize; index += SECTOR_SIZE) {
+            if (buf[index] != (char)((offset + index) / SECTOR_SIZE)) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static long long TimeCost(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long long cost = (end.tv_sec - start->tv_sec) * NS_PER_SECOND + (end.tv_nsec - start->tv_nsec);
+    return (cost != 0) ? cost : 1;
+}
+
+static int ReadPass(int fd, char *buf, int reqSize)
+{
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ret = ReadRange(fd, buf, 0, FILE_SIZE, reqSize);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    printf("vfat read %d bytes: %lld KB/s\n", reqSize, (FILE_SIZE * NS_PER_SECOND) / (TimeCost(&start) * 1024));
+    return 0;
+}
+
+struct ReaderArg {
+    int fd;
+    int index;
+    int ret;
+    char *buf;
+};
+
+static void *ReaderThread(void *arg)
+{
+    struct ReaderArg *reader = static_cast<struct ReaderArg *>(arg);
+    off_t start = (off_t)reader->index * (FILE_SIZE / READER_NUM);
+
+    reader->ret = ReadRange(reader->fd, reader->buf, start, start + FILE_SIZE / READER_NUM, READ_MAX);
+    return nullptr;
+}
+
+static int ParallelPass(int fd)
+{
+    pthread_t threads[READER_NUM];
+    struct ReaderArg readers[READER_NUM];
+    struct timespec start;
+    int ret;
+    int i;
+
+    for (i = 0; i < READER_NUM; i++) {
+        readers[i].fd = fd;
+        readers[i].index = i;
+        readers[i].ret = -1;
+        readers[i].buf = static_cast<char *>(malloc(READ_MAX));
+        ICUNIT_ASSERT_NOT_EQUAL(readers[i].buf, NULL, readers[i].buf);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < READER_NUM; i++) {
+        ret = pthread_create(&threads[i], nullptr, ReaderThread, &readers[i]);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+    for (i = 0; i < READER_NUM; i++) {
+        ret = pthread_join(threads[i], nullptr);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+    long long cost = TimeCost(&start);
+
+    for (i = 0; i < READER_NUM; i++) {
+        free(readers[i].buf);
+        ICUNIT_ASSERT_EQUAL(readers[i].ret, 0, readers[i].ret);
+    }
+    printf("vfat read by %d threads: %lld KB/s\n", READER_NUM, (FILE_SIZE * NS_PER_SECOND) / (cost * 1024));
+    return 0;
+}
+
+static int Testcase(void)
+{
+    char *buf = nullptr;
+    int fd;
+    int ret;
+
+    buf = static_cast<char *>(malloc(READ_MAX));
+    ICUNIT_ASSERT_NOT_EQUAL(buf, NULL, buf);
+
+    fd = open(VFAT_FILE_NAME, O_RDWR | O_CREAT | O_TRUNC, 0644); // 0644, file mode
+    ICUNIT_GOTO_NOT_EQUAL(fd, -1, fd, EXIT);
+    for (off_t offset = 0; offset < FILE_SIZE; offset += READ_MAX) {
+        for (int index = 0; index < READ_MAX; index += SECTOR_SIZE) {
+            (void)memset_s(buf + index, SECTOR_SIZE, (char)((offset + index) / SECTOR_SIZE), SECTOR_SIZE);
+        }
+        ret = write(fd, buf, READ_MAX);
+        ICUNIT_GOTO_EQUAL(ret, READ_MAX, ret, EXIT1);
+    }
+    ret = fsync(fd);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT1);
+
+    ret = ReadPass(fd, buf, SECTOR_SIZE);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT1);
+    ret = ReadPass(fd, buf, BLOCK_SIZE * 4); // 4: four-block requests
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT1);
+    ret = ReadPass(fd, buf, READ_MAX);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT1);
+    ret = ParallelPass(fd);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT1);
+
+EXIT1:
+    (void)close(fd);
+    (void)unlink(VFAT_FILE_NAME);
+EXIT:
+    free(buf);
+    return 0;
+}
+
+void ItTestVfat001(void)
+{
+    TEST_ADD_CASE("IT_FS_VFAT_001", Testcase, TEST_VFS, TEST_VFAT, TEST_LEVEL0, TEST_PERFORMANCE);
+}
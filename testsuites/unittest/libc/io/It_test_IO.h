@@ -139,5 +139,7 @@ extern VOID IO_TEST_PPOLL_002(VOID);
 extern VOID IO_TEST_PPOLL_003(VOID);
 extern VOID IO_TEST_EPOLL_001(VOID);
 extern VOID IO_TEST_EPOLL_002(VOID);
+extern VOID IO_TEST_EPOLL_003(VOID);
+extern VOID IO_TEST_ACCESS_001(VOID);
 
 #endif
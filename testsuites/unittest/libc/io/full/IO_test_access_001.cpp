@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_test_IO.h"
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define STORM_THREADS   4
+#define STORM_LOOPS     20000
+#define NS_PER_SEC      1000000000ULL
+
+/* lives on the root file system, so the whole walk is answered by the path cache */
+static const char *g_stormPath = "/lib/libc.so";
+static volatile int g_stormFailed;
+
+static unsigned long long NowNs(void)
+{
+    struct timespec ts = {0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * NS_PER_SEC + (unsigned long long)ts.tv_nsec;
+}
+
+static void *AccessStorm(void *arg)
+{
+    (void)arg;
+    for (int i = 0; i < STORM_LOOPS; i++) {
+        if (access(g_stormPath, R_OK) != 0) {
+            g_stormFailed = 1;
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void *StatStorm(void *arg)
+{
+    struct stat st;
+
+    (void)arg;
+    for (int i = 0; i < STORM_LOOPS; i++) {
+        if (stat(g_stormPath, &st) != 0) {
+            g_stormFailed = 1;
+            break;
+        }
+    }
+    return NULL;
+}
+
+static unsigned long long StormRun(void *(*entry)(void *))
+{
+    pthread_t threads[STORM_THREADS];
+    int created = 0;
+    unsigned long long start = NowNs();
+
+    for (; created < STORM_THREADS; created++) {
+        if (pthread_create(&threads[created], NULL, entry, NULL) != 0) {
+            g_stormFailed = 1;
+            break;
+        }
+    }
+    for (int i = 0; i < created; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+    return NowNs() - start;
+}
+
+static unsigned long long LookupsPerSec(unsigned long long cost)
+{
+    return (unsigned long long)STORM_THREADS * STORM_LOOPS * NS_PER_SEC / (cost ? cost : 1);
+}
+
+static UINT32 testcase(VOID)
+{
+    unsigned long long cost;
+    struct stat st;
+    int ret;
+
+    ret = stat(g_stormPath, &st);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = access(g_stormPath, R_OK);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = access("/lib/no_such_file", F_OK);
+    ICUNIT_ASSERT_EQUAL(ret, -1, ret);
+    ICUNIT_ASSERT_EQUAL(errno, ENOENT, errno);
+
+    g_stormFailed = 0;
+    printf("path walk storm: %d threads x %d lookups of %s\n", STORM_THREADS, STORM_LOOPS, g_stormPath);
+    cost = StormRun(AccessStorm);
+    ICUNIT_ASSERT_EQUAL(g_stormFailed, 0, g_stormFailed);
+    printf("  access : %llu lookups/s\n", LookupsPerSec(cost));
+    cost = StormRun(StatStorm);
+    ICUNIT_ASSERT_EQUAL(g_stormFailed, 0, g_stormFailed);
+    printf("  stat   : %llu lookups/s\n", LookupsPerSec(cost));
+
+    return LOS_OK;
+}
+
+VOID IO_TEST_ACCESS_001(VOID)
+{
+    TEST_ADD_CASE(__FUNCTION__, testcase, TEST_LIB, TEST_LIBC, TEST_LEVEL3, TEST_PERFORMANCE);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "It_test_IO.h"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <time.h>
+
+#define ACTIVE_NUM      4       /* sockets with pending data */
+#define IDLE_MAX        1024    /* stops earlier when the stack runs out of sockets */
+#define WAIT_LOOPS      1000
+#define NS_PER_SEC      1000000000ULL
+
+static unsigned long long NowNs(void)
+{
+    struct timespec ts = {0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * NS_PER_SEC + (unsigned long long)ts.tv_nsec;
+}
+
+/* a loopback udp socket with one datagram queued, it stays readable as long as nobody reads it */
+static int ActiveSocketOpen(void)
+{
+    struct sockaddr_in addr = {0};
+    socklen_t len = sizeof(addr);
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    addr.sin_port = 0;
+    if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+        (getsockname(fd, (struct sockaddr *)&addr, &len) != 0) ||
+        (sendto(fd, "x", 1, 0, (struct sockaddr *)&addr, sizeof(addr)) != 1)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static unsigned long long WaitCost(int epFd)
+{
+    struct epoll_event evs[ACTIVE_NUM];
+    unsigned long long start = NowNs();
+
+    for (int i = 0; i < WAIT_LOOPS; i++) {
+        if (epoll_wait(epFd, evs, ACTIVE_NUM, 0) != ACTIVE_NUM) {
+            return 0;
+        }
+    }
+    return (NowNs() - start) / WAIT_LOOPS;
+}
+
+static UINT32 testcase(VOID)
+{
+    int activeFd[ACTIVE_NUM];
+    int idleFd[IDLE_MAX];
+    int idleNum = 0;
+    int nextReport = 0;
+    unsigned long long cost;
+    struct epoll_event ev = {0};
+    struct epoll_event evs[ACTIVE_NUM];
+    int ret = LOS_NOK;
+    int retval;
+    int i;
+
+    for (i = 0; i < ACTIVE_NUM; i++) {
+        activeFd[i] = -1;
+    }
+
+    int epFd = epoll_create1(0);
+    ICUNIT_ASSERT_NOT_EQUAL(epFd, -1, epFd);
+
+    for (i = 0; i < ACTIVE_NUM; i++) {
+        activeFd[i] = ActiveSocketOpen();
+        ICUNIT_GOTO_NOT_EQUAL(activeFd[i], -1, activeFd[i], OUT);
+        ev.events = EPOLLIN;
+        ev.data.u32 = (UINT32)i;
+        retval = epoll_ctl(epFd, EPOLL_CTL_ADD, activeFd[i], &ev);
+        ICUNIT_GOTO_EQUAL(retval, 0, retval, OUT);
+    }
+
+    /* level triggered: every wait reports all active sockets and hands back the registered data */
+    retval = epoll_wait(epFd, evs, ACTIVE_NUM, 1000); /* 1000, wait time */
+    ICUNIT_GOTO_EQUAL(retval, ACTIVE_NUM, retval, OUT);
+    for (i = 0; i < ACTIVE_NUM; i++) {
+        ICUNIT_GOTO_EQUAL(evs[i].events & EPOLLIN, EPOLLIN, evs[i].events, OUT);
+        ICUNIT_GOTO_EQUAL(evs[i].data.u32 < ACTIVE_NUM, 1, evs[i].data.u32, OUT);
+    }
+
+    printf("epoll_wait bench: %d active sockets\n", ACTIVE_NUM);
+    while (idleNum <= IDLE_MAX) {
+        if (idleNum == nextReport) {
+            cost = WaitCost(epFd);
+            ICUNIT_GOTO_NOT_EQUAL(cost, 0, cost, OUT);
+            printf("  idle %4d : %llu ns/wait\n", idleNum, cost);
+            nextReport = (nextReport == 0) ? 16 : (nextReport << 1); /* 16, first non empty step */
+        }
+        if (idleNum == IDLE_MAX) {
+            break;
+        }
+        idleFd[idleNum] = socket(AF_INET, SOCK_DGRAM, 0);
+        if (idleFd[idleNum] < 0) {
+            break;
+        }
+        ev.events = EPOLLIN;
+        ev.data.u32 = ACTIVE_NUM + idleNum;
+        retval = epoll_ctl(epFd, EPOLL_CTL_ADD, idleFd[idleNum], &ev);
+        idleNum++;
+        ICUNIT_GOTO_EQUAL(retval, 0, retval, OUT);
+    }
+    ret = LOS_OK;
+
+OUT:
+    for (i = 0; i < idleNum; i++) {
+        close(idleFd[i]);
+    }
+    for (i = 0; i < ACTIVE_NUM; i++) {
+        if (activeFd[i] >= 0) {
+            close(activeFd[i]);
+        }
+    }
+    close(epFd);
+    return ret;
+}
+
+VOID IO_TEST_EPOLL_003(VOID)
+{
+    TEST_ADD_CASE(__FUNCTION__, testcase, TEST_LIB, TEST_LIBC, TEST_LEVEL3, TEST_PERFORMANCE);
+}
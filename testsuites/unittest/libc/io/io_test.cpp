@@ -160,6 +160,26 @@ HWTEST_F(IoTest, IO_TEST_EPOLL_002, TestSize.Level0)
     IO_TEST_EPOLL_002();
 }
 
+/* *
+ * @tc.name: IO_TEST_EPOLL_003
+ * @tc.desc: epoll_wait cost with many idle sockets
+ * @tc.type: FUNC
+ */
+HWTEST_F(IoTest, IO_TEST_EPOLL_003, TestSize.Level0)
+{
+    IO_TEST_EPOLL_003();
+}
+
+/* *
+ * @tc.name: IO_TEST_ACCESS_001
+ * @tc.desc: concurrent path lookups served by the path cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(IoTest, IO_TEST_ACCESS_001, TestSize.Level0)
+{
+    IO_TEST_ACCESS_001();
+}
+
 /* *
  * @tc.name: IT_STDLIB_POLL_002
  * @tc.desc: function for IoTest
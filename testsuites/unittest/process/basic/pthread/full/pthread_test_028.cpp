@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_pthread_test.h"
+
+/*
+ * Condition variable broadcast throughput: one thread repeatedly bumps a
+ * generation counter and broadcasts, the waiters acknowledge each round.
+ * The average round time tracks the cost of FUTEX_REQUEUE/CMP_REQUEUE and
+ * FUTEX_WAKE_OP on the broadcast and mutex hand-off paths.
+ */
+#define WAITER_NUM    8
+#define ROUND_NUM     2000
+#define US_PER_SECOND 1000000
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_roundCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_ackCond = PTHREAD_COND_INITIALIZER;
+static volatile int g_round = 0;
+static volatile int g_arrived = 0;
+static volatile int g_seenRounds[WAITER_NUM];
+
+static void *Waiter(void *arg)
+{
+    int index = (int)(intptr_t)arg;
+    int seen = 0;
+
+    while (seen < ROUND_NUM) {
+        pthread_mutex_lock(&g_lock);
+        while (g_round == seen) {
+            pthread_cond_wait(&g_roundCond, &g_lock);
+        }
+        seen = g_round;
+        g_seenRounds[index]++;
+        if (++g_arrived == WAITER_NUM) {
+            pthread_cond_signal(&g_ackCond);
+        }
+        pthread_mutex_unlock(&g_lock);
+    }
+
+    return nullptr;
+}
+
+static int Testcase(void)
+{
+    pthread_t threads[WAITER_NUM];
+    struct timeval start;
+    struct timeval end;
+    int ret;
+    int i;
+
+    g_round = 0;
+    g_arrived = 0;
+    for (i = 0; i < WAITER_NUM; i++) {
+        g_seenRounds[i] = 0;
+        ret = pthread_create(&threads[i], nullptr, Waiter, (void *)(intptr_t)i);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+    SLEEP_AND_YIELD(2); // 2, let every waiter block on the condition
+
+    gettimeofday(&start, 0);
+    for (int round = 1; round <= ROUND_NUM; round++) {
+        pthread_mutex_lock(&g_lock);
+        g_arrived = 0;
+        g_round = round;
+        pthread_cond_broadcast(&g_roundCond);
+        while (g_arrived < WAITER_NUM) {
+            pthread_cond_wait(&g_ackCond, &g_lock);
+        }
+        pthread_mutex_unlock(&g_lock);
+    }
+    gettimeofday(&end, 0);
+
+    for (i = 0; i < WAITER_NUM; i++) {
+        pthread_join(threads[i], nullptr);
+        ICUNIT_ASSERT_EQUAL(g_seenRounds[i], ROUND_NUM, g_seenRounds[i]);
+    }
+
+    long long cost = (end.tv_sec - start.tv_sec) * US_PER_SECOND + (end.tv_usec - start.tv_usec);
+    printf("pthread_cond_broadcast: %d waiters, %d rounds, %lld us per round\n", WAITER_NUM, ROUND_NUM,
+        cost / ROUND_NUM);
+    return 0;
+}
+
+void ItTestPthread028(void)
+{
+    TEST_ADD_CASE("IT_POSIX_PTHREAD_028", Testcase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_FUNCTION);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_pthread_test.h"
+
+/*
+ * Floating point state isolation: every thread keeps its own accumulators in
+ * VFP registers and yields each round, so the registers left behind by one
+ * thread are live in the FPU when the next one resumes. A forked child runs
+ * the same work alongside them. Any leak between tasks changes the result.
+ */
+#define FPU_THREAD_NUM 4
+#define FPU_ROUND_NUM  2000
+
+static double g_expect[FPU_THREAD_NUM];
+static double g_result[FPU_THREAD_NUM];
+
+static double FpuWork(int seed, int yield)
+{
+    double acc = seed + 1.0;
+    double step = 1.0 / (seed + 3.0); /* 3.0: keep every thread's step distinct */
+
+    for (int i = 0; i < FPU_ROUND_NUM; i++) {
+        acc = acc * 0.999 + step; /* 0.999: keep the value bounded */
+        if (yield) {
+            sched_yield();
+        }
+    }
+    return acc;
+}
+
+static void *FpuThread(void *arg)
+{
+    int index = (int)(intptr_t)arg;
+
+    g_result[index] = FpuWork(index, 1);
+    return nullptr;
+}
+
+static int Testcase(void)
+{
+    pthread_t threads[FPU_THREAD_NUM];
+    int status = 0;
+    int ret;
+    int i;
+
+    for (i = 0; i < FPU_THREAD_NUM; i++) {
+        g_expect[i] = FpuWork(i, 0);
+        ret = pthread_create(&threads[i], nullptr, FpuThread, (void *)(intptr_t)i);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+
+    pid_t pid = fork();
+    ICUNIT_ASSERT_WITHIN_EQUAL(pid, 0, 100000, pid); /* 100000, pid range */
+    if (pid == 0) {
+        exit((FpuWork(0, 1) == g_expect[0]) ? 0 : 1);
+    }
+
+    for (i = 0; i < FPU_THREAD_NUM; i++) {
+        pthread_join(threads[i], nullptr);
+        ICUNIT_ASSERT_EQUAL(g_result[i] == g_expect[i], 1, i);
+    }
+
+    ret = waitpid(pid, &status, 0);
+    ICUNIT_ASSERT_EQUAL(ret, pid, ret);
+    ICUNIT_ASSERT_EQUAL(WEXITSTATUS(status), 0, status);
+    return 0;
+}
+
+void ItTestPthread029(void)
+{
+    TEST_ADD_CASE("IT_POSIX_PTHREAD_029", Testcase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_FUNCTION);
+}
@@ -82,6 +82,8 @@ extern void ItTestPthread024(void);
 extern void ItTestPthread025(void);
 extern void ItTestPthread026(void);
 extern void ItTestPthread027(void);
+extern void ItTestPthread028(void);
+extern void ItTestPthread029(void);
 extern void ItTestPthreadAtfork001(void);
 extern void ItTestPthreadAtfork002(void);
 extern void ItTestPthreadOnce001(void);
@@ -421,5 +421,25 @@ HWTEST_F(ProcessPthreadTest, ItTestPthread014, TestSize.Level0)
 }
 #endif
 
+/* *
+ * @tc.name: it_test_pthread_028
+ * @tc.desc: pthread_cond_broadcast throughput benchmark
+ * @tc.type: PERF
+ */
+HWTEST_F(ProcessPthreadTest, ItTestPthread028, TestSize.Level0)
+{
+    ItTestPthread028();
+}
+
+/* *
+ * @tc.name: it_test_pthread_029
+ * @tc.desc: floating point registers stay private to each thread and forked child
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProcessPthreadTest, ItTestPthread029, TestSize.Level0)
+{
+    ItTestPthread029();
+}
+
 #endif
 } // namespace OHOS
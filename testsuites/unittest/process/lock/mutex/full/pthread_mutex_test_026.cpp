@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_mutex_test.h"
+#include <climits>
+#include <sys/syscall.h>
+
+#ifndef FUTEX_WAIT
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+#endif
+#define TEST_FUTEX_CMP_REQUEUE 4
+#define TEST_FUTEX_WAKE_OP 5
+#define TEST_FUTEX_LOCK_PI 6
+#define TEST_FUTEX_UNLOCK_PI 7
+#define TEST_FUTEX_TRYLOCK_PI 8
+#define TEST_FUTEX_WAITERS 0x80000000U
+#define TEST_FUTEX_TID_MASK 0x3FFFFFFFU
+#define TEST_FORGED_TID_MAX 16
+#define TEST_PI_TIMEOUT_US 10000
+#define TEST_FUTEX_OP(op, oparg, cmp, cmparg) \
+    ((((op) & 0xF) << 28) | (((cmp) & 0xF) << 24) | (((oparg) & 0xFFF) << 12) | ((cmparg) & 0xFFF))
+#define TEST_FUTEX_OP_SET 0
+#define TEST_FUTEX_OP_ADD 1
+#define TEST_FUTEX_OP_CMP_EQ 0
+
+static volatile unsigned int g_futexWord1;
+static volatile unsigned int g_futexWord2;
+static volatile unsigned int g_piWord;
+static volatile int g_testToCount001 = 0;
+static volatile int g_testToCount002 = 0;
+
+static int Futex(volatile unsigned int *uaddr, int op, int val, unsigned int val2,
+                 volatile unsigned int *uaddr2, unsigned int val3)
+{
+    return syscall(SYS_futex, uaddr, op, val, val2, uaddr2, val3);
+}
+
+static void *WaitWord1(void *arg)
+{
+    int ret = Futex(&g_futexWord1, FUTEX_WAIT, 0, UINT_MAX, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+
+    g_testToCount001++;
+    return nullptr;
+EXIT:
+    g_testToCount001 = -1;
+    return nullptr;
+}
+
+static void *WaitWord2(void *arg)
+{
+    int ret = Futex(&g_futexWord2, FUTEX_WAIT, 0, UINT_MAX, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+
+    g_testToCount002++;
+    return nullptr;
+EXIT:
+    g_testToCount002 = -1;
+    return nullptr;
+}
+
+static void *PiContender(void *arg)
+{
+    unsigned int tid = (unsigned int)Gettid();
+
+    int ret = Futex(&g_piWord, TEST_FUTEX_TRYLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, -1, ret, EXIT);
+    ICUNIT_GOTO_EQUAL(errno, EAGAIN, errno, EXIT);
+
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, -1, ret, EXIT);
+    ICUNIT_GOTO_EQUAL(errno, EPERM, errno, EXIT);
+
+    ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, 0, UINT_MAX, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    ICUNIT_GOTO_EQUAL(g_piWord & TEST_FUTEX_TID_MASK, tid, g_piWord, EXIT);
+
+    g_testToCount001++;
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    return nullptr;
+EXIT:
+    g_testToCount001 = -1;
+    return nullptr;
+}
+
+static int TestWakeOp(void)
+{
+    int ret;
+    pthread_t thread1, thread2;
+
+    g_futexWord1 = 0;
+    g_futexWord2 = 0;
+    g_testToCount001 = 0;
+    g_testToCount002 = 0;
+
+    ret = pthread_create(&thread1, nullptr, WaitWord1, nullptr);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = pthread_create(&thread2, nullptr, WaitWord2, nullptr);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    SLEEP_AND_YIELD(2); // 2, wait for both threads to block
+
+    /* word2 += 1, the old value 0 satisfies EQ 0, so both words get a waiter woken */
+    ret = Futex(&g_futexWord1, TEST_FUTEX_WAKE_OP, 1, 1, &g_futexWord2,
+                TEST_FUTEX_OP(TEST_FUTEX_OP_ADD, 1, TEST_FUTEX_OP_CMP_EQ, 0));
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ICUNIT_ASSERT_EQUAL(g_futexWord2, 1, g_futexWord2);
+
+    pthread_join(thread1, nullptr);
+    pthread_join(thread2, nullptr);
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 1, g_testToCount001);
+    ICUNIT_ASSERT_EQUAL(g_testToCount002, 1, g_testToCount002);
+
+    /* the old value 1 fails EQ 0, the operation is still applied */
+    ret = Futex(&g_futexWord1, TEST_FUTEX_WAKE_OP, 1, 1, &g_futexWord2,
+                TEST_FUTEX_OP(TEST_FUTEX_OP_SET, 5, TEST_FUTEX_OP_CMP_EQ, 0)); // 5, new value
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ICUNIT_ASSERT_EQUAL(g_futexWord2, 5, g_futexWord2); // 5, new value
+
+    ret = Futex(&g_futexWord1, TEST_FUTEX_WAKE_OP, 1, 1, &g_futexWord2, 0xF0000000U); // invalid op
+    ICUNIT_ASSERT_EQUAL(ret, -1, ret);
+    ICUNIT_ASSERT_EQUAL(errno, EINVAL, errno);
+    return 0;
+}
+
+static int TestCmpRequeue(void)
+{
+    int ret;
+    pthread_t thread;
+
+    g_futexWord1 = 0;
+    g_futexWord2 = 0;
+    g_testToCount001 = 0;
+
+    ret = pthread_create(&thread, nullptr, WaitWord1, nullptr);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    SLEEP_AND_YIELD(2); // 2, wait for the thread to block
+
+    ret = Futex(&g_futexWord1, TEST_FUTEX_CMP_REQUEUE, 0, 1, &g_futexWord2, 1);
+    ICUNIT_ASSERT_EQUAL(ret, -1, ret);
+    ICUNIT_ASSERT_EQUAL(errno, EAGAIN, errno);
+
+    ret = Futex(&g_futexWord1, TEST_FUTEX_CMP_REQUEUE, 0, 1, &g_futexWord2, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 0, g_testToCount001);
+
+    /* the waiter now sleeps on word2 */
+    ret = Futex(&g_futexWord2, FUTEX_WAKE, 1, 0, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    pthread_join(thread, nullptr);
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 1, g_testToCount001);
+    return 0;
+}
+
+static int TestLockPi(void)
+{
+    int ret;
+    pthread_t thread;
+    unsigned int tid = (unsigned int)Gettid();
+
+    g_piWord = 0;
+    g_testToCount001 = 0;
+
+    ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, 0, UINT_MAX, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ICUNIT_ASSERT_EQUAL(g_piWord, tid, g_piWord);
+
+    ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, 0, UINT_MAX, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, -1, ret);
+    ICUNIT_ASSERT_EQUAL(errno, EDEADLK, errno);
+
+    ret = pthread_create(&thread, nullptr, PiContender, nullptr);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    SLEEP_AND_YIELD(2); // 2, wait for the contender to block
+
+    /* a blocked contender forces the unlock through the kernel */
+    ICUNIT_ASSERT_EQUAL(g_piWord, tid | TEST_FUTEX_WAITERS, g_piWord);
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 0, g_testToCount001);
+
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    pthread_join(thread, nullptr);
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 1, g_testToCount001);
+    ICUNIT_ASSERT_EQUAL(g_piWord, 0, g_piWord);
+
+    ret = Futex(&g_piWord, TEST_FUTEX_TRYLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0, 0, nullptr, 0);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ICUNIT_ASSERT_EQUAL(g_piWord, 0, g_piWord);
+    return 0;
+}
+
+/* the word names ownerTid as holder; the kernel must refuse it instead of boosting or waiting on it */
+static int LockPiForged(unsigned int ownerTid, int *err)
+{
+    g_piWord = ownerTid;
+    int ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, 0, TEST_PI_TIMEOUT_US, nullptr, 0);
+    *err = errno;
+    g_piWord = 0;
+    ICUNIT_ASSERT_EQUAL(ret, -1, ret);
+    ICUNIT_ASSERT_EQUAL((*err == ESRCH) || (*err == EPERM), true, *err);
+    return 0;
+}
+
+static int TestLockPiForgedOwner(void)
+{
+    int ret;
+    int err = 0;
+    int toChild[2]; // 2, read and write end
+    int toParent[2]; // 2, read and write end
+    unsigned int childTid = 0;
+    unsigned int tid = (unsigned int)Gettid();
+
+    /* kernel tasks and unused ids never own a user futex */
+    for (unsigned int forged = 1; forged < TEST_FORGED_TID_MAX; forged++) {
+        if (forged == tid) {
+            continue;
+        }
+        ret = LockPiForged(forged, &err);
+        ICUNIT_ASSERT_EQUAL(ret, 0, forged);
+    }
+
+    /* a thread of another process, whose copy of the word is on a different page */
+    ret = pipe(toChild);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = pipe(toParent);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    pid_t pid = fork();
+    ICUNIT_ASSERT_WITHIN_EQUAL(pid, 0, INT_MAX, pid);
+    if (pid == 0) {
+        childTid = (unsigned int)Gettid();
+        (void)write(toParent[1], &childTid, sizeof(childTid));
+        (void)read(toChild[0], &childTid, sizeof(childTid));
+        exit(0);
+    }
+
+    ret = read(toParent[0], &childTid, sizeof(childTid));
+    ICUNIT_GOTO_EQUAL(ret, sizeof(childTid), ret, EXIT);
+    ret = LockPiForged(childTid, &err);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    ICUNIT_GOTO_EQUAL(err, EPERM, err, EXIT);
+
+EXIT:
+    (void)write(toChild[1], &childTid, sizeof(childTid));
+    (void)waitpid(pid, nullptr, 0);
+    (void)close(toChild[0]);
+    (void)close(toChild[1]);
+    (void)close(toParent[0]);
+    (void)close(toParent[1]);
+    return ret;
+}
+
+static int Testcase(void)
+{
+    int ret = TestWakeOp();
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    ret = TestCmpRequeue();
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    ret = TestLockPi();
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    ret = TestLockPiForgedOwner();
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    return 0;
+}
+
+void ItTestPthreadMutex026(void)
+{
+    TEST_ADD_CASE("IT_POSIX_PTHREAD_MUTEX_026", Testcase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_FUNCTION);
+}
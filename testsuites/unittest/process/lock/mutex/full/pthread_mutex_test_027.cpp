@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_mutex_test.h"
+#include <climits>
+#include <sys/syscall.h>
+
+#define TEST_FUTEX_LOCK_PI 6
+#define TEST_FUTEX_UNLOCK_PI 7
+
+static volatile unsigned int g_piWord;
+static volatile int g_lowLocked = 0;
+static volatile int g_highWaiting = 0;
+static volatile int g_mediumDone = 0;
+static volatile int g_testToCount001 = 0;
+
+static int Futex(volatile unsigned int *uaddr, int op, unsigned int val2)
+{
+    return syscall(SYS_futex, uaddr, op, 0, val2, nullptr, 0);
+}
+
+static void BusyWait(long usec)
+{
+    struct timeval start = { 0 };
+    struct timeval now = { 0 };
+
+    gettimeofday(&start, nullptr);
+    do {
+        gettimeofday(&now, nullptr);
+    } while (((now.tv_sec - start.tv_sec) * 1000000 + (now.tv_usec - start.tv_usec)) < usec); // 1000000, s to us
+}
+
+static void *LowThread(void *arg)
+{
+    int ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, UINT_MAX);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+
+    g_lowLocked = 1;
+    while (g_highWaiting == 0) {
+    }
+    BusyWait(10000); // 10000us, critical section after the high priority thread blocked
+
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    return nullptr;
+EXIT:
+    g_testToCount001 = -1;
+    return nullptr;
+}
+
+static void *MediumThread(void *arg)
+{
+    BusyWait(1000000); // 1000000us, keeps the cpu away from the lock holder unless it is boosted
+    g_mediumDone = 1;
+    return nullptr;
+}
+
+static void *HighThread(void *arg)
+{
+    g_highWaiting = 1;
+    int ret = Futex(&g_piWord, TEST_FUTEX_LOCK_PI, UINT_MAX);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+
+    /* the boosted holder released the lock before the medium thread finished */
+    ICUNIT_GOTO_EQUAL(g_mediumDone, 0, g_mediumDone, EXIT);
+    g_testToCount001++;
+
+    ret = Futex(&g_piWord, TEST_FUTEX_UNLOCK_PI, 0);
+    ICUNIT_GOTO_EQUAL(ret, 0, ret, EXIT);
+    return nullptr;
+EXIT:
+    g_testToCount001 = -1;
+    return nullptr;
+}
+
+static int CreateThread(pthread_t *thread, int priority, void *(*func)(void *))
+{
+    struct sched_param param = { 0 };
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    param.sched_priority = priority;
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedparam(&attr, &param);
+    int ret = pthread_create(thread, &attr, func, nullptr);
+    pthread_attr_destroy(&attr);
+    return ret;
+}
+
+static int Testcase(void)
+{
+    struct sched_param param = { 0 };
+    pthread_t low, medium, high;
+    int policy;
+
+    int ret = pthread_getschedparam(pthread_self(), &policy, &param);
+    ICUNIT_ASSERT_EQUAL(ret, 0, -ret);
+
+    g_piWord = 0;
+    g_lowLocked = 0;
+    g_highWaiting = 0;
+    g_mediumDone = 0;
+    g_testToCount001 = 0;
+
+    // 3, a smaller number means a higher priority, all threads run below the test thread
+    ret = CreateThread(&low, param.sched_priority + 3, LowThread);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    while (g_lowLocked == 0) {
+        SLEEP_AND_YIELD(1);
+    }
+
+    ret = CreateThread(&medium, param.sched_priority + 2, MediumThread); // 2, medium priority
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    ret = CreateThread(&high, param.sched_priority + 1, HighThread);
+    ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+
+    pthread_join(high, nullptr);
+    pthread_join(medium, nullptr);
+    pthread_join(low, nullptr);
+
+    ICUNIT_ASSERT_EQUAL(g_testToCount001, 1, g_testToCount001);
+    ICUNIT_ASSERT_EQUAL(g_piWord, 0, g_piWord);
+    return 0;
+}
+
+void ItTestPthreadMutex027(void)
+{
+    TEST_ADD_CASE("IT_POSIX_PTHREAD_MUTEX_027", Testcase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_FUNCTION);
+}
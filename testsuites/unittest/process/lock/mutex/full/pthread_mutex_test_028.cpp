@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013-2019 Huawei Technologies Co., Ltd. All rights reserved.
+ * Copyright (c) 2020-2021 Huawei Device Co., Ltd. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ * conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ * of conditions and the following disclaimer in the documentation and/or other materials
+ * provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used
+ * to endorse or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "it_mutex_test.h"
+#include <ctime>
+
+/*
+ * Futex contention benchmark: THREAD_NUM threads hammer MUTEX_NUM mutexes,
+ * each thread walking the mutexes from its own offset so every lock is
+ * contended by several threads at a time. Each contended lock/unlock pair
+ * goes through FUTEX_WAIT/FUTEX_WAKE on the hash bucket of its address.
+ */
+#define THREAD_NUM    8
+#define MUTEX_NUM     4
+#define LOOP_NUM      5000
+#define NS_PER_SECOND 1000000000LL
+
+static pthread_mutex_t g_mutexes[MUTEX_NUM];
+static volatile int g_counters[MUTEX_NUM];
+static volatile int g_start = 0;
+
+static void *ContendThread(void *arg)
+{
+    int offset = (int)(intptr_t)arg;
+
+    while (g_start == 0) {
+        sched_yield();
+    }
+
+    for (int i = 0; i < LOOP_NUM; i++) {
+        int index = (offset + i) % MUTEX_NUM;
+        pthread_mutex_lock(&g_mutexes[index]);
+        g_counters[index]++;
+        pthread_mutex_unlock(&g_mutexes[index]);
+    }
+
+    return nullptr;
+}
+
+static int Testcase(void)
+{
+    pthread_t threads[THREAD_NUM];
+    struct timespec start;
+    struct timespec end;
+    int total = 0;
+    int ret;
+    int i;
+
+    g_start = 0;
+    for (i = 0; i < MUTEX_NUM; i++) {
+        g_counters[i] = 0;
+        ret = pthread_mutex_init(&g_mutexes[i], nullptr);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+
+    for (i = 0; i < THREAD_NUM; i++) {
+        ret = pthread_create(&threads[i], nullptr, ContendThread, (void *)(intptr_t)i);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    g_start = 1;
+    for (i = 0; i < THREAD_NUM; i++) {
+        ret = pthread_join(threads[i], nullptr);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    for (i = 0; i < MUTEX_NUM; i++) {
+        total += g_counters[i];
+        ret = pthread_mutex_destroy(&g_mutexes[i]);
+        ICUNIT_ASSERT_EQUAL(ret, 0, ret);
+    }
+    ICUNIT_ASSERT_EQUAL(total, THREAD_NUM * LOOP_NUM, total);
+
+    long long cost = (end.tv_sec - start.tv_sec) * NS_PER_SECOND + (end.tv_nsec - start.tv_nsec);
+    printf("futex contention: %d threads, %d mutexes, %lld ns per lock/unlock\n", THREAD_NUM, MUTEX_NUM,
+        cost / (THREAD_NUM * LOOP_NUM));
+    return 0;
+}
+
+void ItTestPthreadMutex028(void)
+{
+    TEST_ADD_CASE("IT_POSIX_PTHREAD_MUTEX_028", Testcase, TEST_POSIX, TEST_MEM, TEST_LEVEL0, TEST_FUNCTION);
+}
@@ -62,5 +62,8 @@ extern void ItTestPthreadMutex022(void);
 extern void ItTestPthreadMutex023(void);
 extern void ItTestPthreadMutex024(void);
 extern void ItTestPthreadMutex025(void);
+extern void ItTestPthreadMutex026(void);
+extern void ItTestPthreadMutex027(void);
+extern void ItTestPthreadMutex028(void);
 
 #endif
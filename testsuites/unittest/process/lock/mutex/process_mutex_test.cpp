@@ -305,5 +305,37 @@ HWTEST_F(ProcessMutexTest, ItTestPthreadMutex025, TestSize.Level0)
 {
     ItTestPthreadMutex025();
 }
+
+/* *
+ * @tc.name: it_test_pthread_mutex_026
+ * @tc.desc: test FUTEX_WAKE_OP, FUTEX_CMP_REQUEUE and FUTEX_LOCK_PI/TRYLOCK_PI/UNLOCK_PI
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProcessMutexTest, ItTestPthreadMutex026, TestSize.Level0)
+{
+    ItTestPthreadMutex026();
+}
+
+#ifndef LOSCFG_USER_TEST_SMP
+/* *
+ * @tc.name: it_test_pthread_mutex_027
+ * @tc.desc: test FUTEX_LOCK_PI boosts the holder above a medium priority thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProcessMutexTest, ItTestPthreadMutex027, TestSize.Level0)
+{
+    ItTestPthreadMutex027();
+}
+#endif
+
+/* *
+ * @tc.name: it_test_pthread_mutex_028
+ * @tc.desc: futex contention benchmark, several threads over several mutexes
+ * @tc.type: PERF
+ */
+HWTEST_F(ProcessMutexTest, ItTestPthreadMutex028, TestSize.Level0)
+{
+    ItTestPthreadMutex028();
+}
 #endif
 } // namespace OHOS